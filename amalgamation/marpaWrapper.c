@@ -12,6 +12,11 @@
   #
   cp work/dev/marpa.w work/ami/marpa_ami.w ~/git/c-marpaWrapper/libmarpa/work/stage
   popd
+  #
+  # marpa.c and marpa.h are then patched again: look for "c-marpaWrapper:" in the previous
+  # version. Events and errors are recorded in the current recognizer of the thread, set
+  # with marpa_r_context_set(), Leo event sets are per recognizer, and the grammar reference
+  # count is atomic: recognizers on one precomputed grammar can run concurrently.
 */
 
 #ifndef MARPA_LINKAGE
@@ -27,13 +32,39 @@
 #  define MARPA_OBS_LINKAGE static
 #endif
 
+/* Every allocation of libmarpa and of the wrapper goes through the allocator of the */
+/* object being worked on, c.f. marpaWrapperAllocator_t. System headers that declare */
+/* the C allocation functions must be seen before the redirection.                   */
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
+#include "marpaWrapper/internal/config.h"
+#include "marpaWrapper/internal/_allocator.h"
+#define malloc(sizel)         _marpaWrapperAllocator_mallocp(sizel)
+#define calloc(nmemb, sizel)  _marpaWrapperAllocator_callocp(nmemb, sizel)
+#define realloc(p, sizel)     _marpaWrapperAllocator_reallocp(p, sizel)
+#define free(p)               _marpaWrapperAllocator_freev(p)
+
 #include "../libmarpa/work/stage/marpa_ami.c"
 #include "../libmarpa/work/stage/marpa_avl.c"
 #include "../libmarpa/work/stage/marpa.c"
 #include "../libmarpa/work/stage/marpa_codes.c"
 #include "../libmarpa/work/stage/marpa_obs.c"
 #include "../libmarpa/work/stage/marpa_tavl.c"
+#include "../src/arena.c"
 #include "../src/asf.c"
 #include "../src/grammar.c"
 #include "../src/recognizer.c"
+#include "../src/recognizerPool.c"
 #include "../src/value.c"
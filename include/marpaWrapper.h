@@ -5,5 +5,7 @@
 #include <marpaWrapper/recognizer.h>
 #include <marpaWrapper/value.h>
 #include <marpaWrapper/asf.h>
+#include <marpaWrapper/arena.h>
+#include <marpaWrapper/recognizerPool.h>
 
 #endif /* MARPAWRAPPER_H */
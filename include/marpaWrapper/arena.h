@@ -0,0 +1,31 @@
+#ifndef MARPAWRAPPER_ARENA_H
+#define MARPAWRAPPER_ARENA_H
+
+#include <marpaWrapper/grammar.h>
+
+/***********************/
+/* Opaque object types */
+/***********************/
+typedef struct marpaWrapperArena marpaWrapperArena_t;
+
+/* ----------------------------------------------------------------------------------------------- */
+/* A per-parse arena: growable chunks given out by a bump pointer, released all at once.           */
+/* Setting marpaWrapperArena_allocatorp() in marpaWrapperRecognizerOption_t puts the recognizer and */
+/* everything derived from it (bocage, order, tree, value, ASF) in the arena. Freeing them is then  */
+/* cheap: the ASF does not walk its internal tables anymore. They must still be freed, before       */
+/* marpaWrapperArena_resetb() that releases the whole arena and keeps its largest chunk for the     */
+/* next document. An arena is not thread-safe: use one arena per parse at a time.                  */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+  marpaWrapper_EXPORT marpaWrapperArena_t     *marpaWrapperArena_newp(genericLogger_t *genericLoggerp, size_t chunkl);
+  marpaWrapper_EXPORT marpaWrapperAllocator_t *marpaWrapperArena_allocatorp(marpaWrapperArena_t *marpaWrapperArenap);
+  marpaWrapper_EXPORT short                    marpaWrapperArena_resetb(marpaWrapperArena_t *marpaWrapperArenap);
+  marpaWrapper_EXPORT short                    marpaWrapperArena_statsb(marpaWrapperArena_t *marpaWrapperArenap, size_t *usedlp, size_t *capacitylp, size_t *nChunklp);
+  marpaWrapper_EXPORT void                     marpaWrapperArena_freev(marpaWrapperArena_t *marpaWrapperArenap);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MARPAWRAPPER_ARENA_H */
@@ -18,6 +18,35 @@ typedef short (*marpaWrapperAsfOkRuleCallback_t)(void *userDatavp, genericStack_
 typedef short (*marpaWrapperAsfOkSymbolCallback_t)(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
 typedef short (*marpaWrapperAsfOkNullingCallback_t)(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli);
 
+/* -------------------------------------------------------------------------- */
+/* K-best token score: argi is the indice in the input stack, -1 if nulling.  */
+/* It returns 0 if failure, 1 if ok.                                          */
+/* -------------------------------------------------------------------------- */
+typedef short (*marpaWrapperAsfTokenScoreCallback_t)(void *userDatavp, int symboli, int argi, int *scoreip);
+
+/* ------------------------------------------------------------------ */
+/* Ambiguity statistics. Tree counts saturate at (size_t) -1. An      */
+/* alternative is a factoring of any symch of a glade, if not dead.   */
+/* ------------------------------------------------------------------ */
+typedef struct marpaWrapperAsfGladeStats {
+  int    gladeIdi;
+  int    symboli;
+  int    starti;              /* Earley set where the span starts */
+  int    lengthi;             /* Length of the span */
+  int    nAlternativei;
+  size_t nTreel;
+} marpaWrapperAsfGladeStats_t;
+
+typedef struct marpaWrapperAsfStats {
+  size_t nTreel;              /* Trees of the peak glade */
+  short  treesSaturatedb;
+  short  factoringsOmittedb;  /* Factorings were omitted: nTreel is a lower bound */
+  size_t nGladel;             /* Glades, symches and factorings of the forest */
+  size_t nSymchl;
+  size_t nFactoringl;
+  size_t nAmbiguousGladel;    /* Glades with more than one alternative */
+} marpaWrapperAsfStats_t;
+
 /* --------------- */
 /* General options */
 /* --------------- */
@@ -27,11 +56,25 @@ typedef struct marpaWrapperAsfOption {
   short            orderByRankb;               /* Default: 1 */
   short            ambiguousb;                 /* Default: 0 */
   int              maxParsesi;                 /* Default: 0 */
+  short            okCacheb;                   /* Default: 0. Value: every tree is still traversed and valued, */
+                                               /* only the ok callbacks of the subtrees that did not change    */
+                                               /* since the previous tree are not called again.                */
+  short            memob;                      /* Default: 0. Traverse: the value of a glade is computed once */
+                                               /* per traversal and shared by all its parents.               */
+  size_t           maxBytesl;                  /* Default: 0. If > 0, glade contents used the longest time   */
+                                               /* ago are evicted before a traversal when their size is over */
+                                               /* this value, and set up again when needed. This is a soft   */
+                                               /* limit, checked between traversals only, on the glade       */
+                                               /* contents only: a traversal, the glades of the previous one */
+                                               /* and a prepared ASF can go over it, and the rest of the ASF */
+                                               /* memory is not counted.                                     */
 } marpaWrapperAsfOption_t;
 
 /* A traverser always returns a false or a true value, and a "user-space" value in *valueip.  */
 /* think to it as convienent ways to have an index in an output stack, managed in user-space. */
 /* A false return value is indicating a failure and traversing will stop.                     */
+/* With the memob option, the traverser is called once per glade: its value must not depend  */
+/* on the parent that asked for it.                                                           */
 typedef short (*traverserCallback_t)(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
 
 #ifdef __cplusplus
@@ -39,14 +82,67 @@ extern "C" {
 #endif
   marpaWrapper_EXPORT marpaWrapperAsf_t        *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperAsfOption_t *marpaWrapperAsfOptionp);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_traverseb(marpaWrapperAsf_t *marpaWrapperAsfp, traverserCallback_t traverserCallbackp, void *userDatavp, int *valueip);
+  /* Set up all the glades, and return the peak glade ID. On a prepared ASF, traversals from any  */
+  /* glade do not modify it: they can run concurrently, e.g. one per RHS glade of a factoring as */
+  /* given by marpaWrapperAsf_traverse_rh_gladeIdb(), if callbacks and allocator are thread-safe. */
+  /* There is no parallel traversal mode: the set up is serial, the threads and the combination  */
+  /* of their values are up to the caller, and marpaWrapperAsf_traverse_gladeb() ignores the     */
+  /* memob option, so that concurrent traversals share no glade value.                           */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_prepareb(marpaWrapperAsf_t *marpaWrapperAsfp, int *gladeIdip);
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, traverserCallback_t traverserCallbackp, void *userDatavp, int *valueip);
   marpaWrapper_EXPORT int                       marpaWrapperAsf_traverse_rh_lengthi(marpaWrapperAsfTraverser_t *traverserp);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_symbolIdb(marpaWrapperAsfTraverser_t *traverserp, int *symbolIdi);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_ruleIdb(marpaWrapperAsfTraverser_t *traverserp, int *ruleIdip);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_nextb(marpaWrapperAsfTraverser_t *traverserp, short *nextbp);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp, int rhIxi, int *valueip, int *lengthip);
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_traverse_rh_gladeIdb(marpaWrapperAsfTraverser_t *traverserp, int rhIxi, int *gladeIdip);
   marpaWrapper_EXPORT marpaWrapperAsf_t        *marpaWrapperAsf_traverse_asfp(marpaWrapperAsfTraverser_t *traverserp);
   marpaWrapper_EXPORT marpaWrapperRecognizer_t *marpaWrapperAsf_recognizerp(marpaWrapperAsf_t *marpaWrapperAsfp);
   marpaWrapper_EXPORT short                     marpaWrapperAsf_genericLoggerp(marpaWrapperAsf_t *marpaWrapperAsfp, genericLogger_t **genericLoggerpp);
+  /* Intset interning: number of intsets, lookups, probes beyond the home slot, longest probe, */
+  /* and key comparisons that failed on an equal 64-bit hash. Any output pointer can be NULL.  */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_intsetStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nIntsetlp, size_t *nLookuplp, size_t *nProbelp, size_t *maxProbelp, size_t *nCollisionlp);
+  /* Traverser memo: number of glade values asked for, and of those that were already known. */
+  /* Any output pointer can be NULL.                                                         */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_memoStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nLookuplp, size_t *nHitlp);
+  /* Glade contents evictions of the maxBytesl option: number of glades evicted, number of  */
+  /* glades set up again, and current size of glade contents. Any output pointer can be NULL. */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_evictionStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nEvictionlp, size_t *nRebuildlp, size_t *nByteslp);
+  /* Ok callbacks whose verdict depends neither on the parents nor on the values: they are   */
+  /* called once per symch with an empty parentRuleiStackp, arg0i and argni being -1, and a   */
+  /* rejection is final. Factorings that are rejected, or that have a down glade with nothing */
+  /* left, are dead: traversals, marpaWrapperAsfValue_valueb() on marpaWrapperAsfValue_asfp() */
+  /* and marpaWrapperAsf_kbestb() skip them. Glades are set up as with                        */
+  /* marpaWrapperAsf_prepareb(). A NULL callback accepts everything. Prunings add up:         */
+  /* *nDeadFactoringlp is the total number of dead factorings, it can be NULL.                */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_pruneb(marpaWrapperAsf_t *marpaWrapperAsfp, void *userDatavp,
+                                                                       marpaWrapperAsfOkRuleCallback_t    okRuleCallbackp,
+                                                                       marpaWrapperAsfOkSymbolCallback_t  okSymbolCallbackp,
+                                                                       marpaWrapperAsfOkNullingCallback_t okNullingCallbackp,
+                                                                       size_t *nDeadFactoringlp);
+  /* The ki best parse trees, without enumerating the others: the score of a tree is the sum  */
+  /* of the ranks of its rules and of the scores of its tokens, 0 when tokenScoreCallbackp is  */
+  /* NULL. Glades are set up as with marpaWrapperAsf_prepareb(). *nTreeip is the number of     */
+  /* trees found, at most ki: tree No 0 is the best, equal scores are in discovery order.      */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_kbestb(marpaWrapperAsf_t *marpaWrapperAsfp, int ki, void *userDatavp, marpaWrapperAsfTokenScoreCallback_t tokenScoreCallbackp, int *nTreeip);
+  /* Value of tree No treei of the last marpaWrapperAsf_kbestb(), with the callbacks of       */
+  /* marpaWrapperValue_valueb(): the result is at indice 0 of the output stack. scoreip can   */
+  /* be NULL.                                                                                  */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_kbest_valueb(marpaWrapperAsf_t *marpaWrapperAsfp, int treei, void *userDatavp,
+                                                                             marpaWrapperValueRuleCallback_t valueRuleCallbackp,
+                                                                             marpaWrapperValueSymbolCallback_t valueSymbolCallbackp,
+                                                                             marpaWrapperValueNullingCallback_t valueNullingCallbackp,
+                                                                             int *scoreip);
+  /* Last marpaWrapperAsf_kbestb(): number of glades visited, and of derivations created,     */
+  /* found or not. Any output pointer can be NULL.                                            */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_kbestStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nGladelp, size_t *nDerivationlp);
+  /* Ambiguity of the forest in a single bottom-up pass, without enumerating trees. Glades are  */
+  /* set up as with marpaWrapperAsf_prepareb(). If topGladeStatsp is not NULL, it receives at    */
+  /* most nTopi ambiguous glades, the ones with the most alternatives first, then the ones with  */
+  /* the most trees: *nTopip is their number. statsp and nTopip can be NULL.                     */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfStats_t *statsp, marpaWrapperAsfGladeStats_t *topGladeStatsp, int nTopi, int *nTopip);
+  /* Statistics of any glade of the last marpaWrapperAsf_statsb() */
+  marpaWrapper_EXPORT short                     marpaWrapperAsf_glade_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfGladeStats_t *gladeStatsp);
   marpaWrapper_EXPORT void                      marpaWrapperAsf_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
 
   /* Valuation method simulation */
@@ -61,6 +157,8 @@ extern "C" {
                                                                           marpaWrapperValueNullingCallback_t valueNullingCallbackp);
   marpaWrapper_EXPORT short                   marpaWrapperAsfValue_value_startb(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int *startip);
   marpaWrapper_EXPORT short                   marpaWrapperAsfValue_value_lengthb(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int *lengthip);
+  /* The ASF used for valuation, e.g. for its statistics */
+  marpaWrapper_EXPORT marpaWrapperAsf_t      *marpaWrapperAsfValue_asfp(marpaWrapperAsfValue_t *marpaWrapperAsfValuep);
   marpaWrapper_EXPORT void                    marpaWrapperAsfValue_freev(marpaWrapperAsfValue_t *marpaWrapperAsfValuep);
 #ifdef __cplusplus
 }
@@ -56,14 +56,27 @@ typedef struct marpaWrapperGrammarRuleOption {
   int    minimumi;       /* Default: 0. Mininimum - must be 0 or 1                  */
 } marpaWrapperGrammarRuleOption_t;
 
+/* ---------------------------------------------------------------------------------------- */
+/* Allocator: all memory of the wrapper and of libmarpa for an object and what derives from */
+/* it. The callbacks follow the malloc(), realloc() and free() semantics.                   */
+/* ---------------------------------------------------------------------------------------- */
+typedef struct marpaWrapperAllocator {
+  void  *userDatavp;
+  void *(*mallocp)(void *userDatavp, size_t sizel);
+  void *(*reallocp)(void *userDatavp, void *p, size_t sizel);
+  void  (*freep)(void *userDatavp, void *p);
+} marpaWrapperAllocator_t;
+
 /* --------------- */
 /* General options */
 /* --------------- */
+/* allocatorp was appended in version 2.0.0: the size of this structure changed, callers must be recompiled */
 typedef struct marpaWrapperGrammarOption {
-  genericLogger_t *genericLoggerp;             /* Default: NULL.                                      */
-  short            warningIsErrorb;            /* Default: 0. Have precedence over warningIsIgnoredb  */
-  short            warningIsIgnoredb;          /* Default: 0.                                         */
-  short            autorankb;                  /* Default: 0.                                         */
+  genericLogger_t         *genericLoggerp;     /* Default: NULL.                                      */
+  short                    warningIsErrorb;    /* Default: 0. Have precedence over warningIsIgnoredb  */
+  short                    warningIsIgnoredb;  /* Default: 0.                                         */
+  short                    autorankb;          /* Default: 0.                                         */
+  marpaWrapperAllocator_t *allocatorp;         /* Default: NULL. C library allocator                  */
 } marpaWrapperGrammarOption_t;
 
 typedef enum marpaWrapperSymbolProperty {
@@ -118,7 +131,22 @@ extern "C" {
   
   marpaWrapper_EXPORT short                  marpaWrapperGrammar_precomputeb(marpaWrapperGrammar_t *marpaWrapperGrammarp);
   marpaWrapper_EXPORT short                  marpaWrapperGrammar_precompute_startb(marpaWrapperGrammar_t *marpaWrapperGrammarp, int starti);
+  /* Events of precomputation. Events of a parse are in its recognizer only, c.f.                      */
+  /* marpaWrapperRecognizer_eventb().                                                                  */
   marpaWrapper_EXPORT short                  marpaWrapperGrammar_eventb(marpaWrapperGrammar_t *marpaWrapperGrammarp, size_t *eventlp, marpaWrapperGrammarEvent_t **eventpp, short exhaustionEventb, short forceReloadb);
+
+  /* Versioned and checksummed binary image of a grammar, portable across hosts. The buffer returned by */
+  /* marpaWrapperGrammar_serializeb() must be freed by the caller. The image holds the symbols and rules */
+  /* definitions only: marpaWrapperGrammar_deserializep() replays them and, if the original was         */
+  /* precomputed, precomputes again. This does not skip precomputation, whose tables libmarpa cannot     */
+  /* export; it only replaces the program that builds the grammar. libmarpa version must be the same.   */
+  marpaWrapper_EXPORT short                  marpaWrapperGrammar_serializeb(marpaWrapperGrammar_t *marpaWrapperGrammarp, char **bufferpp, size_t *bufferlp);
+  marpaWrapper_EXPORT marpaWrapperGrammar_t *marpaWrapperGrammar_deserializep(marpaWrapperGrammarOption_t *marpaWrapperGrammarOptionp, char *bufferp, size_t bufferl);
+  /* Same with a file. marpaWrapperGrammar_loadp() maps the file read-only for the time of the          */
+  /* deserialization, this is equivalent to reading it and calling marpaWrapperGrammar_deserializep():  */
+  /* the restored grammar is private to the caller and nothing is shared between processes.            */
+  marpaWrapper_EXPORT short                  marpaWrapperGrammar_saveb(marpaWrapperGrammar_t *marpaWrapperGrammarp, char *filenames);
+  marpaWrapper_EXPORT marpaWrapperGrammar_t *marpaWrapperGrammar_loadp(marpaWrapperGrammarOption_t *marpaWrapperGrammarOptionp, char *filenames);
 #ifdef __cplusplus
 }
 #endif
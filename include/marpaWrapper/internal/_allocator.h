@@ -0,0 +1,134 @@
+#ifndef MARPAWRAPPER_INTERNAL_ALLOCATOR_H
+#define MARPAWRAPPER_INTERNAL_ALLOCATOR_H
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include "marpaWrapper/grammar.h"
+
+/* The amalgamation redirects malloc/calloc/realloc/free of libmarpa and of the wrapper to the functions */
+/* below. The allocator used is the one of the object the current public entry point works on:          */
+/* MARPAWRAPPER_ALLOCATOR_SET() at its very beginning. A block is therefore always reallocated or freed  */
+/* by an entry point of the object it was allocated for, or of an object that has the same allocator.    */
+/* Release builds add nothing to the blocks. Debug builds prefix every block with its allocator, and     */
+/* check that it is the current one when the block is reallocated or freed.                              */
+/* Memory handed over to the caller is from the C library: (malloc)() and (free)() bypass the redirection. */
+
+#if defined(_MSC_VER)
+#  define MARPAWRAPPER_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) || defined(__clang__)
+#  define MARPAWRAPPER_THREAD_LOCAL __thread
+#else
+#  define MARPAWRAPPER_THREAD_LOCAL
+#endif
+
+static MARPAWRAPPER_THREAD_LOCAL marpaWrapperAllocator_t *_marpaWrapperAllocator_currentp = NULL;
+
+#define MARPAWRAPPER_ALLOCATOR_SET(allocatorp) (_marpaWrapperAllocator_currentp = (allocatorp))
+
+#ifndef NDEBUG
+/* Block header, sized so that the user part keeps malloc() alignment */
+typedef union _marpaWrapperAllocatorHeader {
+  marpaWrapperAllocator_t *allocatorp;
+  void                    *alignp;
+  double                   alignd;
+  long double              alignld;
+} _marpaWrapperAllocatorHeader_t;
+#  define MARPAWRAPPER_ALLOCATOR_HEADER_SIZE sizeof(_marpaWrapperAllocatorHeader_t)
+#  define MARPAWRAPPER_ALLOCATOR_BLOCK(p)    ((void *) (((_marpaWrapperAllocatorHeader_t *) (p)) - 1))
+#  define MARPAWRAPPER_ALLOCATOR_USER(p)     ((void *) (((_marpaWrapperAllocatorHeader_t *) (p)) + 1))
+#else
+#  define MARPAWRAPPER_ALLOCATOR_HEADER_SIZE 0
+#  define MARPAWRAPPER_ALLOCATOR_BLOCK(p)    (p)
+#  define MARPAWRAPPER_ALLOCATOR_USER(p)     (p)
+#endif
+
+/*****************************************************************************/
+static inline void *_marpaWrapperAllocator_mallocp(size_t sizel)
+/*****************************************************************************/
+{
+  marpaWrapperAllocator_t *allocatorp = _marpaWrapperAllocator_currentp;
+  void                    *blockp;
+
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - MARPAWRAPPER_ALLOCATOR_HEADER_SIZE)) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  sizel += MARPAWRAPPER_ALLOCATOR_HEADER_SIZE;
+
+  blockp = (allocatorp == NULL) ? malloc(sizel) : allocatorp->mallocp(allocatorp->userDatavp, sizel);
+  if (MARPAWRAPPER_UNLIKELY(blockp == NULL)) {
+    return NULL;
+  }
+#ifndef NDEBUG
+  ((_marpaWrapperAllocatorHeader_t *) blockp)->allocatorp = allocatorp;
+#endif
+
+  return MARPAWRAPPER_ALLOCATOR_USER(blockp);
+}
+
+/*****************************************************************************/
+static inline void *_marpaWrapperAllocator_callocp(size_t nmemb, size_t sizel)
+/*****************************************************************************/
+{
+  void *p;
+
+  if (MARPAWRAPPER_UNLIKELY((sizel > 0) && (nmemb > ((size_t) -1) / sizel))) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  p = _marpaWrapperAllocator_mallocp(nmemb * sizel);
+  if (MARPAWRAPPER_LIKELY(p != NULL)) {
+    memset(p, 0, nmemb * sizel);
+  }
+
+  return p;
+}
+
+/*****************************************************************************/
+static inline void *_marpaWrapperAllocator_reallocp(void *p, size_t sizel)
+/*****************************************************************************/
+{
+  marpaWrapperAllocator_t *allocatorp = _marpaWrapperAllocator_currentp;
+  void                    *blockp;
+
+  if (p == NULL) {
+    return _marpaWrapperAllocator_mallocp(sizel);
+  }
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - MARPAWRAPPER_ALLOCATOR_HEADER_SIZE)) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  sizel += MARPAWRAPPER_ALLOCATOR_HEADER_SIZE;
+
+  blockp = MARPAWRAPPER_ALLOCATOR_BLOCK(p);
+  assert(((_marpaWrapperAllocatorHeader_t *) blockp)->allocatorp == allocatorp);
+  blockp = (allocatorp == NULL) ? realloc(blockp, sizel) : allocatorp->reallocp(allocatorp->userDatavp, blockp, sizel);
+  if (MARPAWRAPPER_UNLIKELY(blockp == NULL)) {
+    return NULL;
+  }
+
+  return MARPAWRAPPER_ALLOCATOR_USER(blockp);
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperAllocator_freev(void *p)
+/*****************************************************************************/
+{
+  marpaWrapperAllocator_t *allocatorp = _marpaWrapperAllocator_currentp;
+  void                    *blockp;
+
+  if (p != NULL) {
+    blockp = MARPAWRAPPER_ALLOCATOR_BLOCK(p);
+    assert(((_marpaWrapperAllocatorHeader_t *) blockp)->allocatorp == allocatorp);
+    if (allocatorp == NULL) {
+      free(blockp);
+    } else {
+      allocatorp->freep(allocatorp->userDatavp, blockp);
+    }
+  }
+}
+
+#endif /* MARPAWRAPPER_INTERNAL_ALLOCATOR_H */
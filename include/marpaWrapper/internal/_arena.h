@@ -0,0 +1,46 @@
+#ifndef MARPAWRAPPER_INTERNAL_ARENA_H
+#define MARPAWRAPPER_INTERNAL_ARENA_H
+
+#include <stddef.h>
+#include "marpaWrapper/arena.h"
+
+/* Default size of the first chunk - next ones double up to MARPAWRAPPERARENA_MAX_CHUNK */
+#define MARPAWRAPPERARENA_DEFAULT_CHUNK (64 * 1024)
+#define MARPAWRAPPERARENA_MAX_CHUNK     (64 * 1024 * 1024)
+
+/* Every block is preceded by its size, for realloc, and keeps malloc() alignment */
+typedef union _marpaWrapperArenaAlign {
+  size_t       sizel;
+  void        *alignp;
+  double       alignd;
+  long double  alignld;
+} _marpaWrapperArenaAlign_t;
+
+#define MARPAWRAPPERARENA_ALIGN              sizeof(_marpaWrapperArenaAlign_t)
+#define MARPAWRAPPERARENA_ROUND(sizel)       ((((sizel) + MARPAWRAPPERARENA_ALIGN - 1) / MARPAWRAPPERARENA_ALIGN) * MARPAWRAPPERARENA_ALIGN)
+
+typedef struct _marpaWrapperArenaChunk {
+  struct _marpaWrapperArenaChunk *previousp;
+  size_t                          sizel;  /* Usable size, after the header */
+  size_t                          usedl;
+} _marpaWrapperArenaChunk_t;
+
+#define MARPAWRAPPERARENA_CHUNK_HEADER       MARPAWRAPPERARENA_ROUND(sizeof(_marpaWrapperArenaChunk_t))
+#define MARPAWRAPPERARENA_CHUNK_DATA(chunkp) (((char *) (chunkp)) + MARPAWRAPPERARENA_CHUNK_HEADER)
+
+struct marpaWrapperArena {
+  marpaWrapperAllocator_t    marpaWrapperAllocator; /* userDatavp is the arena */
+  genericLogger_t           *genericLoggerp;
+  size_t                     chunkl;                /* Minimum size of the next chunk */
+  _marpaWrapperArenaChunk_t *chunkp;                /* Current chunk, older ones are chained behind it */
+  char                      *lastp;                 /* Last block given: it can grow or be given back in place */
+  size_t                     usedl;                 /* Bytes given since creation or last reset */
+  size_t                     capacityl;             /* Sum of chunk sizes */
+  size_t                     nChunkl;
+};
+
+/* Objects whose allocator is an arena do not need to release their memory piece by piece */
+static void *_marpaWrapperArena_mallocp(void *userDatavp, size_t sizel);
+#define MARPAWRAPPERARENA_ALLOCATOR_IS_ARENA(allocatorp) (((allocatorp) != NULL) && ((allocatorp)->mallocp == _marpaWrapperArena_mallocp))
+
+#endif /* MARPAWRAPPER_INTERNAL_ARENA_H */
@@ -2,6 +2,7 @@
 #define MARPAWRAPPER_INTERNAL_ASF_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include "genericStack.h"
 #include "genericHash.h"
 #include "genericSparseArray.h"
@@ -18,10 +19,11 @@
 #define MARPAWRAPPERASF_USE_VISITED_FLAG 0
 #endif
 
+/* An idset is the slice [offsetl, offsetl + counti[ of the intset slab */
 typedef struct marpaWrapperAsfIdset {
   int    idi;
-  int    counti;
-  int   *idip;
+  int    counti;          /* -1 when this intset id is not an idset of this kind */
+  size_t offsetl;
 } marpaWrapperAsfIdset_t;
 
 typedef marpaWrapperAsfIdset_t marpaWrapperAsfNidset_t;
@@ -33,9 +35,72 @@ typedef enum marpaWrapperAsfIdsete {
   _MARPAWRAPPERASFIDSET_IDSETE_MAX
 } marpaWrapperAsfIdsete_t;
 
+/* Idsets of one kind, indexed by intset id. Records are in blocks of           */
+/* MARPAWRAPPERASF_IDSET_BLOCK_SIZE that never move: an idset pointer stays      */
+/* valid while the vector grows. Ids themselves are in the intset slab.        */
+#ifndef MARPAWRAPPERASF_IDSET_BLOCK_SHIFT
+#define MARPAWRAPPERASF_IDSET_BLOCK_SHIFT 10
+#endif
+#define MARPAWRAPPERASF_IDSET_BLOCK_SIZE (1 << MARPAWRAPPERASF_IDSET_BLOCK_SHIFT)
+#define MARPAWRAPPERASF_IDSET_BLOCK_MASK (MARPAWRAPPERASF_IDSET_BLOCK_SIZE - 1)
+
+typedef struct marpaWrapperAsfIdsetVector {
+  size_t                   sizeBlockl; /* Allocated size */
+  size_t                   nBlockl;    /* Used size      */
+  marpaWrapperAsfIdset_t **blockpp;
+} marpaWrapperAsfIdsetVector_t;
+
+/* Intset interning: open addressing with linear probing on a power of two    */
+/* number of slots, kept at most half full. The full 64-bit hash is stored so */
+/* that a probe compares keys only when hashes are equal. Keys, i.e. sorted   */
+/* ids, are stored one after the other in a single slab.                      */
+#ifndef MARPAWRAPPERASF_INTSET_INITIAL_SIZE
+#define MARPAWRAPPERASF_INTSET_INITIAL_SIZE 1024
+#endif
+
+typedef struct marpaWrapperAsfIntsetSlot {
+  uint64_t hashull;
+  int      intsetIdi;   /* -1 when the slot is empty */
+  int      counti;
+  size_t   offsetl;     /* Ids are slabip[offsetl .. offsetl + counti - 1] */
+} marpaWrapperAsfIntsetSlot_t;
+
+typedef struct marpaWrapperAsfIntsetTable {
+  size_t                       sizel;       /* Number of slots, a power of two */
+  size_t                       usedl;
+  marpaWrapperAsfIntsetSlot_t *slotp;
+  size_t                       sizeSlabl;   /* Allocated size */
+  size_t                       nSlabl;      /* Used size      */
+  int                         *slabip;
+  /* Statistics */
+  size_t                       nLookupl;
+  size_t                       nProbel;     /* Slots visited after the home slot */
+  size_t                       maxProbel;
+  size_t                       nCollisionl; /* Same hash, different key */
+} marpaWrapperAsfIntsetTable_t;
+
+/* The content of a glade is appended to per-ASF arrays when it is set up: a glade */
+/* is a range of symches, a symch a range of factorings, a factoring a range of     */
+/* glade ids. Ranges are indices, so the arrays can grow without fixups.           */
+typedef struct marpaWrapperAsfSymch {
+  int   ruleIdi;              /* < 0 for a token */
+  short factoringsOmittedb;
+  int   firstFactoringi;      /* Indice in factoringp */
+  int   nFactoringi;
+} marpaWrapperAsfSymch_t;
+
+typedef struct marpaWrapperAsfFactoring {
+  int   firstFactori;         /* Indice in factorip */
+  int   nFactori;
+  short deadb;                /* Rejected by marpaWrapperAsf_pruneb(): traversals skip it */
+} marpaWrapperAsfFactoring_t;
+
+/* Glades are stored by value in marpaWrapperAsfp->gladep, indexed by their id */
 typedef struct marpaWrapperAsfGlade {
-  int             idi;
-  genericStack_t *symchesStackp;
+  int             idi;            /* -1 when this slot is not a glade */
+  int             firstSymchi;    /* Indice in symchp */
+  int             nSymchi;        /* -1 until the glade is set up */
+  int             lastTraversali; /* Last traversal that used it, -1 when its contents were evicted */
 #if MARPAWRAPPERASF_USE_VISITED_FLAG > 0
   short           visitedb;
 #endif
@@ -44,6 +109,13 @@ typedef struct marpaWrapperAsfGlade {
 #endif
 } marpaWrapperAsfGlade_t;
 
+/* Eviction sorts set up glades, most recently used first */
+typedef struct marpaWrapperAsfEvictionCandidate {
+  int lastTraversali;
+  int gladeIdi;
+  int firstSymchi;      /* In the new arrays, when the glade is kept */
+} marpaWrapperAsfEvictionCandidate_t;
+
 typedef int *andNodeStack_t;
 
 typedef struct marpaWrapperAsfOrNode {
@@ -67,6 +139,99 @@ typedef struct marpaWrapperAsfSourceData {
   int sourceNidi;
 } marpaWrapperAsfSourceData_t;
 
+/* There is a single choicepoint per ASF, reset for every glade that is set up.  */
+/* The factoring stack keeps nooks by value, so a nook pointer is valid only     */
+/* until the next push. An OR node is in use when its entry in orNodeInUseip is  */
+/* equal to generationi: a reset is an increment.                                */
+typedef struct marpaWrapperAsfChoicePoint {
+  marpaWrapperAsfNook_t *nookp;
+  size_t                 sizeNookl;   /* Allocated size */
+  int                    nNooki;      /* Used size, 0 when there is no factoring */
+  int                   *orNodeInUseip;
+  int                    nOrNodeInUsei;
+  int                    generationi;
+} marpaWrapperAsfChoicePoint_t;
+
+/* Traverser values of the memob option, indexed by glade id. A value is known */
+/* in the current traversal when its generationi is equal to the memo one: a   */
+/* new traversal is an increment.                                              */
+typedef struct marpaWrapperAsfMemoValue {
+  int valuei;
+  int generationi;
+} marpaWrapperAsfMemoValue_t;
+
+typedef struct marpaWrapperAsfMemo {
+  marpaWrapperAsfMemoValue_t *valuep;
+  size_t                      sizeValuel;  /* Allocated size   */
+  size_t                      nValuel;     /* Initialized size */
+  int                         generationi;
+  size_t                      nLookupl;
+  size_t                      nHitl;
+} marpaWrapperAsfMemo_t;
+
+/* K-best derivations of marpaWrapperAsf_kbestb(). A derivation of a glade is  */
+/* a symch, one of its factorings and, for every factor, a derivation of the  */
+/* down glade. Found and candidate derivations are appended to a single pool, */
+/* where found ones are linked per glade in descending score order, and       */
+/* candidates are in a pairing heap per glade. A lower indice in the pool     */
+/* wins between equal scores.                                                 */
+typedef struct marpaWrapperAsfKbestDerivation {
+  int scorei;
+  int gladeIdi;
+  int symchi;                 /* Indice in symchp */
+  int factoringi;             /* Indice in factoringp, -1 for a token */
+  int firstDowni;             /* Indice in downip of the derivations of the factors */
+  int nextFoundi;             /* Next found derivation of the glade, -1 if none */
+  int childi;                 /* Pairing heap: first child, -1 if none */
+  int siblingi;               /* Pairing heap: next sibling, -1 if none */
+} marpaWrapperAsfKbestDerivation_t;
+
+/* Indexed by glade id */
+typedef struct marpaWrapperAsfKbestGlade {
+  short stateb;               /* 0: not visited, -1: being visited, 1: visited */
+  short expandedb;            /* The successors of lastFoundi are candidates */
+  int   firstFoundi;          /* -1 if none */
+  int   lastFoundi;           /* -1 if none */
+  int   heapi;                /* Best candidate, -1 if none */
+} marpaWrapperAsfKbestGlade_t;
+
+typedef struct marpaWrapperAsfKbest {
+  marpaWrapperAsfKbestGlade_t        *gladep;
+  size_t                              sizeGladel;      /* Allocated size */
+  marpaWrapperAsfKbestDerivation_t   *derivationp;
+  size_t                              sizeDerivationl;
+  size_t                              nDerivationl;
+  int                                *downip;
+  size_t                              sizeDownl;
+  size_t                              nDownl;
+  int                                *treeip;          /* Found derivations of the peak glade */
+  size_t                              sizeTreel;
+  int                                 nTreei;
+  size_t                              nVisitedl;       /* Glades visited */
+  void                               *userDatavp;
+  marpaWrapperAsfTokenScoreCallback_t tokenScoreCallbackp;
+} marpaWrapperAsfKbest_t;
+
+/* Pruning of marpaWrapperAsf_pruneb(). Glade states are indexed by glade id: */
+/* 0 not seen, -1 being seen, 1 alive, 2 dead. Prunings add up.               */
+typedef struct marpaWrapperAsfPrune {
+  short                             *gladeStatebp;
+  size_t                             sizeGladeStatel;  /* Allocated size */
+  short                              prunedb;          /* At least one factoring is dead */
+  size_t                             nDeadFactoringl;
+  genericStack_t                    *parentRuleiStackp; /* Always empty */
+  void                              *userDatavp;
+  marpaWrapperAsfOkRuleCallback_t    okRuleCallbackp;
+  marpaWrapperAsfOkSymbolCallback_t  okSymbolCallbackp;
+  marpaWrapperAsfOkNullingCallback_t okNullingCallbackp;
+} marpaWrapperAsfPrune_t;
+
+/* Tree counts of marpaWrapperAsf_statsb(), indexed by glade id */
+typedef struct marpaWrapperAsfCount {
+  size_t nTreel;
+  short  stateb;              /* 0: not counted, -1: being counted, 1: counted */
+} marpaWrapperAsfCount_t;
+
 struct marpaWrapperAsf {
   marpaWrapperRecognizer_t    *marpaWrapperRecognizerp;
   marpaWrapperAsfOption_t      marpaWrapperAsfOption;
@@ -75,17 +240,44 @@ struct marpaWrapperAsf {
 
   /* Memoization */
   genericStack_t              *orNodeStackp;
-  genericHash_t               *intsetHashp;
-  genericSparseArray_t        *nidsetSparseArrayp;
-  genericSparseArray_t        *powersetSparseArrayp;
-  genericStack_t              *gladeStackp;
+  marpaWrapperAsfIntsetTable_t intsetTable;
+  marpaWrapperAsfIdsetVector_t idsetVectors[_MARPAWRAPPERASFIDSET_IDSETE_MAX];
+  marpaWrapperAsfGlade_t      *gladep;
+  size_t                       sizeGladel;      /* Allocated size */
+  size_t                       nGladel;         /* Initialized size */
+  marpaWrapperAsfSymch_t      *symchp;
+  size_t                       sizeSymchl;      /* Allocated size */
+  size_t                       nSymchl;         /* Used size      */
+  marpaWrapperAsfFactoring_t  *factoringp;
+  size_t                       sizeFactoringl;
+  size_t                       nFactoringl;
+  int                         *factorip;
+  size_t                       sizeFactorl;
+  size_t                       nFactorl;
 
   /* Memoization of choices */
   int                         nextIntseti;
 
-  /* Traverser callback */
-  traverserCallback_t         traverserCallbackp;
-  void                       *userDatavp;
+  /* Traversers */
+  marpaWrapperAsfMemo_t       memo;
+  short                       preparedb;        /* All glades are set up */
+
+  /* Eviction of glade contents (option maxBytesl) */
+  int                         traversali;       /* Number of traversals */
+  size_t                      nEvictionl;
+  size_t                      nRebuildl;
+  size_t                      keptBytesl;       /* Glade contents after the last eviction */
+
+  /* K-best extraction */
+  marpaWrapperAsfKbest_t      kbest;
+
+  /* Dead factorings */
+  marpaWrapperAsfPrune_t      prune;
+
+  /* Ambiguity statistics */
+  marpaWrapperAsfCount_t     *countp;
+  size_t                      sizeCountl;       /* Allocated size */
+  size_t                      nCountl;          /* Initialized size, 0 until marpaWrapperAsf_statsb() */
 
   /* For optimizations, internal generic stacks of methods */
   /* that do not recurse are setted once */
@@ -97,26 +289,48 @@ struct marpaWrapperAsf {
   int                        *causeNidsp;
   int                         causeNidsi;
 
-  /* For optimization of _marpaWrapperAsf_glade_obtainp() */
-  genericStack_t             *gladeObtainTmpStackp;
+  /* Scratch area of the radix sorts of intsets and of glade source data */
+  void                       *sortScratchp;
+  size_t                      sortScratchl;
+
+  /* For optimization of _marpaWrapperAsf_glade_obtainp(), that does not recurse */
+  genericStack_t              *gladeObtainTmpStackp;
+  marpaWrapperAsfSourceData_t *sourceDatap;
+  size_t                       sizeSourceDatal;
+  int                         *nidWithCurrentSortIxip;
+  size_t                       sizeNidWithCurrentSortIxil;
+  int                         *symchIdip;
+  size_t                       sizeSymchIdil;
+  marpaWrapperAsfChoicePoint_t choicepoint;
+
+  /* For optimization of _marpaWrapperAsf_glade_id_factorsb() */
+  genericStack_t             *andNodeIdStackp;
+  genericStack_t             *causeNidsStackp;
 
   /* For optimization of _marpaWrapperAsf_and_nodes_to_cause_nidsp() */
   genericHash_t              *causesHashp;
 };
 
-typedef struct marpaWrapperAsfChoicePoint {
-  genericStack_t         *factoringStackp;
-  genericSparseArray_t   *orNodeInUseSparseArrayp;
-} marpaWrapperAsfChoicePoint_t;
-
+/* A traverser never writes to the ASF once it is prepared, except for the memo */
 struct marpaWrapperAsfTraverser {
   marpaWrapperAsf_t      *marpaWrapperAsfp;
-  genericSparseArray_t   *valueSparseArrayp;
-  marpaWrapperAsfGlade_t *gladep;
+  traverserCallback_t     traverserCallbackp;
+  void                   *userDatavp;
+  short                   memob;
+  genericSparseArray_t   *valueSparseArrayp; /* NULL when memob is set */
+  int                     gladeIdi;       /* Not a pointer: glades move when new ones are registered */
   int                     symchIxi;
   int                     factoringIxi;
 };
 
+/* Valuation using the ASF keeps the path of the previous parse tree: one */
+/* record per traverser call, in call order.                             */
+typedef struct marpaWrapperAsfValueNode {
+  int   consumedNextChoicesi;  /* -1 when not set */
+  short haveNextChoiceb;       /* -1 when not set */
+  int   endIndicei;            /* Indice following the last node of the subtree */
+} marpaWrapperAsfValueNode_t;
+
 /* Internal structure used for valuation using the ASF */
 struct marpaWrapperAsfValue {
   /* Internal ASF instance */
@@ -144,8 +358,14 @@ struct marpaWrapperAsfValue {
   short                                 firstb;
   short                                 wantNextChoiceb;
   short                                 gotNextChoiceb;
-  genericStack_t                       *consumedNextChoicesPerLevelStackp;
-  genericStack_t                       *haveNextChoicePerLevelStackp;
+  marpaWrapperAsfValueNode_t           *nodep;
+  size_t                                sizeNodel;
+  int                                   nNodei;
+  /* Indice of the deepest node with another choice in the previous tree, -1 if none */
+  int                                   nextChoiceIndicei;
+  /* Nodes that end before nextChoiceIndicei are the same as in the previous tree */
+  short                                 skipOkb;
+  short                                 rejectb;
 };
 
 #endif /* MARPAWRAPPER_INTERNAL_ASF_H */
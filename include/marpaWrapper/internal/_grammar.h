@@ -5,6 +5,32 @@
 #include "marpaWrapper/grammar.h"
 #include "marpa.h"
 
+/* ------------------------------------------------------------------------------ */
+/* Serialized grammar image: a sequence of 32-bit little-endian words, no pointer */
+/* ------------------------------------------------------------------------------ */
+/* Header                                                                         */
+#define MARPAWRAPPERGRAMMAR_IMAGE_MAGIC          0x5347574d /* "MWGS" */
+#define MARPAWRAPPERGRAMMAR_IMAGE_VERSION        2 /* 2: the checksum covers the header */
+#define MARPAWRAPPERGRAMMAR_IMAGE_MAGIC_IX       0
+#define MARPAWRAPPERGRAMMAR_IMAGE_VERSION_IX     1
+#define MARPAWRAPPERGRAMMAR_IMAGE_MAJOR_IX       2  /* libmarpa major version */
+#define MARPAWRAPPERGRAMMAR_IMAGE_MINOR_IX       3  /* libmarpa minor version */
+#define MARPAWRAPPERGRAMMAR_IMAGE_MICRO_IX       4  /* libmarpa micro version */
+#define MARPAWRAPPERGRAMMAR_IMAGE_FLAGS_IX       5
+#define MARPAWRAPPERGRAMMAR_IMAGE_START_IX       6  /* Start symbol, -1 if none */
+#define MARPAWRAPPERGRAMMAR_IMAGE_NSYMBOL_IX     7
+#define MARPAWRAPPERGRAMMAR_IMAGE_NRULE_IX       8
+#define MARPAWRAPPERGRAMMAR_IMAGE_NRHS_IX        9  /* Total number of RHS over all rules */
+#define MARPAWRAPPERGRAMMAR_IMAGE_CHECKSUM_IX    10 /* FNV-1a of everything but this word */
+#define MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS   11
+/* Flags */
+#define MARPAWRAPPERGRAMMAR_IMAGE_FLAG_PRECOMPUTED 0x01
+/* Then nSymbol records of: terminalb, startb, eventSeti */
+#define MARPAWRAPPERGRAMMAR_IMAGE_SYMBOL_WORDS   3
+/* Then nRule records of: lhs, ranki, nullRanksHighb, sequenceb, separatorSymboli, properb, minimumi, rhs length */
+#define MARPAWRAPPERGRAMMAR_IMAGE_RULE_WORDS     8
+/* Then the nRhs RHS symbols, rule after rule */
+
 typedef struct marpaWrapperGrammarSymbol {
   Marpa_Symbol_ID                   marpaSymbolIdi;
   marpaWrapperGrammarSymbolOption_t marpaWrapperGrammarSymbolOption;
@@ -33,10 +59,22 @@ struct marpaWrapperGrammar {
   size_t                        nRulel;              /* Used size      */
   marpaWrapperGrammarRule_t    *ruleArrayp;
 
-  /* Last events list */
+  /* Last events list of the grammar itself. Parse events are in the recognizer */
   size_t                        sizeEventl;           /* Allocated size */
   size_t                        nEventl;              /* Used size      */
   marpaWrapperGrammarEvent_t   *eventArrayp;
 };
 
+/* Grammar entry points select the grammar allocator, and make libmarpa record events and errors */
+/* in the grammar itself, not in a recognizer that the current thread last worked on.           */
+#define MARPAWRAPPERGRAMMAR_CONTEXT_SET(allocatorp) do { \
+    MARPAWRAPPER_ALLOCATOR_SET(allocatorp);               \
+    marpa_r_context_set(NULL);                            \
+  } while (0)
+
+/* Drains libmarpa events into a caller-owned list: the grammar itself is not modified */
+static short _marpaWrapperGrammar_fetchEventsb(marpaWrapperGrammar_t *marpaWrapperGrammarp, genericLogger_t *genericLoggerp, short exhaustionEventb, marpaWrapperGrammarEvent_t **eventArraypp, size_t *sizeEventlp, size_t *nEventlp, short sortb);
+/* Puts an event list in delivery order: completions, nullings, then predictions */
+static void  _marpaWrapperGrammar_sortEventsv(marpaWrapperGrammarEvent_t *eventArrayp, size_t nEventl);
+
 #endif /* MARPAWRAPPER_INTERNAL_GRAMMAR_H */
@@ -32,8 +32,32 @@ struct marpaWrapperRecognizer {
   size_t                               nProgressl;    /* Used size      */
   marpaWrapperRecognizerProgress_t    *progressp;
 
+  /* Last events list - per recognizer, so that parses on one grammar do not mix their events */
+  size_t                               sizeEventl;    /* Allocated size */
+  size_t                               nEventl;       /* Used size      */
+  marpaWrapperGrammarEvent_t          *eventArrayp;
+  short                                sortEventb;    /* Event list is sorted only when asked */
+
+  /* Earleme completions, and how many of them had no event to fetch */
+  size_t                               nCompletel;
+  size_t                               nEventlessCompletel;
+
+  /* Last libmarpa error - a copy of the one libmarpa records for this recognizer */
+  int                                  marpaErrorCodei;
+
   marpaWrapperRecognizerTreeMode_t     treeModeb;     /* Indicates that we are already in tree mode */
   short                                haveVariableLengthTokenb; /* Used in forest mode */
+  short                                warmb;         /* Kept by a pool, until marpaWrapperRecognizerPool_getp() gives it out again */
 };
 
+/* Recognizer entry points, and the values and forests derived from it, select the allocator */
+/* of the recognizer, and make libmarpa record events and errors in this recognizer: this is  */
+/* what allows several recognizers to share one precomputed grammar on different threads.    */
+/* User callbacks may call other objects that select their own context: it is restored when  */
+/* they return.                                                                               */
+#define MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp) do {                        \
+    MARPAWRAPPER_ALLOCATOR_SET((marpaWrapperRecognizerp)->marpaWrapperRecognizerOption.allocatorp); \
+    marpa_r_context_set((marpaWrapperRecognizerp)->marpaRecognizerp);                             \
+  } while (0)
+
 #endif /* MARPAWRAPPER_INTERNAL_RECOGNIZER_H */
@@ -0,0 +1,21 @@
+#ifndef MARPAWRAPPER_INTERNAL_RECOGNIZERPOOL_H
+#define MARPAWRAPPER_INTERNAL_RECOGNIZERPOOL_H
+
+#include <stddef.h>
+#include "marpaWrapper/recognizerPool.h"
+
+struct marpaWrapperRecognizerPool {
+  marpaWrapperGrammar_t           *marpaWrapperGrammarp;
+  marpaWrapperRecognizerOption_t   marpaWrapperRecognizerOption; /* genericLoggerp is a clone, if any */
+  size_t                           maxWarml;
+
+  /* Warm recognizers, used as a stack: the last released is the first given */
+  size_t                           sizeWarml;     /* Allocated size */
+  size_t                           nWarml;        /* Used size      */
+  marpaWrapperRecognizer_t       **warmpp;
+
+  size_t                           hitl;
+  size_t                           missl;
+};
+
+#endif /* MARPAWRAPPER_INTERNAL_RECOGNIZERPOOL_H */
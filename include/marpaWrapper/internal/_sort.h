@@ -0,0 +1,189 @@
+#ifndef MARPAWRAPPER_INTERNAL_SORT_H
+#define MARPAWRAPPER_INTERNAL_SORT_H
+
+#include <stddef.h>
+#include <string.h>
+#include <limits.h>
+
+/* Sorting of small arrays of int without qsort() and its comparator calls:     */
+/* - up to 16 elements: branch-free sorting networks (3, 4, 8 and 16 inputs,    */
+/*   the last two padded with INT_MAX)                                         */
+/* - up to MARPAWRAPPERSORT_RADIX_MIN elements: insertion sort                  */
+/* - above: LSD radix sort, byte per byte, using a scratch area of nl ints      */
+#ifndef MARPAWRAPPERSORT_RADIX_MIN
+#define MARPAWRAPPERSORT_RADIX_MIN 64
+#endif
+
+#define MARPAWRAPPERSORT_CMPXCHG(ip, i, j) do {                   \
+    int _ai = (ip)[i];                                            \
+    int _aj = (ip)[j];                                            \
+    (ip)[i] = (_ai < _aj) ? _ai : _aj;                            \
+    (ip)[j] = (_ai < _aj) ? _aj : _ai;                            \
+  } while (0)
+
+/* Radix keys are unsigned with the sign bit flipped, so that negative ints come first */
+#define MARPAWRAPPERSORT_RADIX_KEY(i) (((unsigned int) (i)) ^ (((unsigned int) INT_MAX) + 1U))
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_int3v(int *ip)
+/*****************************************************************************/
+{
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 2);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 2);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 1);
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_int4v(int *ip)
+/*****************************************************************************/
+{
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 1); MARPAWRAPPERSORT_CMPXCHG(ip, 2, 3);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 2); MARPAWRAPPERSORT_CMPXCHG(ip, 1, 3);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 2);
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_int8v(int *ip)
+/*****************************************************************************/
+/* 19 comparators, depth 6                                                   */
+/*****************************************************************************/
+{
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 2); MARPAWRAPPERSORT_CMPXCHG(ip, 1, 3); MARPAWRAPPERSORT_CMPXCHG(ip, 4, 6); MARPAWRAPPERSORT_CMPXCHG(ip, 5, 7);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 4); MARPAWRAPPERSORT_CMPXCHG(ip, 1, 5); MARPAWRAPPERSORT_CMPXCHG(ip, 2, 6); MARPAWRAPPERSORT_CMPXCHG(ip, 3, 7);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 1); MARPAWRAPPERSORT_CMPXCHG(ip, 2, 3); MARPAWRAPPERSORT_CMPXCHG(ip, 4, 5); MARPAWRAPPERSORT_CMPXCHG(ip, 6, 7);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 2, 4); MARPAWRAPPERSORT_CMPXCHG(ip, 3, 5);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 4); MARPAWRAPPERSORT_CMPXCHG(ip, 3, 6);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 2); MARPAWRAPPERSORT_CMPXCHG(ip, 3, 4); MARPAWRAPPERSORT_CMPXCHG(ip, 5, 6);
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_int16v(int *ip)
+/*****************************************************************************/
+/* 60 comparators, depth 10                                                  */
+/*****************************************************************************/
+{
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 13); MARPAWRAPPERSORT_CMPXCHG(ip, 1, 12); MARPAWRAPPERSORT_CMPXCHG(ip, 2, 15); MARPAWRAPPERSORT_CMPXCHG(ip, 3, 14);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 4, 8);  MARPAWRAPPERSORT_CMPXCHG(ip, 5, 6);  MARPAWRAPPERSORT_CMPXCHG(ip, 7, 11); MARPAWRAPPERSORT_CMPXCHG(ip, 9, 10);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 5);  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 7);  MARPAWRAPPERSORT_CMPXCHG(ip, 2, 9);  MARPAWRAPPERSORT_CMPXCHG(ip, 3, 4);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 6, 13); MARPAWRAPPERSORT_CMPXCHG(ip, 8, 14); MARPAWRAPPERSORT_CMPXCHG(ip, 10, 15); MARPAWRAPPERSORT_CMPXCHG(ip, 11, 12);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 1);  MARPAWRAPPERSORT_CMPXCHG(ip, 2, 3);  MARPAWRAPPERSORT_CMPXCHG(ip, 4, 5);  MARPAWRAPPERSORT_CMPXCHG(ip, 6, 8);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 7, 9);  MARPAWRAPPERSORT_CMPXCHG(ip, 10, 11); MARPAWRAPPERSORT_CMPXCHG(ip, 12, 13); MARPAWRAPPERSORT_CMPXCHG(ip, 14, 15);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 0, 2);  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 3);  MARPAWRAPPERSORT_CMPXCHG(ip, 4, 10); MARPAWRAPPERSORT_CMPXCHG(ip, 5, 11);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 6, 7);  MARPAWRAPPERSORT_CMPXCHG(ip, 8, 9);  MARPAWRAPPERSORT_CMPXCHG(ip, 12, 14); MARPAWRAPPERSORT_CMPXCHG(ip, 13, 15);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 2);  MARPAWRAPPERSORT_CMPXCHG(ip, 3, 12); MARPAWRAPPERSORT_CMPXCHG(ip, 4, 6);  MARPAWRAPPERSORT_CMPXCHG(ip, 5, 7);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 8, 10); MARPAWRAPPERSORT_CMPXCHG(ip, 9, 11); MARPAWRAPPERSORT_CMPXCHG(ip, 13, 14);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 1, 4);  MARPAWRAPPERSORT_CMPXCHG(ip, 2, 6);  MARPAWRAPPERSORT_CMPXCHG(ip, 5, 8);  MARPAWRAPPERSORT_CMPXCHG(ip, 7, 10);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 9, 13); MARPAWRAPPERSORT_CMPXCHG(ip, 11, 14);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 2, 4);  MARPAWRAPPERSORT_CMPXCHG(ip, 3, 6);  MARPAWRAPPERSORT_CMPXCHG(ip, 9, 12); MARPAWRAPPERSORT_CMPXCHG(ip, 11, 13);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 3, 5);  MARPAWRAPPERSORT_CMPXCHG(ip, 6, 8);  MARPAWRAPPERSORT_CMPXCHG(ip, 7, 9);  MARPAWRAPPERSORT_CMPXCHG(ip, 10, 12);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 3, 4);  MARPAWRAPPERSORT_CMPXCHG(ip, 5, 6);  MARPAWRAPPERSORT_CMPXCHG(ip, 7, 8);  MARPAWRAPPERSORT_CMPXCHG(ip, 9, 10);
+  MARPAWRAPPERSORT_CMPXCHG(ip, 11, 12);
+
+  MARPAWRAPPERSORT_CMPXCHG(ip, 6, 7);  MARPAWRAPPERSORT_CMPXCHG(ip, 8, 9);
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_intInsertionv(int *ip, size_t nl)
+/*****************************************************************************/
+{
+  size_t i;
+  size_t j;
+  int    vi;
+
+  for (i = 1; i < nl; i++) {
+    vi = ip[i];
+    for (j = i; (j > 0) && (ip[j - 1] > vi); j--) {
+      ip[j] = ip[j - 1];
+    }
+    ip[j] = vi;
+  }
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_intRadixv(int *ip, int *scratchip, size_t nl)
+/*****************************************************************************/
+/* A pass where all keys have the same byte is skipped.                      */
+/*****************************************************************************/
+{
+  size_t        countl[256];
+  int          *fromip = ip;
+  int          *toip   = scratchip;
+  int          *tmpip;
+  unsigned int  shifti;
+  size_t        i;
+  size_t        suml;
+  size_t        cl;
+
+  for (shifti = 0; shifti < (sizeof(int) * CHAR_BIT); shifti += 8) {
+    memset(countl, 0, sizeof(countl));
+    for (i = 0; i < nl; i++) {
+      countl[(MARPAWRAPPERSORT_RADIX_KEY(fromip[i]) >> shifti) & 0xFF]++;
+    }
+    if (countl[(MARPAWRAPPERSORT_RADIX_KEY(fromip[0]) >> shifti) & 0xFF] == nl) {
+      continue;
+    }
+    for (i = 0, suml = 0; i < 256; i++) {
+      cl        = countl[i];
+      countl[i] = suml;
+      suml     += cl;
+    }
+    for (i = 0; i < nl; i++) {
+      toip[countl[(MARPAWRAPPERSORT_RADIX_KEY(fromip[i]) >> shifti) & 0xFF]++] = fromip[i];
+    }
+    tmpip  = fromip;
+    fromip = toip;
+    toip   = tmpip;
+  }
+
+  if (fromip != ip) {
+    memcpy(ip, fromip, nl * sizeof(int));
+  }
+}
+
+/*****************************************************************************/
+static inline void _marpaWrapperSort_intv(int *ip, int *scratchip, size_t nl)
+/*****************************************************************************/
+/* scratchip is used only when nl > MARPAWRAPPERSORT_RADIX_MIN               */
+/*****************************************************************************/
+{
+  int     padi[16];
+  size_t  i;
+
+  if (nl <= 2) {
+    if (nl == 2) {
+      MARPAWRAPPERSORT_CMPXCHG(ip, 0, 1);
+    }
+  } else if (nl == 3) {
+    _marpaWrapperSort_int3v(ip);
+  } else if (nl == 4) {
+    _marpaWrapperSort_int4v(ip);
+  } else if (nl <= 16) {
+    memcpy(padi, ip, nl * sizeof(int));
+    if (nl <= 8) {
+      for (i = nl; i < 8; i++) {
+        padi[i] = INT_MAX;
+      }
+      _marpaWrapperSort_int8v(padi);
+    } else {
+      for (i = nl; i < 16; i++) {
+        padi[i] = INT_MAX;
+      }
+      _marpaWrapperSort_int16v(padi);
+    }
+    memcpy(ip, padi, nl * sizeof(int));
+  } else if (nl <= MARPAWRAPPERSORT_RADIX_MIN) {
+    _marpaWrapperSort_intInsertionv(ip, nl);
+  } else {
+    _marpaWrapperSort_intRadixv(ip, scratchip, nl);
+  }
+}
+
+#endif /* MARPAWRAPPER_INTERNAL_SORT_H */
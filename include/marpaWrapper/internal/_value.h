@@ -5,6 +5,34 @@
 #include "marpaWrapper/value.h"
 #include "marpa.h"
 
+/* Tree image of marpaWrapperValue_serializeb(): a header of little-endian words, */
+/* then the steps in postfix order, each one being LEB128 varints:                 */
+/* - (id << 2) | type, type being a marpaWrapperValueStepType_t                    */
+/* - rule:  the number of children                                                 */
+/* - token: the token value, zigzag-encoded                                        */
+/* Stack indices are not stored: they are the depth of the evaluation stack.      */
+#define MARPAWRAPPERVALUE_IMAGE_MAGIC          0x5356574d /* "MWVS" */
+#define MARPAWRAPPERVALUE_IMAGE_VERSION        1
+#define MARPAWRAPPERVALUE_IMAGE_MAGIC_IX       0
+#define MARPAWRAPPERVALUE_IMAGE_VERSION_IX     1
+#define MARPAWRAPPERVALUE_IMAGE_NSTEP_IX       2
+#define MARPAWRAPPERVALUE_IMAGE_CHECKSUM_IX    3  /* FNV-1a of everything after the header */
+#define MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS   4
+/* Largest encoding of a step: two 32-bit varints */
+#define MARPAWRAPPERVALUE_IMAGE_STEP_MAXBYTES  10
+
+/* Block of the valuator cache of the reuseValuatorb option, sized so that the */
+/* user part keeps malloc() alignment                                         */
+typedef union marpaWrapperValueBlock {
+  struct {
+    size_t                         sizel;  /* Usable bytes */
+    union marpaWrapperValueBlock  *nextp;  /* Next free block */
+  } block;
+  void                            *alignp;
+  double                           alignd;
+  long double                      alignld;
+} marpaWrapperValueBlock_t;
+
 struct marpaWrapperValue {
   marpaWrapperRecognizer_t     *marpaWrapperRecognizerp;
   marpaWrapperValueOption_t     marpaWrapperValueOption;
@@ -12,6 +40,18 @@ struct marpaWrapperValue {
   Marpa_Order                   marpaOrderp;
   Marpa_Tree                    marpaTreep;
   Marpa_Value                   marpaValuep;
+  /* Steps buffer of marpaWrapperValue_stepsb() */
+  marpaWrapperValueStep_t      *stepp;
+  size_t                        sizeStepl;
+  /* Image buffer of marpaWrapperValue_serializeb(), copied out at the end */
+  unsigned char                *imagep;
+  size_t                        sizeImagel;
+  /* Valuator cache of the reuseValuatorb option: it is the allocator of marpa_v_new(), */
+  /* so that marpa_v_unref() gives the blocks back to it instead of releasing them.     */
+  marpaWrapperAllocator_t       cacheAllocator;  /* userDatavp is the value instance */
+  marpaWrapperValueBlock_t     *freeBlockp;
+  size_t                        allocationl;
+  size_t                        reusel;
 };
 
 #endif /* MARPAWRAPPER_INTERNAL_VALUE_H */
@@ -11,10 +11,12 @@ typedef struct marpaWrapperRecognizer marpaWrapperRecognizer_t;
 /* --------------- */
 /* General options */
 /* --------------- */
+/* allocatorp was appended in version 2.0.0: the size of this structure changed, callers must be recompiled */
 typedef struct marpaWrapperRecognizerOption {
-  genericLogger_t *genericLoggerp;             /* Default: NULL. */
-  short            disableThresholdb;          /* Default: 0.    */
-  short            exhaustionEventb;           /* Default: 0     */
+  genericLogger_t         *genericLoggerp;     /* Default: NULL. */
+  short                    disableThresholdb;  /* Default: 0.    */
+  short                    exhaustionEventb;   /* Default: 0     */
+  marpaWrapperAllocator_t *allocatorp;         /* Default: NULL. Allocator of the grammar. Values and ASFs use the one of the recognizer */
 } marpaWrapperRecognizerOption_t;
 
 typedef struct marpaWrapperRecognizerProgress {
@@ -29,6 +31,18 @@ typedef struct marpaWrapperRecognizerContext {
   void *valuep;
 } marpaWrapperRecognizerContext_t;
 
+/* Token for marpaWrapperRecognizer_readManyb() */
+typedef struct marpaWrapperRecognizerToken {
+  int symboli;
+  int valuei;
+  int lengthi;
+  int advancei;  /* Number of earleme completions after this token: 0 for an alternative at the same earleme, usually 1 */
+} marpaWrapperRecognizerToken_t;
+
+/* Called by marpaWrapperRecognizer_readManyb() on a rejected token (only then rejected tokens are not an error), */
+/* or when events are generated after token No tokenl. Must return 1 to continue, 0 to stop the batch.          */
+typedef short (*marpaWrapperRecognizerReadManyCallback_t)(void *userDatavp, size_t tokenl, short rejectedb, size_t eventl, marpaWrapperGrammarEvent_t *eventp);
+
 typedef char *(*marpaWrapperRecognizerSymbolDescriptionCallback_t)(void *userDatavp, int symboli);
 typedef void  (*marpaWrapperRecognizerContextFreeCallback_t)(void *userDatavp, marpaWrapperRecognizerContext_t *contextp);
 
@@ -36,10 +50,18 @@ typedef void  (*marpaWrapperRecognizerContextFreeCallback_t)(void *userDatavp, m
 extern "C" {
 #endif
   marpaWrapper_EXPORT marpaWrapperRecognizer_t    *marpaWrapperRecognizer_newp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp);
+  /* Rewinds to the start of input for a new document with the same grammar. Buffers, options and logger */
+  /* are kept. Events switched with marpaWrapperRecognizer_event_onoffb() are back to the grammar defaults. */
+  /* Fails if a value or an ASF on the recognizer is not freed.                                           */
+  marpaWrapper_EXPORT short                        marpaWrapperRecognizer_resetb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, int valuei, int lengthi);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_completeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_latestb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *earleySetIdip);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_readb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, int valuei, int lengthi);
+  /* Reads tokenl tokens in one call. *readlp is set to the number of tokens consumed, all their completions done: when */
+  /* the callback stops the batch on the events of a token, the remaining completions of that token are still done,    */
+  /* without callback, and the token is counted; a rejected token that stops the batch is not counted.                 */
+  marpaWrapper_EXPORT short                        marpaWrapperRecognizer_readManyb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperRecognizerToken_t *tokenp, size_t tokenl, size_t *readlp, marpaWrapperRecognizerReadManyCallback_t readManyCallbackp, void *userDatavp);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_event_onoffb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, marpaWrapperGrammarEventType_t eventSeti, int onoffb);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_expectedb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t *nSymbollp, int **symbolArraypp);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_isExpectedb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, short *isExpectedbp);
@@ -52,6 +74,14 @@ extern "C" {
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_currentEarlemeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *ip);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_earlemeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int i, int *ip);
   marpaWrapper_EXPORT short                        marpaWrapperRecognizer_furthestEarlemeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *ip);
+  /* Events and last libmarpa error of the latest operation. They are kept in the recognizer, libmarpa    */
+  /* included, so that recognizers on one precomputed grammar never see each other's events and errors:  */
+  /* they can run concurrently, one thread per recognizer, as long as the grammar is not modified.       */
+  marpaWrapper_EXPORT short                        marpaWrapperRecognizer_eventb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t *eventlp, marpaWrapperGrammarEvent_t **eventpp);
+  marpaWrapper_EXPORT short                        marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *marpaErrorCodeip);
+  /* Number of earleme completions so far, and how many of them took the fast path: libmarpa reported */
+  /* no event, so there was nothing to fetch. The event list is sorted only when it is asked for.     */
+  marpaWrapper_EXPORT short                        marpaWrapperRecognizer_completeStatsb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t *completelp, size_t *eventlessCompletelp);
   marpaWrapper_EXPORT void                         marpaWrapperRecognizer_freev(marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
 #ifdef __cplusplus
 }
@@ -0,0 +1,34 @@
+#ifndef MARPAWRAPPER_RECOGNIZERPOOL_H
+#define MARPAWRAPPER_RECOGNIZERPOOL_H
+
+#include <marpaWrapper/recognizer.h>
+
+/***********************/
+/* Opaque object types */
+/***********************/
+typedef struct marpaWrapperRecognizerPool marpaWrapperRecognizerPool_t;
+
+/* ----------------------------------------------------------------------------------------------- */
+/* A pool of recognizers on one grammar, all created with the same options.                       */
+/* marpaWrapperRecognizerPool_getp() returns a recognizer at the start of input, like              */
+/* marpaWrapperRecognizer_newp(): a warm one if any (hit), a new one otherwise (miss).             */
+/* marpaWrapperRecognizerPool_releaseb() resets it with marpaWrapperRecognizer_resetb() and keeps  */
+/* it warm, unless there are already maxWarml of them: then it is freed.                           */
+/* A released recognizer belongs to the pool, unless the release failed. Recognizers that are      */
+/* not released are not known by the pool and must be freed with marpaWrapperRecognizer_freev().   */
+/* Releasing a warm recognizer again fails with errno EINVAL.                                      */
+/* The grammar must outlive the pool. A pool is not thread-safe.                                   */
+/* ----------------------------------------------------------------------------------------------- */
+#ifdef __cplusplus
+extern "C" {
+#endif
+  marpaWrapper_EXPORT marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPool_newp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp, size_t maxWarml);
+  marpaWrapper_EXPORT marpaWrapperRecognizer_t     *marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp);
+  marpaWrapper_EXPORT short                         marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp, marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
+  marpaWrapper_EXPORT short                         marpaWrapperRecognizerPool_statsb(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp, size_t *hitlp, size_t *misslp, size_t *warmlp);
+  marpaWrapper_EXPORT void                          marpaWrapperRecognizerPool_freev(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MARPAWRAPPER_RECOGNIZERPOOL_H */
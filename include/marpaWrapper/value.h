@@ -14,6 +14,31 @@ typedef short (*marpaWrapperValueRuleCallback_t)(void *userDatavp, int rulei, in
 typedef short (*marpaWrapperValueSymbolCallback_t)(void *userDatavp, int symboli, int argi, int resulti);
 typedef short (*marpaWrapperValueNullingCallback_t)(void *userDatavp, int symboli, int resulti);
 
+/* Steps */
+/* ----- */
+/* A step record of marpaWrapperValue_stepsb() carries what the callbacks and   */
+/* marpaWrapperValue_value_startb()/marpaWrapperValue_value_lengthb() would see: */
+/* - rule:    idi is the rule, arg0i..argni -> resulti                          */
+/* - token:   idi is the symbol, tokenValuei is the argi of the symbol callback */
+/* - nulling: idi is the symbol, tokenValuei is -1                              */
+/* For token and nulling steps arg0i and argni are both resulti.                */
+typedef enum marpaWrapperValueStepType {
+  MARPAWRAPPERVALUE_STEP_RULE = 0,
+  MARPAWRAPPERVALUE_STEP_TOKEN,
+  MARPAWRAPPERVALUE_STEP_NULLING
+} marpaWrapperValueStepType_t;
+
+typedef struct marpaWrapperValueStep {
+  int typei;                    /* A marpaWrapperValueStepType_t */
+  int idi;
+  int arg0i;
+  int argni;
+  int resulti;
+  int tokenValuei;
+  int starti;                   /* Start Earley Set */
+  int lengthi;                  /* Number of Earley Sets, 0 for a nulling step */
+} marpaWrapperValueStep_t;
+
 /* --------------- */
 /* General options */
 /* --------------- */
@@ -24,6 +49,8 @@ typedef struct marpaWrapperValueOption {
   short                              ambiguousb;                 /* Default: 0 */
   short                              nullb;                      /* Default: 0 */
   int                                maxParsesi;                 /* Default: 0 */
+  short                              reuseValuatorb;             /* Default: 0. The memory of the Marpa valuator */
+                                                                 /* of a tree is kept for the next tree.        */
 } marpaWrapperValueOption_t;
 
 #ifdef __cplusplus
@@ -35,6 +62,34 @@ extern "C" {
 								    marpaWrapperValueRuleCallback_t    ruleCallbackp,
 								    marpaWrapperValueSymbolCallback_t  symbolCallbackp,
 								    marpaWrapperValueNullingCallback_t nullingCallbackp);
+  /* Same as marpaWrapperValue_valueb(), the steps being stored instead of calling */
+  /* back: in stepp if they fit in sizeStepl records, else in a buffer owned by the */
+  /* value instance, reused by next calls and freed by marpaWrapperValue_freev().   */
+  /* *stepspp says where they are, *nSteplp how many there are.                     */
+  marpaWrapper_EXPORT short                marpaWrapperValue_stepsb(marpaWrapperValue_t      *marpaWrapperValuep,
+								    marpaWrapperValueStep_t  *stepp,
+								    size_t                    sizeStepl,
+								    marpaWrapperValueStep_t **stepspp,
+								    size_t                   *nSteplp);
+  /* Same as marpaWrapperValue_valueb(), the tree being encoded in a compact image:  */
+  /* rule and symbol ids, number of children and token values, as varints in       */
+  /* postfix order. The buffer comes from the C library and must be freed by the   */
+  /* caller. It does not depend on the value instance, the recognizer or the       */
+  /* grammar, that can be freed right after.                                       */
+  marpaWrapper_EXPORT short                marpaWrapperValue_serializeb(marpaWrapperValue_t *marpaWrapperValuep, char **bufferpp, size_t *bufferlp);
+  /* Valuation of an image with the callbacks of marpaWrapperValue_valueb(), called */
+  /* with the same arguments. marpaWrapperValue_value_startb() and                 */
+  /* marpaWrapperValue_value_lengthb() are not available: there is no Earley set.   */
+  marpaWrapper_EXPORT short                marpaWrapperValue_image_valueb(genericLogger_t                   *genericLoggerp,
+									  char                              *bufferp,
+									  size_t                             bufferl,
+									  void                              *userDatavp,
+									  marpaWrapperValueRuleCallback_t    ruleCallbackp,
+									  marpaWrapperValueSymbolCallback_t  symbolCallbackp,
+									  marpaWrapperValueNullingCallback_t nullingCallbackp);
+  /* reuseValuatorb option: number of blocks the valuators got from the recognizer allocator, */
+  /* and of blocks they got back from a previous tree.                                       */
+  marpaWrapper_EXPORT short                marpaWrapperValue_valuatorStatsb(marpaWrapperValue_t *marpaWrapperValuep, size_t *allocationlp, size_t *reuselp);
   marpaWrapper_EXPORT short                marpaWrapperValue_value_startb(marpaWrapperValue_t *marpaWrapperValuep, int *startip);
   marpaWrapper_EXPORT short                marpaWrapperValue_value_lengthb(marpaWrapperValue_t *marpaWrapperValuep, int *lengthip);
   marpaWrapper_EXPORT void                 marpaWrapperValue_freev(marpaWrapperValue_t *marpaWrapperValuep);
@@ -69,10 +69,26 @@ MARPA_LIB_MAJOR_VERSION!=MARPA_MAJOR_VERSION \
 #define MINIMUM_RANK (INT_MIN/4+(INT_MIN%4> 0?1:0) ) 
 #define Default_Rank_of_G(g) ((g) ->t_default_rank) 
 #define G_is_Precomputed(g) ((g) ->t_is_precomputed) 
-#define G_EVENT_COUNT(g) MARPA_DSTACK_LENGTH((g) ->t_events) 
+#define G_EVENT_COUNT(g) MARPA_DSTACK_LENGTH(G_CONTEXT(g)->t_events) 
 #define INITIAL_G_EVENTS_CAPACITY (1024/sizeof(int) ) 
-#define G_EVENTS_CLEAR(g) MARPA_DSTACK_CLEAR((g) ->t_events) 
-#define G_EVENT_PUSH(g) MARPA_DSTACK_PUSH((g) ->t_events,GEV_Object) 
+#define G_EVENTS_CLEAR(g) MARPA_DSTACK_CLEAR(G_CONTEXT(g)->t_events) 
+#define G_EVENT_PUSH(g) MARPA_DSTACK_PUSH(G_CONTEXT(g)->t_events,GEV_Object) 
+/* c-marpaWrapper: events and errors go to the context of the current recognizer of this thread, */
+/* if it is one of g, else to the context of g itself, c.f. marpa_r_context_set().               */
+#define G_CONTEXT(g) ((marpa_r_context!=NULL&&G_of_R(marpa_r_context)==(g))?&marpa_r_context->t_context:&(g)->t_context) 
+#if defined(_MSC_VER)
+#define MARPA_THREAD_LOCAL __declspec(thread)
+#define MARPA_ATOMIC_INCREMENT(p) _InterlockedIncrement((long volatile*)(p))
+#define MARPA_ATOMIC_DECREMENT(p) _InterlockedDecrement((long volatile*)(p))
+#elif defined(__GNUC__)||defined(__clang__)
+#define MARPA_THREAD_LOCAL __thread
+#define MARPA_ATOMIC_INCREMENT(p) __atomic_add_fetch((p),1,__ATOMIC_ACQ_REL)
+#define MARPA_ATOMIC_DECREMENT(p) __atomic_sub_fetch((p),1,__ATOMIC_ACQ_REL)
+#else
+#define MARPA_THREAD_LOCAL
+#define MARPA_ATOMIC_INCREMENT(p) (++*(p))
+#define MARPA_ATOMIC_DECREMENT(p) (--*(p))
+#endif
 #define I_AM_OK 0x69734f4b
 #define IS_G_OK(g) ((g) ->t_is_ok==I_AM_OK) 
 #define ID_of_XSY(xsy) ((xsy) ->t_symbol_id) 
@@ -841,6 +857,13 @@ MARPA_DSTACK_DECLARE(t_buffer);
 };
 typedef struct s_cil_arena CILAR_Object;
 
+/* c-marpaWrapper: what a grammar writes while a recognizer works on it */
+struct s_g_context{
+MARPA_DSTACK_DECLARE(t_events);
+const char*t_error_string;
+Marpa_Error_Code t_error;
+};
+
 /*:1185*/
 #line 16988 "marpa.w"
 
@@ -881,7 +904,7 @@ Bit_Vector t_lbv_xsyid_prediction_event_starts_active;
 /*:105*//*112:*/
 #line 1063 "marpa.w"
 
-MARPA_DSTACK_DECLARE(t_events);
+struct s_g_context t_context;
 /*:112*//*120:*/
 #line 1139 "marpa.w"
 
@@ -898,7 +921,6 @@ CILAR_Object t_cilar;
 /*:127*//*135:*/
 #line 1232 "marpa.w"
 
-const char*t_error_string;
 /*:135*//*456:*/
 #line 4955 "marpa.w"
 
@@ -937,7 +959,6 @@ Marpa_Rank t_default_rank;
 /*:92*//*136:*/
 #line 1234 "marpa.w"
 
-Marpa_Error_Code t_error;
 /*:136*//*161:*/
 #line 1404 "marpa.w"
 int t_force_valued;
@@ -1816,6 +1837,10 @@ struct marpa_r{
 #line 6191 "marpa.w"
 
 GRAMMAR t_grammar;
+/* c-marpaWrapper: events, errors and Leo event sets of this recognizer */
+struct s_g_context t_context;
+CILAR_Object t_cilar;
+int t_cilar_is_ready;
 /*:558*//*565:*/
 #line 6218 "marpa.w"
 
@@ -1955,6 +1980,9 @@ BITFIELD t_trace_source_type:3;
 
 };
 
+/* c-marpaWrapper: the recognizer the current thread works on, c.f. marpa_r_context_set() */
+static MARPA_THREAD_LOCAL RECCE marpa_r_context= NULL;
+
 /*:550*/
 #line 16999 "marpa.w"
 
@@ -2647,7 +2675,7 @@ g->t_lbv_xsyid_prediction_event_starts_active= NULL;
 /*:106*//*113:*/
 #line 1067 "marpa.w"
 
-MARPA_DSTACK_INIT(g->t_events,GEV_Object,INITIAL_G_EVENTS_CAPACITY);
+MARPA_DSTACK_INIT(g->t_context.t_events,GEV_Object,INITIAL_G_EVENTS_CAPACITY);
 /*:113*//*121:*/
 #line 1141 "marpa.w"
 
@@ -2664,8 +2692,8 @@ cilar_init(&(g)->t_cilar);
 /*:128*//*137:*/
 #line 1236 "marpa.w"
 
-g->t_error= MARPA_ERR_NONE;
-g->t_error_string= NULL;
+g->t_context.t_error= MARPA_ERR_NONE;
+g->t_context.t_error_string= NULL;
 /*:137*//*162:*/
 #line 1405 "marpa.w"
 
@@ -2699,8 +2727,7 @@ void
 grammar_unref(GRAMMAR g)
 {
 MARPA_ASSERT(g->t_ref_count> 0)
-g->t_ref_count--;
-if(g->t_ref_count<=0)
+if(MARPA_ATOMIC_DECREMENT(&g->t_ref_count)<=0)
 {
 grammar_free(g);
 }
@@ -2716,7 +2743,7 @@ PRIVATE GRAMMAR
 grammar_ref(GRAMMAR g)
 {
 MARPA_ASSERT(g->t_ref_count> 0)
-g->t_ref_count++;
+MARPA_ATOMIC_INCREMENT(&g->t_ref_count);
 return g;
 }
 Marpa_Grammar
@@ -2745,7 +2772,7 @@ MARPA_DSTACK_DESTROY(g->t_xrl_stack);
 
 /*:70*//*114:*/
 #line 1069 "marpa.w"
-MARPA_DSTACK_DESTROY(g->t_events);
+MARPA_DSTACK_DESTROY(g->t_context.t_events);
 
 /*:114*//*123:*/
 #line 1148 "marpa.w"
@@ -2830,7 +2857,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -2887,7 +2914,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -2913,7 +2940,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -2957,7 +2984,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -2991,7 +3018,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3054,7 +3081,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3085,7 +3112,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3137,7 +3164,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3168,7 +3195,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3218,7 +3245,7 @@ const int failure_indicator= -2;
 /*:1230*/
 #line 1106 "marpa.w"
 
-MARPA_DSTACK events= &g->t_events;
+MARPA_DSTACK events= &G_CONTEXT(g)->t_events;
 GEV internal_event;
 int type;
 
@@ -3259,14 +3286,14 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
 /*:1250*/
 #line 1132 "marpa.w"
 
-return MARPA_DSTACK_LENGTH(g->t_events);
+return MARPA_DSTACK_LENGTH(G_CONTEXT(g)->t_events);
 }
 
 /*:119*//*139:*/
@@ -3275,8 +3302,8 @@ return MARPA_DSTACK_LENGTH(g->t_events);
 MARPA_LINKAGE
 Marpa_Error_Code marpa_g_error(Marpa_Grammar g,const char**p_error_string)
 {
-const Marpa_Error_Code error_code= g->t_error;
-const char*error_string= g->t_error_string;
+const Marpa_Error_Code error_code= G_CONTEXT(g)->t_error;
+const char*error_string= G_CONTEXT(g)->t_error_string;
 if(p_error_string){
 *p_error_string= error_string;
 }
@@ -3291,7 +3318,7 @@ Marpa_Error_Code
 marpa_g_error_clear(Marpa_Grammar g)
 {
 clear_error(g);
-return g->t_error;
+return G_CONTEXT(g)->t_error;
 }
 
 /*:140*//*146:*/
@@ -3411,7 +3438,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3466,7 +3493,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3521,7 +3548,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3712,7 +3739,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3774,7 +3801,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3825,7 +3852,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3886,7 +3913,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -3948,7 +3975,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4000,7 +4027,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4077,7 +4104,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4139,7 +4166,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4191,7 +4218,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4262,7 +4289,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4341,7 +4368,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4394,7 +4421,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4465,7 +4492,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4544,7 +4571,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4596,7 +4623,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4667,7 +4694,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4933,7 +4960,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -4964,7 +4991,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5015,7 +5042,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5066,7 +5093,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5440,7 +5467,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5527,7 +5554,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5669,7 +5696,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5727,7 +5754,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5788,7 +5815,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5844,7 +5871,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5900,7 +5927,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -5976,7 +6003,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6031,7 +6058,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6104,7 +6131,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6165,7 +6192,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6225,7 +6252,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6280,7 +6307,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6333,7 +6360,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6407,7 +6434,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6472,7 +6499,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6537,7 +6564,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6602,7 +6629,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6735,7 +6762,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6787,7 +6814,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -6839,7 +6866,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -7164,7 +7191,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10138,7 +10165,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10191,7 +10218,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10229,7 +10256,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10350,6 +10377,11 @@ r->t_obs= marpa_obs_init;
 
 r->t_ref_count= 1;
 
+MARPA_DSTACK_INIT(r->t_context.t_events,GEV_Object,INITIAL_G_EVENTS_CAPACITY);
+r->t_context.t_error= MARPA_ERR_NONE;
+r->t_context.t_error_string= NULL;
+r->t_cilar_is_ready= 0;
+
 /*:554*//*559:*/
 #line 6193 "marpa.w"
 
@@ -10554,6 +10586,11 @@ const GRAMMAR g= G_of_R(r);
 /*:560*/
 #line 6182 "marpa.w"
 
+if(marpa_r_context==r)
+marpa_r_context= NULL;
+MARPA_DSTACK_DESTROY(r->t_context.t_events);
+if(r->t_cilar_is_ready)
+cilar_destroy(&r->t_cilar);
 /*561:*/
 #line 6200 "marpa.w"
 grammar_unref(g);
@@ -10615,6 +10652,26 @@ marpa_obs_free(r->t_obs);
 my_free(r);
 }
 
+/* c-marpaWrapper: Leo event sets are merged during the parse, in the recognizer */
+PRIVATE CILAR
+r_cilar(RECCE r)
+{
+if(!r->t_cilar_is_ready)
+{
+cilar_init(&r->t_cilar);
+r->t_cilar_is_ready= 1;
+}
+return &r->t_cilar;
+}
+
+/* c-marpaWrapper: until the next call, events and errors of the grammar of r go to r on this thread. */
+/* With NULL, they go to the grammar itself. This lets threads share a precomputed grammar.          */
+MARPA_LINKAGE
+void marpa_r_context_set(Marpa_Recognizer r)
+{
+marpa_r_context= r;
+}
+
 /*:557*//*567:*/
 #line 6230 "marpa.w"
 
@@ -10643,7 +10700,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10729,7 +10786,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10803,7 +10860,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10883,7 +10940,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -10964,7 +11021,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11044,7 +11101,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11124,7 +11181,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11202,7 +11259,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11240,7 +11297,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11288,7 +11345,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11327,7 +11384,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11391,7 +11448,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11457,7 +11514,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -11516,7 +11573,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -13197,7 +13254,7 @@ const CIL trailhead_ahm_event_ahmids=
 Event_AHMIDs_of_AHM(trailhead_ahm);
 if(Count_of_CIL(trailhead_ahm_event_ahmids))
 {
-CIL new_cil= cil_merge_one(&g->t_cilar,predecessor_cil,
+CIL new_cil= cil_merge_one(r_cilar(r),predecessor_cil,
 Item_of_CIL
 (trailhead_ahm_event_ahmids,0));
 if(new_cil)
@@ -13347,7 +13404,7 @@ const CIL trailhead_ahm_event_ahmids=
 Event_AHMIDs_of_AHM(trailhead_ahm);
 if(Count_of_CIL(trailhead_ahm_event_ahmids))
 {
-CIL new_cil= cil_merge_one(&g->t_cilar,predecessor_cil,
+CIL new_cil= cil_merge_one(r_cilar(r),predecessor_cil,
 Item_of_CIL
 (trailhead_ahm_event_ahmids,0));
 if(new_cil)
@@ -13881,7 +13938,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -13951,7 +14008,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -14033,7 +14090,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -14161,7 +14218,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -14358,7 +14415,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -14690,7 +14747,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -15630,7 +15687,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -15669,7 +15726,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -15794,7 +15851,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -15833,7 +15890,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -15971,7 +16028,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16094,7 +16151,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16143,7 +16200,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16200,7 +16257,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16250,7 +16307,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16525,7 +16582,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16629,7 +16686,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -16800,7 +16857,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17180,7 +17237,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17239,7 +17296,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17440,7 +17497,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17509,7 +17566,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17590,7 +17647,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17706,7 +17763,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17798,7 +17855,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17874,7 +17931,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -17970,7 +18027,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -18192,7 +18249,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -18710,7 +18767,10 @@ if(start>=BV_BITS(bv))return 0;
 min= start;
 max= start;
 offset= start/bv_wordbits;
-*(bv+size-1)&= mask;
+
+/* c-marpaWrapper: the grammar bit vectors are scanned by recognizers that may run
+   concurrently: only write when there is something to clear */
+if((*(bv+size-1)&~mask)!=0)*(bv+size-1)&= mask;
 bv+= offset;
 size-= offset;
 bitmask= (LBW)1<<(start&bv_modmask);
@@ -19419,8 +19479,8 @@ return free_psl;
 PRIVATE_NOT_INLINE void
 set_error(GRAMMAR g,Marpa_Error_Code code,const char*message,unsigned int flags)
 {
-g->t_error= code;
-g->t_error_string= message;
+G_CONTEXT(g)->t_error= code;
+G_CONTEXT(g)->t_error_string= message;
 if(flags&FATAL_FLAG)
 g->t_is_ok= 0;
 }
@@ -19432,12 +19492,12 @@ clear_error(GRAMMAR g)
 {
 if(!IS_G_OK(g))
 {
-if(g->t_error==MARPA_ERR_NONE)
-g->t_error= MARPA_ERR_I_AM_NOT_OK;
-return g->t_error;
+if(G_CONTEXT(g)->t_error==MARPA_ERR_NONE)
+G_CONTEXT(g)->t_error= MARPA_ERR_I_AM_NOT_OK;
+return G_CONTEXT(g)->t_error;
 }
-g->t_error= MARPA_ERR_NONE;
-g->t_error_string= NULL;
+G_CONTEXT(g)->t_error= MARPA_ERR_NONE;
+G_CONTEXT(g)->t_error_string= NULL;
 return MARPA_ERR_NONE;
 }
 
@@ -19484,7 +19544,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19543,7 +19603,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19607,7 +19667,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19667,7 +19727,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19718,7 +19778,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19815,7 +19875,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19925,7 +19985,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -19995,7 +20055,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20063,7 +20123,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20127,7 +20187,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20202,7 +20262,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20300,7 +20360,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20393,7 +20453,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20465,7 +20525,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20527,7 +20587,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20617,7 +20677,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20699,7 +20759,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20788,7 +20848,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20870,7 +20930,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -20948,7 +21008,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21040,7 +21100,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21120,7 +21180,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21195,7 +21255,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21272,7 +21332,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21363,7 +21423,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21436,7 +21496,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21509,7 +21569,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21582,7 +21642,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21655,7 +21715,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21728,7 +21788,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21801,7 +21861,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21874,7 +21934,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -21948,7 +22008,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22028,7 +22088,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22117,7 +22177,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22197,7 +22257,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22602,7 +22662,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22680,7 +22740,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22758,7 +22818,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22836,7 +22896,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22914,7 +22974,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -22992,7 +23052,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -23070,7 +23130,7 @@ MARPA_ERROR(MARPA_ERR_HEADERS_DO_NOT_MATCH);
 return failure_indicator;
 }
 if(_MARPA_UNLIKELY(!IS_G_OK(g))){
-MARPA_ERROR(g->t_error);
+MARPA_ERROR(G_CONTEXT(g)->t_error);
 return failure_indicator;
 }
 
@@ -512,6 +512,7 @@ MARPA_LINKAGE  int marpa_g_has_cycle (Marpa_Grammar g);
 MARPA_LINKAGE  int marpa_g_is_precomputed (Marpa_Grammar g);
 MARPA_LINKAGE  int marpa_g_precompute (Marpa_Grammar g);
 MARPA_LINKAGE  Marpa_Recognizer marpa_r_new ( Marpa_Grammar g );
+MARPA_LINKAGE  void marpa_r_context_set ( Marpa_Recognizer r );
 MARPA_LINKAGE  Marpa_Recognizer marpa_r_ref (Marpa_Recognizer r);
 MARPA_LINKAGE  void marpa_r_unref (Marpa_Recognizer r);
 MARPA_LINKAGE  int marpa_r_start_input (Marpa_Recognizer r);
@@ -0,0 +1,326 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "marpaWrapper/internal/config.h"
+#include "marpaWrapper/internal/_arena.h"
+#include "marpaWrapper/internal/_logging.h"
+
+/* The arena and its chunks are in the C library heap: (malloc)() and (free)() bypass the */
+/* allocator redirection of the amalgamation.                                               */
+
+static void *_marpaWrapperArena_reallocp(void *userDatavp, void *p, size_t sizel);
+static void  _marpaWrapperArena_freev(void *userDatavp, void *p);
+static short _marpaWrapperArena_chunkb(marpaWrapperArena_t *marpaWrapperArenap, size_t wantedl);
+
+/****************************************************************************/
+marpaWrapperArena_t *marpaWrapperArena_newp(genericLogger_t *genericLoggerp, size_t chunkl)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperArena_newp)
+  marpaWrapperArena_t *marpaWrapperArenap;
+
+  marpaWrapperArenap = (marpaWrapperArena_t *) (malloc)(sizeof(marpaWrapperArena_t));
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperArenap == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
+    goto err;
+  }
+
+  marpaWrapperArenap->marpaWrapperAllocator.userDatavp = marpaWrapperArenap;
+  marpaWrapperArenap->marpaWrapperAllocator.mallocp    = _marpaWrapperArena_mallocp;
+  marpaWrapperArenap->marpaWrapperAllocator.reallocp   = _marpaWrapperArena_reallocp;
+  marpaWrapperArenap->marpaWrapperAllocator.freep      = _marpaWrapperArena_freev;
+  marpaWrapperArenap->genericLoggerp                   = NULL;
+  marpaWrapperArenap->chunkl                           = (chunkl > 0) ? chunkl : MARPAWRAPPERARENA_DEFAULT_CHUNK;
+  marpaWrapperArenap->chunkp                           = NULL;
+  marpaWrapperArenap->lastp                            = NULL;
+  marpaWrapperArenap->usedl                            = 0;
+  marpaWrapperArenap->capacityl                        = 0;
+  marpaWrapperArenap->nChunkl                          = 0;
+
+  if (genericLoggerp != NULL) {
+    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Cloning genericLogger");
+
+    marpaWrapperArenap->genericLoggerp = GENERICLOGGER_CLONE(genericLoggerp);
+    if (MARPAWRAPPER_UNLIKELY(marpaWrapperArenap->genericLoggerp == NULL)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Failed to clone genericLogger: %s", strerror(errno));
+      goto err;
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", marpaWrapperArenap);
+  return marpaWrapperArenap;
+
+ err:
+  if (marpaWrapperArenap != NULL) {
+    int errnoi = errno;
+    marpaWrapperArena_freev(marpaWrapperArenap);
+    errno = errnoi;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
+  return NULL;
+}
+
+/****************************************************************************/
+marpaWrapperAllocator_t *marpaWrapperArena_allocatorp(marpaWrapperArena_t *marpaWrapperArenap)
+/****************************************************************************/
+{
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperArenap == NULL)) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  return &(marpaWrapperArenap->marpaWrapperAllocator);
+}
+
+/****************************************************************************/
+short marpaWrapperArena_resetb(marpaWrapperArena_t *marpaWrapperArenap)
+/****************************************************************************/
+/* Everything given by the arena is released at once. The largest chunk is  */
+/* kept, so that a document of the same size does not allocate again.      */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperArena_resetb)
+  _marpaWrapperArenaChunk_t *chunkp;
+  _marpaWrapperArenaChunk_t *previousp;
+  _marpaWrapperArenaChunk_t *keptChunkp = NULL;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperArenap == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  for (chunkp = marpaWrapperArenap->chunkp; chunkp != NULL; chunkp = previousp) {
+    previousp = chunkp->previousp;
+    if ((keptChunkp == NULL) || (chunkp->sizel > keptChunkp->sizel)) {
+      if (keptChunkp != NULL) {
+        (free)(keptChunkp);
+      }
+      keptChunkp = chunkp;
+    } else {
+      (free)(chunkp);
+    }
+  }
+
+  if (keptChunkp != NULL) {
+    keptChunkp->previousp           = NULL;
+    keptChunkp->usedl               = 0;
+    marpaWrapperArenap->capacityl   = keptChunkp->sizel;
+    marpaWrapperArenap->nChunkl     = 1;
+  } else {
+    marpaWrapperArenap->capacityl   = 0;
+    marpaWrapperArenap->nChunkl     = 0;
+  }
+  marpaWrapperArenap->chunkp = keptChunkp;
+  marpaWrapperArenap->lastp  = NULL;
+  marpaWrapperArenap->usedl  = 0;
+
+  MARPAWRAPPER_TRACE(marpaWrapperArenap->genericLoggerp, funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(NULL, funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+short marpaWrapperArena_statsb(marpaWrapperArena_t *marpaWrapperArenap, size_t *usedlp, size_t *capacitylp, size_t *nChunklp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperArena_statsb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperArenap == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (usedlp != NULL) {
+    *usedlp = marpaWrapperArenap->usedl;
+  }
+  if (capacitylp != NULL) {
+    *capacitylp = marpaWrapperArenap->capacityl;
+  }
+  if (nChunklp != NULL) {
+    *nChunklp = marpaWrapperArenap->nChunkl;
+  }
+
+  MARPAWRAPPER_TRACE(marpaWrapperArenap->genericLoggerp, funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(NULL, funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+void marpaWrapperArena_freev(marpaWrapperArena_t *marpaWrapperArenap)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperArena_freev)
+  genericLogger_t           *genericLoggerp;
+  _marpaWrapperArenaChunk_t *chunkp;
+  _marpaWrapperArenaChunk_t *previousp;
+
+  if (marpaWrapperArenap != NULL) {
+    /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
+    genericLoggerp = marpaWrapperArenap->genericLoggerp;
+
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Freeing %ld chunks", (unsigned long) marpaWrapperArenap->nChunkl);
+    for (chunkp = marpaWrapperArenap->chunkp; chunkp != NULL; chunkp = previousp) {
+      previousp = chunkp->previousp;
+      (free)(chunkp);
+    }
+
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperArenap);
+    (free)(marpaWrapperArenap);
+
+    if (genericLoggerp != NULL) {
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing cloned generic logger");
+      GENERICLOGGER_FREE(genericLoggerp);
+    }
+  }
+}
+
+/****************************************************************************/
+static short _marpaWrapperArena_chunkb(marpaWrapperArena_t *marpaWrapperArenap, size_t wantedl)
+/****************************************************************************/
+/* Pushes a new chunk of at least wantedl usable bytes.                     */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperArena_chunkb)
+  _marpaWrapperArenaChunk_t *chunkp;
+  size_t                     sizel = marpaWrapperArenap->chunkl;
+
+  if (sizel < wantedl) {
+    sizel = wantedl;
+  }
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - MARPAWRAPPERARENA_CHUNK_HEADER)) {
+    errno = ENOMEM;
+    goto err;
+  }
+
+  chunkp = (_marpaWrapperArenaChunk_t *) (malloc)(MARPAWRAPPERARENA_CHUNK_HEADER + sizel);
+  if (MARPAWRAPPER_UNLIKELY(chunkp == NULL)) {
+    MARPAWRAPPER_ERRORF(marpaWrapperArenap->genericLoggerp, "malloc failure: %s", strerror(errno));
+    goto err;
+  }
+  chunkp->previousp = marpaWrapperArenap->chunkp;
+  chunkp->sizel     = sizel;
+  chunkp->usedl     = 0;
+
+  marpaWrapperArenap->chunkp     = chunkp;
+  marpaWrapperArenap->lastp      = NULL;
+  marpaWrapperArenap->capacityl += sizel;
+  marpaWrapperArenap->nChunkl++;
+
+  /* Chunks double, so that the number of chunks is logarithmic in the size of the parse */
+  if (marpaWrapperArenap->chunkl < MARPAWRAPPERARENA_MAX_CHUNK) {
+    marpaWrapperArenap->chunkl *= 2;
+  }
+
+  MARPAWRAPPER_TRACEF(marpaWrapperArenap->genericLoggerp, funcs, "New chunk %p of %ld bytes", chunkp, (unsigned long) sizel);
+  return 1;
+
+ err:
+  return 0;
+}
+
+/****************************************************************************/
+static void *_marpaWrapperArena_mallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+{
+  marpaWrapperArena_t       *marpaWrapperArenap = (marpaWrapperArena_t *) userDatavp;
+  _marpaWrapperArenaChunk_t *chunkp             = marpaWrapperArenap->chunkp;
+  size_t                     neededl;
+  char                      *p;
+
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - (2 * MARPAWRAPPERARENA_ALIGN))) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  neededl = MARPAWRAPPERARENA_ALIGN + MARPAWRAPPERARENA_ROUND(sizel);
+
+  if ((chunkp == NULL) || (chunkp->sizel - chunkp->usedl < neededl)) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperArena_chunkb(marpaWrapperArenap, neededl))) {
+      return NULL;
+    }
+    chunkp = marpaWrapperArenap->chunkp;
+  }
+
+  p = MARPAWRAPPERARENA_CHUNK_DATA(chunkp) + chunkp->usedl;
+  ((_marpaWrapperArenaAlign_t *) p)->sizel = sizel;
+  p += MARPAWRAPPERARENA_ALIGN;
+
+  chunkp->usedl             += neededl;
+  marpaWrapperArenap->usedl += neededl;
+  marpaWrapperArenap->lastp  = p;
+
+  return (void *) p;
+}
+
+/****************************************************************************/
+static void *_marpaWrapperArena_reallocp(void *userDatavp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  marpaWrapperArena_t       *marpaWrapperArenap = (marpaWrapperArena_t *) userDatavp;
+  _marpaWrapperArenaChunk_t *chunkp             = marpaWrapperArenap->chunkp;
+  size_t                     oldl;
+  size_t                     deltal;
+  void                      *newp;
+
+  if (p == NULL) {
+    return _marpaWrapperArena_mallocp(userDatavp, sizel);
+  }
+
+  oldl = ((_marpaWrapperArenaAlign_t *) (((char *) p) - MARPAWRAPPERARENA_ALIGN))->sizel;
+  if (sizel <= oldl) {
+    return p;
+  }
+
+  /* The last block grows in place when its chunk has room */
+  if (p == marpaWrapperArenap->lastp) {
+    deltal = MARPAWRAPPERARENA_ROUND(sizel) - MARPAWRAPPERARENA_ROUND(oldl);
+    if ((sizel <= ((size_t) -1) - MARPAWRAPPERARENA_ALIGN) && (chunkp->sizel - chunkp->usedl >= deltal)) {
+      ((_marpaWrapperArenaAlign_t *) (((char *) p) - MARPAWRAPPERARENA_ALIGN))->sizel = sizel;
+      chunkp->usedl             += deltal;
+      marpaWrapperArenap->usedl += deltal;
+      return p;
+    }
+  }
+
+  newp = _marpaWrapperArena_mallocp(userDatavp, sizel);
+  if (MARPAWRAPPER_UNLIKELY(newp == NULL)) {
+    return NULL;
+  }
+  memcpy(newp, p, oldl);
+
+  return newp;
+}
+
+/****************************************************************************/
+static void _marpaWrapperArena_freev(void *userDatavp, void *p)
+/****************************************************************************/
+/* Only the last block is given back, the rest waits for the reset.         */
+/****************************************************************************/
+{
+  marpaWrapperArena_t       *marpaWrapperArenap = (marpaWrapperArena_t *) userDatavp;
+  _marpaWrapperArenaChunk_t *chunkp             = marpaWrapperArenap->chunkp;
+  size_t                     neededl;
+
+  if ((p != NULL) && (p == marpaWrapperArenap->lastp)) {
+    neededl = MARPAWRAPPERARENA_ALIGN + MARPAWRAPPERARENA_ROUND(((_marpaWrapperArenaAlign_t *) (((char *) p) - MARPAWRAPPERARENA_ALIGN))->sizel);
+    chunkp->usedl             -= neededl;
+    marpaWrapperArenap->usedl -= neededl;
+    marpaWrapperArenap->lastp  = NULL;
+  }
+}
@@ -7,20 +7,15 @@
 
 #include "marpa.h"
 #include "marpaWrapper/internal/config.h"
+#include "marpaWrapper/internal/_manageBuf.h"
+#include "marpaWrapper/internal/_sort.h"
+#include "marpaWrapper/internal/_allocator.h"
+#include "marpaWrapper/internal/_arena.h"
 #include "marpaWrapper/internal/_asf.h"
 #include "marpaWrapper/internal/_recognizer.h"
 #include "marpaWrapper/internal/_grammar.h"
 #include "marpaWrapper/internal/_logging.h"
 
-#ifndef MARPAWRAPPERASF_INTSET_MAXROWS
-#define MARPAWRAPPERASF_INTSET_MAXROWS 65536   /* x &0xFFFF */
-#endif
-
-#undef MARPAWRAPPERASF_INTSET_MODULO
-/* x mod 65536 is x & 0xffff when x is unsigned */
-/* #define MARPAWRAPPERASF_INTSET_MODULO (MARPAWRAPPERASF_INTSET_MAXROWS - 1) */
-#define MARPAWRAPPERASF_INTSET_MODULO(x) ((x) & 0xFFFF)
-
 #ifndef MARPAWRAPPERASF_FACTORING_MAX
 #define MARPAWRAPPERASF_FACTORING_MAX 42
 #endif
@@ -49,36 +44,18 @@
 #endif
 #endif
 
-#ifndef MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE
-#if GENERICSTACK_DEFAULT_LENGTH > 0
-#define MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE GENERICSTACK_DEFAULT_LENGTH
-#else
-#define MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE 128  /* Subjective number */
-#endif
-#endif
-
-#ifndef MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE
-#if GENERICSTACK_DEFAULT_LENGTH > 0
-#define MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE GENERICSTACK_DEFAULT_LENGTH
-#else
-#define MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE 128  /* Subjective number */
-#endif
-#endif
-
-#ifndef MARPAWRAPPERASF_ORNODEINUSESPARSEARRAY_SIZE
-#if GENERICSTACK_DEFAULT_LENGTH > 0
-#define MARPAWRAPPERASF_ORNODEINUSESPARSEARRAY_SIZE GENERICSTACK_DEFAULT_LENGTH
-#else
-#define MARPAWRAPPERASF_ORNODEINUSESPARSEARRAY_SIZE 128  /* Subjective number */
-#endif
-#endif
+/* The ASF runs in the context of the recognizer: its allocator, and its libmarpa events and errors */
+#define MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp) MARPAWRAPPERRECOGNIZER_CONTEXT_SET((marpaWrapperAsfp)->marpaWrapperRecognizerp)
 
 static marpaWrapperAsfOption_t marpaWrapperAsfOptionDefault = {
   NULL,   /* genericLoggerp */
    1,     /* highRankOnlyb */
    1,     /* orderByRankb */
    0,     /* ambiguousb */
-   0      /* maxParsesi */
+   0,     /* maxParsesi */
+   0,     /* okCacheb */
+   0,     /* memob */
+   0      /* maxBytesl */
 };
 
 static char *marpaWrapperAsfIdsets[_MARPAWRAPPERASFIDSET_IDSETE_MAX] = {
@@ -92,17 +69,22 @@ typedef struct marpaWrapperAfsAndNodeIdAndPredecessorId {
 } marpaWrapperAfsAndNodeIdAndPredecessorId_t;
 
 static inline void                       _marpaWrapperAsf_orNodeStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
-static inline void                       _marpaWrapperAsf_gladeStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
-static inline void                       _marpaWrapperAsf_glade_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep);
-static inline void                       _marpaWrapperAsf_symchesStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t *symchesStackp);
-static inline void                       _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t **factoringStackpp);
-static inline void                       _marpaWrapperAsf_factoringsStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t *factoringsStackp);
-static inline genericStack_t            *_marpaWrapperAsf_factoringStackp_resetb(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t **factoringStackpp);
+static inline marpaWrapperAsfGlade_t    *_marpaWrapperAsf_glade_registerp(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi);
+static inline marpaWrapperAsfGlade_t    *_marpaWrapperAsf_glade_findp(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi);
+static inline marpaWrapperAsfSymch_t    *_marpaWrapperAsf_glade_symchp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep, int symchIxi);
+static inline marpaWrapperAsfFactoring_t *_marpaWrapperAsf_symch_factoringp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSymch_t *symchp, int factoringIxi);
+static inline int                       *_marpaWrapperAsf_symch_factoring_newp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSymch_t *symchp, int nFactori);
 static inline short                      _marpaWrapperAsf_peakb(marpaWrapperAsf_t *marpaWrapperAsfp, int *gladeIdip);
 static inline int                        _marpaWrapperAsf_andNodeIdAndPredecessorIdCmpi(const void *p1, const void *p2);
-static inline short                      _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAsfp, int *intsetIdip, int counti, int *idip);
-static inline int                        _marpaWrapperAsf_idCmpi(const void *p1, const void *p2);
-
+static inline int                        _marpaWrapperAsf_evictionCandidateCmpi(const void *p1, const void *p2);
+static inline size_t                     _marpaWrapperAsf_glade_bytesl(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep);
+static inline short                      _marpaWrapperAsf_evictb(marpaWrapperAsf_t *marpaWrapperAsfp);
+static inline short                      _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAsfp, int *intsetIdip, size_t *offsetlp, int counti, int *idip);
+static inline uint64_t                   _marpaWrapperAsf_intset_hashull(int counti, int *idip);
+static inline short                      _marpaWrapperAsf_intset_growb(marpaWrapperAsf_t *marpaWrapperAsfp);
+static inline void                       _marpaWrapperAsf_intset_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
+
+static inline marpaWrapperAsfIdset_t    *_marpaWrapperAsf_idset_findp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete, int intsetIdi);
 static inline marpaWrapperAsfIdset_t    *_marpaWrapperAsf_idset_obtainp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete, int counti, int *idip);
 static inline int                       *_marpaWrapperAsf_idset_idip(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete, marpaWrapperAsfIdset_t *idsetp);
 static inline short                      _marpaWrapperAsf_idset_idi_by_ixib(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete, marpaWrapperAsfIdset_t *idsetp, int ixi, int *idip);
@@ -111,8 +93,7 @@ static inline int                        _marpaWrapperAsf_idset_idi(marpaWrapper
 static inline void                       _marpaWrapperAsf_idset_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete);
 
 /* nidset methods */
-int                                      _marpaWrapperAsf_nidset_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp);
-void                                     _marpaWrapperAsf_nidset_sparseArrayFreev(void *userDatavp, void **pp);
+static inline marpaWrapperAsfNidset_t   *_marpaWrapperAsf_nidset_findp(marpaWrapperAsf_t *marpaWrapperAsfp, int intsetIdi);
 static inline marpaWrapperAsfNidset_t   *_marpaWrapperAsf_nidset_obtainp(marpaWrapperAsf_t *marpaWrapperAsfp, int counti, int *idip);
 static inline int                       *_marpaWrapperAsf_nidset_idip(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdset_t *idsetp);
 static inline short                      _marpaWrapperAsf_nidset_idi_by_ixib(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdset_t *idsetp, int ixi, int *idip);
@@ -121,8 +102,6 @@ static inline int                        _marpaWrapperAsf_nidset_idi(marpaWrappe
 static inline void                       _marpaWrapperAsf_nidset_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
 
 /* powerset methods */
-int                                      _marpaWrapperAsf_powerset_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp);
-void                                     _marpaWrapperAsf_powerset_sparseArrayFreev(void *userDatavp, void **pp);
 static inline marpaWrapperAsfPowerset_t *_marpaWrapperAsf_powerset_obtainp(marpaWrapperAsf_t *marpaWrapperAsfp, int counti, int *idip);
 static inline int                       *_marpaWrapperAsf_powerset_idip(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdset_t *idsetp);
 static inline short                      _marpaWrapperAsf_powerset_idi_by_ixib(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdset_t *idsetp, int ixi, int *idip);
@@ -134,7 +113,7 @@ static inline void                       _marpaWrapperAsf_powerset_freev(marpaWr
 static inline int                        _marpaWrapperAsf_nidset_sort_ixi(marpaWrapperAsf_t *marpaWrapperAsfp, int nidi);
 static inline int                        _marpaWrapperAsf_and_node_to_nidi(int idi);
 static inline int                        _marpaWrapperAsf_nid_to_and_nodei(int idi);
-static inline int                        _marpaWrapperAsf_sourceDataCmpi(const void *p1, const void *p2);
+static inline short                      _marpaWrapperAsf_sourceData_sortb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSourceData_t *sourceDatap, int nSourceDatai);
 static inline int                        _marpaWrapperAsf_nid_token_idi(marpaWrapperAsf_t *marpaWrapperAsfp, int nidi);
 static inline int                        _marpaWrapperAsf_nid_symbol_idi(marpaWrapperAsf_t *marpaWrapperAsfp, int nidi);
 static inline int                        _marpaWrapperAsf_nid_rule_idi(marpaWrapperAsf_t *marpaWrapperAsfp, int nidi);
@@ -162,11 +141,8 @@ static inline short                      _marpaWrapperAsf_glade_symch_countb(mar
 static inline int                        _marpaWrapperAsf_glade_symbol_idi(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi);
 static inline int                        _marpaWrapperAsf_glade_spani(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int *lengthip);
 
-/* Specific to orNodeInUseSparseArray */
-int                                      _marpaWrapperAsf_orNodeInUse_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp);
-
 /* Specific to nook */
-static inline marpaWrapperAsfNook_t     *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_t *marpaWrapperAsfp, int orNodeIdi, int parentOrNodeIdi);
+static inline marpaWrapperAsfNook_t     *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp, int orNodeIdi, int parentOrNodeIdi);
 static inline short                      _marpaWrapperAsf_nook_has_semantic_causeb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfNook_t *nookp);
 static inline short                      _marpaWrapperAsf_setLastChoiceb(marpaWrapperAsf_t *marpaWrapperAsfp, short *haveLastChoicebp, marpaWrapperAsfNook_t *nookp);
 static inline short                      _marpaWrapperAsf_nook_incrementb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfNook_t *nookp, short *haveLastChoicebp);
@@ -175,13 +151,8 @@ static inline short                      _marpaWrapperAsf_nook_incrementb(marpaW
 static inline short                      _marpaWrapperAsf_symch_factoring_countb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int symchIxi, int *factoringCountip);
 
 /* Specific to intset */
-int                                      _marpaWrapperAsf_intset_keyIndFunctioni(void *userDatavp, genericStackItemType_t itemType, void **pp);
-short                                    _marpaWrapperAsf_intset_keyCmpFunctionb(void *userDatavp, void **pp1, void **pp2);
-void                                    *_marpaWrapperAsf_intset_keyCopyFunctionp(void *userDatavp, void **pp);
-void                                     _marpaWrapperAsf_intset_keyFreeFunctionv(void *userDatavp, void **pp);
 
 /* General */
-void                                     _marpaWrapperAsf_idset_sparseArrayFreev(void *userDatavp, void **pp);
 static inline unsigned long              _marpaWrapperAsf_djb2(unsigned char *str);
 static inline unsigned long              _marpaWrapperAsf_djb2_s(unsigned char *str, int lengthi);
 static inline int                        _marpaWrapperAsf_token_es_spani(marpaWrapperAsf_t *marpaWrapperAsfp, int andNodeIdi, int *lengthip);
@@ -189,22 +160,56 @@ static inline int                        _marpaWrapperAsf_or_node_es_spani(marpa
 #ifndef MARPAWRAPPER_NTRACE
 static inline void                       _marpaWrapperAsf_dump_stack(marpaWrapperAsf_t *marpaWrapperAsfp, char *what, genericStack_t *stackp);
 #endif
+static inline short                      _marpaWrapperAsf_traverse_fromb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, traverserCallback_t traverserCallbackp, void *userDatavp, short memob, int *valueip);
 static inline short                      _marpaWrapperAsf_traverse_nextFactoringb(marpaWrapperAsfTraverser_t *traverserp, int *factoringIxip);
 static inline short                      _marpaWrapperAsf_traverse_nextSymchb(marpaWrapperAsfTraverser_t *traverserp, int *symchIxip);
 
 /* Specific to choicepoint */
-static inline marpaWrapperAsfChoicePoint_t *_marpaWrapperAsf_choicepoint_newp(marpaWrapperAsf_t *marpaWrapperAsfp);
+static inline short                         _marpaWrapperAsf_choicepoint_initb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp, int nOrNodei);
+static inline void                          _marpaWrapperAsf_choicepoint_resetv(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp);
 static inline void                          _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp);
 
+/* Specific to the traverser memo */
+static inline void                          _marpaWrapperAsf_memo_resetv(marpaWrapperAsf_t *marpaWrapperAsfp);
+static inline short                         _marpaWrapperAsf_memo_findb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int *valueip);
+static inline short                         _marpaWrapperAsf_memo_setb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int valuei);
+
+/* Specific to ambiguity statistics */
+static inline short                         _marpaWrapperAsf_stats_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfStats_t *statsp, marpaWrapperAsfGladeStats_t *topGladeStatsp, int nTopi, int *nTopip);
+static inline short                         _marpaWrapperAsf_glade_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfGladeStats_t *gladeStatsp);
+static inline short                         _marpaWrapperAsf_glade_stats_betterb(marpaWrapperAsfGladeStats_t *gladeStats1p, marpaWrapperAsfGladeStats_t *gladeStats2p);
+
+/* Specific to pruning */
+static inline short                         _marpaWrapperAsf_prune_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi);
+static inline void                          _marpaWrapperAsf_prune_factoringv(marpaWrapperAsf_t *marpaWrapperAsfp, int factoringi);
+static inline short                         _marpaWrapperAsf_glade_tokenb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int *symbolip, int *argip);
+static inline short                         _marpaWrapperAsf_traverse_aliveb(marpaWrapperAsfTraverser_t *traverserp, short *aliveb);
+
+/* Specific to k-best extraction */
+static inline void                          _marpaWrapperAsf_kbest_freev(marpaWrapperAsf_t *marpaWrapperAsfp);
+static inline short                         _marpaWrapperAsf_kbest_nextb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int derivationi, int *nextip);
+static inline short                         _marpaWrapperAsf_kbest_visitb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi);
+static inline short                         _marpaWrapperAsf_kbest_successorsb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivationi);
+static inline int                           _marpaWrapperAsf_kbest_derivation_newi(marpaWrapperAsf_t *marpaWrapperAsfp, int scorei, int gladeIdi, int symchi, int factoringi, int nFactori);
+static inline short                         _marpaWrapperAsf_kbest_betterb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivation1i, int derivation2i);
+static inline int                           _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsf_t *marpaWrapperAsfp, int heap1i, int heap2i);
+static inline int                           _marpaWrapperAsf_kbest_heap_popi(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfKbestGlade_t *kbestGladep);
+static inline short                         _marpaWrapperAsf_kbest_value_derivationb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivationi, int stacki, void *userDatavp,
+                                                                                     marpaWrapperValueRuleCallback_t valueRuleCallbackp,
+                                                                                     marpaWrapperValueSymbolCallback_t valueSymbolCallbackp,
+                                                                                     marpaWrapperValueNullingCallback_t valueNullingCallbackp);
+
 /* Specific to value using the ASF */
 static inline short                       _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static inline marpaWrapperAsfValueNode_t *_marpaWrapperAsfValue_nodep(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int indicei);
+static inline short                       _marpaWrapperAsfValue_node_setb(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int indicei, short haveNextChoiceb, int consumedNextChoicesi, int endIndicei);
 
 /* Specific to value sparse array */
 int                                      _marpaWrapperAsf_valueSparseArray_indi(void *userDatavp, genericStackItemType_t itemType, void **pp);
 
 /* For my very internal purpose */
 #ifndef MARPAWRAPPER_NTRACE
-static void _marpaWrapperAsf_dumpintsetHashpv(marpaWrapperAsf_t *marpaWrapperAsfp);
+static void _marpaWrapperAsf_dumpintsetTablev(marpaWrapperAsf_t *marpaWrapperAsfp);
 #endif
 
 /****************************************************************************/
@@ -236,6 +241,7 @@ marpaWrapperAsf_t *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRe
     marpaWrapperAsfOptionp = &marpaWrapperAsfOptionDefault;
   }
   genericLoggerp = marpaWrapperAsfOptionp->genericLoggerp;
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
 
   /* Impossible if we are already valuating it */
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->treeModeb != MARPAWRAPPERRECOGNIZERTREEMODE_NA)) {
@@ -255,19 +261,49 @@ marpaWrapperAsf_t *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRe
   marpaWrapperAsfp->marpaBocagep            = NULL;
   marpaWrapperAsfp->marpaOrderp             = NULL;
   marpaWrapperAsfp->orNodeStackp            = NULL;
-  marpaWrapperAsfp->intsetHashp             = NULL;
-  marpaWrapperAsfp->nidsetSparseArrayp      = NULL;
-  marpaWrapperAsfp->powersetSparseArrayp    = NULL;
-  marpaWrapperAsfp->gladeStackp             = NULL;
+  memset(&(marpaWrapperAsfp->intsetTable), 0, sizeof(marpaWrapperAsfp->intsetTable));
+  memset(marpaWrapperAsfp->idsetVectors, 0, sizeof(marpaWrapperAsfp->idsetVectors));
+  marpaWrapperAsfp->gladep                  = NULL;
+  marpaWrapperAsfp->sizeGladel              = 0;
+  marpaWrapperAsfp->nGladel                 = 0;
+  marpaWrapperAsfp->symchp                  = NULL;
+  marpaWrapperAsfp->sizeSymchl              = 0;
+  marpaWrapperAsfp->nSymchl                 = 0;
+  marpaWrapperAsfp->factoringp              = NULL;
+  marpaWrapperAsfp->sizeFactoringl          = 0;
+  marpaWrapperAsfp->nFactoringl             = 0;
+  marpaWrapperAsfp->factorip                = NULL;
+  marpaWrapperAsfp->sizeFactorl             = 0;
+  marpaWrapperAsfp->nFactorl                = 0;
   marpaWrapperAsfp->nextIntseti             = 0;
-  marpaWrapperAsfp->traverserCallbackp      = NULL;
-  marpaWrapperAsfp->userDatavp              = NULL;
+  marpaWrapperAsfp->preparedb               = 0;
+  marpaWrapperAsfp->traversali              = 0;
+  marpaWrapperAsfp->nEvictionl              = 0;
+  marpaWrapperAsfp->nRebuildl               = 0;
+  marpaWrapperAsfp->keptBytesl              = 0;
+  memset(&(marpaWrapperAsfp->memo), 0, sizeof(marpaWrapperAsfp->memo));
+  memset(&(marpaWrapperAsfp->kbest), 0, sizeof(marpaWrapperAsfp->kbest));
+  memset(&(marpaWrapperAsfp->prune), 0, sizeof(marpaWrapperAsfp->prune));
+  marpaWrapperAsfp->countp                  = NULL;
+  marpaWrapperAsfp->sizeCountl              = 0;
+  marpaWrapperAsfp->nCountl                 = 0;
   marpaWrapperAsfp->worklistStackp          = NULL;
   marpaWrapperAsfp->intsetidp               = NULL;
   marpaWrapperAsfp->intsetcounti            = 0;
   marpaWrapperAsfp->causeNidsp              = NULL;
   marpaWrapperAsfp->causeNidsi              = 0;
   marpaWrapperAsfp->gladeObtainTmpStackp    = NULL;
+  marpaWrapperAsfp->sourceDatap             = NULL;
+  marpaWrapperAsfp->sizeSourceDatal         = 0;
+  marpaWrapperAsfp->nidWithCurrentSortIxip  = NULL;
+  marpaWrapperAsfp->sizeNidWithCurrentSortIxil = 0;
+  marpaWrapperAsfp->symchIdip               = NULL;
+  marpaWrapperAsfp->sizeSymchIdil           = 0;
+  memset(&(marpaWrapperAsfp->choicepoint), 0, sizeof(marpaWrapperAsfp->choicepoint));
+  marpaWrapperAsfp->andNodeIdStackp         = NULL;
+  marpaWrapperAsfp->causeNidsStackp         = NULL;
+  marpaWrapperAsfp->sortScratchp            = NULL;
+  marpaWrapperAsfp->sortScratchl            = 0;
   marpaWrapperAsfp->causesHashp             = NULL;
 
   /* Always succeed as per the doc */
@@ -332,51 +368,7 @@ marpaWrapperAsf_t *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRe
     goto err;
   }
 
-  GENERICHASH_NEW_ALL(marpaWrapperAsfp->intsetHashp,
-                      _marpaWrapperAsf_intset_keyIndFunctioni,
-                      _marpaWrapperAsf_intset_keyCmpFunctionb,
-                      _marpaWrapperAsf_intset_keyCopyFunctionp,
-                      _marpaWrapperAsf_intset_keyFreeFunctionv,
-                      NULL,  /* The value type will always be INT: no need */
-                      NULL,  /* for a copy not a free functions for the value */
-                      MARPAWRAPPERASF_INTSET_MAXROWS,
-                      0);
-  if (MARPAWRAPPER_UNLIKELY(GENERICHASH_ERROR(marpaWrapperAsfp->intsetHashp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Intset hash initialization error, %s", strerror(errno));
-    goto err;
-  }
-
-  GENERICSPARSEARRAY_NEW_ALL(marpaWrapperAsfp->nidsetSparseArrayp,
-			     _marpaWrapperAsf_nidset_sparseArrayIndi,
-			     /* We make sure we never insert if it already exist: no need to an internal copy again. */
-			     /* We take this as an advantage by returning what is allocated on the heap just before  */
-			     /* the call to GENERICSPARSEARRAY_SET: this is alleviating the needed of another FIND.  */
-			     NULL,
-			     _marpaWrapperAsf_nidset_sparseArrayFreev, /* ... so we just need to free it */
-			     MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE, /* We know we hash on this number of rows */
-			     0
-			     );
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(marpaWrapperAsfp->nidsetSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Nidset sparse array initialization error, %s", strerror(errno));
-    goto err;
-  }
-
-  GENERICSPARSEARRAY_NEW_ALL(marpaWrapperAsfp->powersetSparseArrayp,
-			     _marpaWrapperAsf_powerset_sparseArrayIndi,
-			     /* Same remark as before */
-			     NULL,
-			     _marpaWrapperAsf_powerset_sparseArrayFreev, /* ... so we just need to free it */
-			     MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE, /* We know we hash on this number of rows */
-			     0
-			     );
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(marpaWrapperAsfp->powersetSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Powerset sparse array error, %s", strerror(errno));
-    goto err;
-  }
-
-  GENERICSTACK_NEW(marpaWrapperAsfp->gladeStackp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfp->gladeStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "glade stack initialization error, %s", strerror(errno));
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_intset_growb(marpaWrapperAsfp))) {
     goto err;
   }
 
@@ -392,6 +384,18 @@ marpaWrapperAsf_t *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRe
     goto err;
   }
 
+  GENERICSTACK_NEW(marpaWrapperAsfp->andNodeIdStackp);
+  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfp->andNodeIdStackp))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "andNodeIdStackp stack initialization error, %s", strerror(errno));
+    goto err;
+  }
+
+  GENERICSTACK_NEW(marpaWrapperAsfp->causeNidsStackp);
+  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfp->causeNidsStackp))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "causeNidsStackp stack initialization error, %s", strerror(errno));
+    goto err;
+  }
+
   GENERICHASH_NEW(marpaWrapperAsfp->causesHashp, _marpaWrapperAsf_causesHash_indi);
   if (MARPAWRAPPER_UNLIKELY(GENERICHASH_ERROR(marpaWrapperAsfp->causesHashp))) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "causesHashp hash initialization error, %s", strerror(errno));
@@ -474,6 +478,10 @@ marpaWrapperAsf_t *marpaWrapperAsf_newp(marpaWrapperRecognizer_t *marpaWrapperRe
 
   }
 
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_choicepoint_initb(marpaWrapperAsfp, &(marpaWrapperAsfp->choicepoint), orNodei))) {
+    goto err;
+  }
+
   if (genericLoggerp != NULL) {
     MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Cloning genericLogger");
 
@@ -528,13 +536,150 @@ short marpaWrapperAsf_traverseb(marpaWrapperAsf_t *marpaWrapperAsfp, traverserCa
   MARPAWRAPPER_FUNCS(marpaWrapperAsf_traverseb)
   genericLogger_t            *genericLoggerp = NULL;
   int                         gladeIdi;
+  short                       memob;
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  if (MARPAWRAPPER_UNLIKELY(traverserCallbackp == NULL)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "traverserCallbackp is NULL");
+    goto err;
+  }
+
+  /* Glades used by this traversal must not be evicted before it ends */
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_evictb(marpaWrapperAsfp))) {
+    goto err;
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_peakb(marpaWrapperAsfp, &gladeIdi) == 0)) {
+    goto err;
+  }
+
+  memob = marpaWrapperAsfp->marpaWrapperAsfOption.memob;
+  if (memob) {
+    /* Values of a previous traversal are meaningless */
+    _marpaWrapperAsf_memo_resetv(marpaWrapperAsfp);
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_traverse_fromb(marpaWrapperAsfp, gladeIdi, traverserCallbackp, userDatavp, memob, valueip))) {
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_prepareb(marpaWrapperAsf_t *marpaWrapperAsfp, int *gladeIdip)
+/****************************************************************************/
+/* Glades are set up breadth first from the peak: after that, traversals    */
+/* never modify the ASF.                                                    */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_prepareb)
+  genericLogger_t            *genericLoggerp = NULL;
+  int                        *queueip        = NULL;
+  size_t                      sizeQueuel     = 0;
+  size_t                      nQueuel        = 0;
+  size_t                      queueIxl;
+  int                         peakGladeIdi;
+  int                         gladeIdi;
+  int                         downGladeIdi;
   marpaWrapperAsfGlade_t     *gladep;
-  marpaWrapperAsfTraverser_t  traverser;
-  int                         valuei;
-  genericSparseArray_t        valueSparseArray;
-  genericSparseArray_t       *valueSparseArrayp = &valueSparseArray;
+  int                         firstSymchi;
+  int                         nSymchi;
+  int                         symchi;
+  int                         firstFactoringi;
+  int                         nFactoringi;
+  int                         factoringi;
+  int                         firstFactori;
+  int                         nFactori;
+  int                         factori;
 
-  GENERICSPARSEARRAY_INIT(valueSparseArrayp, _marpaWrapperAsf_valueSparseArray_indi);
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_peakb(marpaWrapperAsfp, &peakGladeIdi) == 0)) {
+    goto err;
+  }
+
+  if (! marpaWrapperAsfp->preparedb) {
+    /* A glade is queued once: when it is queued it is already set up, so it is not queued again */
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, queueip, sizeQueuel, 1, sizeof(int));
+    queueip[nQueuel++] = peakGladeIdi;
+    for (queueIxl = 0; queueIxl < nQueuel; queueIxl++) {
+      gladeIdi = queueip[queueIxl];
+      gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+      if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
+        MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", gladeIdi);
+        goto err;
+      }
+      /* Only ranges are kept: setting up a glade may move all the arrays */
+      firstSymchi = gladep->firstSymchi;
+      nSymchi     = gladep->nSymchi;
+      for (symchi = firstSymchi; symchi < firstSymchi + nSymchi; symchi++) {
+        firstFactoringi = marpaWrapperAsfp->symchp[symchi].firstFactoringi;
+        nFactoringi     = marpaWrapperAsfp->symchp[symchi].nFactoringi;
+        for (factoringi = firstFactoringi; factoringi < firstFactoringi + nFactoringi; factoringi++) {
+          firstFactori = marpaWrapperAsfp->factoringp[factoringi].firstFactori;
+          nFactori     = marpaWrapperAsfp->factoringp[factoringi].nFactori;
+          for (factori = firstFactori; factori < firstFactori + nFactori; factori++) {
+            downGladeIdi = marpaWrapperAsfp->factorip[factori];
+            gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, downGladeIdi);
+            if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
+              MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", downGladeIdi);
+              goto err;
+            }
+            if (gladep->nSymchi >= 0) {
+              continue;
+            }
+            if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_obtainp(marpaWrapperAsfp, downGladeIdi) == NULL)) {
+              goto err;
+            }
+            MARPAWRAPPER_MANAGEBUF(genericLoggerp, queueip, sizeQueuel, nQueuel + 1, sizeof(int));
+            queueip[nQueuel++] = downGladeIdi;
+          }
+        }
+      }
+    }
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%ld glades prepared", (long) nQueuel);
+    marpaWrapperAsfp->preparedb = 1;
+  }
+
+  if (gladeIdip != NULL) {
+    *gladeIdip = peakGladeIdi;
+  }
+
+  MARPAWRAPPER_FREEBUF(queueip);
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (*gladeIdip=%d)", peakGladeIdi);
+  return 1;
+
+ err:
+  MARPAWRAPPER_FREEBUF(queueip);
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_traverse_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, traverserCallback_t traverserCallbackp, void *userDatavp, int *valueip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_traverse_gladeb)
+  genericLogger_t            *genericLoggerp = NULL;
 
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
     errno = EINVAL;
@@ -542,33 +687,75 @@ short marpaWrapperAsf_traverseb(marpaWrapperAsf_t *marpaWrapperAsfp, traverserCa
   }
 
   genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
 
   if (MARPAWRAPPER_UNLIKELY(traverserCallbackp == NULL)) {
     MARPAWRAPPER_ERROR(genericLoggerp, "traverserCallbackp is NULL");
     goto err;
   }
 
-  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_peakb(marpaWrapperAsfp, &gladeIdi) == 0)) {
+  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsfp->preparedb)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "The ASF is not prepared");
+    goto err;
+  }
+
+  /* The shared memo would be written concurrently */
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_traverse_fromb(marpaWrapperAsfp, gladeIdi, traverserCallbackp, userDatavp, 0 /* memob */, valueip))) {
     goto err;
   }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_traverse_fromb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, traverserCallback_t traverserCallbackp, void *userDatavp, short memob, int *valueip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_traverse_fromb)
+  genericLogger_t            *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfGlade_t     *gladep;
+  marpaWrapperAsfTraverser_t  traverser;
+  int                         valuei;
+  short                       aliveb;
+  genericSparseArray_t        valueSparseArray;
+  genericSparseArray_t       *valueSparseArrayp = &valueSparseArray;
+
+  GENERICSPARSEARRAY_INIT(valueSparseArrayp, _marpaWrapperAsf_valueSparseArray_indi);
+
   gladep = _marpaWrapperAsf_glade_obtainp(marpaWrapperAsfp, gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
     goto err;
   }
 
-  marpaWrapperAsfp->traverserCallbackp = traverserCallbackp;
-  marpaWrapperAsfp->userDatavp         = userDatavp;
+  traverser.marpaWrapperAsfp   = marpaWrapperAsfp;
+  traverser.traverserCallbackp = traverserCallbackp;
+  traverser.userDatavp         = userDatavp;
+  traverser.memob              = memob;
+  traverser.valueSparseArrayp  = memob ? NULL : valueSparseArrayp;
+  traverser.gladeIdi           = gladeIdi;
+  traverser.symchIxi           = 0;
+  traverser.factoringIxi       = 0;
 
-  traverser.marpaWrapperAsfp  = marpaWrapperAsfp;
-  traverser.valueSparseArrayp = valueSparseArrayp;
-  traverser.gladep            = gladep;
-  traverser.symchIxi          = 0;
-  traverser.factoringIxi      = 0;
+  if (marpaWrapperAsfp->prune.prunedb) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_traverse_aliveb(&traverser, &aliveb))) {
+      goto err;
+    }
+    if (MARPAWRAPPER_UNLIKELY(! aliveb)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d has no tree left after pruning", gladeIdi);
+      goto err;
+    }
+  }
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Calling traverser for glade %d", gladep->idi);
-  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsfp->traverserCallbackp(&traverser, marpaWrapperAsfp->userDatavp, &valuei))) {
+  if (MARPAWRAPPER_UNLIKELY(! traverserCallbackp(&traverser, userDatavp, &valuei))) {
     goto err;
   }
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
 
   if (valueip != NULL) {
     *valueip = valuei;
@@ -589,10 +776,15 @@ void marpaWrapperAsf_freev(marpaWrapperAsf_t *marpaWrapperAsfp)
 {
   MARPAWRAPPER_FUNCS(marpaWrapperAsf_freev)
   genericLogger_t         *genericLoggerp;
+  marpaWrapperAllocator_t *allocatorp;
 
   if (marpaWrapperAsfp != NULL) {
     /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
     genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+    allocatorp     = (marpaWrapperAsfp->marpaWrapperRecognizerp != NULL) ? marpaWrapperAsfp->marpaWrapperRecognizerp->marpaWrapperRecognizerOption.allocatorp : NULL;
+    if (marpaWrapperAsfp->marpaWrapperRecognizerp != NULL) {
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+    }
 
     if (marpaWrapperAsfp->marpaOrderp != NULL) {
       MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_o_unref(%p)", marpaWrapperAsfp->marpaOrderp);
@@ -609,45 +801,78 @@ void marpaWrapperAsf_freev(marpaWrapperAsf_t *marpaWrapperAsfp)
       marpaWrapperAsfp->marpaWrapperRecognizerp->treeModeb = MARPAWRAPPERRECOGNIZERTREEMODE_NA;
     }
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing orNode stack");
-    _marpaWrapperAsf_orNodeStackp_freev(marpaWrapperAsfp);
+    /* Everything below is in the arena, if any: it goes away with marpaWrapperArena_resetb() */
+    if (MARPAWRAPPERARENA_ALLOCATOR_IS_ARENA(allocatorp)) {
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Arena allocator: internal tables are left to the arena");
+    } else {
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing orNode stack");
+      _marpaWrapperAsf_orNodeStackp_freev(marpaWrapperAsfp);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing intset hash");
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing intset table");
 #ifndef MARPAWRAPPER_NTRACE
-    _marpaWrapperAsf_dumpintsetHashpv(marpaWrapperAsfp);
+      _marpaWrapperAsf_dumpintsetTablev(marpaWrapperAsfp);
 #endif
-    GENERICHASH_FREE(marpaWrapperAsfp->intsetHashp, marpaWrapperAsfp);
+      _marpaWrapperAsf_intset_freev(marpaWrapperAsfp);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing Nidset stack");
-    _marpaWrapperAsf_nidset_freev(marpaWrapperAsfp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing Nidset stack");
+      _marpaWrapperAsf_nidset_freev(marpaWrapperAsfp);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing Powerset stack");
-    _marpaWrapperAsf_powerset_freev(marpaWrapperAsfp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing Powerset stack");
+      _marpaWrapperAsf_powerset_freev(marpaWrapperAsfp);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glade stack");
-    _marpaWrapperAsf_gladeStackp_freev(marpaWrapperAsfp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glades");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->gladep);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing worklist stack");
-    GENERICSTACK_FREE(marpaWrapperAsfp->worklistStackp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing worklist stack");
+      GENERICSTACK_FREE(marpaWrapperAsfp->worklistStackp);
 
-    if (marpaWrapperAsfp->intsetidp != NULL) {
-      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing intsetidp");
-      free(marpaWrapperAsfp->intsetidp);
-    }
+      if (marpaWrapperAsfp->intsetidp != NULL) {
+        MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing intsetidp");
+        free(marpaWrapperAsfp->intsetidp);
+      }
 
-    if (marpaWrapperAsfp->causeNidsp != NULL) {
-      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing causeNidsp");
-      free(marpaWrapperAsfp->causeNidsp);
-    }
+      if (marpaWrapperAsfp->causeNidsp != NULL) {
+        MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing causeNidsp");
+        free(marpaWrapperAsfp->causeNidsp);
+      }
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing sort scratch area");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->sortScratchp);
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glade contents");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->symchp);
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->factoringp);
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->factorip);
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glade obtain scratch areas");
+      GENERICSTACK_FREE(marpaWrapperAsfp->gladeObtainTmpStackp);
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->sourceDatap);
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->nidWithCurrentSortIxip);
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->symchIdip);
+      _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsfp, &(marpaWrapperAsfp->choicepoint));
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing gladeObtainTmpStackp");
-    GENERICSTACK_FREE(marpaWrapperAsfp->gladeObtainTmpStackp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing traverser memo");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->memo.valuep);
 
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing causesHashp");
-    GENERICHASH_FREE(marpaWrapperAsfp->causesHashp, marpaWrapperAsfp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing k-best derivations");
+      _marpaWrapperAsf_kbest_freev(marpaWrapperAsfp);
 
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperAsfp);
-    free(marpaWrapperAsfp);
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glade prune states");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->prune.gladeStatebp);
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing tree counts");
+      MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->countp);
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing glade id factors stacks");
+      GENERICSTACK_FREE(marpaWrapperAsfp->andNodeIdStackp);
+      GENERICSTACK_FREE(marpaWrapperAsfp->causeNidsStackp);
+
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing causesHashp");
+      GENERICHASH_FREE(marpaWrapperAsfp->causesHashp, marpaWrapperAsfp);
+
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperAsfp);
+      free(marpaWrapperAsfp);
+    }
 
     if (genericLoggerp != NULL) {
       MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing cloned generic logger");
@@ -681,133 +906,148 @@ static inline void _marpaWrapperAsf_orNodeStackp_freev(marpaWrapperAsf_t *marpaW
 }
 
 /****************************************************************************/
-static inline void _marpaWrapperAsf_gladeStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp)
+static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_registerp(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi)
+/****************************************************************************/
+/* The returned pointer is valid until the next registration.               */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_gladeStackp_freev)
-  int                      gladeUsedi;
-  int                      i;
-  marpaWrapperAsfGlade_t  *gladep;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_registerp)
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  size_t                  wantedl;
+  size_t                  i;
+  marpaWrapperAsfGlade_t *gladep;
+
+  if (MARPAWRAPPER_UNLIKELY(gladeIdi < 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Invalid glade id %d", gladeIdi);
+    goto err;
+  }
 
-  if (marpaWrapperAsfp->gladeStackp != NULL) {
-    gladeUsedi = GENERICSTACK_USED(marpaWrapperAsfp->gladeStackp);
-    for (i = 0; i < gladeUsedi; i++) {
-      if (GENERICSTACK_IS_PTR(marpaWrapperAsfp->gladeStackp, i)) {
-	gladep = (marpaWrapperAsfGlade_t *) GENERICSTACK_GET_PTR(marpaWrapperAsfp->gladeStackp, i);
-        _marpaWrapperAsf_glade_freev(marpaWrapperAsfp, gladep);
-      }
+  wantedl = ((size_t) gladeIdi) + 1;
+  if (wantedl > marpaWrapperAsfp->nGladel) {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->gladep, marpaWrapperAsfp->sizeGladel, wantedl, sizeof(marpaWrapperAsfGlade_t));
+    for (i = marpaWrapperAsfp->nGladel; i < wantedl; i++) {
+      marpaWrapperAsfp->gladep[i].idi = -1;
     }
-    GENERICSTACK_FREE(marpaWrapperAsfp->gladeStackp);
+    marpaWrapperAsfp->nGladel = wantedl;
   }
-}
-
-/****************************************************************************/
-static inline void _marpaWrapperAsf_glade_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep)
-/****************************************************************************/
-{
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_freev)
 
-  if (gladep != NULL) {
-    _marpaWrapperAsf_symchesStackp_freev(marpaWrapperAsfp, gladep->symchesStackp);
-    free(gladep);
+  gladep = &(marpaWrapperAsfp->gladep[gladeIdi]);
+  if (gladep->idi < 0) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating glade at indice %d", gladeIdi);
+    gladep->idi           = gladeIdi;
+    gladep->firstSymchi   = 0;
+    gladep->nSymchi       = -1;
+    gladep->lastTraversali = 0;
+#if MARPAWRAPPERASF_USE_VISITED_FLAG > 0
+    gladep->visitedb      = 0;
+#endif
   }
+#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
+  gladep->registeredb   = 1;
+#endif
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", gladep);
+  return gladep;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
+  return NULL;
 }
 
 /****************************************************************************/
-static inline void _marpaWrapperAsf_symchesStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t *symchesStackp)
+static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_findp(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi)
+/****************************************************************************/
+/* Returns NULL without logging if gladeIdi is not a glade.                 */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_symchesStackp_freev)
-  int                      symchesUsedi;
-  int                      i;
-  genericStack_t          *factoringsStackp;
-
-  if (symchesStackp != NULL) {
-    symchesUsedi = GENERICSTACK_USED(symchesStackp);
-    for (i = 0; i < symchesUsedi; i++) {
-      /* symchesStackp is a stack of factoringsStackp */
-      if (GENERICSTACK_IS_PTR(symchesStackp, i)) {
-	factoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(symchesStackp, i);
-	_marpaWrapperAsf_factoringsStackp_freev(marpaWrapperAsfp, factoringsStackp);
-      }
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_findp)
+#ifndef MARPAWRAPPER_NTRACE
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
+  marpaWrapperAsfGlade_t *gladep         = NULL;
+
+  if ((gladeIdi >= 0) && (((size_t) gladeIdi) < marpaWrapperAsfp->nGladel)) {
+    gladep = &(marpaWrapperAsfp->gladep[gladeIdi]);
+    if (gladep->idi < 0) {
+      gladep = NULL;
     }
-    GENERICSTACK_FREE(symchesStackp);
   }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", gladep);
+  return gladep;
 }
 
 /****************************************************************************/
-static inline void _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t **factoringStackpp)
+static inline marpaWrapperAsfSymch_t *_marpaWrapperAsf_glade_symchp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep, int symchIxi)
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_factoringStackp_freev)
-  int                      factoringUsedi;
-  int                      i;
-  marpaWrapperAsfNook_t   *nookp;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_symchp)
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfSymch_t *symchp;
 
-  if (factoringStackpp != NULL) {
-    genericStack_t *factoringStackp = *factoringStackpp;
-    if (factoringStackp != NULL) {
-      factoringUsedi = GENERICSTACK_USED(factoringStackp);
-      for (i = 0; i < factoringUsedi; i++) {
-	if (GENERICSTACK_IS_PTR(factoringStackp, i)) {
-	  nookp = (marpaWrapperAsfNook_t *) GENERICSTACK_GET_PTR(factoringStackp, i);
-	  if (nookp != NULL) {
-	    free(nookp);
-	  }
-	}
-      }
-      GENERICSTACK_FREE(factoringStackp);
-    }
-    *factoringStackpp = NULL;
+  if (MARPAWRAPPER_UNLIKELY((symchIxi < 0) || (symchIxi >= gladep->nSymchi))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No symch at indice %d of glade %d", symchIxi, gladep->idi);
+    goto err;
   }
+  symchp = &(marpaWrapperAsfp->symchp[gladep->firstSymchi + symchIxi]);
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", symchp);
+  return symchp;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
+  return NULL;
 }
 
 /****************************************************************************/
-static inline void _marpaWrapperAsf_factoringsStackp_freev(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t *factoringsStackp)
+static inline marpaWrapperAsfFactoring_t *_marpaWrapperAsf_symch_factoringp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSymch_t *symchp, int factoringIxi)
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_factoringsStackp_freev)
-  int                      factoringsUsedi;
-  int                      i;
-  genericStack_t          *localStackp;
-
-  if (factoringsStackp != NULL) {
-    factoringsUsedi = GENERICSTACK_USED(factoringsStackp);
-    /* At indice >= 2, factoringsStackp can contain inner generic stacks */
-    /* that are an array of gladeIdi */
-    for (i = 2; i < factoringsUsedi; i++) {
-      if (GENERICSTACK_IS_PTR(factoringsStackp, i)) {
-        localStackp = (genericStack_t *) GENERICSTACK_GET_PTR(factoringsStackp, i);
-	GENERICSTACK_FREE(localStackp);
-      }
-    }
-    /* Note: GENERICSTACK_FREE() is always restting the pointer as well */
-    GENERICSTACK_FREE(factoringsStackp);
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_symch_factoringp)
+  genericLogger_t            *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfFactoring_t *factoringp;
+
+  if (MARPAWRAPPER_UNLIKELY((factoringIxi < 0) || (factoringIxi >= symchp->nFactoringi))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No factoring at indice %d of symch", factoringIxi);
+    goto err;
   }
+  factoringp = &(marpaWrapperAsfp->factoringp[symchp->firstFactoringi + factoringIxi]);
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", factoringp);
+  return factoringp;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
+  return NULL;
 }
 
 /****************************************************************************/
-static inline genericStack_t *_marpaWrapperAsf_factoringStackp_resetb(marpaWrapperAsf_t *marpaWrapperAsfp, genericStack_t **factoringStackpp)
+static inline int *_marpaWrapperAsf_symch_factoring_newp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSymch_t *symchp, int nFactori)
+/****************************************************************************/
+/* Appends a factoring of nFactori factors to symchp, that must be the last  */
+/* symch being set up. Returns where the caller writes the factors: this is  */
+/* valid until the next call.                                                */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_factoringStackp_resetb)
-  genericLogger_t             *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericStack_t              *factoringStackp;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_symch_factoring_newp)
+  genericLogger_t            *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfFactoring_t *factoringp;
+  int                        *factorip;
 
-  if (MARPAWRAPPER_UNLIKELY(factoringStackpp == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "factoringStackpp is NULL", strerror(errno));
-    goto err;
-  }
-  _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsfp, factoringStackpp);
-  GENERICSTACK_NEW(factoringStackp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "factoringStack reset failure: %s", strerror(errno));
-    goto err;
-  }
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->factoringp, marpaWrapperAsfp->sizeFactoringl, marpaWrapperAsfp->nFactoringl + 1, sizeof(marpaWrapperAsfFactoring_t));
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->factorip, marpaWrapperAsfp->sizeFactorl, marpaWrapperAsfp->nFactorl + nFactori, sizeof(int));
 
-  *factoringStackpp = factoringStackp;
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", factoringStackp);
-  return factoringStackp;
+  factoringp               = &(marpaWrapperAsfp->factoringp[marpaWrapperAsfp->nFactoringl++]);
+  factoringp->firstFactori = (int) marpaWrapperAsfp->nFactorl;
+  factoringp->nFactori     = nFactori;
+  factoringp->deadb        = 0;
+  symchp->nFactoringi++;
+
+  factorip = &(marpaWrapperAsfp->factorip[marpaWrapperAsfp->nFactorl]);
+  marpaWrapperAsfp->nFactorl += nFactori;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", factorip);
+  return factorip;
 
  err:
   MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
@@ -827,7 +1067,6 @@ static inline short _marpaWrapperAsf_peakb(marpaWrapperAsf_t *marpaWrapperAsfp,
   marpaWrapperAsfNidset_t *baseNidsetp;
   marpaWrapperAsfOrNode_t *orNodep;
   int                      gladeIdi;
-  marpaWrapperAsfGlade_t  *gladep;
 
   augmentOrNodeIdi = (int) _marpa_b_top_or_node(marpaWrapperAsfp->marpaBocagep);
   if (MARPAWRAPPER_UNLIKELY(augmentOrNodeIdi < -1)) {
@@ -860,35 +1099,8 @@ static inline short _marpaWrapperAsf_peakb(marpaWrapperAsf_t *marpaWrapperAsfp,
 
   /* We cannot "obtain" the glade if it is not registered */
   gladeIdi = _marpaWrapperAsf_nidset_idi(marpaWrapperAsfp, baseNidsetp);
-  if (! GENERICSTACK_IS_PTR(marpaWrapperAsfp->gladeStackp, gladeIdi)) {
-
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating glade at indice %d", gladeIdi);
-    gladep = (marpaWrapperAsfGlade_t *) malloc(sizeof(marpaWrapperAsfGlade_t));
-
-    if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-      goto err;
-    }
-    gladep->idi           = gladeIdi;
-    gladep->symchesStackp = NULL;
-#if MARPAWRAPPERASF_USE_VISITED_FLAG > 0
-    gladep->visitedb      = 0;
-#endif
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-    gladep->registeredb   = 1;
-#endif
-    GENERICSTACK_SET_PTR(marpaWrapperAsfp->gladeStackp, gladep, gladeIdi);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfp->gladeStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "glade stack failure: %s", strerror(errno));
-      free(gladep);
-      goto err;
-    }
-  } else {
-
-    gladep = (marpaWrapperAsfGlade_t *) GENERICSTACK_GET_PTR(marpaWrapperAsfp->gladeStackp,  gladeIdi);
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-    gladep->registeredb   = 1;
-#endif
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_registerp(marpaWrapperAsfp, gladeIdi) == NULL)) {
+    goto err;
   }
 
   if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_obtainp(marpaWrapperAsfp, gladeIdi) == NULL)) {
@@ -905,14 +1117,209 @@ static inline short _marpaWrapperAsf_peakb(marpaWrapperAsf_t *marpaWrapperAsfp,
 }
 
 /****************************************************************************/
-static inline int _marpaWrapperAsf_andNodeIdAndPredecessorIdCmpi(const void *p1, const void *p2)
+static inline int _marpaWrapperAsf_evictionCandidateCmpi(const void *p1, const void *p2)
+/****************************************************************************/
+/* Most recently used first, then by glade id                               */
 /****************************************************************************/
 {
-  marpaWrapperAfsAndNodeIdAndPredecessorId_t *a1 = (marpaWrapperAfsAndNodeIdAndPredecessorId_t *) p1;
-  marpaWrapperAfsAndNodeIdAndPredecessorId_t *a2 = (marpaWrapperAfsAndNodeIdAndPredecessorId_t *) p2;
+  marpaWrapperAsfEvictionCandidate_t *a1 = (marpaWrapperAsfEvictionCandidate_t *) p1;
+  marpaWrapperAsfEvictionCandidate_t *a2 = (marpaWrapperAsfEvictionCandidate_t *) p2;
 
-  return
-    (a1->andNodePredecessorIdi < a2->andNodePredecessorIdi)
+  if (a1->lastTraversali != a2->lastTraversali) {
+    return (a1->lastTraversali > a2->lastTraversali) ? -1 : 1;
+  }
+  return (a1->gladeIdi < a2->gladeIdi) ? -1 : ((a1->gladeIdi > a2->gladeIdi) ? 1 : 0);
+}
+
+/****************************************************************************/
+static inline size_t _marpaWrapperAsf_glade_bytesl(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfGlade_t *gladep)
+/****************************************************************************/
+{
+  marpaWrapperAsfSymch_t     *symchp;
+  marpaWrapperAsfFactoring_t *factoringp;
+  size_t                      bytesl = 0;
+  int                         symchIxi;
+  int                         factoringIxi;
+
+  for (symchIxi = 0; symchIxi < gladep->nSymchi; symchIxi++) {
+    symchp  = &(marpaWrapperAsfp->symchp[gladep->firstSymchi + symchIxi]);
+    bytesl += sizeof(marpaWrapperAsfSymch_t);
+    for (factoringIxi = 0; factoringIxi < symchp->nFactoringi; factoringIxi++) {
+      factoringp = &(marpaWrapperAsfp->factoringp[symchp->firstFactoringi + factoringIxi]);
+      bytesl    += sizeof(marpaWrapperAsfFactoring_t) + ((size_t) factoringp->nFactori * sizeof(int));
+    }
+  }
+
+  return bytesl;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_evictb(marpaWrapperAsf_t *marpaWrapperAsfp)
+/****************************************************************************/
+/* Called before a traversal. When glade contents are over maxBytesl, the   */
+/* glades used the longest time ago are evicted until the contents fit in   */
+/* half of it, so that the next evictions are not at every traversal. The   */
+/* glades of the previous traversal are kept whatever their size: the next  */
+/* one is likely to use them again. There is no eviction until the contents */
+/* are twice what was kept, so copies cost O(1) per byte of contents. The   */
+/* contents of the kept glades are copied to new arrays.                    */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_evictb)
+  genericLogger_t                    *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  size_t                              maxBytesl      = marpaWrapperAsfp->marpaWrapperAsfOption.maxBytesl;
+  marpaWrapperAsfEvictionCandidate_t *candidatep     = NULL;
+  size_t                              sizeCandidatel = 0;
+  size_t                              nCandidatel    = 0;
+  marpaWrapperAsfSymch_t             *symchp         = NULL;
+  size_t                              sizeSymchl     = 0;
+  size_t                              nSymchl        = 0;
+  marpaWrapperAsfFactoring_t         *factoringp     = NULL;
+  size_t                              sizeFactoringl = 0;
+  size_t                              nFactoringl    = 0;
+  int                                *factorip       = NULL;
+  size_t                              sizeFactorl    = 0;
+  size_t                              nFactorl       = 0;
+  size_t                              bytesl;
+  size_t                              keptBytesl;
+  size_t                              candidatel;
+  size_t                              nKeptl;
+  size_t                              i;
+  marpaWrapperAsfGlade_t             *gladep;
+  marpaWrapperAsfSymch_t             *oldSymchp;
+  marpaWrapperAsfFactoring_t         *oldFactoringp;
+  int                                 firstSymchi;
+  int                                 symchIxi;
+  int                                 factoringIxi;
+
+  if ((maxBytesl <= 0) || marpaWrapperAsfp->preparedb) {
+    goto done;
+  }
+
+  bytesl = (marpaWrapperAsfp->nSymchl     * sizeof(marpaWrapperAsfSymch_t))
+    +      (marpaWrapperAsfp->nFactoringl * sizeof(marpaWrapperAsfFactoring_t))
+    +      (marpaWrapperAsfp->nFactorl    * sizeof(int));
+  if ((bytesl <= maxBytesl) || (bytesl <= (2 * marpaWrapperAsfp->keptBytesl))) {
+    goto done;
+  }
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Glade contents use %ld bytes > %ld", (long) bytesl, (long) maxBytesl);
+
+  for (i = 0; i < marpaWrapperAsfp->nGladel; i++) {
+    gladep = &(marpaWrapperAsfp->gladep[i]);
+    if ((gladep->idi < 0) || (gladep->nSymchi < 0)) {
+      continue;
+    }
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, candidatep, sizeCandidatel, nCandidatel + 1, sizeof(marpaWrapperAsfEvictionCandidate_t));
+    candidatep[nCandidatel].lastTraversali = gladep->lastTraversali;
+    candidatep[nCandidatel].gladeIdi       = gladep->idi;
+    nCandidatel++;
+  }
+  if (nCandidatel <= 0) {
+    goto done;
+  }
+  qsort(candidatep, nCandidatel, sizeof(marpaWrapperAsfEvictionCandidate_t), _marpaWrapperAsf_evictionCandidateCmpi);
+
+  /* Glades of the previous traversal are always kept. Then, once a glade does not fit, */
+  /* it and all the glades used before it are evicted.                                  */
+  keptBytesl = 0;
+  for (nKeptl = 0; nKeptl < nCandidatel; nKeptl++) {
+    bytesl = _marpaWrapperAsf_glade_bytesl(marpaWrapperAsfp, &(marpaWrapperAsfp->gladep[candidatep[nKeptl].gladeIdi]));
+    if ((candidatep[nKeptl].lastTraversali != marpaWrapperAsfp->traversali) && (keptBytesl + bytesl > (maxBytesl / 2))) {
+      break;
+    }
+    keptBytesl += bytesl;
+  }
+  marpaWrapperAsfp->keptBytesl = keptBytesl;
+  if (nKeptl >= nCandidatel) {
+    goto done;
+  }
+
+  /* Kept contents are copied to new arrays: glades are changed only when all is copied */
+  for (candidatel = 0; candidatel < nKeptl; candidatel++) {
+    gladep      = &(marpaWrapperAsfp->gladep[candidatep[candidatel].gladeIdi]);
+    firstSymchi = (int) nSymchl;
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, symchp, sizeSymchl, nSymchl + gladep->nSymchi + 1, sizeof(marpaWrapperAsfSymch_t));
+    for (symchIxi = 0; symchIxi < gladep->nSymchi; symchIxi++) {
+      oldSymchp                       = &(marpaWrapperAsfp->symchp[gladep->firstSymchi + symchIxi]);
+      symchp[nSymchl]                 = *oldSymchp;
+      symchp[nSymchl].firstFactoringi = (int) nFactoringl;
+      nSymchl++;
+      MARPAWRAPPER_MANAGEBUF(genericLoggerp, factoringp, sizeFactoringl, nFactoringl + oldSymchp->nFactoringi + 1, sizeof(marpaWrapperAsfFactoring_t));
+      for (factoringIxi = 0; factoringIxi < oldSymchp->nFactoringi; factoringIxi++) {
+        oldFactoringp = &(marpaWrapperAsfp->factoringp[oldSymchp->firstFactoringi + factoringIxi]);
+        MARPAWRAPPER_MANAGEBUF(genericLoggerp, factorip, sizeFactorl, nFactorl + oldFactoringp->nFactori + 1, sizeof(int));
+        if (oldFactoringp->nFactori > 0) {
+          memcpy(factorip + nFactorl, marpaWrapperAsfp->factorip + oldFactoringp->firstFactori, (size_t) oldFactoringp->nFactori * sizeof(int));
+        }
+        factoringp[nFactoringl].firstFactori = (int) nFactorl;
+        factoringp[nFactoringl].nFactori     = oldFactoringp->nFactori;
+        factoringp[nFactoringl].deadb        = oldFactoringp->deadb;
+        nFactoringl++;
+        nFactorl += oldFactoringp->nFactori;
+      }
+    }
+    candidatep[candidatel].firstSymchi = firstSymchi;
+  }
+
+  for (candidatel = 0; candidatel < nCandidatel; candidatel++) {
+    gladep = &(marpaWrapperAsfp->gladep[candidatep[candidatel].gladeIdi]);
+    if (candidatel < nKeptl) {
+      gladep->firstSymchi    = candidatep[candidatel].firstSymchi;
+    } else {
+      gladep->firstSymchi    = 0;
+      gladep->nSymchi        = -1;
+      gladep->lastTraversali = -1;
+      marpaWrapperAsfp->nEvictionl++;
+    }
+  }
+
+  MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->symchp);
+  MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->factoringp);
+  MARPAWRAPPER_FREEBUF(marpaWrapperAsfp->factorip);
+  marpaWrapperAsfp->symchp         = symchp;
+  marpaWrapperAsfp->sizeSymchl     = sizeSymchl;
+  marpaWrapperAsfp->nSymchl        = nSymchl;
+  marpaWrapperAsfp->factoringp     = factoringp;
+  marpaWrapperAsfp->sizeFactoringl = sizeFactoringl;
+  marpaWrapperAsfp->nFactoringl    = nFactoringl;
+  marpaWrapperAsfp->factorip       = factorip;
+  marpaWrapperAsfp->sizeFactorl    = sizeFactorl;
+  marpaWrapperAsfp->nFactorl       = nFactorl;
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Glade contents use %ld bytes after eviction", (long) keptBytesl);
+
+ done:
+  MARPAWRAPPER_FREEBUF(candidatep);
+  /* Stamp of the coming traversal */
+  if (marpaWrapperAsfp->traversali == INT_MAX) {
+    for (i = 0; i < marpaWrapperAsfp->nGladel; i++) {
+      if (marpaWrapperAsfp->gladep[i].lastTraversali > 0) {
+        marpaWrapperAsfp->gladep[i].lastTraversali = 0;
+      }
+    }
+    marpaWrapperAsfp->traversali = 0;
+  }
+  marpaWrapperAsfp->traversali++;
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_FREEBUF(candidatep);
+  MARPAWRAPPER_FREEBUF(symchp);
+  MARPAWRAPPER_FREEBUF(factoringp);
+  MARPAWRAPPER_FREEBUF(factorip);
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline int _marpaWrapperAsf_andNodeIdAndPredecessorIdCmpi(const void *p1, const void *p2)
+/****************************************************************************/
+{
+  marpaWrapperAfsAndNodeIdAndPredecessorId_t *a1 = (marpaWrapperAfsAndNodeIdAndPredecessorId_t *) p1;
+  marpaWrapperAfsAndNodeIdAndPredecessorId_t *a2 = (marpaWrapperAfsAndNodeIdAndPredecessorId_t *) p2;
+
+  return
+    (a1->andNodePredecessorIdi < a2->andNodePredecessorIdi)
     ?
     -1
     :
@@ -939,19 +1346,24 @@ static inline int _marpaWrapperAsf_andNodeIdAndPredecessorIdCmpi(const void *p1,
 }
 
 /****************************************************************************/
-static inline short _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAsfp, int *intsetIdip, int counti, int *idip)
+static inline short _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAsfp, int *intsetIdip, size_t *offsetlp, int counti, int *idip)
+/****************************************************************************/
+/* Ids are left sorted in marpaWrapperAsfp->intsetidp[1..counti]            */
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_intsetIdb)
-  genericLogger_t         *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericHash_t           *intsetHashp    = marpaWrapperAsfp->intsetHashp;
-  int                      intsetcounti   = counti + 1;
-  short                    findResultb;
-  int                      intsetIdi;
-  int                     *intsetidp;
-  int                      indicei;
-  int                      idi0i;
-  int                      idi1i;
+  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfIntsetTable_t *intsetTablep   = &(marpaWrapperAsfp->intsetTable);
+  int                           intsetcounti   = counti + 1;
+  marpaWrapperAsfIntsetSlot_t  *slotp;
+  uint64_t                      hashull;
+  size_t                        maskl;
+  size_t                        indicel;
+  size_t                        probel;
+  int                           intsetIdi;
+  int                          *intsetidp;
+  int                           idi0i;
+  int                           idi1i;
 
   /* This method is responsible of memoization and is called very often */
   if (intsetcounti > marpaWrapperAsfp->intsetcounti) {
@@ -993,8 +1405,11 @@ static inline short _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAs
       }
       break;
     default:
-      memcpy(++intsetidp, idip, sizeof(int) * counti);
-      qsort(intsetidp--, (size_t) counti, sizeof(int), _marpaWrapperAsf_idCmpi);
+      memcpy(intsetidp + 1, idip, sizeof(int) * counti);
+      if (counti > MARPAWRAPPERSORT_RADIX_MIN) {
+        MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->sortScratchp, marpaWrapperAsfp->sortScratchl, (size_t) counti * sizeof(int), 1);
+      }
+      _marpaWrapperSort_intv(intsetidp + 1, (int *) marpaWrapperAsfp->sortScratchp, (size_t) counti);
       break;
     }
   }
@@ -1010,39 +1425,58 @@ static inline short _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAs
     }
   }
 #endif
-  /* If we are going to insert, we want to precompute indice instead of letting */
-  /* the hash macros doing it for the find(), and then for the set().           */
-  indicei = _marpaWrapperAsf_intset_keyIndFunctioni((void *) marpaWrapperAsfp, GENERICSTACKITEMTYPE_PTR, (void **) &intsetidp);
-  GENERICHASH_FIND_BY_IND(intsetHashp,
-			  marpaWrapperAsfp,
-			  PTR,
-			  intsetidp,
-			  INT,
-			  &intsetIdi,
-			  findResultb,
-			  indicei);
-  if (MARPAWRAPPER_UNLIKELY(GENERICHASH_ERROR(intsetHashp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "intset hash find failure: %s", strerror(errno));
-    goto err;
-  }
-  if (! findResultb) {
-    intsetIdi = marpaWrapperAsfp->nextIntseti++;
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Creating next intset id %d at hash row indice %d", intsetIdi, indicei);
-    GENERICHASH_SET_BY_IND(intsetHashp,
-			   marpaWrapperAsfp,
-			   PTR,
-			   intsetidp,
-			   INT,
-			   intsetIdi,
-			   indicei);
-    if (MARPAWRAPPER_UNLIKELY(GENERICHASH_ERROR(intsetHashp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "intset hash set failure: %s", strerror(errno));
+  /* Make sure there is a free slot before probing */
+  if (MARPAWRAPPER_UNLIKELY(((intsetTablep->usedl + 1) * 2) > intsetTablep->sizel)) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_intset_growb(marpaWrapperAsfp))) {
       goto err;
     }
+  }
+
+  hashull = _marpaWrapperAsf_intset_hashull(counti, intsetidp + 1);
+  maskl   = intsetTablep->sizel - 1;
+  indicel = (size_t) hashull & maskl;
+  probel  = 0;
+  while (1) {
+    slotp = &(intsetTablep->slotp[indicel]);
+    if (slotp->intsetIdi < 0) {
+      break;
+    }
+    if ((slotp->hashull == hashull) && (slotp->counti == counti)) {
+      if ((counti <= 0) || (memcmp(intsetTablep->slabip + slotp->offsetl, intsetidp + 1, (size_t) counti * sizeof(int)) == 0)) {
+        break;
+      }
+      intsetTablep->nCollisionl++;
+    }
+    indicel = (indicel + 1) & maskl;
+    probel++;
+  }
+  intsetTablep->nLookupl++;
+  intsetTablep->nProbel += probel;
+  if (probel > intsetTablep->maxProbel) {
+    intsetTablep->maxProbel = probel;
+  }
+
+  if (slotp->intsetIdi < 0) {
+    intsetIdi = marpaWrapperAsfp->nextIntseti++;
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Creating next intset id %d at slot %ld", intsetIdi, (unsigned long) indicel);
+    if (counti > 0) {
+      MARPAWRAPPER_MANAGEBUF(genericLoggerp, intsetTablep->slabip, intsetTablep->sizeSlabl, intsetTablep->nSlabl + (size_t) counti, sizeof(int));
+      memcpy(intsetTablep->slabip + intsetTablep->nSlabl, intsetidp + 1, (size_t) counti * sizeof(int));
+    }
+    slotp->hashull   = hashull;
+    slotp->intsetIdi = intsetIdi;
+    slotp->counti    = counti;
+    slotp->offsetl   = intsetTablep->nSlabl;
+    intsetTablep->nSlabl += (counti > 0) ? (size_t) counti : 0;
+    intsetTablep->usedl++;
   } else {
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Found intset id %d at hash row %d", intsetIdi, indicei);
+    intsetIdi = slotp->intsetIdi;
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Found intset id %d at slot %ld", intsetIdi, (unsigned long) indicel);
   }
 
+  if (offsetlp != NULL) {
+    *offsetlp = slotp->offsetl;
+  }
   *intsetIdip = intsetIdi;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1, *intsetIdip=%d", *intsetIdip);
@@ -1054,13 +1488,21 @@ static inline short _marpaWrapperAsf_intsetIdb(marpaWrapperAsf_t *marpaWrapperAs
 }
 
 /****************************************************************************/
-static inline int _marpaWrapperAsf_idCmpi(const void *p1, const void *p2)
+static inline marpaWrapperAsfIdset_t *_marpaWrapperAsf_idset_findp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfIdsete_t idsete, int intsetIdi)
+/****************************************************************************/
+/* Returns NULL if this intset id is not an idset of this kind.             */
 /****************************************************************************/
 {
-  int i1 = * ((int *) p1);
-  int i2 = * ((int *) p2);
+  marpaWrapperAsfIdsetVector_t *idsetVectorp = &(marpaWrapperAsfp->idsetVectors[idsete]);
+  size_t                        blockl       = ((size_t) intsetIdi) >> MARPAWRAPPERASF_IDSET_BLOCK_SHIFT;
+  marpaWrapperAsfIdset_t       *idsetp;
 
-  return (i1 < i2) ? -1 : ((i1 > i2) ? 1 : 0);
+  if ((intsetIdi < 0) || (blockl >= idsetVectorp->nBlockl)) {
+    return NULL;
+  }
+  idsetp = &(idsetVectorp->blockpp[blockl][intsetIdi & MARPAWRAPPERASF_IDSET_BLOCK_MASK]);
+
+  return (idsetp->counti >= 0) ? idsetp : NULL;
 }
 
 /****************************************************************************/
@@ -1068,58 +1510,49 @@ static inline marpaWrapperAsfIdset_t *_marpaWrapperAsf_idset_obtainp(marpaWrappe
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_idset_obtainp)
-  genericLogger_t         *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericSparseArray_t    *sparseArrayp   = (idsete == MARPAWRAPPERASFIDSET_NIDSET) ? marpaWrapperAsfp->nidsetSparseArrayp : marpaWrapperAsfp->powersetSparseArrayp;
-  char                    *idsets         = marpaWrapperAsfIdsets[idsete];
-  marpaWrapperAsfIdset_t  *idsetp         = NULL;
-  int                      intsetIdi;
-  short                    findResult;
-
-  if (_marpaWrapperAsf_intsetIdb(marpaWrapperAsfp, &intsetIdi, counti, idip) == 0) {
-    goto done;
+  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfIdsetVector_t *idsetVectorp   = &(marpaWrapperAsfp->idsetVectors[idsete]);
+  marpaWrapperAsfIdset_t       *idsetp         = NULL;
+  marpaWrapperAsfIdset_t       *blockp;
+  size_t                        blockl;
+  int                           intsetIdi;
+  size_t                        offsetl;
+  int                           i;
+
+  if (_marpaWrapperAsf_intsetIdb(marpaWrapperAsfp, &intsetIdi, &offsetl, counti, idip) == 0) {
+    goto err;
   }
 
-  GENERICSPARSEARRAY_FIND(sparseArrayp, marpaWrapperAsfp, intsetIdi, PTR, &idsetp, findResult);
-  if (GENERICSPARSEARRAY_ERROR(sparseArrayp)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "%s, sparse array find failure: %s", idsets, strerror(errno));
-    goto done;
-  }
-  if (! findResult) {
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: indice %d not yet generated", idsets, intsetIdi);
-    idsetp = (marpaWrapperAsfIdset_t *) malloc(sizeof(marpaWrapperAsfIdset_t));
-    if (idsetp == NULL) {
+  /* Intset ids are dense: blocks are created up to the one of this id */
+  blockl = ((size_t) intsetIdi) >> MARPAWRAPPERASF_IDSET_BLOCK_SHIFT;
+  while (idsetVectorp->nBlockl <= blockl) {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, idsetVectorp->blockpp, idsetVectorp->sizeBlockl, idsetVectorp->nBlockl + 1, sizeof(marpaWrapperAsfIdset_t *));
+    blockp = (marpaWrapperAsfIdset_t *) malloc(MARPAWRAPPERASF_IDSET_BLOCK_SIZE * sizeof(marpaWrapperAsfIdset_t));
+    if (MARPAWRAPPER_UNLIKELY(blockp == NULL)) {
       MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-      goto done;
+      goto err;
     }
-    idsetp->idi = intsetIdi;
-    idsetp->counti = counti;
-    if (counti <= 0) {
-      idsetp->idip = NULL;
-    } else {
-      if ((idsetp->idip = (int *) malloc(sizeof(int) * counti)) == NULL) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-	free(idsetp);
-	idsetp = NULL;
-	goto done;
-      }
-      memcpy(idsetp->idip, idip, (size_t) (counti * sizeof(int)));
-      qsort(idsetp->idip, (size_t) counti, sizeof(int), _marpaWrapperAsf_idCmpi);
-    }
-    GENERICSPARSEARRAY_SET(sparseArrayp, marpaWrapperAsfp, intsetIdi, PTR, idsetp);
-    if (GENERICSPARSEARRAY_ERROR(sparseArrayp)) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "%s sparse array set failure: %s", idsets, strerror(errno));
-      if (idsetp->idip != NULL) {
-	free(idsetp->idip);
-      }
-      free(idsetp);
-      idsetp = NULL;
-      goto done;
+    for (i = 0; i < MARPAWRAPPERASF_IDSET_BLOCK_SIZE; i++) {
+      blockp[i].counti = -1;
     }
+    idsetVectorp->blockpp[idsetVectorp->nBlockl++] = blockp;
   }
 
- done:
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return %p", idsets, idsetp);
+  idsetp = &(idsetVectorp->blockpp[blockl][intsetIdi & MARPAWRAPPERASF_IDSET_BLOCK_MASK]);
+  if (idsetp->counti < 0) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: indice %d not yet generated", marpaWrapperAsfIdsets[idsete], intsetIdi);
+    /* The sorted ids are already in the intset slab */
+    idsetp->idi     = intsetIdi;
+    idsetp->offsetl = offsetl;
+    idsetp->counti  = (counti > 0) ? counti : 0;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return %p", marpaWrapperAsfIdsets[idsete], idsetp);
   return idsetp;
+
+ err:
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return NULL", marpaWrapperAsfIdsets[idsete]);
+  return NULL;
 }
 
 /****************************************************************************/
@@ -1131,8 +1564,10 @@ static inline int *_marpaWrapperAsf_idset_idip(marpaWrapperAsf_t *marpaWrapperAs
   genericLogger_t         *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
 #endif
 
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return %p", marpaWrapperAsfIdsets[idsete], idsetp->idip);
-  return idsetp->idip;
+  int                     *idip = (idsetp->counti > 0) ? (marpaWrapperAsfp->intsetTable.slabip + idsetp->offsetl) : NULL;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return %p", marpaWrapperAsfIdsets[idsete], idip);
+  return idip;
 }
 
 /****************************************************************************/
@@ -1147,7 +1582,7 @@ static inline short _marpaWrapperAsf_idset_idi_by_ixib(marpaWrapperAsf_t *marpaW
     goto err;
   }
 
-  *idip = idsetp->idip[ixi];
+  *idip = marpaWrapperAsfp->intsetTable.slabip[idsetp->offsetl + ixi];
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s: return 1, *idip=%d", marpaWrapperAsfIdsets[idsete], *idip);
   return 1;
@@ -1189,30 +1624,22 @@ static inline void _marpaWrapperAsf_idset_freev(marpaWrapperAsf_t *marpaWrapperA
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_idset_freev)
-  genericSparseArray_t   **sparseArraypp  = (idsete == MARPAWRAPPERASFIDSET_NIDSET) ? &(marpaWrapperAsfp->nidsetSparseArrayp) : &(marpaWrapperAsfp->powersetSparseArrayp);
-  genericSparseArray_t    *sparseArrayp;
+  marpaWrapperAsfIdsetVector_t *idsetVectorp = &(marpaWrapperAsfp->idsetVectors[idsete]);
 
-  if (*sparseArraypp != NULL) {
-    sparseArrayp = *sparseArraypp;
-    GENERICSPARSEARRAY_FREE(sparseArrayp, marpaWrapperAsfp);
-    *sparseArraypp = NULL;
+  if (idsetVectorp->blockpp != NULL) {
+    while (idsetVectorp->nBlockl > 0) {
+      free(idsetVectorp->blockpp[--idsetVectorp->nBlockl]);
+    }
+    MARPAWRAPPER_FREEBUF(idsetVectorp->blockpp);
   }
+  idsetVectorp->sizeBlockl = 0;
 }
 
 /****************************************************************************/
-int _marpaWrapperAsf_nidset_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp)
-/****************************************************************************/
-{
-  return _marpaWrapperAsf_djb2_s((unsigned char *) pp, sizeof(int)) % MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE;
-  /* We know what we are doing, i.e. that *pp is a positive int */
-  /* return (* ((int *) pp)) % MARPAWRAPPERASF_NIDSETSPARSEARRAY_SIZE; */
-}
-
-/****************************************************************************/
-void _marpaWrapperAsf_nidset_sparseArrayFreev(void *userDatavp, void **pp)
+static inline marpaWrapperAsfNidset_t *_marpaWrapperAsf_nidset_findp(marpaWrapperAsf_t *marpaWrapperAsfp, int intsetIdi)
 /****************************************************************************/
 {
-  _marpaWrapperAsf_idset_sparseArrayFreev(userDatavp, pp);
+  return _marpaWrapperAsf_idset_findp(marpaWrapperAsfp, MARPAWRAPPERASFIDSET_NIDSET, intsetIdi);
 }
 
 /****************************************************************************/
@@ -1257,22 +1684,6 @@ static inline void _marpaWrapperAsf_nidset_freev(marpaWrapperAsf_t *marpaWrapper
   _marpaWrapperAsf_idset_freev(marpaWrapperAsfp, MARPAWRAPPERASFIDSET_NIDSET);
 }
 
-/****************************************************************************/
-int _marpaWrapperAsf_powerset_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp)
-/****************************************************************************/
-{
-  return _marpaWrapperAsf_djb2_s((unsigned char *) pp, sizeof(int)) % MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE;
-  /* We know what we are doing, i.e. that *pp is a positive int */
-  /* return (* ((int *) pp)) % MARPAWRAPPERASF_POWERSETSPARSEARRAY_SIZE; */
-}
-
-/****************************************************************************/
-void _marpaWrapperAsf_powerset_sparseArrayFreev(void *userDatavp, void **pp)
-/****************************************************************************/
-{
-  _marpaWrapperAsf_idset_sparseArrayFreev(userDatavp, pp);
-}
-
 /****************************************************************************/
 static inline marpaWrapperAsfPowerset_t *_marpaWrapperAsf_powerset_obtainp(marpaWrapperAsf_t *marpaWrapperAsfp, int counti, int *idip)
 /****************************************************************************/
@@ -1316,16 +1727,9 @@ static inline void _marpaWrapperAsf_powerset_freev(marpaWrapperAsf_t *marpaWrapp
 }
 
 /****************************************************************************/
-int _marpaWrapperAsf_orNodeInUse_sparseArrayIndi(void *userDatavp, genericStackItemType_t itemType, void **pp)
+static inline marpaWrapperAsfNook_t *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp, int orNodeIdi, int parentOrNodeIdi)
 /****************************************************************************/
-{
-  return _marpaWrapperAsf_djb2_s((unsigned char *) pp, sizeof(int)) % MARPAWRAPPERASF_ORNODEINUSESPARSEARRAY_SIZE;
-  /* We know what we are doing, i.e. that *pp is a positive int */
-  /* return (* ((int *) pp)) % MARPAWRAPPERASF_ORNODEINUSESPARSEARRAY_SIZE; */
-}
-
-/****************************************************************************/
-static inline marpaWrapperAsfNook_t *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_t *marpaWrapperAsfp, int orNodeIdi, int parentOrNodeIdi)
+/* Pushes a new nook on the factoring stack of the choicepoint.              */
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_nook_newp)
@@ -1333,11 +1737,8 @@ static inline marpaWrapperAsfNook_t *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_
   marpaWrapperAsfNook_t   *nookp;
   short                    haveLastChoiceb;
 
-  nookp = (marpaWrapperAsfNook_t *) malloc(sizeof(marpaWrapperAsfNook_t));
-  if (MARPAWRAPPER_UNLIKELY(nookp == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-    goto err;
-  }
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, choicepointp->nookp, choicepointp->sizeNookl, (size_t) (choicepointp->nNooki + 1), sizeof(marpaWrapperAsfNook_t));
+  nookp = &(choicepointp->nookp[choicepointp->nNooki]);
 
   nookp->orNodeIdi              = orNodeIdi;
   nookp->firstChoicei           = 0;
@@ -1351,6 +1752,7 @@ static inline marpaWrapperAsfNook_t *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_
   if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_setLastChoiceb(marpaWrapperAsfp, &haveLastChoiceb, nookp) == 0)) {
     goto err;
   }
+  choicepointp->nNooki++;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Created nook {OR_NODE=%d, PARENT=%d, FIRST_CHOICE=%d, LAST_CHOICE=%d}", nookp->orNodeIdi, nookp->parentOrNodeIdi, nookp->firstChoicei, nookp->lastChoicei);
 
@@ -1358,9 +1760,6 @@ static inline marpaWrapperAsfNook_t *_marpaWrapperAsf_nook_newp(marpaWrapperAsf_
   return nookp;
 
  err:
-  if (nookp != NULL) {
-    free(nookp);
-  }
   MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
   return NULL;
 }
@@ -1489,28 +1888,21 @@ static inline short _marpaWrapperAsf_symch_factoring_countb(marpaWrapperAsf_t *m
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_symch_factoring_countb)
+#ifndef MARPAWRAPPER_NTRACE
   genericLogger_t         *genericLoggerp     = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
   marpaWrapperAsfGlade_t  *gladep;
-  genericStack_t          *symchesStackp;
-  genericStack_t          *factoringsStackp;
+  marpaWrapperAsfSymch_t  *symchp;
 
   gladep = _marpaWrapperAsf_glade_obtainp(marpaWrapperAsfp, gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
     goto err;
   }
-  symchesStackp = gladep->symchesStackp;
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(symchesStackp, symchIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "No symch at indice %d", symchIxi);
-    goto err;
-  }
-  factoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(symchesStackp,  symchIxi);
-  if (MARPAWRAPPER_UNLIKELY(factoringsStackp == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Null factorings stack at symch indice %d", symchIxi);
+  symchp = _marpaWrapperAsf_glade_symchp(marpaWrapperAsfp, gladep, symchIxi);
+  if (MARPAWRAPPER_UNLIKELY(symchp == NULL)) {
     goto err;
   }
-  /* factoringsStackp is (symchRuleIdi, PTR, stack of gladeIdi) */
-  /* This is length - 2 */
-  *factoringCountip = GENERICSTACK_USED(factoringsStackp) - 2;
+  *factoringCountip = symchp->nFactoringi;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1, *factoringCountip=%d", *factoringCountip);
   return 1;
@@ -1576,13 +1968,68 @@ static inline int _marpaWrapperAsf_nid_to_and_nodei(int idi)
 }
 
 /****************************************************************************/
-static inline int _marpaWrapperAsf_sourceDataCmpi(const void *p1, const void *p2)
+static inline short _marpaWrapperAsf_sourceData_sortb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfSourceData_t *sourceDatap, int nSourceDatai)
+/****************************************************************************/
+/* Stable sort on sortIxi: insertion sort, or LSD radix sort on large sets. */
 /****************************************************************************/
 {
-  marpaWrapperAsfSourceData_t *d1 = (marpaWrapperAsfSourceData_t *) p1;
-  marpaWrapperAsfSourceData_t *d2 = (marpaWrapperAsfSourceData_t *) p2;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_sourceData_sortb)
+  genericLogger_t             *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  size_t                       nl             = (size_t) nSourceDatai;
+  size_t                       countl[256];
+  marpaWrapperAsfSourceData_t *fromp;
+  marpaWrapperAsfSourceData_t *top;
+  marpaWrapperAsfSourceData_t *tmpp;
+  marpaWrapperAsfSourceData_t  sourceData;
+  unsigned int                 shifti;
+  size_t                       i;
+  size_t                       j;
+  size_t                       suml;
+  size_t                       cl;
+
+  if (nl <= MARPAWRAPPERSORT_RADIX_MIN) {
+    for (i = 1; i < nl; i++) {
+      sourceData = sourceDatap[i];
+      for (j = i; (j > 0) && (sourceDatap[j - 1].sortIxi > sourceData.sortIxi); j--) {
+        sourceDatap[j] = sourceDatap[j - 1];
+      }
+      sourceDatap[j] = sourceData;
+    }
+  } else {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->sortScratchp, marpaWrapperAsfp->sortScratchl, nl * sizeof(marpaWrapperAsfSourceData_t), 1);
+    fromp = sourceDatap;
+    top   = (marpaWrapperAsfSourceData_t *) marpaWrapperAsfp->sortScratchp;
+    for (shifti = 0; shifti < (sizeof(int) * CHAR_BIT); shifti += 8) {
+      memset(countl, 0, sizeof(countl));
+      for (i = 0; i < nl; i++) {
+        countl[(MARPAWRAPPERSORT_RADIX_KEY(fromp[i].sortIxi) >> shifti) & 0xFF]++;
+      }
+      if (countl[(MARPAWRAPPERSORT_RADIX_KEY(fromp[0].sortIxi) >> shifti) & 0xFF] == nl) {
+        continue;
+      }
+      for (i = 0, suml = 0; i < 256; i++) {
+        cl        = countl[i];
+        countl[i] = suml;
+        suml     += cl;
+      }
+      for (i = 0; i < nl; i++) {
+        top[countl[(MARPAWRAPPERSORT_RADIX_KEY(fromp[i].sortIxi) >> shifti) & 0xFF]++] = fromp[i];
+      }
+      tmpp  = fromp;
+      fromp = top;
+      top   = tmpp;
+    }
+    if (fromp != sourceDatap) {
+      memcpy(sourceDatap, fromp, nl * sizeof(marpaWrapperAsfSourceData_t));
+    }
+  }
 
-  return (d1->sortIxi < d2->sortIxi) ? -1 : ((d1->sortIxi > d2->sortIxi) ? 1 : 0);
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
 }
 
 /****************************************************************************/
@@ -1758,10 +2205,10 @@ static inline marpaWrapperAsfNidset_t *_marpaWrapperAsf_powerset_nidsetp(marpaWr
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_powerset_nidsetp)
+#ifndef MARPAWRAPPER_NTRACE
   genericLogger_t         *genericLoggerp     = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericSparseArray_t    *nidsetSparseArrayp = marpaWrapperAsfp->nidsetSparseArrayp;
+#endif
   marpaWrapperAsfNidset_t *nidsetp;
-  short                    findResult         = 0;
   int                      counti;
   int                      idi;
 
@@ -1770,14 +2217,7 @@ static inline marpaWrapperAsfNidset_t *_marpaWrapperAsf_powerset_nidsetp(marpaWr
     if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_powerset_idi_by_ixib(marpaWrapperAsfp, powersetp, ixi, &idi) == 0)) {
       goto err;
     }
-    GENERICSPARSEARRAY_FIND(nidsetSparseArrayp, marpaWrapperAsfp, idi, PTR, &nidsetp, findResult);
-    if (! findResult) {
-      nidsetp = NULL;
-    }
-    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(nidsetSparseArrayp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "nidset sparse array find failure: %s", strerror(errno));
-      goto err;
-    }
+    nidsetp = _marpaWrapperAsf_nidset_findp(marpaWrapperAsfp, idi);
   } else {
     nidsetp = NULL;
   }
@@ -1793,68 +2233,63 @@ static inline marpaWrapperAsfNidset_t *_marpaWrapperAsf_powerset_nidsetp(marpaWr
 /****************************************************************************/
 static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrapperAsf_t *marpaWrapperAsfp, int gladei)
 /****************************************************************************/
+/* Not reentrant: scratch areas and the choicepoint belong to the ASF.      */
+/****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_obtainp)
-  genericLogger_t             *genericLoggerp         = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericStack_t              *gladeStackp            = marpaWrapperAsfp->gladeStackp;
-  genericSparseArray_t        *nidsetSparseArrayp     = marpaWrapperAsfp->nidsetSparseArrayp;
-  genericStack_t              *gladeObtainTmpStackp   = marpaWrapperAsfp->gladeObtainTmpStackp;
-  marpaWrapperAsfSourceData_t *sourceDatap            = NULL;
-  int                          nidWithCurrentSortIxii = 0;
-  int                         *nidWithCurrentSortIxip = NULL;
-  int                          symchIdii              = 0;
-  int                         *symchIdip              = NULL;
-  short                        thisNidEndb            = 0;
-  int                         *symbolip               = NULL;
-  genericStack_t              *gotFactoringStackp     = NULL;
-  genericStack_t              *symchesStackp          = NULL;
-  genericStack_t              *factoringsStackp       = NULL;
-  marpaWrapperAsfChoicePoint_t *choicepointp = NULL;
-  int                          nSourceDatai;
-  marpaWrapperAsfGlade_t      *gladep;
-  marpaWrapperAsfNidset_t     *baseNidsetp;
-  marpaWrapperAsfPowerset_t   *choicepointPowersetp;
-  int                          sourceNidi;
-  int                          nidIxi;
-  int                          ixi;
-  int                          sortIxOfThisNidi;
-  int                          thisNidi;
-  int                          currentSortIxi;
-  marpaWrapperAsfNidset_t     *nidsetForSortIxp;
-  int                          symchCounti;
-  int                          symchIxi;
-  int                          choicepointNidi;
-  int                          symchRuleIdi;
-  short                        findResult;
+  genericLogger_t              *genericLoggerp         = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  genericStack_t               *gladeObtainTmpStackp   = marpaWrapperAsfp->gladeObtainTmpStackp;
+  marpaWrapperAsfChoicePoint_t *choicepointp           = &(marpaWrapperAsfp->choicepoint);
+  size_t                        nSymchl                = marpaWrapperAsfp->nSymchl;
+  size_t                        nFactoringl            = marpaWrapperAsfp->nFactoringl;
+  size_t                        nFactorl               = marpaWrapperAsfp->nFactorl;
+  marpaWrapperAsfSourceData_t  *sourceDatap;
+  int                           nidWithCurrentSortIxii = 0;
+  int                          *nidWithCurrentSortIxip;
+  int                           symchIdii              = 0;
+  int                          *symchIdip;
+  short                         thisNidEndb            = 0;
+  genericStack_t               *gotFactoringStackp     = NULL;
+  int                           nSourceDatai;
+  marpaWrapperAsfGlade_t       *gladep;
+  marpaWrapperAsfNidset_t      *baseNidsetp;
+  marpaWrapperAsfPowerset_t    *choicepointPowersetp;
+  int                           sourceNidi;
+  int                           nidIxi;
+  int                           ixi;
+  int                           sortIxOfThisNidi;
+  int                           thisNidi;
+  int                           currentSortIxi;
+  marpaWrapperAsfNidset_t      *nidsetForSortIxp;
+  int                           symchCounti;
+  int                           symchIxi;
+  int                           firstSymchi;
+  marpaWrapperAsfSymch_t       *symchp;
+  int                          *factorip;
+  int                           choicepointNidi;
+  int                           symchRuleIdi;
 
 #if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-  if (MARPAWRAPPER_UNLIKELY((! GENERICSTACK_IS_PTR(gladeStackp, gladei))
-                            || ((gladep = (marpaWrapperAsfGlade_t *) GENERICSTACK_GET_PTR(gladeStackp, gladei)) == NULL)
+  if (MARPAWRAPPER_UNLIKELY(((gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladei)) == NULL)
                             || (gladep->registeredb == 0)
                             )) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "Attempt to use an invalid glade, one whose ID is %d", gladei);
     goto err;
   }
 #else
-  if (MARPAWRAPPER_UNLIKELY((! GENERICSTACK_IS_PTR(gladeStackp, gladei))
-                            || ((gladep = (marpaWrapperAsfGlade_t *) GENERICSTACK_GET_PTR(gladeStackp, gladei)) == NULL)
-                            )) {
+  if (MARPAWRAPPER_UNLIKELY((gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladei)) == NULL)) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "Attempt to use an invalid glade, one whose ID is %d", gladei);
     goto err;
   }
 #endif
 
   /* Return the glade if it is already set up */
-  if (gladep->symchesStackp != NULL) {
+  if (gladep->nSymchi >= 0) {
     goto done;
   }
 
-  GENERICSPARSEARRAY_FIND(nidsetSparseArrayp, marpaWrapperAsfp, gladei, PTR, &baseNidsetp, findResult);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(nidsetSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "nidset sparse array find failure: %s", strerror(errno));
-    goto err;
-  }
-  if (MARPAWRAPPER_UNLIKELY(! findResult)) {
+  baseNidsetp = _marpaWrapperAsf_nidset_findp(marpaWrapperAsfp, gladei);
+  if (MARPAWRAPPER_UNLIKELY(baseNidsetp == NULL)) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "No nidset at glade id %d", gladei);
     goto err;
   }
@@ -1863,21 +2298,24 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
     MARPAWRAPPER_ERROR(genericLoggerp, "No nidset");
     goto err;
   }
-  sourceDatap = (marpaWrapperAsfSourceData_t *) malloc((size_t) (nSourceDatai * sizeof(marpaWrapperAsfSourceData_t)));
-  if (MARPAWRAPPER_UNLIKELY(sourceDatap == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-    goto err;
-  }
+  /* There are at most nSourceDatai nids per sort indice, and at most nSourceDatai symches */
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->sourceDatap, marpaWrapperAsfp->sizeSourceDatal, nSourceDatai, sizeof(marpaWrapperAsfSourceData_t));
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->nidWithCurrentSortIxip, marpaWrapperAsfp->sizeNidWithCurrentSortIxil, nSourceDatai, sizeof(int));
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->symchIdip, marpaWrapperAsfp->sizeSymchIdil, nSourceDatai, sizeof(int));
+  sourceDatap            = marpaWrapperAsfp->sourceDatap;
+  nidWithCurrentSortIxip = marpaWrapperAsfp->nidWithCurrentSortIxip;
+  symchIdip              = marpaWrapperAsfp->symchIdip;
+
   for (ixi = 0; ixi < nSourceDatai; ixi++) {
     if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_nidset_idi_by_ixib(marpaWrapperAsfp, baseNidsetp, ixi, &sourceNidi) == 0)) {
       goto err;
     }
-    sourceDatap[ixi].sortIxi = _marpaWrapperAsf_nidset_sort_ixi(marpaWrapperAsfp, sourceNidi);
-    if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_nidset_idi_by_ixib(marpaWrapperAsfp, baseNidsetp, ixi, &(sourceDatap[ixi].sourceNidi)) == 0)) {
-      goto err;
-    }
+    sourceDatap[ixi].sortIxi    = _marpaWrapperAsf_nidset_sort_ixi(marpaWrapperAsfp, sourceNidi);
+    sourceDatap[ixi].sourceNidi = sourceNidi;
+  }
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_sourceData_sortb(marpaWrapperAsfp, sourceDatap, nSourceDatai))) {
+    goto err;
   }
-  qsort(sourceDatap, (size_t) nSourceDatai, sizeof(marpaWrapperAsfSourceData_t), _marpaWrapperAsf_sourceDataCmpi);
 
   sortIxOfThisNidi = sourceDatap[0].sortIxi;
   thisNidi         = sourceDatap[0].sourceNidi;
@@ -1890,24 +2328,7 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
       if (MARPAWRAPPER_UNLIKELY(nidsetForSortIxp == NULL)) {
 	goto err;
       }
-      /* Create or extend symchIdip */
-      if (symchIdip == NULL) {
-	symchIdip = (int *) malloc(sizeof(int));
-	if (MARPAWRAPPER_UNLIKELY(symchIdip == NULL)) {
-	  MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-	  goto err;
-	}
-      } else {
-	int *tmpip = (int *) realloc(symchIdip, (size_t) ((symchIdii + 1) * sizeof(int)));
-	if (MARPAWRAPPER_UNLIKELY(tmpip == NULL)) {
-	  MARPAWRAPPER_ERRORF(genericLoggerp, "realloc failure: %s", strerror(errno));
-	  goto err;
-	}
-	symchIdip = tmpip;
-      }
       symchIdip[symchIdii++] = _marpaWrapperAsf_nidset_idi(marpaWrapperAsfp, nidsetForSortIxp);
-      free(nidWithCurrentSortIxip);
-      nidWithCurrentSortIxip = NULL;
       nidWithCurrentSortIxii = 0;
 
       currentSortIxi = sortIxOfThisNidi;
@@ -1915,21 +2336,6 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
     if (thisNidEndb != 0) {
       break;
     }
-    /* Create or extend nidWithCurrentSortIxip */
-    if (nidWithCurrentSortIxip == NULL) {
-      nidWithCurrentSortIxip = (int *) malloc(sizeof(int));
-      if (MARPAWRAPPER_UNLIKELY(nidWithCurrentSortIxip == NULL)) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-	goto err;
-      }
-    } else {
-      int *tmpip = (int *) realloc(nidWithCurrentSortIxip, (size_t) ((nidWithCurrentSortIxii + 1) * sizeof(int)));
-      if (MARPAWRAPPER_UNLIKELY(tmpip == NULL)) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "realloc failure: %s", strerror(errno));
-	goto err;
-      }
-      nidWithCurrentSortIxip = tmpip;
-    }
     nidWithCurrentSortIxip[nidWithCurrentSortIxii++] = thisNidi;
     if (nidIxi < nSourceDatai) {
       sortIxOfThisNidi = sourceDatap[nidIxi].sortIxi;
@@ -1944,25 +2350,22 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
   if (MARPAWRAPPER_UNLIKELY(choicepointPowersetp == NULL)) {
     goto err;
   }
-  choicepointp = _marpaWrapperAsf_choicepoint_newp(marpaWrapperAsfp);
-  if (MARPAWRAPPER_UNLIKELY(choicepointp == NULL)) {
-    goto err;
-  }
+  _marpaWrapperAsf_choicepoint_resetv(marpaWrapperAsfp, choicepointp);
 
-  /* Check if choicepoint already seen ? */
-  GENERICSTACK_NEW(symchesStackp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(symchesStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Failure to initalize symchesStackp, %s", strerror(errno));
-    goto err;
-  }
+  /* Symches of this glade are contiguous: they are reserved now, the arrays of */
+  /* factorings and factors grow while a symch is set up.                       */
   symchCounti = _marpaWrapperAsf_powerset_counti(marpaWrapperAsfp, choicepointPowersetp);
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->symchp, marpaWrapperAsfp->sizeSymchl, nSymchl + symchCounti, sizeof(marpaWrapperAsfSymch_t));
+  firstSymchi = (int) nSymchl;
+  marpaWrapperAsfp->nSymchl = nSymchl + symchCounti;
+
   for (symchIxi = 0; symchIxi < symchCounti; symchIxi++) {
     marpaWrapperAsfNidset_t *symchNidsetp;
     int                      nidcounti;
     int                      nidixi;
     
-    /* Free factoring stack */
-    _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsfp, &(choicepointp->factoringStackp));
+    /* Reset factoring stack */
+    choicepointp->nNooki = 0;
 
     symchNidsetp = _marpaWrapperAsf_powerset_nidsetp(marpaWrapperAsfp, choicepointPowersetp, symchIxi);
     if (MARPAWRAPPER_UNLIKELY(symchNidsetp == NULL)) {
@@ -1973,103 +2376,37 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
       goto err;
     }
     symchRuleIdi = _marpaWrapperAsf_nid_rule_idi(marpaWrapperAsfp, choicepointNidi);
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating factoringsStackp for rule %d", symchRuleIdi);
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating factorings for rule %d", symchRuleIdi);
 
-    /* Initial NULL indicates no factorings omitted */
-    GENERICSTACK_NEW(factoringsStackp);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "factoringsStackp initialization failure: %s", strerror(errno));
-      goto err;
-    }
-    GENERICSTACK_PUSH_INT(factoringsStackp, symchRuleIdi);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "factoringsStackp set at indice 0 failure: %s", strerror(errno));
-      GENERICSTACK_FREE(factoringsStackp);
-      goto err;
-    }
-    GENERICSTACK_PUSH_PTR(factoringsStackp, NULL);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "factoringsStackp set at indice 1 failure: %s", strerror(errno));
-      GENERICSTACK_FREE(factoringsStackp);
-      goto err;
-    }
+    /* The symch array does not move while this glade is set up */
+    symchp                     = &(marpaWrapperAsfp->symchp[firstSymchi + symchIxi]);
+    symchp->ruleIdi            = symchRuleIdi;
+    symchp->factoringsOmittedb = 0;
+    symchp->firstFactoringi    = (int) marpaWrapperAsfp->nFactoringl;
+    symchp->nFactoringi        = 0;
 
     /* For a token, there will not be multiple factorings or nids */
     if (symchRuleIdi < 0) {
       marpaWrapperAsfNidset_t *baseNidsetp = _marpaWrapperAsf_nidset_obtainp(marpaWrapperAsfp, 1, &choicepointNidi);
       int                      gladeIdi;
-      genericStack_t          *localStackp = NULL;
 
       if (MARPAWRAPPER_UNLIKELY(baseNidsetp == NULL)) {
 	goto err;
       }
       gladeIdi = _marpaWrapperAsf_nidset_idi(marpaWrapperAsfp, baseNidsetp);
-      if (! GENERICSTACK_IS_PTR(gladeStackp, gladeIdi)) {
-        marpaWrapperAsfGlade_t *localGladep;
-
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating glade at indice %d", gladeIdi);
-        localGladep = (marpaWrapperAsfGlade_t *) malloc(sizeof(marpaWrapperAsfGlade_t));
-        if (MARPAWRAPPER_UNLIKELY(localGladep == NULL)) {
-          MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-          goto err;
-        }
-        localGladep->idi           = gladeIdi;
-        localGladep->symchesStackp = NULL;
-#if MARPAWRAPPERASF_USE_VISITED_FLAG > 0
-        localGladep->visitedb      = 0;
-#endif
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-        localGladep->registeredb   = 1;
-#endif
-        GENERICSTACK_SET_PTR(gladeStackp, localGladep, gladeIdi);
-        if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(gladeStackp))) {
-          MARPAWRAPPER_ERRORF(genericLoggerp, "glade stack failure: %s", strerror(errno));
-          free(localGladep);
-          goto err;
-        }
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-      } else {
-        marpaWrapperAsfGlade_t *localGladep;
-
-        localGladep = GENERICSTACK_GET_PTR(gladeStackp, gladeIdi);
-        localGladep->registeredb = 1;
-#endif
+      if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_registerp(marpaWrapperAsfp, gladeIdi) == NULL)) {
+        goto err;
       }
 
-      GENERICSTACK_NEW(localStackp);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(localStackp))) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "localStackp initialization failure, %s", strerror(errno));
+      factorip = _marpaWrapperAsf_symch_factoring_newp(marpaWrapperAsfp, symchp, 1);
+      if (MARPAWRAPPER_UNLIKELY(factorip == NULL)) {
 	goto err;
       }
-      GENERICSTACK_PUSH_INT(localStackp, gladeIdi);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(localStackp))) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "localStackp push failure, %s", strerror(errno));
-        GENERICSTACK_FREE(localStackp);
-	goto err;
-      }
-      GENERICSTACK_PUSH_PTR(factoringsStackp, localStackp);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "Failure to push factoringsStackp, %s", strerror(errno));
-	GENERICSTACK_FREE(localStackp);
-	goto err;
-      }
-      /* localStackp is now in factoringsStackp */
-      localStackp = NULL;
-      GENERICSTACK_PUSH_PTR(symchesStackp, factoringsStackp);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(symchesStackp))) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "Failure to push symchesStack, %s", strerror(errno));
-	goto err;
-      }
-      /* factoringsStackp is now in symchesStackp, and we do NOT execute the rest of the loop */
-      factoringsStackp = NULL;
+      factorip[0] = gladeIdi;
+      /* We do NOT execute the rest of the loop */
       continue;
     }
 
-    symchNidsetp = _marpaWrapperAsf_powerset_nidsetp(marpaWrapperAsfp, choicepointPowersetp, symchIxi);
-    if (MARPAWRAPPER_UNLIKELY(symchNidsetp == NULL)) {
-      MARPAWRAPPER_ERROR(genericLoggerp, "symchNidsetp is NULL");
-      goto err;
-    }
     nidcounti = _marpaWrapperAsf_nidset_counti(marpaWrapperAsfp, symchNidsetp);
     for (nidixi = 0; nidixi < nidcounti; nidixi++) {
       short breakFactoringsLoop = 0;
@@ -2091,110 +2428,67 @@ static inline marpaWrapperAsfGlade_t *_marpaWrapperAsf_glade_obtainp(marpaWrappe
 
       /* Here, either gotFactoringStackp is NULL, either it is gladeObtainTmpStackp */
       while (gotFactoringStackp != NULL) {
-	if (GENERICSTACK_USED(factoringsStackp) > MARPAWRAPPERASF_FACTORING_MAX) {
-	  /* Update factorings omitted flag - this indice is already allocated: factoringsStackp cannot change*/
-	  GENERICSTACK_SET_INT(factoringsStackp, 1, 1);
-	  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-	    MARPAWRAPPER_ERROR(genericLoggerp, "Failure to set omitted flag in local factoring");
-	    goto err;
-	  }
+	int nFactori;
+	int itemIxi;
+
+	/* The limit historically counts two more items: the rule id and the omitted flag */
+	if ((symchp->nFactoringi + 2) > MARPAWRAPPERASF_FACTORING_MAX) {
+	  symchp->factoringsOmittedb = 1;
 	  breakFactoringsLoop = 1;
 	  break;
 	}
-	{
-	  genericStack_t *tmpFactoringStackp;
-	  int             itemIxi;
 
-	  GENERICSTACK_NEW(tmpFactoringStackp);
-	  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(tmpFactoringStackp))) {
-	    MARPAWRAPPER_ERROR(genericLoggerp, "Failure to initalize tmpFactoringStackp");
+	/* Factors are in reverse order in gotFactoringStackp */
+	nFactori = GENERICSTACK_USED(gotFactoringStackp);
+	factorip = _marpaWrapperAsf_symch_factoring_newp(marpaWrapperAsfp, symchp, nFactori);
+	if (MARPAWRAPPER_UNLIKELY(factorip == NULL)) {
+	  goto err;
+	}
+	for (itemIxi = nFactori - 1; itemIxi >= 0; itemIxi--) {
+	  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_INT(gotFactoringStackp, itemIxi))) {
+	    MARPAWRAPPER_ERRORF(genericLoggerp, "Indice %d is not an int", itemIxi);
 	    goto err;
 	  }
-          if (GENERICSTACK_USED(gotFactoringStackp) > 0) {
-            for (itemIxi = GENERICSTACK_USED(gotFactoringStackp) - 1; itemIxi >= 0; itemIxi--) {
-              if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_INT(gotFactoringStackp, itemIxi))) {
-                MARPAWRAPPER_ERRORF(genericLoggerp, "Indice %d is not an int", itemIxi);
-                GENERICSTACK_FREE(tmpFactoringStackp);
-                goto err;
-              }
-	    
-              GENERICSTACK_PUSH_INT(tmpFactoringStackp, GENERICSTACK_GET_INT(gotFactoringStackp,  itemIxi));
-              if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(tmpFactoringStackp))) {
-                MARPAWRAPPER_ERROR(genericLoggerp, "Failure to push in tmpFactoringStackp");
-                GENERICSTACK_FREE(tmpFactoringStackp);
-                goto err;
-              }
-            }
-          }
-
-          GENERICSTACK_PUSH_PTR(factoringsStackp, tmpFactoringStackp);
-          if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringsStackp))) {
-            MARPAWRAPPER_ERROR(genericLoggerp, "Failure to push in factoringsStackp");
-            GENERICSTACK_FREE(tmpFactoringStackp);
-            goto err;
-          }
-          /* tmpFactoringStackp is now in factoringsStackp */
+	  *factorip++ = GENERICSTACK_GET_INT(gotFactoringStackp, itemIxi);
+	}
 
-	  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_next_factoringb(marpaWrapperAsfp, choicepointp, choicepointNidi, &factoringb) == 0)) {
-	    goto err;
-	  }
-	  GENERICSTACK_USED(gladeObtainTmpStackp) = 0;
-	  gotFactoringStackp = gladeObtainTmpStackp;
-	  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsfp, choicepointp, &gotFactoringStackp) == 0)) {
-	    goto err;
-	  }
+	if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_next_factoringb(marpaWrapperAsfp, choicepointp, choicepointNidi, &factoringb) == 0)) {
+	  goto err;
+	}
+	GENERICSTACK_USED(gladeObtainTmpStackp) = 0;
+	gotFactoringStackp = gladeObtainTmpStackp;
+	if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsfp, choicepointp, &gotFactoringStackp) == 0)) {
+	  goto err;
 	}
       }
       if (breakFactoringsLoop != 0) {
 	break;
       }
     }
-    GENERICSTACK_PUSH_PTR(symchesStackp, factoringsStackp);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(symchesStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "Failure to push symchesStack, %s", strerror(errno));
-      goto err;
-    }
-    /* factoringsStackp is now in symchesStackp */
-    factoringsStackp = NULL;
   }
 
-  /* Replace current symches */
-  _marpaWrapperAsf_symchesStackp_freev(marpaWrapperAsfp, gladep->symchesStackp);
-  gladep->symchesStackp = symchesStackp;
-  /* symchesStackp is now in gladep */
-  symchesStackp = NULL;
-  gladep->idi = gladei;
-
-  GENERICSTACK_SET_PTR(gladeStackp, gladep, gladei);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(gladeStackp))) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Failure to set in gladeStackp");
-    goto err;
+  /* Registering down glades may have moved the glades */
+  gladep = &(marpaWrapperAsfp->gladep[gladei]);
+  gladep->firstSymchi = firstSymchi;
+  gladep->nSymchi     = symchCounti;
+  if (gladep->lastTraversali < 0) {
+    marpaWrapperAsfp->nRebuildl++;
   }
 
   goto done;
 
  err:
   gladep = NULL;
-  if (symchesStackp != NULL) {
-    _marpaWrapperAsf_symchesStackp_freev(marpaWrapperAsfp, symchesStackp);
-  }
+  /* Forget anything that was appended for this glade */
+  marpaWrapperAsfp->nSymchl     = nSymchl;
+  marpaWrapperAsfp->nFactoringl = nFactoringl;
+  marpaWrapperAsfp->nFactorl    = nFactorl;
 
  done:
-  if (sourceDatap != NULL) {
-    free(sourceDatap);
-  }
-  if (nidWithCurrentSortIxip != NULL) {
-    free(nidWithCurrentSortIxip);
-  }
-  if (symchIdip != NULL) {
-    free(symchIdip);
-  }
-  if (symbolip != NULL) {
-    free(symbolip);
+  /* A prepared ASF is never evicted, and may be read concurrently */
+  if ((gladep != NULL) && (marpaWrapperAsfp->marpaWrapperAsfOption.maxBytesl > 0) && (! marpaWrapperAsfp->preparedb)) {
+    gladep->lastTraversali = marpaWrapperAsfp->traversali;
   }
-  _marpaWrapperAsf_factoringsStackp_freev(marpaWrapperAsfp, factoringsStackp);
-  _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsfp, choicepointp);
-
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", gladep);
   return gladep;
 }
@@ -2206,10 +2500,7 @@ static inline short _marpaWrapperAsf_first_factoringb(marpaWrapperAsf_t *marpaWr
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_first_factoringb)
   genericLogger_t             *genericLoggerp          = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
   genericStack_t              *orNodeStackp            = marpaWrapperAsfp->orNodeStackp;
-  marpaWrapperAsfNook_t       *nookp                   = NULL;
-  genericSparseArray_t        *orNodeInUseSparseArrayp = choicepointp->orNodeInUseSparseArrayp;
   marpaWrapperAsfOrNode_t     *orNodep;
-  genericStack_t              *factoringStackp;
 
   /* Current NID of current SYMCH */
   /* The caller should ensure that we are never called unless the current NIS is for a rule */
@@ -2221,36 +2512,19 @@ static inline short _marpaWrapperAsf_first_factoringb(marpaWrapperAsf_t *marpaWr
   /* Due to skipping, even the top OR node can have no valid choices */
   if ((! GENERICSTACK_IS_PTR(orNodeStackp, nidOfChoicePointi)) ||
       (((orNodep = (marpaWrapperAsfOrNode_t *) GENERICSTACK_GET_PTR(orNodeStackp, nidOfChoicePointi))->nAndNodei) <= 0)) {
-    _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsfp, &(choicepointp->factoringStackp));
+    choicepointp->nNooki = 0;
     *firstFactoringbp = 0;
     goto done;
   }
 
-  GENERICSPARSEARRAY_SET(orNodeInUseSparseArrayp, marpaWrapperAsfp, nidOfChoicePointi, SHORT, 1);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(orNodeInUseSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "orNodeInUseSparseArrayp set failure: %s", strerror(errno));
-    goto err;
-  }
+  /* nidOfChoicePointi is an indice in orNodeStackp, so it is in range */
+  choicepointp->orNodeInUseip[nidOfChoicePointi] = choicepointp->generationi;
 
-  nookp = _marpaWrapperAsf_nook_newp(marpaWrapperAsfp, nidOfChoicePointi, -1);
-  if (MARPAWRAPPER_UNLIKELY(nookp == NULL)) {
+  choicepointp->nNooki = 0;
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_nook_newp(marpaWrapperAsfp, choicepointp, nidOfChoicePointi, -1) == NULL)) {
     goto err;
   }
 
-  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_factoringStackp_resetb(marpaWrapperAsfp, &(choicepointp->factoringStackp)) == 0)) {
-    goto err;
-  }
-
-  factoringStackp = choicepointp->factoringStackp;
-  GENERICSTACK_PUSH_PTR(factoringStackp, nookp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "factoringStackp push failure: %s", strerror(errno));
-    goto err;
-  }
-
-  /* nookp is now in marpaWrapperAsfp->factoringStackp */
-  nookp = NULL;
-
   /* Iterate as long as we cannot finish this stack */
   while (1) {
     short factoringFinishb;
@@ -2278,10 +2552,6 @@ static inline short _marpaWrapperAsf_first_factoringb(marpaWrapperAsf_t *marpaWr
   return 1;
 
  err:
-  if (nookp != NULL) {
-    free(nookp);
-  }
-  
   MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
   return 0;
 }
@@ -2294,20 +2564,18 @@ static inline short _marpaWrapperAsf_factoring_finishb(marpaWrapperAsf_t *marpaW
   genericLogger_t          *genericLoggerp          = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
   Marpa_Bocage              marpaBocagep            = marpaWrapperAsfp->marpaBocagep;
   genericStack_t           *orNodeStackp            = marpaWrapperAsfp->orNodeStackp;
-  genericStack_t           *factoringStackp         = choicepointp->factoringStackp;
-  genericSparseArray_t     *orNodeInUseSparseArrayp = choicepointp->orNodeInUseSparseArrayp;
   genericStack_t           *worklistStackp          = marpaWrapperAsfp->worklistStackp;
   int                       worklistUsedi;
   int                       worklistStacki;
   int                       worklistLasti;
 
-  if (MARPAWRAPPER_UNLIKELY(factoringStackp == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "factoringStackp is NULL");
+  if (MARPAWRAPPER_UNLIKELY(choicepointp->nNooki <= 0)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Factoring stack is empty");
     goto err;
   }
 
   GENERICSTACK_USED(worklistStackp) = 0;
-  for (worklistStacki = 0; worklistStacki < GENERICSTACK_USED(factoringStackp); worklistStacki++) {
+  for (worklistStacki = 0; worklistStacki < choicepointp->nNooki; worklistStacki++) {
     GENERICSTACK_SET_INT(worklistStackp, worklistStacki, worklistStacki);
     if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(worklistStackp))) {
       MARPAWRAPPER_ERRORF(genericLoggerp, "worklistStackp initialization at indice %d failure: %s", worklistStacki, strerror(errno));
@@ -2325,17 +2593,14 @@ static inline short _marpaWrapperAsf_factoring_finishb(marpaWrapperAsf_t *marpaW
     short                    childIsCauseb = 0;
     short                    childIsPredecessorb = 0;
     marpaWrapperAsfNook_t   *newNookp;
-    /* See GCC comment below */
-    short                    orNodeInUsedb = 0;
-    short                    findResultb = 0;
 
     worklistLasti = worklistUsedi - 1;
 
-    if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(factoringStackp, worklistLasti))) {
+    if (MARPAWRAPPER_UNLIKELY((worklistLasti < 0) || (worklistLasti >= choicepointp->nNooki))) {
       MARPAWRAPPER_ERRORF(genericLoggerp, "No nook at indice %d", worklistLasti);
       goto err;
     }
-    workNookp = (marpaWrapperAsfNook_t *) GENERICSTACK_GET_PTR(factoringStackp, worklistLasti);
+    workNookp = &(choicepointp->nookp[worklistLasti]);
     workOrNodeIdi  = workNookp->orNodeIdi;
     if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(orNodeStackp, workOrNodeIdi))) {
       MARPAWRAPPER_ERRORF(genericLoggerp, "No orNode at indice %d of orNodesStackp", workOrNodeIdi);
@@ -2372,14 +2637,7 @@ static inline short _marpaWrapperAsf_factoring_finishb(marpaWrapperAsf_t *marpaW
     continue;
 
   endFindChildOrNodeLabel:
-    GENERICSPARSEARRAY_FIND(orNodeInUseSparseArrayp, marpaWrapperAsfp, childOrNodei, SHORT, &orNodeInUsedb, findResultb);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(orNodeInUseSparseArrayp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "orNodeInUseSparseArrayp find failure, %s", strerror(errno));
-      goto err;
-    }
-    /* GCC seem to badly optimize this statement: if (findResultb && orNodeInUsedb), always doing the && */
-    /* even if findResultb is 0 - this is why both are explicitely initialized. */
-    if (findResultb && orNodeInUsedb) {
+    if ((childOrNodei >= 0) && (childOrNodei < choicepointp->nOrNodeInUsei) && (choicepointp->orNodeInUseip[childOrNodei] == choicepointp->generationi)) {
       *factoringFinishbp = 0;
       goto done;
     }
@@ -2390,7 +2648,12 @@ static inline short _marpaWrapperAsf_factoring_finishb(marpaWrapperAsf_t *marpaW
       goto done;
     }
 
-    newNookp = _marpaWrapperAsf_nook_newp(marpaWrapperAsfp, childOrNodei, worklistLasti);
+    newNookp = _marpaWrapperAsf_nook_newp(marpaWrapperAsfp, choicepointp, childOrNodei, worklistLasti);
+    if (MARPAWRAPPER_UNLIKELY(newNookp == NULL)) {
+      goto err;
+    }
+    /* The push may have moved the nooks */
+    workNookp = &(choicepointp->nookp[worklistLasti]);
     if (childIsCauseb != 0) {
       newNookp->isCauseb = 1;
       workNookp->causeIsExpandedb = 1;
@@ -2400,12 +2663,7 @@ static inline short _marpaWrapperAsf_factoring_finishb(marpaWrapperAsf_t *marpaW
       workNookp->predecessorIsExpandedb = 1;
     }
 
-    GENERICSTACK_PUSH_PTR(factoringStackp, newNookp);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringStackp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "factoringStackp push failure, %s", strerror(errno));
-      goto err;
-    }
-    GENERICSTACK_PUSH_INT(worklistStackp, GENERICSTACK_USED(factoringStackp) - 1);
+    GENERICSTACK_PUSH_INT(worklistStackp, choicepointp->nNooki - 1);
     if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(worklistStackp))) {
       MARPAWRAPPER_ERRORF(genericLoggerp, "worklistStackp push failure, %s", strerror(errno));
       goto err;
@@ -2429,8 +2687,6 @@ static inline short _marpaWrapperAsf_factoring_iterateb(marpaWrapperAsf_t *marpa
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_factoring_iterateb)
   genericLogger_t          *genericLoggerp          = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericStack_t           *factoringStackp         = choicepointp->factoringStackp;
-  genericSparseArray_t     *orNodeInUseSparseArrayp = choicepointp->orNodeInUseSparseArrayp;
   marpaWrapperAsfNook_t    *topNookp;
   marpaWrapperAsfNook_t    *parentNookp;
   int                       stackIxOfParentNooki;
@@ -2439,18 +2695,13 @@ static inline short _marpaWrapperAsf_factoring_iterateb(marpaWrapperAsf_t *marpa
   short                     haveLastChoiceb;
 
   while (1) {
-    factoringStacki = GENERICSTACK_USED(factoringStackp);
+    factoringStacki = choicepointp->nNooki;
     if (factoringStacki <= 0) {
-      _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsfp, &(choicepointp->factoringStackp));
       *factoringIteratebp = 0;
       goto done;
     }
 
-    if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(factoringStackp, factoringStacki - 1))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "No nook at indice %d of factoringStackp", (factoringStacki - 1));
-      goto err;
-    }
-    topNookp = (marpaWrapperAsfNook_t *) GENERICSTACK_GET_PTR(factoringStackp, factoringStacki - 1);
+    topNookp = &(choicepointp->nookp[factoringStacki - 1]);
     if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_nook_incrementb(marpaWrapperAsfp, topNookp, &haveLastChoiceb) == 0)) {
       goto err;
     }
@@ -2462,11 +2713,11 @@ static inline short _marpaWrapperAsf_factoring_iterateb(marpaWrapperAsf_t *marpa
     /* "Dirty" the corresponding bits in the parent and pop this nook */
     stackIxOfParentNooki = topNookp->parentOrNodeIdi;
     if (stackIxOfParentNooki >= 0) {
-      if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(factoringStackp,  stackIxOfParentNooki))) {
-	MARPAWRAPPER_ERRORF(genericLoggerp, "No nook at indice %d of factoringStackp", stackIxOfParentNooki);
+      if (MARPAWRAPPER_UNLIKELY(stackIxOfParentNooki >= factoringStacki)) {
+	MARPAWRAPPER_ERRORF(genericLoggerp, "No nook at indice %d of factoring stack", stackIxOfParentNooki);
 	goto err;
       }
-      parentNookp = (marpaWrapperAsfNook_t *) GENERICSTACK_GET_PTR(factoringStackp,  stackIxOfParentNooki);
+      parentNookp = &(choicepointp->nookp[stackIxOfParentNooki]);
       if (topNookp->isCauseb != 0) {
 	parentNookp->causeIsExpandedb = 0;
       }
@@ -2475,18 +2726,11 @@ static inline short _marpaWrapperAsf_factoring_iterateb(marpaWrapperAsf_t *marpa
       }
     }
     orNodei = topNookp->orNodeIdi;
-    GENERICSPARSEARRAY_SET(orNodeInUseSparseArrayp, marpaWrapperAsfp, orNodei, PTR, NULL);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(orNodeInUseSparseArrayp))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "orNodeInUseSparseArrayp set failure, %s", strerror(errno));
-      goto err;
+    if ((orNodei >= 0) && (orNodei < choicepointp->nOrNodeInUsei)) {
+      choicepointp->orNodeInUseip[orNodei] = 0;
     }
     /* On the top of the stack, this is topNookp per definition */
-    GENERICSTACK_POP_PTR(factoringStackp);
-    if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(factoringStackp))) {
-      MARPAWRAPPER_ERROR(genericLoggerp, "failure to pop from factoringStackp");
-      goto err;
-    }
-    free(topNookp);
+    choicepointp->nNooki--;
   }
 
   *factoringIteratebp = 1;
@@ -2508,11 +2752,8 @@ static inline short _marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsf_t *marpaW
   genericLogger_t          *genericLoggerp          = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
   genericStack_t           *stackp                  = *stackpp;
   genericStack_t           *orNodeStackp            = marpaWrapperAsfp->orNodeStackp;
-  genericStack_t           *gladeStackp             = marpaWrapperAsfp->gladeStackp;
-  genericStack_t            andNodeIdStack;
-  genericStack_t           *andNodeIdStackp         = &andNodeIdStack;
-  genericStack_t            causeNidsStack;
-  genericStack_t           *causeNidsStackp         = &causeNidsStack;
+  genericStack_t           *andNodeIdStackp         = marpaWrapperAsfp->andNodeIdStackp;
+  genericStack_t           *causeNidsStackp         = marpaWrapperAsfp->causeNidsStackp;
   int                      *causeNidsp;
   int                       factorIxi;
   marpaWrapperAsfNook_t    *nookp;
@@ -2523,26 +2764,15 @@ static inline short _marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsf_t *marpaW
   int                       choicei;
   marpaWrapperAsfNidset_t  *baseNidsetp;
   int                       gladeIdi;
-  int                       choicepointpMaxIndice;
-  genericStack_t           *choicepointpFactoringStackp;
-  
-  GENERICSTACK_INIT(andNodeIdStackp);
-  GENERICSTACK_INIT(causeNidsStackp);
   
-  if (choicepointp->factoringStackp == NULL) {
+  if (choicepointp->nNooki <= 0) {
     stackp = NULL;
     goto done;
   }
 
-  choicepointpFactoringStackp = choicepointp->factoringStackp;
-  choicepointpMaxIndice = GENERICSTACK_USED(choicepointpFactoringStackp) - 1;
-  for (factorIxi = 0; factorIxi <= choicepointpMaxIndice; factorIxi++) {
+  for (factorIxi = 0; factorIxi < choicepointp->nNooki; factorIxi++) {
 
-    if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(choicepointpFactoringStackp,  factorIxi))) {
-      MARPAWRAPPER_ERRORF(genericLoggerp, "Not a pointer at indice %d of factoringStackp", factorIxi);
-      goto err;
-    }
-    nookp = (marpaWrapperAsfNook_t *) GENERICSTACK_GET_PTR(choicepointpFactoringStackp,  factorIxi);
+    nookp = &(choicepointp->nookp[factorIxi]);
     if (_marpaWrapperAsf_nook_has_semantic_causeb(marpaWrapperAsfp, nookp) == 0) {
       continue;
     }
@@ -2614,36 +2844,8 @@ static inline short _marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsf_t *marpaW
     }
     gladeIdi = _marpaWrapperAsf_nidset_idi(marpaWrapperAsfp, baseNidsetp);
     MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... gladeIdi = %d", gladeIdi);
-    if (! GENERICSTACK_IS_PTR(gladeStackp,  gladeIdi)) {
-      marpaWrapperAsfGlade_t *gladep;
-
-      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Generating glade at indice %d", gladeIdi);
-      gladep = (marpaWrapperAsfGlade_t *) malloc(sizeof(marpaWrapperAsfGlade_t));
-      if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-        MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-        goto err;
-      }
-      gladep->idi           = gladeIdi;
-      gladep->symchesStackp = NULL;
-#if MARPAWRAPPERASF_USE_VISITED_FLAG > 0
-      gladep->visitedb      = 0;
-#endif
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-      gladep->registeredb   = 1;
-#endif
-      GENERICSTACK_SET_PTR(gladeStackp, gladep,  gladeIdi);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(gladeStackp))) {
-        MARPAWRAPPER_ERROR(genericLoggerp, "Failure to set in gladeStackp");
-        free(gladep);
-        goto err;
-      }
-#if MARPAWRAPPERASF_USE_REGISTERED_FLAG > 0
-    } else {
-      marpaWrapperAsfGlade_t *gladep;
-
-      gladep = GENERICSTACK_GET_PTR(gladeStackp,  gladeIdi);
-      gladep->registeredb = 1;
-#endif
+    if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_glade_registerp(marpaWrapperAsfp, gladeIdi) == NULL)) {
+      goto err;
     }
     GENERICSTACK_PUSH_INT(stackp, gladeIdi);
     if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(stackp))) {
@@ -2654,9 +2856,9 @@ static inline short _marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsf_t *marpaW
   }
   
  done:
-  GENERICSTACK_RESET(andNodeIdStackp);
-  GENERICSTACK_RESET(causeNidsStackp);
-  
+  GENERICSTACK_USED(andNodeIdStackp) = 0;
+  GENERICSTACK_USED(causeNidsStackp) = 0;
+
   *stackpp = stackp;
 #ifndef MARPAWRAPPER_NTRACE
   _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "Glade id factors", *stackpp);
@@ -2665,8 +2867,8 @@ static inline short _marpaWrapperAsf_glade_id_factorsb(marpaWrapperAsf_t *marpaW
   return 1;
 
  err:
-  GENERICSTACK_RESET(andNodeIdStackp);
-  GENERICSTACK_RESET(causeNidsStackp);
+  GENERICSTACK_USED(andNodeIdStackp) = 0;
+  GENERICSTACK_USED(causeNidsStackp) = 0;
   MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
   return 0;
 }
@@ -2762,7 +2964,7 @@ static inline short _marpaWrapperAsf_next_factoringb(marpaWrapperAsf_t *marpaWra
   genericLogger_t          *genericLoggerp          = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
   short                     factoringb              = 0;
 
-  if (MARPAWRAPPER_UNLIKELY(choicepointp->factoringStackp == NULL)) {
+  if (MARPAWRAPPER_UNLIKELY(choicepointp->nNooki <= 0)) {
       MARPAWRAPPER_ERROR(genericLoggerp, "Attempt to iterate factoring of uninitialized checkpoint");
       goto err;
   }
@@ -2804,12 +3006,10 @@ static inline short _marpaWrapperAsf_glade_is_visitedb(marpaWrapperAsf_t *marpaW
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_is_visitedb)
   genericLogger_t         *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
   short                    rcb            = 0;
-  genericStack_t          *gladeStackp    = marpaWrapperAsfp->gladeStackp;
   marpaWrapperAsfGlade_t  *gladep;
 
-  if (GENERICSTACK_IS_PTR(gladeStackp,  gladeIdi)) {
-
-    gladep = GENERICSTACK_GET_PTR(gladeStackp,  gladeIdi);
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+  if (gladep != NULL) {
     rcb = gladep->visitedb;
   }
 
@@ -2825,23 +3025,17 @@ static inline void _marpaWrapperAsf_glade_visited_clearb(marpaWrapperAsf_t *marp
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_visited_clearb)
   genericLogger_t         *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericStack_t          *gladeStackp    = marpaWrapperAsfp->gladeStackp;
   marpaWrapperAsfGlade_t  *gladep;
-  int                      i;
+  size_t                   i;
 
   if (gladeIdip != NULL) {
-    if (GENERICSTACK_IS_PTR(gladeStackp,  *gladeIdip)) {
-
-      gladep = GENERICSTACK_GET_PTR(gladeStackp,  *gladeIdip);
+    gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, *gladeIdip);
+    if (gladep != NULL) {
       gladep->visitedb = 0;
     }
   } else {
-    for (i = 0; i < GENERICSTACK_USED(gladeStackp); i++) {
-      if (GENERICSTACK_IS_PTR(gladeStackp, i)) {
-
-	gladep = GENERICSTACK_GET_PTR(gladeStackp, i);
-	gladep->visitedb = 0;
-      }
+    for (i = 0; i < marpaWrapperAsfp->nGladel; i++) {
+      marpaWrapperAsfp->gladep[i].visitedb = 0;
     }
   }
 }
@@ -2862,7 +3056,7 @@ static inline short _marpaWrapperAsf_glade_symch_countb(marpaWrapperAsf_t *marpa
     goto err;
   }
 
-  counti = GENERICSTACK_USED(gladep->symchesStackp);
+  counti = gladep->nSymchi;
   if (countip != NULL) {
     *countip = counti;
   }
@@ -2881,18 +3075,12 @@ static inline int _marpaWrapperAsf_glade_symbol_idi(marpaWrapperAsf_t *marpaWrap
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_symbol_idi)
   genericLogger_t         *genericLoggerp     = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericSparseArray_t    *nidsetSparseArrayp = marpaWrapperAsfp->nidsetSparseArrayp;
   int                      nid0;
   marpaWrapperAsfNidset_t *nidsetp;
   int                      symbolIdi;
-  short                    findResult;
 
-  GENERICSPARSEARRAY_FIND(nidsetSparseArrayp, marpaWrapperAsfp, gladeIdi, PTR, &nidsetp, findResult);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(nidsetSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "nidset sparse array find failure: %s", strerror(errno));
-    goto err;
-  }
-  if (MARPAWRAPPER_UNLIKELY(! findResult)) {
+  nidsetp = _marpaWrapperAsf_nidset_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY(nidsetp == NULL)) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", gladeIdi);
     goto err;
   }
@@ -2920,19 +3108,13 @@ static inline int _marpaWrapperAsf_glade_spani(marpaWrapperAsf_t *marpaWrapperAs
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_spani)
   genericLogger_t         *genericLoggerp     = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericSparseArray_t    *nidsetSparseArrayp = marpaWrapperAsfp->nidsetSparseArrayp;
   int                      spanIdi            = -1;
   int                      nid0;
   marpaWrapperAsfNidset_t *nidsetp;
-  short                    findResult;
   int                      lengthi;
 
-  GENERICSPARSEARRAY_FIND(nidsetSparseArrayp, marpaWrapperAsfp, gladeIdi, PTR, &nidsetp, findResult);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(nidsetSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "nidset sparse array find failure: %s", strerror(errno));
-    goto err;
-  }
-  if (MARPAWRAPPER_UNLIKELY(! findResult)) {
+  nidsetp = _marpaWrapperAsf_nidset_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY(nidsetp == NULL)) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", gladeIdi);
     goto err;
   }
@@ -2962,12 +3144,9 @@ int marpaWrapperAsf_traverse_rh_lengthi(marpaWrapperAsfTraverser_t *traverserp)
   genericLogger_t          *genericLoggerp = NULL;
   marpaWrapperAsf_t        *marpaWrapperAsfp;
   marpaWrapperAsfGlade_t   *gladep;
-  int                       symchIxi;
-  genericStack_t           *factoringsStackp;
-  genericStack_t           *downFactoringsStackp;
+  marpaWrapperAsfSymch_t   *symchp;
+  marpaWrapperAsfFactoring_t *factoringp;
   int                       downRuleIdi;
-  int                       factoringIxi;
-  int                       realFactoringIxi;
   int                       lengthi;
 
   if (MARPAWRAPPER_UNLIKELY(traverserp == NULL)) {
@@ -2978,40 +3157,20 @@ int marpaWrapperAsf_traverse_rh_lengthi(marpaWrapperAsfTraverser_t *traverserp)
   marpaWrapperAsfp = traverserp->marpaWrapperAsfp;
   genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
-    goto err;
-  }
-  symchIxi = traverserp->symchIxi;
-  /* symchesStackp is a stack of factoringsStack */
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(gladep->symchesStackp,  symchIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "No symch at indice %d of current glade", symchIxi);
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
-  factoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(gladep->symchesStackp, symchIxi);
-  /* factoringsStackp is (symchRuleIdi, PTR, downFactoringsStackp[0], downFactoringsStackp[1], ... ) */
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_INT(factoringsStackp, 0))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Not an integer at indice 0 of factoringsStackp", 0);
-#ifndef MARPAWRAPPER_NTRACE
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "symchesStackp", gladep->symchesStackp);
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "factoringsStackp", factoringsStackp);
-#endif
+  symchp = _marpaWrapperAsf_glade_symchp(marpaWrapperAsfp, gladep, traverserp->symchIxi);
+  if (MARPAWRAPPER_UNLIKELY(symchp == NULL)) {
     goto err;
   }
-
-  factoringIxi = traverserp->factoringIxi;
-  realFactoringIxi = 2 + factoringIxi;
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(factoringsStackp, realFactoringIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Not a pointer at indice 2+%d of factoringsStackp", factoringIxi);
-#ifndef MARPAWRAPPER_NTRACE
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "symchesStackp", gladep->symchesStackp);
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "factoringsStackp", factoringsStackp);
-#endif
+  factoringp = _marpaWrapperAsf_symch_factoringp(marpaWrapperAsfp, symchp, traverserp->factoringIxi);
+  if (MARPAWRAPPER_UNLIKELY(factoringp == NULL)) {
     goto err;
   }
-  downRuleIdi          = GENERICSTACK_GET_INT(factoringsStackp, 0);
-  downFactoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(factoringsStackp, realFactoringIxi);
+  downRuleIdi = symchp->ruleIdi;
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "downRuleIdi is %d", downRuleIdi);
 
   if (MARPAWRAPPER_UNLIKELY(downRuleIdi < 0)) {
@@ -3019,8 +3178,8 @@ int marpaWrapperAsf_traverse_rh_lengthi(marpaWrapperAsfTraverser_t *traverserp)
     goto err;
   }
 
-  /* downFactoringsStackp is a stack of gladeIdi */
-  lengthi = GENERICSTACK_USED(downFactoringsStackp);
+  /* Factors are glade ids */
+  lengthi = factoringp->nFactori;
   
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1, lengthl = %d", lengthi);
   return lengthi;
@@ -3047,15 +3206,16 @@ short marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp,
   marpaWrapperAsf_t          *marpaWrapperAsfp;
   marpaWrapperAsfGlade_t     *gladep;
   int                         symchIxi;
-  genericStack_t             *factoringsStackp;
-  genericStack_t             *downFactoringsStackp;
+  marpaWrapperAsfSymch_t     *symchp;
+  marpaWrapperAsfFactoring_t *factoringp;
   int                         ruleIdi;
   int                         factoringIxi;
-  int                         realFactoringIxi;
   int                         maxRhixi;
   marpaWrapperAsfGlade_t     *downGladep;
   int                         downGladeIdi;
   short                       findResultb = 0;
+  short                       memob;
+  short                       aliveb;
 
   if (MARPAWRAPPER_UNLIKELY(traverserp == NULL)) {
     errno = EINVAL;
@@ -3065,40 +3225,23 @@ short marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp,
   marpaWrapperAsfp  = traverserp->marpaWrapperAsfp;
   valueSparseArrayp = traverserp->valueSparseArrayp;
   genericLoggerp    = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  memob             = traverserp->memob;
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
 
-  GENERICSPARSEARRAY_INIT(childValueSparseArrayp, _marpaWrapperAsf_valueSparseArray_indi);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(childValueSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "childValueSparseArrayp initialization failure: %s", strerror(errno));
-    goto err;
-  }
-  childValueSparseArrayb = 1;
-
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Current glade id is %d", gladep->idi);
   symchIxi = traverserp->symchIxi;
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Current symchIxi is %d", symchIxi);
-  /* symchesStackp is a stack of factoringsStack */
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(gladep->symchesStackp,  symchIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "No symch at indice %d of current glade", symchIxi);
-    goto err;
-  }
-  factoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(gladep->symchesStackp, symchIxi);
-  /* factoringsStackp is (symchRuleIdi, PTR, downFactoringsStackp[0], downFactoringsStackp[1], ... ) */
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_INT(factoringsStackp, 0))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Not an integer at indice 0 of factoringsStackp", 0);
-#ifndef MARPAWRAPPER_NTRACE
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "symchesStackp", gladep->symchesStackp);
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "factoringsStackp", factoringsStackp);
-#endif
+  symchp = _marpaWrapperAsf_glade_symchp(marpaWrapperAsfp, gladep, symchIxi);
+  if (MARPAWRAPPER_UNLIKELY(symchp == NULL)) {
     goto err;
   }
 
-  /* symchesStackp contains entries in the form: (rule_id, xxx, @factorings) */
-  ruleIdi          = GENERICSTACK_GET_INT(factoringsStackp, 0);
+  ruleIdi          = symchp->ruleIdi;
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Current rule id is %d", ruleIdi);
 
   if (ruleIdi < 0) {
@@ -3124,21 +3267,12 @@ short marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp,
   factoringIxi = traverserp->factoringIxi;
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Current factoringIxi is %d", factoringIxi);
 
-  realFactoringIxi = 2 + factoringIxi;
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(factoringsStackp, realFactoringIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Not a pointer at indice 2+%d of factoringsStackp", factoringIxi);
-#ifndef MARPAWRAPPER_NTRACE
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "symchesStackp", gladep->symchesStackp);
-    _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "factoringsStackp", factoringsStackp);
-#endif
+  factoringp = _marpaWrapperAsf_symch_factoringp(marpaWrapperAsfp, symchp, factoringIxi);
+  if (MARPAWRAPPER_UNLIKELY(factoringp == NULL)) {
     goto err;
   }
-  downFactoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(factoringsStackp, realFactoringIxi);
 
-#ifndef MARPAWRAPPER_NTRACE
-  _marpaWrapperAsf_dump_stack(marpaWrapperAsfp, "downFactoringsStackp", downFactoringsStackp);
-#endif
-  maxRhixi = GENERICSTACK_USED(downFactoringsStackp);
+  maxRhixi = factoringp->nFactori;
   lengthi = maxRhixi; /* Number of RHS */
   /*
    * Nullables have no RHS
@@ -3148,20 +3282,22 @@ short marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp,
     goto ok;
   }
   --maxRhixi;
-  if (MARPAWRAPPER_UNLIKELY(rhIxi > maxRhixi)) {
+  if (MARPAWRAPPER_UNLIKELY((rhIxi < 0) || (rhIxi > maxRhixi))) {
     MARPAWRAPPER_ERRORF(genericLoggerp, "rhIxi should be in range [0..%d]", maxRhixi);
     goto err;
   }
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_INT(downFactoringsStackp, rhIxi))) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Not an int in downFactoringsStackp");
-    goto err;
-  }
-  downGladeIdi = GENERICSTACK_GET_INT(downFactoringsStackp, rhIxi);
+  downGladeIdi = marpaWrapperAsfp->factorip[factoringp->firstFactori + rhIxi];
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Current downGladeIdi is %d", downGladeIdi);
-  GENERICSPARSEARRAY_FIND(valueSparseArrayp, marpaWrapperAsfp, downGladeIdi, INT, &valuei, findResultb);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(valueSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "valueSparseArrayp find failure, %s", strerror(errno));
-    goto err;
+  if (memob) {
+    /* A child traverser always starts at the first symch and factoring of its glade: */
+    /* the glade id is enough to identify its value.                                  */
+    findResultb = _marpaWrapperAsf_memo_findb(marpaWrapperAsfp, downGladeIdi, &valuei);
+  } else {
+    GENERICSPARSEARRAY_FIND(valueSparseArrayp, marpaWrapperAsfp, downGladeIdi, INT, &valuei, findResultb);
+    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(valueSparseArrayp))) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "valueSparseArrayp find failure, %s", strerror(errno));
+      goto err;
+    }
   }
   if (findResultb) {
     /* Already memoized */
@@ -3173,27 +3309,57 @@ short marpaWrapperAsf_traverse_rh_valueb(marpaWrapperAsfTraverser_t *traverserp,
     MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", downGladeIdi);
     goto err;
   }
+  if (! memob) {
+    GENERICSPARSEARRAY_INIT(childValueSparseArrayp, _marpaWrapperAsf_valueSparseArray_indi);
+    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(childValueSparseArrayp))) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "childValueSparseArrayp initialization failure: %s", strerror(errno));
+      goto err;
+    }
+    childValueSparseArrayb = 1;
+  }
   /*
    * Do a shallow clone
    */
-  childTraverser.marpaWrapperAsfp  = marpaWrapperAsfp;
-  childTraverser.valueSparseArrayp = childValueSparseArrayp;
-  childTraverser.gladep            = downGladep;
-  childTraverser.symchIxi          = 0;
-  childTraverser.factoringIxi      = 0;
+  childTraverser.marpaWrapperAsfp   = marpaWrapperAsfp;
+  childTraverser.traverserCallbackp = traverserp->traverserCallbackp;
+  childTraverser.userDatavp         = traverserp->userDatavp;
+  childTraverser.memob              = memob;
+  childTraverser.valueSparseArrayp  = childValueSparseArrayb ? childValueSparseArrayp : NULL;
+  childTraverser.gladeIdi           = downGladeIdi;
+  childTraverser.symchIxi           = 0;
+  childTraverser.factoringIxi       = 0;
+  if (marpaWrapperAsfp->prune.prunedb) {
+    /* The factoring we come from is alive: so is downGladeIdi */
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_traverse_aliveb(&childTraverser, &aliveb))) {
+      goto err;
+    }
+    if (MARPAWRAPPER_UNLIKELY(! aliveb)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d has no tree left after pruning", downGladeIdi);
+      goto err;
+    }
+  }
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Calling traverser for downglade %d", downGladep->idi);
-  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsfp->traverserCallbackp(&childTraverser, marpaWrapperAsfp->userDatavp, &valuei))) {
+  if (MARPAWRAPPER_UNLIKELY(! childTraverser.traverserCallbackp(&childTraverser, childTraverser.userDatavp, &valuei))) {
     goto err;
   }
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
 
-  GENERICSPARSEARRAY_SET(valueSparseArrayp, marpaWrapperAsfp, downGladeIdi, INT, valuei);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(valueSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "valueSparseArrayp set failure, %s", strerror(errno));
-    goto err;   
+  if (memob) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_memo_setb(marpaWrapperAsfp, downGladeIdi, valuei))) {
+      goto err;
+    }
+  } else {
+    GENERICSPARSEARRAY_SET(valueSparseArrayp, marpaWrapperAsfp, downGladeIdi, INT, valuei);
+    if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(valueSparseArrayp))) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "valueSparseArrayp set failure, %s", strerror(errno));
+      goto err;   
+    }
   }
 
 ok:
-  GENERICSPARSEARRAY_RESET(childValueSparseArrayp, marpaWrapperAsfp);
+  if (childValueSparseArrayb) {
+    GENERICSPARSEARRAY_RESET(childValueSparseArrayp, marpaWrapperAsfp);
+  }
   if (valueip != NULL) {
     *valueip = valuei;
   }
@@ -3212,6 +3378,61 @@ ok:
   return 0;
 }
 
+/****************************************************************************/
+short marpaWrapperAsf_traverse_rh_gladeIdb(marpaWrapperAsfTraverser_t *traverserp, int rhIxi, int *gladeIdip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_traverse_rh_gladeIdb)
+  genericLogger_t            *genericLoggerp = NULL;
+  marpaWrapperAsf_t          *marpaWrapperAsfp;
+  marpaWrapperAsfGlade_t     *gladep;
+  marpaWrapperAsfSymch_t     *symchp;
+  marpaWrapperAsfFactoring_t *factoringp;
+  int                         gladeIdi;
+
+  if (MARPAWRAPPER_UNLIKELY(traverserp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  marpaWrapperAsfp = traverserp->marpaWrapperAsfp;
+  genericLoggerp   = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
+    goto err;
+  }
+  symchp = _marpaWrapperAsf_glade_symchp(marpaWrapperAsfp, gladep, traverserp->symchIxi);
+  if (MARPAWRAPPER_UNLIKELY(symchp == NULL)) {
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(symchp->ruleIdi < 0)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "A token has no RHS");
+    goto err;
+  }
+  factoringp = _marpaWrapperAsf_symch_factoringp(marpaWrapperAsfp, symchp, traverserp->factoringIxi);
+  if (MARPAWRAPPER_UNLIKELY(factoringp == NULL)) {
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY((rhIxi < 0) || (rhIxi >= factoringp->nFactori))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "rhIxi should be in range [0..%d]", factoringp->nFactori - 1);
+    goto err;
+  }
+  gladeIdi = marpaWrapperAsfp->factorip[factoringp->firstFactori + rhIxi];
+
+  if (gladeIdip != NULL) {
+    *gladeIdip = gladeIdi;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (*gladeIdip=%d)", gladeIdi);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
 /****************************************************************************/
 short marpaWrapperAsf_traverse_symbolIdb(marpaWrapperAsfTraverser_t *traverserp, int *symbolIdip)
 /****************************************************************************/
@@ -3231,9 +3452,9 @@ short marpaWrapperAsf_traverse_symbolIdb(marpaWrapperAsfTraverser_t *traverserp,
   marpaWrapperAsfp = traverserp->marpaWrapperAsfp;
   genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
   gladeIdi = gladep->idi;
@@ -3262,10 +3483,8 @@ short marpaWrapperAsf_traverse_ruleIdb(marpaWrapperAsfTraverser_t *traverserp, i
   MARPAWRAPPER_FUNCS(marpaWrapperAsf_traverse_ruleIdb)
   genericLogger_t          *genericLoggerp = NULL;
   marpaWrapperAsf_t        *marpaWrapperAsfp;
-  genericStack_t           *symchesStackp;
   marpaWrapperAsfGlade_t   *gladep;
-  int                       symchIxi;
-  genericStack_t           *factoringsStackp;
+  marpaWrapperAsfSymch_t   *symchp;
   int                       ruleIdi;
 
   if (MARPAWRAPPER_UNLIKELY(traverserp == NULL)) {
@@ -3276,23 +3495,16 @@ short marpaWrapperAsf_traverse_ruleIdb(marpaWrapperAsfTraverser_t *traverserp, i
   marpaWrapperAsfp = traverserp->marpaWrapperAsfp;
   genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
-    goto err;
-  }
-  symchIxi = traverserp->symchIxi;
-  symchesStackp = gladep->symchesStackp;
-  if (MARPAWRAPPER_UNLIKELY(! GENERICSTACK_IS_PTR(symchesStackp,  symchIxi))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "No symch at indice %d", symchIxi);
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
-  factoringsStackp = (genericStack_t *) GENERICSTACK_GET_PTR(symchesStackp,  symchIxi);
-  if (MARPAWRAPPER_UNLIKELY(factoringsStackp == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "Null factorings stack at symch indice %d", symchIxi);
+  symchp = _marpaWrapperAsf_glade_symchp(marpaWrapperAsfp, gladep, traverserp->symchIxi);
+  if (MARPAWRAPPER_UNLIKELY(symchp == NULL)) {
     goto err;
   }
-  ruleIdi = GENERICSTACK_GET_INT(factoringsStackp, 0);
+  ruleIdi = symchp->ruleIdi;
 
   if (ruleIdip != NULL) {
     *ruleIdip = ruleIdi;
@@ -3336,9 +3548,9 @@ static inline short _marpaWrapperAsf_traverse_nextFactoringb(marpaWrapperAsfTrav
   }
   */
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
   gladeIdi = gladep->idi;
@@ -3392,9 +3604,9 @@ static inline short _marpaWrapperAsf_traverse_nextSymchb(marpaWrapperAsfTraverse
     goto err;
   }
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
   gladeIdi = gladep->idi;
@@ -3432,6 +3644,9 @@ short marpaWrapperAsf_traverse_nextb(marpaWrapperAsfTraverser_t *traverserp, sho
 #endif
   int                       idi;
   short                     nextb = 1;
+  short                     aliveb;
+  int                       symchIxi;
+  int                       factoringIxi;
 
   if (MARPAWRAPPER_UNLIKELY(traverserp == NULL)) {
     errno = EINVAL;
@@ -3441,6 +3656,9 @@ short marpaWrapperAsf_traverse_nextb(marpaWrapperAsfTraverser_t *traverserp, sho
 #ifndef MARPAWRAPPER_NTRACE
   genericLoggerp = traverserp->marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
 #endif
+  MARPAWRAPPERASF_CONTEXT_SET(traverserp->marpaWrapperAsfp);
+  symchIxi     = traverserp->symchIxi;
+  factoringIxi = traverserp->factoringIxi;
 
   if (MARPAWRAPPER_UNLIKELY(_marpaWrapperAsf_traverse_nextFactoringb(traverserp, &idi) == 0)) {
     goto err;
@@ -3454,6 +3672,18 @@ short marpaWrapperAsf_traverse_nextb(marpaWrapperAsfTraverser_t *traverserp, sho
     }
   }
 
+  if (nextb && traverserp->marpaWrapperAsfp->prune.prunedb) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_traverse_aliveb(traverserp, &aliveb))) {
+      goto err;
+    }
+    if (! aliveb) {
+      /* Only dead factorings are left: stay where we were */
+      traverserp->symchIxi     = symchIxi;
+      traverserp->factoringIxi = factoringIxi;
+      nextb = 0;
+    }
+  }
+
   if (nextbp != NULL) {
     *nextbp = nextb;
   }
@@ -3466,6 +3696,51 @@ short marpaWrapperAsf_traverse_nextb(marpaWrapperAsfTraverser_t *traverserp, sho
   return 0;
 }
 
+/****************************************************************************/
+static inline short _marpaWrapperAsf_traverse_aliveb(marpaWrapperAsfTraverser_t *traverserp, short *alivebp)
+/****************************************************************************/
+/* Moves the traverser to the first factoring that is not dead, starting   */
+/* from its current one. It does not move if there is none.                */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_traverse_aliveb)
+  marpaWrapperAsf_t      *marpaWrapperAsfp = traverserp->marpaWrapperAsfp;
+  genericLogger_t        *genericLoggerp   = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfGlade_t *gladep;
+  marpaWrapperAsfSymch_t *symchp;
+  int                     symchIxi;
+  int                     factoringIxi;
+  short                   aliveb = 0;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY((gladep == NULL) || (gladep->nSymchi < 0))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No prepared glade found for glade ID %d", traverserp->gladeIdi);
+    goto err;
+  }
+
+  for (symchIxi = traverserp->symchIxi, factoringIxi = traverserp->factoringIxi; symchIxi < gladep->nSymchi; symchIxi++, factoringIxi = 0) {
+    symchp = &(marpaWrapperAsfp->symchp[gladep->firstSymchi + symchIxi]);
+    for (; factoringIxi < symchp->nFactoringi; factoringIxi++) {
+      if (! marpaWrapperAsfp->factoringp[symchp->firstFactoringi + factoringIxi].deadb) {
+        traverserp->symchIxi     = symchIxi;
+        traverserp->factoringIxi = factoringIxi;
+        aliveb = 1;
+        goto done;
+      }
+    }
+  }
+
+ done:
+  *alivebp = aliveb;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1, *alivebp=%d", (int) aliveb);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
 /****************************************************************************/
 marpaWrapperAsf_t *marpaWrapperAsf_traverse_asfp(marpaWrapperAsfTraverser_t *traverserp)
 /****************************************************************************/
@@ -3536,16 +3811,107 @@ short marpaWrapperAsf_genericLoggerp(marpaWrapperAsf_t *marpaWrapperAsfp, generi
 }
 
 /****************************************************************************/
-void _marpaWrapperAsf_idset_sparseArrayFreev(void *userDatavp, void **pp)
+short marpaWrapperAsf_intsetStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nIntsetlp, size_t *nLookuplp, size_t *nProbelp, size_t *maxProbelp, size_t *nCollisionlp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_intsetStatsb)
+  marpaWrapperAsfIntsetTable_t *intsetTablep;
+
+  if (marpaWrapperAsfp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  intsetTablep = &(marpaWrapperAsfp->intsetTable);
+  if (nIntsetlp != NULL) {
+    *nIntsetlp = intsetTablep->usedl;
+  }
+  if (nLookuplp != NULL) {
+    *nLookuplp = intsetTablep->nLookupl;
+  }
+  if (nProbelp != NULL) {
+    *nProbelp = intsetTablep->nProbel;
+  }
+  if (maxProbelp != NULL) {
+    *maxProbelp = intsetTablep->maxProbel;
+  }
+  if (nCollisionlp != NULL) {
+    *nCollisionlp = intsetTablep->nCollisionl;
+  }
+
+  MARPAWRAPPER_TRACE(marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp, funcs, "return 1");
+  return 1;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_evictionStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nEvictionlp, size_t *nRebuildlp, size_t *nByteslp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_evictionStatsb)
+
+  if (marpaWrapperAsfp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (nEvictionlp != NULL) {
+    *nEvictionlp = marpaWrapperAsfp->nEvictionl;
+  }
+  if (nRebuildlp != NULL) {
+    *nRebuildlp = marpaWrapperAsfp->nRebuildl;
+  }
+  if (nByteslp != NULL) {
+    *nByteslp = (marpaWrapperAsfp->nSymchl     * sizeof(marpaWrapperAsfSymch_t))
+      +         (marpaWrapperAsfp->nFactoringl * sizeof(marpaWrapperAsfFactoring_t))
+      +         (marpaWrapperAsfp->nFactorl    * sizeof(int));
+  }
+
+  MARPAWRAPPER_TRACE(marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp, funcs, "return 1");
+  return 1;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_memoStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nLookuplp, size_t *nHitlp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_memoStatsb)
+
+  if (marpaWrapperAsfp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (nLookuplp != NULL) {
+    *nLookuplp = marpaWrapperAsfp->memo.nLookupl;
+  }
+  if (nHitlp != NULL) {
+    *nHitlp = marpaWrapperAsfp->memo.nHitl;
+  }
+
+  MARPAWRAPPER_TRACE(marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp, funcs, "return 1");
+  return 1;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_kbestStatsb(marpaWrapperAsf_t *marpaWrapperAsfp, size_t *nGladelp, size_t *nDerivationlp)
 /****************************************************************************/
 {
-  /* We know we receive a pointer to a (marpaWrapperAsfIdset_t  *)  that is never NULL */
-  marpaWrapperAsfIdset_t  *idsetp = * ((marpaWrapperAsfIdset_t **) pp);
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_kbestStatsb)
+
+  if (marpaWrapperAsfp == NULL) {
+    errno = EINVAL;
+    return 0;
+  }
 
-  if (idsetp->idip != NULL) {
-    free(idsetp->idip);
+  if (nGladelp != NULL) {
+    *nGladelp = marpaWrapperAsfp->kbest.nVisitedl;
   }
-  free(idsetp);
+  if (nDerivationlp != NULL) {
+    *nDerivationlp = marpaWrapperAsfp->kbest.nDerivationl;
+  }
+
+  MARPAWRAPPER_TRACE(marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp, funcs, "return 1");
+  return 1;
 }
 
 /****************************************************************************/
@@ -3579,309 +3945,1423 @@ static inline unsigned long _marpaWrapperAsf_djb2_s(unsigned char *str, int leng
 }
 
 /****************************************************************************/
-int _marpaWrapperAsf_intset_keyIndFunctioni(void *userDatavp, genericStackItemType_t itemType, void **pp)
+static inline uint64_t _marpaWrapperAsf_intset_hashull(int counti, int *idip)
+/****************************************************************************/
+/* Every id goes through a multiply/xorshift round, then the whole is       */
+/* finalized with the 64-bit MurmurHash3 mixer: unlike a XOR of the ids,    */
+/* permutations, sub-sets and small values do not collapse together.        */
 /****************************************************************************/
 {
-#ifndef MARPAWRAPPER_NTRACE
-  /* For performance, this block, used only in TRACE mode, is compiled only if */
-  /* compiled with support of tracing at this level.                           */
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_intset_keyIndFunctioni)
-  marpaWrapperAsf_t *marpaWrapperAsfp = (marpaWrapperAsf_t *) userDatavp;
-  genericLogger_t   *genericLoggerp   = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-#endif
-  /* *pp is an array of int, with size at indice 0                                    */
-  int   *idip = (int *) *pp;
-  int    sizi = idip[0];
-  int    sumi = 0;
-  int    i;
-  int    rci;
-
-  if (sizi == 0) {
-    return 0;
-  }
+  uint64_t hashull = UINT64_C(0x9E3779B97F4A7C15) ^ (uint64_t) (unsigned int) counti;
+  int      i;
 
-  for (i = 1; i <= sizi; i++) {
-    sumi ^= idip[i];
-#ifndef MARPAWRAPPER_NTRACE
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "idip[%d]=%d => sumi=%d", i, idip[i], sumi);
-#endif
+  for (i = 0; i < counti; i++) {
+    hashull ^= (uint64_t) (unsigned int) idip[i];
+    hashull *= UINT64_C(0x9E3779B97F4A7C15);
+    hashull ^= hashull >> 29;
   }
 
-  rci = MARPAWRAPPERASF_INTSET_MODULO(sumi);
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "sumi=%d => indice %d", i, sumi, rci);
-#endif
+  hashull ^= hashull >> 33;
+  hashull *= UINT64_C(0xFF51AFD7ED558CCD);
+  hashull ^= hashull >> 33;
+  hashull *= UINT64_C(0xC4CEB9FE1A85EC53);
+  hashull ^= hashull >> 33;
 
-  return rci;
+  return hashull;
 }
 
 /****************************************************************************/
-short _marpaWrapperAsf_intset_keyCmpFunctionb(void *userDatavp, void **pp1, void **pp2)
+static inline short _marpaWrapperAsf_intset_growb(marpaWrapperAsf_t *marpaWrapperAsfp)
+/****************************************************************************/
+/* Doubles the number of slots, rehashing with the stored hashes.           */
 /****************************************************************************/
 {
-#ifndef MARPAWRAPPER_NTRACE
-  /* For performance, this block, used only in TRACE mode, is compiled only if */
-  /* compiled with support of tracing at this level.                           */
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_intset_keyCmpFunctionb)
-  marpaWrapperAsf_t *marpaWrapperAsfp = (marpaWrapperAsf_t *) userDatavp;
-  genericLogger_t   *genericLoggerp   = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-#endif
-  int *idi1p = (int *) *pp1;
-  int *idi2p = (int *) *pp2;
-  int  siz1i = idi1p[0];
-  int  siz2i = idi2p[0];
-  int  i;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_intset_growb)
+  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfIntsetTable_t *intsetTablep   = &(marpaWrapperAsfp->intsetTable);
+  size_t                        sizel          = (intsetTablep->sizel > 0) ? (intsetTablep->sizel * 2) : MARPAWRAPPERASF_INTSET_INITIAL_SIZE;
+  size_t                        maskl          = sizel - 1;
+  marpaWrapperAsfIntsetSlot_t  *slotp;
+  marpaWrapperAsfIntsetSlot_t  *oldSlotp;
+  size_t                        indicel;
+  size_t                        i;
+
+  if (MARPAWRAPPER_UNLIKELY(sizel < intsetTablep->sizel)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Intset table size turnaround at %ld slots", (unsigned long) intsetTablep->sizel);
+    errno = ENOMEM;
+    goto err;
+  }
 
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "siz1i %d == siz2i %d ?", siz1i, siz2i);
-#endif
-  if (siz1i != siz2i) {
-#ifndef MARPAWRAPPER_NTRACE
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
-#endif
-    return 0;
-  } else if (siz1i == 0) {
-#ifndef MARPAWRAPPER_NTRACE
-    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
-#endif
-    return 1;
+  slotp = (marpaWrapperAsfIntsetSlot_t *) malloc(sizel * sizeof(marpaWrapperAsfIntsetSlot_t));
+  if (MARPAWRAPPER_UNLIKELY(slotp == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
+    goto err;
   }
-  
-  /* By definition elements are ordered */
-  for (i = 1; i <= siz1i; i++) {
-#ifndef MARPAWRAPPER_NTRACE
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "idi1[%d] %d == idi2[%d] %d ?", i, idi1p[i], i, idi2p[i]);
-#endif
-    if (idi1p[i] != idi2p[i]) {
-#ifndef MARPAWRAPPER_NTRACE
-      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
-#endif
-      return 0;
+  for (i = 0; i < sizel; i++) {
+    slotp[i].intsetIdi = -1;
+  }
+
+  for (i = 0; i < intsetTablep->sizel; i++) {
+    oldSlotp = &(intsetTablep->slotp[i]);
+    if (oldSlotp->intsetIdi < 0) {
+      continue;
     }
+    indicel = (size_t) oldSlotp->hashull & maskl;
+    while (slotp[indicel].intsetIdi >= 0) {
+      indicel = (indicel + 1) & maskl;
+    }
+    slotp[indicel] = *oldSlotp;
   }
 
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
-#endif
+  if (intsetTablep->slotp != NULL) {
+    free(intsetTablep->slotp);
+  }
+  intsetTablep->slotp = slotp;
+  intsetTablep->sizel = sizel;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1, %ld slots", (unsigned long) sizel);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_intset_freev(marpaWrapperAsf_t *marpaWrapperAsfp)
+/****************************************************************************/
+{
+  marpaWrapperAsfIntsetTable_t *intsetTablep = &(marpaWrapperAsfp->intsetTable);
+
+  if (intsetTablep->slotp != NULL) {
+    free(intsetTablep->slotp);
+    intsetTablep->slotp = NULL;
+  }
+  MARPAWRAPPER_FREEBUF(intsetTablep->slabip);
+  intsetTablep->sizel     = 0;
+  intsetTablep->usedl     = 0;
+  intsetTablep->sizeSlabl = 0;
+  intsetTablep->nSlabl    = 0;
+}
+
+/****************************************************************************/
+static inline int _marpaWrapperAsf_or_node_es_spani(marpaWrapperAsf_t *marpaWrapperAsfp, int choicepointi, int *lengthip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_or_node_es_spani)
+#ifndef MARPAWRAPPER_NTRACE
+  genericLogger_t *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
+  Marpa_Bocage     marpaBocagep   = marpaWrapperAsfp->marpaBocagep;
+  int              originEsi;
+  int              currentEsi;
+  int              spanIdi;
+  int              lengthi;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "_marpa_b_or_node_origin(%p, %d)", marpaBocagep, choicepointi);
+  originEsi = _marpa_b_or_node_origin(marpaBocagep, choicepointi);
+  
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "_marpa_b_or_node_set(%p, %d)", marpaBocagep, choicepointi);
+  currentEsi = _marpa_b_or_node_set(marpaBocagep, choicepointi);
+  
+  spanIdi = originEsi;
+  lengthi = currentEsi - originEsi;
+
+  if (lengthip != NULL) {
+    *lengthip = lengthi;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return spanIdi=%d, *lengthip=%d", spanIdi, lengthi);
+  return spanIdi;
+}
+
+#ifndef MARPAWRAPPER_NTRACE
+/****************************************************************************/
+static inline void _marpaWrapperAsf_dump_stack(marpaWrapperAsf_t *marpaWrapperAsfp, char *what, genericStack_t *stackp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_dump_stack)
+  genericLogger_t         *genericLoggerp           = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  int                      i;
+  char                     c;
+
+  if (what == NULL) {
+    what = "uncategorized";
+  }
+  
+  if (stackp == NULL) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s stack is NULL", what);
+  } else {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s stack length is %d", what, GENERICSTACK_USED(stackp));
+    for (i = 0; i < GENERICSTACK_USED(stackp); i++) {
+      switch (GENERICSTACKITEMTYPE(stackp, i)) {
+      case GENERICSTACKITEMTYPE_NA:
+	MARPAWRAPPER_TRACE(genericLoggerp, funcs, "... stackp[%d] is NA");
+	break;
+      case GENERICSTACKITEMTYPE_CHAR:
+        c = GENERICSTACK_GET_CHAR(stackp, i);
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is CHAR: '%c' (0x%d)", i, c, (int) c);
+	break;
+      case GENERICSTACKITEMTYPE_SHORT:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is SHORT: %d", i, (int) GENERICSTACK_GET_SHORT(stackp, i));
+	break;
+      case GENERICSTACKITEMTYPE_INT:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is INT: %d", i, GENERICSTACK_GET_INT(stackp, i));
+	break;
+      case GENERICSTACKITEMTYPE_LONG:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is LONG: %ld", i, GENERICSTACK_GET_LONG(stackp, i));
+	break;
+      case GENERICSTACKITEMTYPE_FLOAT:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is FLOAT: %f", i, (double) GENERICSTACK_GET_FLOAT(stackp, i));
+	break;
+      case GENERICSTACKITEMTYPE_DOUBLE:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is DOUBLE: %f", i, GENERICSTACK_GET_DOUBLE(stackp, i));
+	break;
+      case GENERICSTACKITEMTYPE_PTR:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is PTR: %p", i, GENERICSTACK_GET_PTR(stackp, i));
+	break;
+      default:
+	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is unknown", i);
+	break;
+      }
+    }
+  }
+}
+#endif
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_choicepoint_initb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp, int nOrNodei)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_choicepoint_initb)
+  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+
+  choicepointp->nookp         = NULL;
+  choicepointp->sizeNookl     = 0;
+  choicepointp->nNooki        = 0;
+  choicepointp->nOrNodeInUsei = nOrNodei;
+  choicepointp->generationi   = 0;
+  choicepointp->orNodeInUseip = (int *) calloc((size_t) ((nOrNodei > 0) ? nOrNodei : 1), sizeof(int));
+  if (MARPAWRAPPER_UNLIKELY(choicepointp->orNodeInUseip == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "calloc failure: %s", strerror(errno));
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_choicepoint_resetv(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp)
+/****************************************************************************/
+{
+  choicepointp->nNooki = 0;
+  /* A new generation makes all OR nodes not in use */
+  if (choicepointp->generationi == INT_MAX) {
+    memset(choicepointp->orNodeInUseip, 0, (size_t) choicepointp->nOrNodeInUsei * sizeof(int));
+    choicepointp->generationi = 0;
+  }
+  choicepointp->generationi++;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FREEBUF(choicepointp->nookp);
+  if (choicepointp->orNodeInUseip != NULL) {
+    free(choicepointp->orNodeInUseip);
+    choicepointp->orNodeInUseip = NULL;
+  }
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_memo_resetv(marpaWrapperAsf_t *marpaWrapperAsfp)
+/****************************************************************************/
+{
+  marpaWrapperAsfMemo_t *memop = &(marpaWrapperAsfp->memo);
+  size_t                 i;
+
+  /* A new generation forgets all values */
+  if (memop->generationi == INT_MAX) {
+    for (i = 0; i < memop->nValuel; i++) {
+      memop->valuep[i].generationi = 0;
+    }
+    memop->generationi = 0;
+  }
+  memop->generationi++;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_memo_findb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int *valueip)
+/****************************************************************************/
+{
+  marpaWrapperAsfMemo_t *memop = &(marpaWrapperAsfp->memo);
+
+  memop->nLookupl++;
+  if ((gladeIdi < 0) || (((size_t) gladeIdi) >= memop->nValuel) || (memop->valuep[gladeIdi].generationi != memop->generationi)) {
+    return 0;
+  }
+  memop->nHitl++;
+  *valueip = memop->valuep[gladeIdi].valuei;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_memo_setb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int valuei)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_memo_setb)
+  genericLogger_t       *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfMemo_t *memop          = &(marpaWrapperAsfp->memo);
+  size_t                 wantedl;
+  size_t                 i;
+
+  if (MARPAWRAPPER_UNLIKELY(gladeIdi < 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Invalid glade id %d", gladeIdi);
+    goto err;
+  }
+
+  wantedl = ((size_t) gladeIdi) + 1;
+  if (wantedl > memop->nValuel) {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, memop->valuep, memop->sizeValuel, wantedl, sizeof(marpaWrapperAsfMemoValue_t));
+    for (i = memop->nValuel; i < wantedl; i++) {
+      memop->valuep[i].generationi = 0;
+    }
+    memop->nValuel = wantedl;
+  }
+
+  memop->valuep[gladeIdi].valuei      = valuei;
+  memop->valuep[gladeIdi].generationi = memop->generationi;
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfStats_t *statsp, marpaWrapperAsfGladeStats_t *topGladeStatsp, int nTopi, int *nTopip)
+/****************************************************************************/
+/* Trees of a glade are the sum, over its alternatives, of the product of   */
+/* the trees of the down glades. Every glade is counted once.               */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_statsb)
+  genericLogger_t        *genericLoggerp = NULL;
+  marpaWrapperAsfStats_t  stats;
+  int                     peakGladeIdi;
+  int                     nTopFoundi     = 0;
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  if (topGladeStatsp == NULL) {
+    nTopi = 0;
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi))) {
+    goto err;
+  }
+
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfp->countp, marpaWrapperAsfp->sizeCountl, marpaWrapperAsfp->nGladel, sizeof(marpaWrapperAsfCount_t));
+  memset(marpaWrapperAsfp->countp, 0, marpaWrapperAsfp->nGladel * sizeof(marpaWrapperAsfCount_t));
+  marpaWrapperAsfp->nCountl = marpaWrapperAsfp->nGladel;
+
+  memset(&stats, 0, sizeof(stats));
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_stats_gladeb(marpaWrapperAsfp, peakGladeIdi, &stats, topGladeStatsp, nTopi, &nTopFoundi))) {
+    goto err;
+  }
+  stats.nTreel = marpaWrapperAsfp->countp[peakGladeIdi].nTreel;
+
+  if (statsp != NULL) {
+    *statsp = stats;
+  }
+  if (nTopip != NULL) {
+    *nTopip = nTopFoundi;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (%lu trees%s, %ld glades, %ld ambiguous)", (unsigned long) stats.nTreel, stats.treesSaturatedb ? " at least" : "", (long) stats.nGladel, (long) stats.nAmbiguousGladel);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_glade_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfGladeStats_t *gladeStatsp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_glade_statsb)
+  genericLogger_t *genericLoggerp = NULL;
+
+  if (MARPAWRAPPER_UNLIKELY((marpaWrapperAsfp == NULL) || (gladeStatsp == NULL))) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+
+  if (MARPAWRAPPER_UNLIKELY((gladeIdi < 0) || (((size_t) gladeIdi) >= marpaWrapperAsfp->nCountl) || (marpaWrapperAsfp->countp[gladeIdi].stateb != 1))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d was not counted by marpaWrapperAsf_statsb()", gladeIdi);
+    goto err;
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_glade_statsb(marpaWrapperAsfp, gladeIdi, gladeStatsp))) {
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_stats_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfStats_t *statsp, marpaWrapperAsfGladeStats_t *topGladeStatsp, int nTopi, int *nTopip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_stats_gladeb)
+  genericLogger_t             *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfCount_t      *countp         = marpaWrapperAsfp->countp;
+  marpaWrapperAsfGlade_t      *gladep;
+  marpaWrapperAsfSymch_t      *symchp;
+  marpaWrapperAsfFactoring_t  *factoringp;
+  marpaWrapperAsfGladeStats_t  gladeStats;
+  int                          firstSymchi;
+  int                          nSymchi;
+  int                          symchi;
+  int                          factoringi;
+  int                          factorIxi;
+  int                          downGladeIdi;
+  int                          nAlternativei   = 0;
+  size_t                       nTreel          = 0;
+  size_t                       nFactoringTreel;
+  int                          topi;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY((gladep == NULL) || (gladep->nSymchi < 0))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No prepared glade found for glade ID %d", gladeIdi);
+    goto err;
+  }
+  countp[gladeIdi].stateb = -1;
+  firstSymchi = gladep->firstSymchi;
+  nSymchi     = gladep->nSymchi;
+
+  for (symchi = firstSymchi; symchi < firstSymchi + nSymchi; symchi++) {
+    symchp = &(marpaWrapperAsfp->symchp[symchi]);
+    if (symchp->factoringsOmittedb) {
+      statsp->factoringsOmittedb = 1;
+    }
+    for (factoringi = symchp->firstFactoringi; factoringi < symchp->firstFactoringi + symchp->nFactoringi; factoringi++) {
+      factoringp = &(marpaWrapperAsfp->factoringp[factoringi]);
+      if (factoringp->deadb) {
+        continue;
+      }
+      nAlternativei++;
+      nFactoringTreel = 1;
+      /* The factor of a token is the glade itself */
+      if (symchp->ruleIdi >= 0) {
+        for (factorIxi = 0; factorIxi < factoringp->nFactori; factorIxi++) {
+          downGladeIdi = marpaWrapperAsfp->factorip[factoringp->firstFactori + factorIxi];
+          if (countp[downGladeIdi].stateb == 0) {
+            if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_stats_gladeb(marpaWrapperAsfp, downGladeIdi, statsp, topGladeStatsp, nTopi, nTopip))) {
+              goto err;
+            }
+          } else if (MARPAWRAPPER_UNLIKELY(countp[downGladeIdi].stateb < 0)) {
+            MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d is its own descendant", downGladeIdi);
+            goto err;
+          }
+          /* The factoring pointer is still valid: glade contents do not move once prepared */
+          if ((nFactoringTreel > 0) && (countp[downGladeIdi].nTreel > (((size_t) -1) / nFactoringTreel))) {
+            nFactoringTreel         = (size_t) -1;
+            statsp->treesSaturatedb = 1;
+          } else {
+            nFactoringTreel *= countp[downGladeIdi].nTreel;
+          }
+        }
+      }
+      if (nFactoringTreel > (((size_t) -1) - nTreel)) {
+        nTreel                  = (size_t) -1;
+        statsp->treesSaturatedb = 1;
+      } else {
+        nTreel += nFactoringTreel;
+      }
+    }
+    statsp->nFactoringl += symchp->nFactoringi;
+  }
+
+  countp[gladeIdi].nTreel = nTreel;
+  countp[gladeIdi].stateb = 1;
+  statsp->nGladel++;
+  statsp->nSymchl += nSymchi;
+
+  if (nAlternativei > 1) {
+    statsp->nAmbiguousGladel++;
+    if (nTopi > 0) {
+      if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_glade_statsb(marpaWrapperAsfp, gladeIdi, &gladeStats))) {
+        goto err;
+      }
+      /* Insertion in the top glades, the best first: the last one goes away if it is full */
+      if (*nTopip < nTopi) {
+        topi = (*nTopip)++;
+      } else if (_marpaWrapperAsf_glade_stats_betterb(&gladeStats, &(topGladeStatsp[nTopi - 1]))) {
+        topi = nTopi - 1;
+      } else {
+        topi = -1;
+      }
+      if (topi >= 0) {
+        while ((topi > 0) && _marpaWrapperAsf_glade_stats_betterb(&gladeStats, &(topGladeStatsp[topi - 1]))) {
+          topGladeStatsp[topi] = topGladeStatsp[topi - 1];
+          topi--;
+        }
+        topGladeStatsp[topi] = gladeStats;
+      }
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (glade %d: %d alternatives, %lu trees)", gladeIdi, nAlternativei, (unsigned long) nTreel);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_glade_statsb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, marpaWrapperAsfGladeStats_t *gladeStatsp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_statsb)
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfGlade_t *gladep;
+  marpaWrapperAsfSymch_t *symchp;
+  int                     symchi;
+  int                     factoringi;
+  int                     symboli;
+  int                     starti;
+  int                     lengthi;
+  int                     nAlternativei  = 0;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY((gladep == NULL) || (gladep->nSymchi < 0))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No prepared glade found for glade ID %d", gladeIdi);
+    goto err;
+  }
+  symboli = _marpaWrapperAsf_glade_symbol_idi(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY(symboli < 0)) {
+    goto err;
+  }
+  starti = _marpaWrapperAsf_glade_spani(marpaWrapperAsfp, gladeIdi, &lengthi);
+  if (MARPAWRAPPER_UNLIKELY(starti < 0)) {
+    goto err;
+  }
+
+  for (symchi = gladep->firstSymchi; symchi < gladep->firstSymchi + gladep->nSymchi; symchi++) {
+    symchp = &(marpaWrapperAsfp->symchp[symchi]);
+    for (factoringi = symchp->firstFactoringi; factoringi < symchp->firstFactoringi + symchp->nFactoringi; factoringi++) {
+      if (! marpaWrapperAsfp->factoringp[factoringi].deadb) {
+        nAlternativei++;
+      }
+    }
+  }
+
+  gladeStatsp->gladeIdi      = gladeIdi;
+  gladeStatsp->symboli       = symboli;
+  gladeStatsp->starti        = starti;
+  gladeStatsp->lengthi       = lengthi;
+  gladeStatsp->nAlternativei = nAlternativei;
+  gladeStatsp->nTreel        = marpaWrapperAsfp->countp[gladeIdi].nTreel;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (glade %d: symbol %d at [%d, %d[, %d alternatives)", gladeIdi, symboli, starti, starti + lengthi, nAlternativei);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_glade_stats_betterb(marpaWrapperAsfGladeStats_t *gladeStats1p, marpaWrapperAsfGladeStats_t *gladeStats2p)
+/****************************************************************************/
+{
+  if (gladeStats1p->nAlternativei != gladeStats2p->nAlternativei) {
+    return (gladeStats1p->nAlternativei > gladeStats2p->nAlternativei) ? 1 : 0;
+  }
+  return (gladeStats1p->nTreel > gladeStats2p->nTreel) ? 1 : 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_pruneb(marpaWrapperAsf_t *marpaWrapperAsfp, void *userDatavp,
+                             marpaWrapperAsfOkRuleCallback_t    okRuleCallbackp,
+                             marpaWrapperAsfOkSymbolCallback_t  okSymbolCallbackp,
+                             marpaWrapperAsfOkNullingCallback_t okNullingCallbackp,
+                             size_t *nDeadFactoringlp)
+/****************************************************************************/
+/* Ok callbacks are called once per symch, before any tree is enumerated,  */
+/* and a rejection kills the factorings of the symch. A factoring with a   */
+/* dead down glade is dead, and a glade with no factoring alive is dead.   */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_pruneb)
+  genericLogger_t        *genericLoggerp = NULL;
+  marpaWrapperAsfPrune_t *prunep;
+  int                     peakGladeIdi;
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  prunep         = &(marpaWrapperAsfp->prune);
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  /* Token values are span IDs, as in marpaWrapperAsf_traverse_rh_valueb() */
+  if (MARPAWRAPPER_UNLIKELY((okSymbolCallbackp != NULL) && (marpaWrapperAsfp->marpaWrapperRecognizerp->haveVariableLengthTokenb != 0))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "This call is not allowed if there is at least one variablen length token");
+    goto err;
+  }
+
+  /* Dead flags are in glade contents, that are not evicted after that */
+  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi))) {
+    goto err;
+  }
+
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, prunep->gladeStatebp, prunep->sizeGladeStatel, marpaWrapperAsfp->nGladel, sizeof(short));
+  memset(prunep->gladeStatebp, 0, marpaWrapperAsfp->nGladel * sizeof(short));
+
+  GENERICSTACK_NEW(prunep->parentRuleiStackp);
+  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(prunep->parentRuleiStackp))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "parentRuleiStackp initialization failure, %s", strerror(errno));
+    goto err;
+  }
+  prunep->userDatavp         = userDatavp;
+  prunep->okRuleCallbackp    = okRuleCallbackp;
+  prunep->okSymbolCallbackp  = okSymbolCallbackp;
+  prunep->okNullingCallbackp = okNullingCallbackp;
+
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_prune_gladeb(marpaWrapperAsfp, peakGladeIdi))) {
+    goto err;
+  }
+  GENERICSTACK_FREE(prunep->parentRuleiStackp);
+
+  if (nDeadFactoringlp != NULL) {
+    *nDeadFactoringlp = prunep->nDeadFactoringl;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (%ld dead factorings, peak glade %s)", (long) prunep->nDeadFactoringl, (prunep->gladeStatebp[peakGladeIdi] == 1) ? "alive" : "dead");
+  return 1;
+
+ err:
+  if (marpaWrapperAsfp != NULL) {
+    GENERICSTACK_FREE(marpaWrapperAsfp->prune.parentRuleiStackp);
+  }
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_prune_gladeb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_prune_gladeb)
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfPrune_t *prunep         = &(marpaWrapperAsfp->prune);
+  marpaWrapperAsfGlade_t *gladep;
+  marpaWrapperAsfSymch_t *symchp;
+  int                     firstSymchi;
+  int                     nSymchi;
+  int                     symchi;
+  int                     firstFactoringi;
+  int                     nFactoringi;
+  int                     factoringi;
+  int                     firstFactori;
+  int                     nFactori;
+  int                     factorIxi;
+  int                     downGladeIdi;
+  int                     symboli;
+  int                     argi;
+  short                   aliveb = 0;
+  short                   rcb;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY((gladep == NULL) || (gladep->nSymchi < 0))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No prepared glade found for glade ID %d", gladeIdi);
+    goto err;
+  }
+  prunep->gladeStatebp[gladeIdi] = -1;
+  firstSymchi = gladep->firstSymchi;
+  nSymchi     = gladep->nSymchi;
+
+  for (symchi = firstSymchi; symchi < firstSymchi + nSymchi; symchi++) {
+    symchp          = &(marpaWrapperAsfp->symchp[symchi]);
+    firstFactoringi = symchp->firstFactoringi;
+    nFactoringi     = symchp->nFactoringi;
+
+    /* Nothing to ask if the symch is already dead */
+    for (factoringi = firstFactoringi; factoringi < firstFactoringi + nFactoringi; factoringi++) {
+      if (! marpaWrapperAsfp->factoringp[factoringi].deadb) {
+        break;
+      }
+    }
+    if (factoringi >= firstFactoringi + nFactoringi) {
+      continue;
+    }
+
+    rcb = 1;
+    if (symchp->ruleIdi < 0) {
+      /* A token: its single factoring is the glade itself */
+      if ((prunep->okSymbolCallbackp != NULL) || (prunep->okNullingCallbackp != NULL)) {
+        if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_glade_tokenb(marpaWrapperAsfp, gladeIdi, &symboli, &argi))) {
+          goto err;
+        }
+        if (argi < 0) {
+          if (prunep->okNullingCallbackp != NULL) {
+            rcb = prunep->okNullingCallbackp(prunep->userDatavp, prunep->parentRuleiStackp, symboli);
+          }
+        } else {
+          if (prunep->okSymbolCallbackp != NULL) {
+            rcb = prunep->okSymbolCallbackp(prunep->userDatavp, prunep->parentRuleiStackp, symboli, argi);
+          }
+        }
+        MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+        if (MARPAWRAPPER_UNLIKELY(rcb == 0)) {
+          MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d ok callback says failure", symboli);
+          goto err;
+        }
+      }
+      if (rcb < 0) {
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Glade %d: symbol No %d is rejected", gladeIdi, symboli);
+        _marpaWrapperAsf_prune_factoringv(marpaWrapperAsfp, firstFactoringi);
+      } else {
+        aliveb = 1;
+      }
+      continue;
+    }
+
+    if (prunep->okRuleCallbackp != NULL) {
+      rcb = prunep->okRuleCallbackp(prunep->userDatavp, prunep->parentRuleiStackp, symchp->ruleIdi, -1, -1);
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+      if (MARPAWRAPPER_UNLIKELY(rcb == 0)) {
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Rule No %d ok callback says failure", symchp->ruleIdi);
+        goto err;
+      }
+    }
+
+    for (factoringi = firstFactoringi; factoringi < firstFactoringi + nFactoringi; factoringi++) {
+      if (marpaWrapperAsfp->factoringp[factoringi].deadb) {
+        continue;
+      }
+      if (rcb < 0) {
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Glade %d: rule No %d is rejected", gladeIdi, symchp->ruleIdi);
+        _marpaWrapperAsf_prune_factoringv(marpaWrapperAsfp, factoringi);
+        continue;
+      }
+      firstFactori = marpaWrapperAsfp->factoringp[factoringi].firstFactori;
+      nFactori     = marpaWrapperAsfp->factoringp[factoringi].nFactori;
+      for (factorIxi = 0; factorIxi < nFactori; factorIxi++) {
+        downGladeIdi = marpaWrapperAsfp->factorip[firstFactori + factorIxi];
+        if (prunep->gladeStatebp[downGladeIdi] == 0) {
+          if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_prune_gladeb(marpaWrapperAsfp, downGladeIdi))) {
+            goto err;
+          }
+        } else if (MARPAWRAPPER_UNLIKELY(prunep->gladeStatebp[downGladeIdi] < 0)) {
+          MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d is its own descendant", downGladeIdi);
+          goto err;
+        }
+        if (prunep->gladeStatebp[downGladeIdi] != 1) {
+          break;
+        }
+      }
+      if (factorIxi < nFactori) {
+        _marpaWrapperAsf_prune_factoringv(marpaWrapperAsfp, factoringi);
+      } else {
+        aliveb = 1;
+      }
+    }
+  }
+
+  prunep->gladeStatebp[gladeIdi] = aliveb ? 1 : 2;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (glade %d is %s)", gladeIdi, aliveb ? "alive" : "dead");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_prune_factoringv(marpaWrapperAsf_t *marpaWrapperAsfp, int factoringi)
+/****************************************************************************/
+{
+  marpaWrapperAsfp->factoringp[factoringi].deadb = 1;
+  marpaWrapperAsfp->prune.nDeadFactoringl++;
+  marpaWrapperAsfp->prune.prunedb = 1;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_kbestb(marpaWrapperAsf_t *marpaWrapperAsfp, int ki, void *userDatavp, marpaWrapperAsfTokenScoreCallback_t tokenScoreCallbackp, int *nTreeip)
+/****************************************************************************/
+/* Lazy k-best extraction (Huang and Chiang, 2005): the derivations of a    */
+/* glade are found one at a time and on demand, so that only the parts of  */
+/* the forest that contribute to the ki best trees go beyond their best    */
+/* derivation.                                                              */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_kbestb)
+  genericLogger_t             *genericLoggerp = NULL;
+  marpaWrapperAsfKbest_t      *kbestp;
+  marpaWrapperAsfKbestGlade_t *kbestGladep;
+  int                          peakGladeIdi;
+  int                          treei;
+  int                          derivationi;
+  size_t                       i;
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  kbestp         = &(marpaWrapperAsfp->kbest);
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  if (MARPAWRAPPER_UNLIKELY(ki <= 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Invalid number of trees %d", ki);
+    goto err;
+  }
+
+  /* Token values are span IDs, as in marpaWrapperAsf_traverse_rh_valueb() */
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp->marpaWrapperRecognizerp->haveVariableLengthTokenb != 0)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "This call is not allowed if there is at least one variablen length token");
+    goto err;
+  }
+
+  /* Glade contents do not move after that */
+  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi))) {
+    goto err;
+  }
+
+  kbestp->nDerivationl        = 0;
+  kbestp->nDownl              = 0;
+  kbestp->nTreei              = 0;
+  kbestp->nVisitedl           = 0;
+  kbestp->userDatavp          = userDatavp;
+  kbestp->tokenScoreCallbackp = tokenScoreCallbackp;
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, kbestp->gladep, kbestp->sizeGladel, marpaWrapperAsfp->nGladel, sizeof(marpaWrapperAsfKbestGlade_t));
+  for (i = 0; i < marpaWrapperAsfp->nGladel; i++) {
+    kbestGladep = &(kbestp->gladep[i]);
+    kbestGladep->stateb      = 0;
+    kbestGladep->expandedb   = 0;
+    kbestGladep->firstFoundi = -1;
+    kbestGladep->lastFoundi  = -1;
+    kbestGladep->heapi       = -1;
+  }
+
+  for (treei = 0, derivationi = -1; treei < ki; treei++) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_nextb(marpaWrapperAsfp, peakGladeIdi, derivationi, &derivationi))) {
+      goto err;
+    }
+    if (derivationi < 0) {
+      break;
+    }
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, kbestp->treeip, kbestp->sizeTreel, (size_t) treei + 1, sizeof(int));
+    kbestp->treeip[treei] = derivationi;
+    kbestp->nTreei        = treei + 1;
+  }
+
+  if (nTreeip != NULL) {
+    *nTreeip = kbestp->nTreei;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (*nTreeip=%d, %ld derivations)", kbestp->nTreei, (long) kbestp->nDerivationl);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperAsf_kbest_valueb(marpaWrapperAsf_t *marpaWrapperAsfp, int treei, void *userDatavp,
+                                   marpaWrapperValueRuleCallback_t valueRuleCallbackp,
+                                   marpaWrapperValueSymbolCallback_t valueSymbolCallbackp,
+                                   marpaWrapperValueNullingCallback_t valueNullingCallbackp,
+                                   int *scoreip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsf_kbest_valueb)
+  genericLogger_t        *genericLoggerp = NULL;
+  marpaWrapperAsfKbest_t *kbestp;
+  int                     derivationi;
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  kbestp         = &(marpaWrapperAsfp->kbest);
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp);
+
+  if (MARPAWRAPPER_UNLIKELY((treei < 0) || (treei >= kbestp->nTreei))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No k-best tree No %d", treei);
+    goto err;
+  }
+
+  derivationi = kbestp->treeip[treei];
+  if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_value_derivationb(marpaWrapperAsfp, derivationi, 0, userDatavp, valueRuleCallbackp, valueSymbolCallbackp, valueNullingCallbackp))) {
+    goto err;
+  }
+
+  if (scoreip != NULL) {
+    *scoreip = kbestp->derivationp[derivationi].scorei;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (score %d)", kbestp->derivationp[derivationi].scorei);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperAsf_kbest_freev(marpaWrapperAsf_t *marpaWrapperAsfp)
+/****************************************************************************/
+{
+  marpaWrapperAsfKbest_t *kbestp = &(marpaWrapperAsfp->kbest);
+
+  MARPAWRAPPER_FREEBUF(kbestp->gladep);
+  MARPAWRAPPER_FREEBUF(kbestp->derivationp);
+  MARPAWRAPPER_FREEBUF(kbestp->downip);
+  MARPAWRAPPER_FREEBUF(kbestp->treeip);
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_kbest_nextb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int derivationi, int *nextip)
+/****************************************************************************/
+/* *nextip is the found derivation of the glade that follows derivationi,   */
+/* or its best one when derivationi is -1. It is -1 if there is none. The   */
+/* successors of the last found derivation become candidates only when     */
+/* another one is wanted.                                                   */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_kbest_nextb)
+  genericLogger_t             *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfKbest_t      *kbestp         = &(marpaWrapperAsfp->kbest);
+  marpaWrapperAsfKbestGlade_t *kbestGladep;
+  int                          nexti;
+
+  if (MARPAWRAPPER_UNLIKELY((gladeIdi < 0) || (((size_t) gladeIdi) >= marpaWrapperAsfp->nGladel))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Invalid glade id %d", gladeIdi);
+    goto err;
+  }
+
+  /* The array of k-best glades does not move during an extraction */
+  kbestGladep = &(kbestp->gladep[gladeIdi]);
+  if (kbestGladep->stateb == 0) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_visitb(marpaWrapperAsfp, gladeIdi))) {
+      goto err;
+    }
+  } else if (MARPAWRAPPER_UNLIKELY(kbestGladep->stateb < 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Glade %d is its own descendant", gladeIdi);
+    goto err;
+  }
+
+  nexti = (derivationi < 0) ? kbestGladep->firstFoundi : kbestp->derivationp[derivationi].nextFoundi;
+  if ((nexti < 0) && (derivationi == kbestGladep->lastFoundi)) {
+    if ((kbestGladep->lastFoundi >= 0) && (! kbestGladep->expandedb)) {
+      kbestGladep->expandedb = 1;
+      if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_successorsb(marpaWrapperAsfp, kbestGladep->lastFoundi))) {
+        goto err;
+      }
+    }
+    if (kbestGladep->heapi >= 0) {
+      nexti = _marpaWrapperAsf_kbest_heap_popi(marpaWrapperAsfp, kbestGladep);
+      if (kbestGladep->lastFoundi >= 0) {
+        kbestp->derivationp[kbestGladep->lastFoundi].nextFoundi = nexti;
+      } else {
+        kbestGladep->firstFoundi = nexti;
+      }
+      kbestGladep->lastFoundi = nexti;
+      kbestGladep->expandedb  = 0;
+    }
+  }
+
+  *nextip = nexti;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (glade %d, derivation %d: next %d)", gladeIdi, derivationi, nexti);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_kbest_visitb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi)
+/****************************************************************************/
+/* The first candidates of a glade are the best derivation of every        */
+/* factoring, and the derivation of every token symch.                      */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_kbest_visitb)
+  genericLogger_t             *genericLoggerp       = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperGrammar_t       *marpaWrapperGrammarp = marpaWrapperAsfp->marpaWrapperRecognizerp->marpaWrapperGrammarp;
+  marpaWrapperAsfKbest_t      *kbestp               = &(marpaWrapperAsfp->kbest);
+  marpaWrapperAsfKbestGlade_t *kbestGladep          = &(kbestp->gladep[gladeIdi]);
+  marpaWrapperAsfGlade_t      *gladep;
+  int                          firstSymchi;
+  int                          nSymchi;
+  int                          symchi;
+  int                          ruleIdi;
+  int                          firstFactoringi;
+  int                          nFactoringi;
+  int                          factoringi;
+  int                          firstFactori;
+  int                          nFactori;
+  int                          factorIxi;
+  int                          scorei;
+  int                          symboli;
+  int                          argi;
+  int                          derivationi;
+  int                          downDerivationi;
+
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY((gladep == NULL) || (gladep->nSymchi < 0))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No prepared glade found for glade ID %d", gladeIdi);
+    goto err;
+  }
+  kbestGladep->stateb = -1;
+  firstSymchi = gladep->firstSymchi;
+  nSymchi     = gladep->nSymchi;
+
+  for (symchi = firstSymchi; symchi < firstSymchi + nSymchi; symchi++) {
+    ruleIdi = marpaWrapperAsfp->symchp[symchi].ruleIdi;
+    if (ruleIdi < 0) {
+      if (marpaWrapperAsfp->factoringp[marpaWrapperAsfp->symchp[symchi].firstFactoringi].deadb) {
+        continue;
+      }
+      scorei = 0;
+      if (kbestp->tokenScoreCallbackp != NULL) {
+        if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_glade_tokenb(marpaWrapperAsfp, gladeIdi, &symboli, &argi))) {
+          goto err;
+        }
+        if (MARPAWRAPPER_UNLIKELY(! kbestp->tokenScoreCallbackp(kbestp->userDatavp, symboli, argi, &scorei))) {
+          MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d score callback says failure", symboli);
+          goto err;
+        }
+        MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+      }
+      derivationi = _marpaWrapperAsf_kbest_derivation_newi(marpaWrapperAsfp, scorei, gladeIdi, symchi, -1, 0);
+      if (MARPAWRAPPER_UNLIKELY(derivationi < 0)) {
+        goto err;
+      }
+      kbestGladep->heapi = _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsfp, kbestGladep->heapi, derivationi);
+      continue;
+    }
+
+    if (MARPAWRAPPER_UNLIKELY(((size_t) ruleIdi) >= marpaWrapperGrammarp->nRulel)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Unknown rule No %d", ruleIdi);
+      goto err;
+    }
+    firstFactoringi = marpaWrapperAsfp->symchp[symchi].firstFactoringi;
+    nFactoringi     = marpaWrapperAsfp->symchp[symchi].nFactoringi;
+    for (factoringi = firstFactoringi; factoringi < firstFactoringi + nFactoringi; factoringi++) {
+      if (marpaWrapperAsfp->factoringp[factoringi].deadb) {
+        continue;
+      }
+      firstFactori = marpaWrapperAsfp->factoringp[factoringi].firstFactori;
+      nFactori     = marpaWrapperAsfp->factoringp[factoringi].nFactori;
+      derivationi  = _marpaWrapperAsf_kbest_derivation_newi(marpaWrapperAsfp, 0, gladeIdi, symchi, factoringi, nFactori);
+      if (MARPAWRAPPER_UNLIKELY(derivationi < 0)) {
+        goto err;
+      }
+      scorei = marpaWrapperGrammarp->ruleArrayp[ruleIdi].marpaWrapperGrammarRuleOption.ranki;
+      for (factorIxi = 0; factorIxi < nFactori; factorIxi++) {
+        if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_nextb(marpaWrapperAsfp, marpaWrapperAsfp->factorip[firstFactori + factorIxi], -1, &downDerivationi))) {
+          goto err;
+        }
+        if (downDerivationi < 0) {
+          break;
+        }
+        kbestp->downip[kbestp->derivationp[derivationi].firstDowni + factorIxi] = downDerivationi;
+        scorei += kbestp->derivationp[downDerivationi].scorei;
+      }
+      if (factorIxi < nFactori) {
+        /* A down glade without derivation: so is this factoring */
+        continue;
+      }
+      kbestp->derivationp[derivationi].scorei = scorei;
+      kbestGladep->heapi = _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsfp, kbestGladep->heapi, derivationi);
+    }
+  }
+
+  kbestGladep->stateb = 1;
+  kbestp->nVisitedl++;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (glade %d)", gladeIdi);
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsf_kbest_successorsb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivationi)
+/****************************************************************************/
+/* A successor uses the next derivation of one down glade. Only the        */
+/* factors from the last one that is not at its best derivation move on:   */
+/* every candidate then has a single predecessor, no better than itself,   */
+/* and no candidate is created twice.                                      */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_kbest_successorsb)
+#ifndef MARPAWRAPPER_NTRACE
+  genericLogger_t        *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
+  marpaWrapperAsfKbest_t *kbestp         = &(marpaWrapperAsfp->kbest);
+  int                     gladeIdi       = kbestp->derivationp[derivationi].gladeIdi;
+  int                     symchi         = kbestp->derivationp[derivationi].symchi;
+  int                     factoringi     = kbestp->derivationp[derivationi].factoringi;
+  int                     firstDowni     = kbestp->derivationp[derivationi].firstDowni;
+  int                     firstFactori;
+  int                     nFactori;
+  int                     factorIxi;
+  int                     downGladeIdi;
+  int                     downDerivationi;
+  int                     nextDownDerivationi;
+  int                     successori;
+
+  if (factoringi < 0) {
+    /* A token has a single derivation */
+    goto done;
+  }
+
+  firstFactori = marpaWrapperAsfp->factoringp[factoringi].firstFactori;
+  nFactori     = marpaWrapperAsfp->factoringp[factoringi].nFactori;
+  for (factorIxi = nFactori - 1; factorIxi > 0; factorIxi--) {
+    downGladeIdi = marpaWrapperAsfp->factorip[firstFactori + factorIxi];
+    if (kbestp->downip[firstDowni + factorIxi] != kbestp->gladep[downGladeIdi].firstFoundi) {
+      break;
+    }
+  }
+
+  for (; factorIxi < nFactori; factorIxi++) {
+    downGladeIdi    = marpaWrapperAsfp->factorip[firstFactori + factorIxi];
+    downDerivationi = kbestp->downip[firstDowni + factorIxi];
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_nextb(marpaWrapperAsfp, downGladeIdi, downDerivationi, &nextDownDerivationi))) {
+      goto err;
+    }
+    if (nextDownDerivationi < 0) {
+      continue;
+    }
+
+    successori = _marpaWrapperAsf_kbest_derivation_newi(marpaWrapperAsfp,
+                                                        kbestp->derivationp[derivationi].scorei - kbestp->derivationp[downDerivationi].scorei + kbestp->derivationp[nextDownDerivationi].scorei,
+                                                        gladeIdi,
+                                                        symchi,
+                                                        factoringi,
+                                                        nFactori);
+    if (MARPAWRAPPER_UNLIKELY(successori < 0)) {
+      goto err;
+    }
+    /* The pool of down derivations may have moved */
+    memcpy(&(kbestp->downip[kbestp->derivationp[successori].firstDowni]), &(kbestp->downip[firstDowni]), nFactori * sizeof(int));
+    kbestp->downip[kbestp->derivationp[successori].firstDowni + factorIxi] = nextDownDerivationi;
+
+    kbestp->gladep[gladeIdi].heapi = _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsfp, kbestp->gladep[gladeIdi].heapi, successori);
+  }
+
+ done:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
   return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
 }
 
 /****************************************************************************/
-void *_marpaWrapperAsf_intset_keyCopyFunctionp(void *userDatavp, void **pp)
+static inline int _marpaWrapperAsf_kbest_derivation_newi(marpaWrapperAsf_t *marpaWrapperAsfp, int scorei, int gladeIdi, int symchi, int factoringi, int nFactori)
+/****************************************************************************/
+/* Returns the indice of the new derivation, or -1. Down derivations are   */
+/* left to the caller.                                                      */
 /****************************************************************************/
 {
-#ifndef MARPAWRAPPER_NTRACE
-  /* For performance, this block, used only in TRACE mode, is compiled only if */
-  /* compiled with support of tracing at this level.                           */
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_intset_keyCopyFunctionp)
-  marpaWrapperAsf_t *marpaWrapperAsfp = (marpaWrapperAsf_t *) userDatavp;
-  genericLogger_t   *genericLoggerp   = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-#endif
-  int   *idip = (int *) *pp;
-  int    sizi = idip[0];
-  size_t sizl = sizeof(int) * (sizi + 1);
-  int   *rcp = NULL;
-
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "sizi %ld", (unsigned long) sizl);
-#endif
-
-  rcp = (int *) malloc(sizl);
-  if (MARPAWRAPPER_UNLIKELY(rcp == NULL)) {
-#ifndef MARPAWRAPPER_NTRACE
-    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
-#endif
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_kbest_derivation_newi)
+  genericLogger_t                  *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfKbest_t           *kbestp         = &(marpaWrapperAsfp->kbest);
+  marpaWrapperAsfKbestDerivation_t *derivationp;
+  int                               derivationi;
+
+  if (MARPAWRAPPER_UNLIKELY((kbestp->nDerivationl >= INT_MAX) || ((kbestp->nDownl + nFactori) >= INT_MAX))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Too many k-best derivations");
     goto err;
   }
-  memcpy(rcp, idip, sizl);
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", rcp);
-#endif
-  return rcp;
+  MARPAWRAPPER_MANAGEBUF(genericLoggerp, kbestp->derivationp, kbestp->sizeDerivationl, kbestp->nDerivationl + 1, sizeof(marpaWrapperAsfKbestDerivation_t));
+  if (nFactori > 0) {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, kbestp->downip, kbestp->sizeDownl, kbestp->nDownl + nFactori, sizeof(int));
+  }
+
+  derivationi = (int) kbestp->nDerivationl++;
+  derivationp = &(kbestp->derivationp[derivationi]);
+  derivationp->scorei     = scorei;
+  derivationp->gladeIdi   = gladeIdi;
+  derivationp->symchi     = symchi;
+  derivationp->factoringi = factoringi;
+  derivationp->firstDowni = (int) kbestp->nDownl;
+  derivationp->nextFoundi = -1;
+  derivationp->childi     = -1;
+  derivationp->siblingi   = -1;
+  kbestp->nDownl += nFactori;
+
+  return derivationi;
 
  err:
-#ifndef MARPAWRAPPER_NTRACE
-  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
-#endif
-  return rcp;
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return -1");
+  return -1;
 }
 
 /****************************************************************************/
-void _marpaWrapperAsf_intset_keyFreeFunctionv(void *userDatavp, void **pp)
+static inline short _marpaWrapperAsf_kbest_betterb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivation1i, int derivation2i)
 /****************************************************************************/
 {
-  free((int *) *pp);
+  marpaWrapperAsfKbestDerivation_t *derivationp = marpaWrapperAsfp->kbest.derivationp;
+
+  if (derivationp[derivation1i].scorei != derivationp[derivation2i].scorei) {
+    return (derivationp[derivation1i].scorei > derivationp[derivation2i].scorei) ? 1 : 0;
+  }
+  return (derivation1i < derivation2i) ? 1 : 0;
 }
 
 /****************************************************************************/
-static inline int _marpaWrapperAsf_or_node_es_spani(marpaWrapperAsf_t *marpaWrapperAsfp, int choicepointi, int *lengthip)
+static inline int _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsf_t *marpaWrapperAsfp, int heap1i, int heap2i)
+/****************************************************************************/
+/* Returns the root of the meld of two pairing heaps, that have no sibling */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_or_node_es_spani)
-#ifndef MARPAWRAPPER_NTRACE
-  genericLogger_t *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-#endif
-  Marpa_Bocage     marpaBocagep   = marpaWrapperAsfp->marpaBocagep;
-  int              originEsi;
-  int              currentEsi;
-  int              spanIdi;
-  int              lengthi;
-
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "_marpa_b_or_node_origin(%p, %d)", marpaBocagep, choicepointi);
-  originEsi = _marpa_b_or_node_origin(marpaBocagep, choicepointi);
-  
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "_marpa_b_or_node_set(%p, %d)", marpaBocagep, choicepointi);
-  currentEsi = _marpa_b_or_node_set(marpaBocagep, choicepointi);
-  
-  spanIdi = originEsi;
-  lengthi = currentEsi - originEsi;
+  marpaWrapperAsfKbestDerivation_t *derivationp = marpaWrapperAsfp->kbest.derivationp;
+  int                               besti;
+  int                               otheri;
 
-  if (lengthip != NULL) {
-    *lengthip = lengthi;
+  if (heap1i < 0) {
+    return heap2i;
+  }
+  if (heap2i < 0) {
+    return heap1i;
+  }
+  if (_marpaWrapperAsf_kbest_betterb(marpaWrapperAsfp, heap2i, heap1i)) {
+    besti  = heap2i;
+    otheri = heap1i;
+  } else {
+    besti  = heap1i;
+    otheri = heap2i;
   }
+  derivationp[otheri].siblingi = derivationp[besti].childi;
+  derivationp[besti].childi    = otheri;
 
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return spanIdi=%d, *lengthip=%d", spanIdi, lengthi);
-  return spanIdi;
+  return besti;
 }
 
-#ifndef MARPAWRAPPER_NTRACE
 /****************************************************************************/
-static inline void _marpaWrapperAsf_dump_stack(marpaWrapperAsf_t *marpaWrapperAsfp, char *what, genericStack_t *stackp)
+static inline int _marpaWrapperAsf_kbest_heap_popi(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfKbestGlade_t *kbestGladep)
+/****************************************************************************/
+/* The heap must not be empty. Children of the root are melded by pairs,   */
+/* left to right, then the pairs are melded right to left.                  */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_dump_stack)
-  genericLogger_t         *genericLoggerp           = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  int                      i;
-  char                     c;
-
-  if (what == NULL) {
-    what = "uncategorized";
-  }
-  
-  if (stackp == NULL) {
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s stack is NULL", what);
-  } else {
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%s stack length is %d", what, GENERICSTACK_USED(stackp));
-    for (i = 0; i < GENERICSTACK_USED(stackp); i++) {
-      switch (GENERICSTACKITEMTYPE(stackp, i)) {
-      case GENERICSTACKITEMTYPE_NA:
-	MARPAWRAPPER_TRACE(genericLoggerp, funcs, "... stackp[%d] is NA");
-	break;
-      case GENERICSTACKITEMTYPE_CHAR:
-        c = GENERICSTACK_GET_CHAR(stackp, i);
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is CHAR: '%c' (0x%d)", i, c, (int) c);
-	break;
-      case GENERICSTACKITEMTYPE_SHORT:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is SHORT: %d", i, (int) GENERICSTACK_GET_SHORT(stackp, i));
-	break;
-      case GENERICSTACKITEMTYPE_INT:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is INT: %d", i, GENERICSTACK_GET_INT(stackp, i));
-	break;
-      case GENERICSTACKITEMTYPE_LONG:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is LONG: %ld", i, GENERICSTACK_GET_LONG(stackp, i));
-	break;
-      case GENERICSTACKITEMTYPE_FLOAT:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is FLOAT: %f", i, (double) GENERICSTACK_GET_FLOAT(stackp, i));
-	break;
-      case GENERICSTACKITEMTYPE_DOUBLE:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is DOUBLE: %f", i, GENERICSTACK_GET_DOUBLE(stackp, i));
-	break;
-      case GENERICSTACKITEMTYPE_PTR:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is PTR: %p", i, GENERICSTACK_GET_PTR(stackp, i));
-	break;
-      default:
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "... stackp[%d] is unknown", i);
-	break;
-      }
+  marpaWrapperAsfKbestDerivation_t *derivationp = marpaWrapperAsfp->kbest.derivationp;
+  int                               besti       = kbestGladep->heapi;
+  int                               childi      = derivationp[besti].childi;
+  int                               pairsi      = -1;
+  int                               heapi       = -1;
+  int                               firsti;
+  int                               secondi;
+  int                               nexti;
+
+  while (childi >= 0) {
+    firsti  = childi;
+    secondi = derivationp[firsti].siblingi;
+    childi  = (secondi >= 0) ? derivationp[secondi].siblingi : -1;
+    derivationp[firsti].siblingi = -1;
+    if (secondi >= 0) {
+      derivationp[secondi].siblingi = -1;
     }
+    firsti = _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsfp, firsti, secondi);
+    derivationp[firsti].siblingi = pairsi;
+    pairsi = firsti;
+  }
+
+  while (pairsi >= 0) {
+    nexti = derivationp[pairsi].siblingi;
+    derivationp[pairsi].siblingi = -1;
+    heapi  = _marpaWrapperAsf_kbest_heap_meldi(marpaWrapperAsfp, heapi, pairsi);
+    pairsi = nexti;
   }
+
+  derivationp[besti].childi = -1;
+  kbestGladep->heapi        = heapi;
+
+  return besti;
 }
-#endif
 
 /****************************************************************************/
-static inline marpaWrapperAsfChoicePoint_t *_marpaWrapperAsf_choicepoint_newp(marpaWrapperAsf_t *marpaWrapperAsfp)
+static inline short _marpaWrapperAsf_glade_tokenb(marpaWrapperAsf_t *marpaWrapperAsfp, int gladeIdi, int *symbolip, int *argip)
+/****************************************************************************/
+/* *argip is the indice in the input stack, -1 for a nulling token          */
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_choicepoint_newp)
-  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  marpaWrapperAsfChoicePoint_t *choicepointp;
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_glade_tokenb)
+#ifndef MARPAWRAPPER_NTRACE
+  genericLogger_t *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
+  int              symboli;
+  int              spanIdi;
+  int              lengthi;
 
-  choicepointp = (marpaWrapperAsfChoicePoint_t *) malloc(sizeof(marpaWrapperAsfChoicePoint_t));
-  if (MARPAWRAPPER_UNLIKELY(choicepointp == NULL)) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
+  symboli = _marpaWrapperAsf_glade_symbol_idi(marpaWrapperAsfp, gladeIdi);
+  if (MARPAWRAPPER_UNLIKELY(symboli < 0)) {
     goto err;
   }
-
-  choicepointp->factoringStackp   = NULL;
-  GENERICSPARSEARRAY_NEW(choicepointp->orNodeInUseSparseArrayp, _marpaWrapperAsf_orNodeInUse_sparseArrayIndi);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSPARSEARRAY_ERROR(choicepointp->orNodeInUseSparseArrayp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "orNodeInUseSparseArrayp initialization failure: %s", strerror(errno));
+  spanIdi = _marpaWrapperAsf_glade_spani(marpaWrapperAsfp, gladeIdi, &lengthi);
+  if (MARPAWRAPPER_UNLIKELY(spanIdi < 0)) {
     goto err;
   }
 
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", choicepointp);
-  return choicepointp;
+  *symbolip = symboli;
+  /* Real values start at indice 1 of the input stack */
+  *argip    = (lengthi > 0) ? (spanIdi + 1) : -1;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return 1 (symbol %d, arg %d)", *symbolip, *argip);
+  return 1;
 
  err:
-  _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsfp, choicepointp);
-  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
-  return NULL;
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
 }
 
 /****************************************************************************/
-static inline void _marpaWrapperAsf_choicepoint_freev(marpaWrapperAsf_t *marpaWrapperAsfp, marpaWrapperAsfChoicePoint_t *choicepointp)
+static inline short _marpaWrapperAsf_kbest_value_derivationb(marpaWrapperAsf_t *marpaWrapperAsfp, int derivationi, int stacki, void *userDatavp,
+                                                             marpaWrapperValueRuleCallback_t valueRuleCallbackp,
+                                                             marpaWrapperValueSymbolCallback_t valueSymbolCallbackp,
+                                                             marpaWrapperValueNullingCallback_t valueNullingCallbackp)
+/****************************************************************************/
+/* The RHS of a rule at stacki are at stacki, stacki + 1, etc...            */
 /****************************************************************************/
 {
-  if (choicepointp != NULL) {
-    _marpaWrapperAsf_factoringStackp_freev(marpaWrapperAsfp, &(choicepointp->factoringStackp));
-    GENERICSPARSEARRAY_FREE(choicepointp->orNodeInUseSparseArrayp, marpaWrapperAsfp);
-    free(choicepointp);
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_kbest_value_derivationb)
+  genericLogger_t                  *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfKbest_t           *kbestp         = &(marpaWrapperAsfp->kbest);
+  marpaWrapperAsfKbestDerivation_t *derivationp    = &(kbestp->derivationp[derivationi]);
+  int                               ruleIdi        = marpaWrapperAsfp->symchp[derivationp->symchi].ruleIdi;
+  int                               symboli;
+  int                               argi;
+  int                               nFactori;
+  int                               factorIxi;
+  int                               downDerivationi;
+  short                             rcb;
+
+  if (derivationp->factoringi < 0) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_glade_tokenb(marpaWrapperAsfp, derivationp->gladeIdi, &symboli, &argi))) {
+      goto err;
+    }
+    if (argi < 0) {
+      if (MARPAWRAPPER_UNLIKELY(valueNullingCallbackp == NULL)) {
+        MARPAWRAPPER_ERRORF(genericLoggerp, "Value nulling callback is needed for symbol No %d", symboli);
+        goto err;
+      }
+      rcb = valueNullingCallbackp(userDatavp, symboli, stacki);
+    } else {
+      if (MARPAWRAPPER_UNLIKELY(valueSymbolCallbackp == NULL)) {
+        MARPAWRAPPER_ERRORF(genericLoggerp, "Value symbol callback is needed for symbol No %d", symboli);
+        goto err;
+      }
+      rcb = valueSymbolCallbackp(userDatavp, symboli, argi, stacki);
+    }
+    MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+    if (MARPAWRAPPER_UNLIKELY(! rcb)) {
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d value callback says failure", symboli);
+      goto err;
+    }
+    goto done;
+  }
+
+  /* No derivation is created during valuation: derivationp stays valid */
+  nFactori = marpaWrapperAsfp->factoringp[derivationp->factoringi].nFactori;
+  for (factorIxi = 0; factorIxi < nFactori; factorIxi++) {
+    downDerivationi = kbestp->downip[derivationp->firstDowni + factorIxi];
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsf_kbest_value_derivationb(marpaWrapperAsfp, downDerivationi, stacki + factorIxi, userDatavp, valueRuleCallbackp, valueSymbolCallbackp, valueNullingCallbackp))) {
+      goto err;
+    }
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(valueRuleCallbackp == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Value rule callback is needed for rule No %d", ruleIdi);
+    goto err;
+  }
+  rcb = valueRuleCallbackp(userDatavp, ruleIdi, stacki, stacki + nFactori - 1, stacki);
+  MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+  if (MARPAWRAPPER_UNLIKELY(! rcb)) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Rule No %d value callback says failure", ruleIdi);
+    goto err;
   }
+
+ done:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
 }
 
 #ifndef MARPAWRAPPER_NTRACE
 /****************************************************************************/
-static void _marpaWrapperAsf_dumpintsetHashpv(marpaWrapperAsf_t *marpaWrapperAsfp)
+static void _marpaWrapperAsf_dumpintsetTablev(marpaWrapperAsf_t *marpaWrapperAsfp)
 /****************************************************************************/
 {
-  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_dumpintsetHashpv)
-  genericLogger_t   *genericLoggerp  = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
-  genericHash_t     *intsetHashp     = marpaWrapperAsfp->intsetHashp;
-  int                i;
-  int                j;
-  int                k;
-  int               *idip;
-  int                nInRowi;
-
-  if (intsetHashp == NULL) {
-    return;
-  }
-
-  for (i = 0; i < GENERICSTACK_USED(intsetHashp->keyStackp); i++) {
-    genericStack_t *subStackp;
-
-    if (! GENERICSTACK_IS_PTR(intsetHashp->keyStackp, i)) {
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsf_dumpintsetTablev)
+  genericLogger_t              *genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfIntsetTable_t *intsetTablep   = &(marpaWrapperAsfp->intsetTable);
+  marpaWrapperAsfIntsetSlot_t  *slotp;
+  size_t                        i;
+  int                           k;
+
+  for (i = 0; i < intsetTablep->sizel; i++) {
+    slotp = &(intsetTablep->slotp[i]);
+    if (slotp->intsetIdi < 0) {
       continue;
     }
-
-    subStackp = GENERICSTACK_GET_PTR(intsetHashp->keyStackp, i);
-    nInRowi = 0;
-    for (j = 0; j < GENERICSTACK_USED(subStackp); j++) {
-
-      if (! GENERICSTACK_IS_PTR(subStackp, j)) {
-	continue;
-      }
-      ++nInRowi;
-      idip = GENERICSTACK_GET_PTR(subStackp, j);
-      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Row %6d column %6d", i, j);
-      for (k = 1; k <= idip[0]; k++) {
-	MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "   %d", idip[k]);
-      }
-    }
-    if (nInRowi > 1) {
-      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Row %6d has %d collisions", i, nInRowi);
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Slot %6ld intset %6d home slot %6ld", (unsigned long) i, slotp->intsetIdi, (unsigned long) (slotp->hashull & (intsetTablep->sizel - 1)));
+    for (k = 0; k < slotp->counti; k++) {
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "   %d", intsetTablep->slabip[slotp->offsetl + k]);
     }
   }
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "%ld lookups, %ld probes, max probe %ld, %ld collisions",
+                      (unsigned long) intsetTablep->nLookupl,
+                      (unsigned long) intsetTablep->nProbel,
+                      (unsigned long) intsetTablep->maxProbel,
+                      (unsigned long) intsetTablep->nCollisionl);
 }
 #endif
 
@@ -3909,6 +5389,8 @@ marpaWrapperAsfValue_t *marpaWrapperAsfValue_newp(marpaWrapperRecognizer_t *marp
   }
 
   genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  /* The value traverser depends on the path to the glade */
+  marpaWrapperAsfp->marpaWrapperAsfOption.memob = 0;
 
   marpaWrapperAsfValuep = (marpaWrapperAsfValue_t *) malloc(sizeof(marpaWrapperAsfValue_t));
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperAsfValuep == NULL)) {
@@ -3933,8 +5415,12 @@ marpaWrapperAsfValue_t *marpaWrapperAsfValue_newp(marpaWrapperRecognizer_t *marp
   marpaWrapperAsfValuep->indicei                           = -1;
   marpaWrapperAsfValuep->wantNextChoiceb                   = 0;
   marpaWrapperAsfValuep->gotNextChoiceb                    = 0;
-  marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp = NULL;
-  marpaWrapperAsfValuep->haveNextChoicePerLevelStackp      = NULL;
+  marpaWrapperAsfValuep->nodep                             = NULL;
+  marpaWrapperAsfValuep->sizeNodel                         = 0;
+  marpaWrapperAsfValuep->nNodei                            = 0;
+  marpaWrapperAsfValuep->nextChoiceIndicei                 = -1;
+  marpaWrapperAsfValuep->skipOkb                           = 0;
+  marpaWrapperAsfValuep->rejectb                           = 0;
 
   GENERICSTACK_NEW(marpaWrapperAsfValuep->parentRuleiStackp);
   if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfValuep->parentRuleiStackp))) {
@@ -3942,18 +5428,6 @@ marpaWrapperAsfValue_t *marpaWrapperAsfValue_newp(marpaWrapperRecognizer_t *marp
     goto err;
   }
 
-  GENERICSTACK_NEW(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp initialization failure: %s", strerror(errno));
-    goto err;
-  }
-
-  GENERICSTACK_NEW(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp);
-  if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp))) {
-    MARPAWRAPPER_ERRORF(genericLoggerp, "marpaWrapperAsfValuep->haveNextChoicePerLevelStackp initialization failure: %s", strerror(errno));
-    goto err;
-  }
-
   goto done;
 
  err:
@@ -4007,22 +5481,28 @@ short marpaWrapperAsfValue_valueb(marpaWrapperAsfValue_t *marpaWrapperAsfValuep,
     MARPAWRAPPER_TRACE(genericLoggerp, funcs,"-------------------------");
     MARPAWRAPPER_TRACE(genericLoggerp, funcs,"Current state of choices:");
     MARPAWRAPPER_TRACE(genericLoggerp, funcs,"-------------------------");
-    for (i = 0; i < GENERICSTACK_USED(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp); i++) {
-      if (GENERICSTACK_IS_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i)) {
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"haveNextChoicePerLevelStackp[%d]=%d", i, (int) GENERICSTACK_GET_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i));
-      } else {
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"haveNextChoicePerLevelStackp[%d]=NA", i);
-      }
+    for (i = 0; i < marpaWrapperAsfValuep->nNodei; i++) {
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"node[%d]: haveNextChoice=%d, consumedNextChoices=%d, endIndice=%d", i, (int) marpaWrapperAsfValuep->nodep[i].haveNextChoiceb, marpaWrapperAsfValuep->nodep[i].consumedNextChoicesi, marpaWrapperAsfValuep->nodep[i].endIndicei);
     }
-    for (i = 0; i < GENERICSTACK_USED(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp); i++) {
-      if (GENERICSTACK_IS_INT(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp, i)) {
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"consumedNextChoicesPerLevelStackp[%d]=%d", i, GENERICSTACK_GET_SHORT(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp, i));
-      } else {
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"consumedNextChoicesPerLevelStackp[%d]=NA", i);
+  }
+#endif
+
+  /* The node that takes its next choice is the deepest one that has another choice: any node  */
+  /* before it and not containing it is replayed as in the previous tree. This is reliable only */
+  /* if there was no rejection: else nodes of rejected alternatives have taken indices.        */
+  if (marpaWrapperAsfValuep->wantNextChoiceb) {
+    int i;
+
+    marpaWrapperAsfValuep->nextChoiceIndicei = -1;
+    for (i = marpaWrapperAsfValuep->nNodei - 1; i >= 0; i--) {
+      if (marpaWrapperAsfValuep->nodep[i].haveNextChoiceb > 0) {
+        marpaWrapperAsfValuep->nextChoiceIndicei = i;
+        break;
       }
     }
+    marpaWrapperAsfValuep->skipOkb = (marpaWrapperAsfp->marpaWrapperAsfOption.okCacheb != 0) && (! marpaWrapperAsfValuep->rejectb) && (marpaWrapperAsfValuep->nextChoiceIndicei >= 0);
   }
-#endif
+  marpaWrapperAsfValuep->rejectb = 0;
 
   /* Check if next round should be done */
   if (MARPAWRAPPER_UNLIKELY((marpaWrapperAsfp->marpaWrapperAsfOption.maxParsesi > 0) && (marpaWrapperAsfValuep->nParsesi >= marpaWrapperAsfp->marpaWrapperAsfOption.maxParsesi))) {
@@ -4076,7 +5556,10 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
 /*             0 if the end                                                 */
 /*             1 if ok                                                      */
 /*                                                                          */
-/* Each iteration is doing a replay to get positionned where needed.        */
+/* Each iteration is doing a replay to get positionned where needed: every */
+/* tree is traversed and valued again. With the okCacheb option, only the   */
+/* ok callbacks are not called during the replay of the nodes that end      */
+/* before the node taking its next choice.                                  */
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(_marpaWrapperAsf_valueTraverserb)
@@ -4105,17 +5588,21 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
   int                                 argni;
   int                                 localWantedOutputStacki;
   short                               manageNextChoiceb;
-  int                                 consumedNextChoicesi;
+  int                                 consumedNextChoicesi  = 0;
   int                                 nextChoicei;
-  int                                 numberOfLevelsInStacki;
-  int                                 i;
-  short                               isDeepestLevelWithAChoiceb;
-  short                               haveLevelWithAChoiceb;
+  marpaWrapperAsfValueNode_t         *nodep;
+  short                               skipOkb;
   int                                 indicei;
 
   marpaWrapperAsfValuep->leveli++;
   marpaWrapperAsfValuep->traverserp = traverserp; /* Take care: any call CAN change it - this is why it is restored systematically after ANY call */
   indicei = ++marpaWrapperAsfValuep->indicei;
+  /* Ok callbacks already accepted this node in the previous tree */
+  skipOkb = 0;
+  if (marpaWrapperAsfValuep->skipOkb && (indicei < marpaWrapperAsfValuep->nextChoiceIndicei)) {
+    nodep = _marpaWrapperAsfValue_nodep(marpaWrapperAsfValuep, indicei);
+    skipOkb = (nodep == NULL) || (nodep->endIndicei <= marpaWrapperAsfValuep->nextChoiceIndicei);
+  }
 
   rcb = marpaWrapperAsf_genericLoggerp(marpaWrapperAsfp, &genericLoggerp);
   marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
@@ -4155,8 +5642,13 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
         MARPAWRAPPER_ERRORF(genericLoggerp, "Ok nulling callback is needed for symbol No %d", marpaSymbolIdi);
         goto reject;
       }
-      rcb = okNullingCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaSymbolIdi);
-      marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      if (skipOkb) {
+        rcb = 1;
+      } else {
+        rcb = okNullingCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaSymbolIdi);
+        marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+        MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+      }
       if (rcb < 0) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d ok nulling callback says reject", marpaSymbolIdi);
         goto reject;
@@ -4170,6 +5662,7 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
       }
       rcb = valueNullingCallbackp(marpaWrapperAsfValuep->userDatavp, marpaSymbolIdi, wantedOutputStacki);
       marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
       if (MARPAWRAPPER_UNLIKELY(! rcb)) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d value nulling callback says failure", marpaSymbolIdi);
         goto err;
@@ -4183,8 +5676,13 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
         MARPAWRAPPER_ERRORF(genericLoggerp, "Ok symbol callback is needed for symbol No %d", marpaSymbolIdi);
         goto reject;
       }
-      rcb = okSymbolCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaSymbolIdi, tokenValuei);
-      marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      if (skipOkb) {
+        rcb = 1;
+      } else {
+        rcb = okSymbolCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaSymbolIdi, tokenValuei);
+        marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+        MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+      }
       if (rcb < 0) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d ok callback says reject", marpaSymbolIdi);
         goto reject;
@@ -4198,6 +5696,7 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
       }
       rcb = valueSymbolCallbackp(marpaWrapperAsfValuep->userDatavp, marpaSymbolIdi, tokenValuei, wantedOutputStacki);
       marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
       if (MARPAWRAPPER_UNLIKELY(! rcb)) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol No %d value callback says failure", marpaSymbolIdi);
         goto err;
@@ -4219,8 +5718,9 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
     consumedNextChoicesi = 0;
 
     /* Look how far is this level */
-    if (GENERICSTACK_IS_INT(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp, indicei)) {
-      consumedNextChoicesi = GENERICSTACK_GET_INT(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp, indicei);
+    nodep = _marpaWrapperAsfValue_nodep(marpaWrapperAsfValuep, indicei);
+    if ((nodep != NULL) && (nodep->consumedNextChoicesi >= 0)) {
+      consumedNextChoicesi = nodep->consumedNextChoicesi;
       if (consumedNextChoicesi > 0) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Consuming immediately %d choices", marpaWrapperAsfValuep->leveli, indicei, consumedNextChoicesi);
         for (nextChoicei = 1; nextChoicei <= consumedNextChoicesi; nextChoicei++) {
@@ -4239,63 +5739,35 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
       }
     }
 
-    if (marpaWrapperAsfValuep->wantNextChoiceb) {
-      if (! marpaWrapperAsfValuep->gotNextChoiceb) {
-        if (GENERICSTACK_IS_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, indicei) &&
-            GENERICSTACK_GET_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, indicei)) {
-          /* We accept to get next choice at this iteration only if this is the deepest that give this possibility */
-          numberOfLevelsInStacki = GENERICSTACK_USED(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp);
-          isDeepestLevelWithAChoiceb = 1;
-          for (i = indicei + 1; i < numberOfLevelsInStacki; i++) {
-            if (GENERICSTACK_IS_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i) &&
-                GENERICSTACK_GET_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i)) {
-              MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Not switching to next choice - another iteration can do so indice at %d", marpaWrapperAsfValuep->leveli, indicei, i);
-              isDeepestLevelWithAChoiceb = 0;
-              break;
-            }
-          }
-          if (isDeepestLevelWithAChoiceb) {
-            marpaWrapperAsfValuep->gotNextChoiceb = 1;
-            MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Getting next choice", marpaWrapperAsfValuep->leveli, indicei);
-            /* We do not do the goto nextRule, because we want to verify that the prediction was correct */
-            rcb = marpaWrapperAsf_traverse_nextb(traverserp, &nextb);
-            marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
-            if (MARPAWRAPPER_UNLIKELY(! rcb)) {
-              goto err;
-            }
-            if (MARPAWRAPPER_UNLIKELY(! nextb)) {
-              /* Impossible */
-              MARPAWRAPPER_ERRORF(genericLoggerp, "[%3d][%3d] ==> Predicted next choice does not exist", marpaWrapperAsfValuep->leveli, indicei);
-              goto err;
-            }
-            rcb = marpaWrapperAsf_traverse_ruleIdb(traverserp, &marpaRuleIdi);
-            marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
-            if (MARPAWRAPPER_UNLIKELY(! rcb)) {
-              goto err;
-            }
-            ++consumedNextChoicesi;
-
-            /* This is invalidating all the further iteration numbers */
-            MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Invalidating any other setup after current indice", marpaWrapperAsfValuep->leveli, indicei);
-            GENERICSTACK_USED(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp)      = indicei + 1;
-            GENERICSTACK_USED(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp) = indicei + 1;
-          }
-        }
+    if (marpaWrapperAsfValuep->wantNextChoiceb && (! marpaWrapperAsfValuep->gotNextChoiceb)) {
+      if (marpaWrapperAsfValuep->nextChoiceIndicei < 0) {
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> No choice is available at any iteration - end of parse tree valuation", marpaWrapperAsfValuep->leveli, indicei);
+        goto err;
       }
-      if (! marpaWrapperAsfValuep->gotNextChoiceb) {
-        /* If we are here, this is an error ir no choice change is possible at any iteration */
-        haveLevelWithAChoiceb = 0;
-        for (i = 0; i < GENERICSTACK_USED(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp); i++) {
-          if (GENERICSTACK_IS_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i) &&
-              GENERICSTACK_GET_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, i)) {
-            haveLevelWithAChoiceb = 1;
-            break;
-          }
+      if (indicei == marpaWrapperAsfValuep->nextChoiceIndicei) {
+        marpaWrapperAsfValuep->gotNextChoiceb = 1;
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Getting next choice", marpaWrapperAsfValuep->leveli, indicei);
+        /* We do not do the goto nextRule, because we want to verify that the prediction was correct */
+        rcb = marpaWrapperAsf_traverse_nextb(traverserp, &nextb);
+        marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+        if (MARPAWRAPPER_UNLIKELY(! rcb)) {
+          goto err;
         }
-        if (MARPAWRAPPER_UNLIKELY(! haveLevelWithAChoiceb)) {
-          MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> No choice is available at any iteration - end of parse tree valuation", marpaWrapperAsfValuep->leveli, indicei);
+        if (MARPAWRAPPER_UNLIKELY(! nextb)) {
+          /* Impossible */
+          MARPAWRAPPER_ERRORF(genericLoggerp, "[%3d][%3d] ==> Predicted next choice does not exist", marpaWrapperAsfValuep->leveli, indicei);
           goto err;
         }
+        rcb = marpaWrapperAsf_traverse_ruleIdb(traverserp, &marpaRuleIdi);
+        marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+        if (MARPAWRAPPER_UNLIKELY(! rcb)) {
+          goto err;
+        }
+        ++consumedNextChoicesi;
+
+        /* This is invalidating all the further iteration numbers */
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Invalidating any other setup after current indice", marpaWrapperAsfValuep->leveli, indicei);
+        marpaWrapperAsfValuep->nNodei = indicei + 1;
       }
     }
 
@@ -4344,8 +5816,13 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
         MARPAWRAPPER_ERRORF(genericLoggerp, "Ok rule callback is needed for rule No %d", marpaRuleIdi);
         goto reject;
       }
-      rcb = okRuleCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaRuleIdi, arg0i, argni);
-      marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      if (skipOkb) {
+        rcb = 1;
+      } else {
+        rcb = okRuleCallbackp(marpaWrapperAsfValuep->userDatavp, marpaWrapperAsfValuep->parentRuleiStackp, marpaRuleIdi, arg0i, argni);
+        marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+        MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
+      }
       if (rcb < 0) {
         MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Rule No %d value callback says reject", marpaRuleIdi);
 	if (nbAlternativeOki == 0) {
@@ -4363,6 +5840,7 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
       }
       rcb = valueRuleCallbackp(marpaWrapperAsfValuep->userDatavp, marpaRuleIdi, arg0i, argni, wantedOutputStacki);
       marpaWrapperAsfValuep->traverserp = traverserp; /* Restore */
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfp); /* Restore */
       if (MARPAWRAPPER_UNLIKELY(! rcb)) {
         MARPAWRAPPER_ERRORF(genericLoggerp, "Rule No %d value callback failure", marpaSymbolIdi);
         goto err;
@@ -4406,6 +5884,7 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
   /* Formally not an error, we indicate our caller this is a rejection */
   rcb = 1;
   wantedOutputStacki = -1;
+  marpaWrapperAsfValuep->rejectb = 1;
   goto done;
 
  err:
@@ -4419,19 +5898,10 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
       goto err;
     }
     if (manageNextChoiceb) {
-      GENERICSTACK_SET_SHORT(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp, nextb, indicei);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp))) {
-        MARPAWRAPPER_ERRORF(genericLoggerp, "[%3d][%3d] ==> marpaWrapperAsfValuep->haveNextChoicePerLevelStackp set failure, %s", marpaWrapperAsfValuep->leveli, indicei, strerror(errno));
-        goto err;
-      }
-      MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Setted have next choice flag to %d", marpaWrapperAsfValuep->leveli, indicei, (int) nextb);
-
-      GENERICSTACK_SET_INT(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp, consumedNextChoicesi, indicei);
-      if (MARPAWRAPPER_UNLIKELY(GENERICSTACK_ERROR(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp))) {
-        MARPAWRAPPER_ERRORF(genericLoggerp, "[%3d][%3d] ==> marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp set failure, %s", marpaWrapperAsfValuep->leveli, indicei, strerror(errno));
+      if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperAsfValue_node_setb(marpaWrapperAsfValuep, indicei, nextb, consumedNextChoicesi, marpaWrapperAsfValuep->indicei + 1))) {
         goto err;
       }
-      MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Setted consumed next choices to %d", marpaWrapperAsfValuep->leveli, indicei, consumedNextChoicesi);
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs,"[%3d][%3d] ==> Setted have next choice flag to %d, consumed next choices to %d", marpaWrapperAsfValuep->leveli, indicei, (int) nextb, consumedNextChoicesi);
     }
     if (valueip != NULL) {
       *valueip = wantedOutputStacki;
@@ -4451,14 +5921,83 @@ static inline short _marpaWrapperAsf_valueTraverserb(marpaWrapperAsfTraverser_t
   return rcb;
 }
 
+/****************************************************************************/
+static inline marpaWrapperAsfValueNode_t *_marpaWrapperAsfValue_nodep(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int indicei)
+/****************************************************************************/
+/* Returns NULL if the node at indicei is not set.                          */
+/****************************************************************************/
+{
+  if ((indicei >= 0) && (indicei < marpaWrapperAsfValuep->nNodei)) {
+    return &(marpaWrapperAsfValuep->nodep[indicei]);
+  }
+  return NULL;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperAsfValue_node_setb(marpaWrapperAsfValue_t *marpaWrapperAsfValuep, int indicei, short haveNextChoiceb, int consumedNextChoicesi, int endIndicei)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperAsfValue_node_setb)
+  genericLogger_t            *genericLoggerp = marpaWrapperAsfValuep->marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+  marpaWrapperAsfValueNode_t *nodep;
+  int                         i;
+
+  if (indicei >= marpaWrapperAsfValuep->nNodei) {
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperAsfValuep->nodep, marpaWrapperAsfValuep->sizeNodel, (size_t) indicei + 1, sizeof(marpaWrapperAsfValueNode_t));
+    for (i = marpaWrapperAsfValuep->nNodei; i < indicei; i++) {
+      nodep = &(marpaWrapperAsfValuep->nodep[i]);
+      nodep->consumedNextChoicesi = -1;
+      nodep->haveNextChoiceb      = -1;
+      nodep->endIndicei           = i + 1;
+    }
+    marpaWrapperAsfValuep->nNodei = indicei + 1;
+  }
+
+  nodep = &(marpaWrapperAsfValuep->nodep[indicei]);
+  nodep->consumedNextChoicesi = consumedNextChoicesi;
+  nodep->haveNextChoiceb      = haveNextChoiceb;
+  nodep->endIndicei           = endIndicei;
+
+  return 1;
+
+ err:
+  return 0;
+}
+
+/****************************************************************************/
+marpaWrapperAsf_t *marpaWrapperAsfValue_asfp(marpaWrapperAsfValue_t *marpaWrapperAsfValuep)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperAsfValue_asfp)
+  marpaWrapperAsf_t        *marpaWrapperAsfp;
+#ifndef MARPAWRAPPER_NTRACE
+  genericLogger_t          *genericLoggerp;
+#endif
+
+  if (marpaWrapperAsfValuep == NULL) {
+    errno = EINVAL;
+    return NULL;
+  }
+
+  marpaWrapperAsfp = marpaWrapperAsfValuep->marpaWrapperAsfp;
+#ifndef MARPAWRAPPER_NTRACE
+  genericLoggerp = marpaWrapperAsfp->marpaWrapperAsfOption.genericLoggerp;
+#endif
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", marpaWrapperAsfp);
+  return marpaWrapperAsfp;
+}
+
 /****************************************************************************/
 void marpaWrapperAsfValue_freev(marpaWrapperAsfValue_t *marpaWrapperAsfValuep)
 /****************************************************************************/
 {
   if (marpaWrapperAsfValuep != NULL) {
+    if (marpaWrapperAsfValuep->marpaWrapperAsfp != NULL) {
+      MARPAWRAPPERASF_CONTEXT_SET(marpaWrapperAsfValuep->marpaWrapperAsfp);
+    }
     GENERICSTACK_FREE(marpaWrapperAsfValuep->parentRuleiStackp);
-    GENERICSTACK_FREE(marpaWrapperAsfValuep->consumedNextChoicesPerLevelStackp);
-    GENERICSTACK_FREE(marpaWrapperAsfValuep->haveNextChoicePerLevelStackp);
+    MARPAWRAPPER_FREEBUF(marpaWrapperAsfValuep->nodep);
     marpaWrapperAsf_freev(marpaWrapperAsfValuep->marpaWrapperAsfp);
     free(marpaWrapperAsfValuep);
   }
@@ -4494,9 +6033,9 @@ short marpaWrapperAsfValue_value_startb(marpaWrapperAsfValue_t *marpaWrapperAsfV
     goto err;
   }
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
 
@@ -4547,9 +6086,9 @@ short marpaWrapperAsfValue_value_lengthb(marpaWrapperAsfValue_t *marpaWrapperAsf
     goto err;
   }
 
-  gladep = traverserp->gladep;
+  gladep = _marpaWrapperAsf_glade_findp(marpaWrapperAsfp, traverserp->gladeIdi);
   if (MARPAWRAPPER_UNLIKELY(gladep == NULL)) {
-    MARPAWRAPPER_ERROR(genericLoggerp, "Current glade is NULL");
+    MARPAWRAPPER_ERRORF(genericLoggerp, "No glade found for glade ID %d", traverserp->gladeIdi);
     goto err;
   }
 
@@ -2,18 +2,31 @@
 #include <stdlib.h>
 #include <string.h>
 #include <errno.h>
+#include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#endif
 
 #include "marpa.h"
 #include "marpaWrapper/internal/config.h"
 #include "marpaWrapper/internal/_manageBuf.h"
+#include "marpaWrapper/internal/_allocator.h"
 #include "marpaWrapper/internal/_logging.h"
 #include "marpaWrapper/internal/_grammar.h"
+#include "marpaWrapper/internal/_recognizer.h"
 
 static marpaWrapperGrammarOption_t marpaWrapperGrammarOptionDefault = {
   NULL,    /* genericLoggerp             */
   0,       /* warningIsErrorb            */
   0,       /* warningIsIgnoredb          */
-  0        /* autorankb                  */
+  0,       /* autorankb                  */
+  NULL     /* allocatorp                 */
 };
 
 static marpaWrapperGrammarSymbolOption_t marpaWrapperGrammarSymbolOptionDefault = {
@@ -41,6 +54,9 @@ static marpaWrapperGrammarCloneOption_t marpaWrapperGrammarCloneOptionDefault =
 #define MARPAWRAPPERGRAMMAREVENT_WEIGHT(eventType) ((eventType) == MARPAWRAPPERGRAMMAR_EVENT_COMPLETED) ? -1 : (((eventType) == MARPAWRAPPERGRAMMAR_EVENT_NULLED) ? 0 : 1)
 static inline int   _marpaWrapperGrammar_cmpi(const void *event1p, const void *event2p);
 static inline short _marpaWrapperGrammar_precomputeb(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *startip);
+static inline void         _marpaWrapperGrammar_image_setv(unsigned char *imagep, size_t wordl, int valuei);
+static inline int          _marpaWrapperGrammar_image_geti(unsigned char *imagep, size_t wordl);
+static inline unsigned int _marpaWrapperGrammar_image_checksumi(unsigned char *p, size_t lengthl);
 
 /****************************************************************************/
 marpaWrapperGrammar_t *marpaWrapperGrammar_newp(marpaWrapperGrammarOption_t *marpaWrapperGrammarOptionp)
@@ -57,6 +73,7 @@ marpaWrapperGrammar_t *marpaWrapperGrammar_newp(marpaWrapperGrammarOption_t *mar
     marpaWrapperGrammarOptionp = &marpaWrapperGrammarOptionDefault;
   }
   genericLoggerp = marpaWrapperGrammarOptionp->genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarOptionp->allocatorp);
 
 #ifndef MARPAWRAPPER_NTRACE
   {
@@ -287,6 +304,7 @@ void marpaWrapperGrammar_freev(marpaWrapperGrammar_t *marpaWrapperGrammarp)
   if (marpaWrapperGrammarp != NULL) {
     /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
     genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+    MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
     if (marpaWrapperGrammarp->marpaGrammarp != NULL) {
       MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_unref(%p)", marpaWrapperGrammarp->marpaGrammarp);
@@ -331,6 +349,7 @@ int marpaWrapperGrammar_newSymboli(marpaWrapperGrammar_t *marpaWrapperGrammarp,
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
   /* Create symbol */
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_symbol_new(%p)", marpaWrapperGrammarp->marpaGrammarp);
@@ -446,6 +465,7 @@ int marpaWrapperGrammar_newRulei(marpaWrapperGrammar_t *marpaWrapperGrammarp, ma
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
   /* Check parameters - Some depend on marpaWrapperGrammarRuleOptionp */
   if (marpaWrapperGrammarRuleOptionp == NULL) {
@@ -576,6 +596,7 @@ int marpaWrapperGrammar_newRuleExti(marpaWrapperGrammar_t *marpaWrapperGrammarp,
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
   marpaWrapperGrammarRuleOption.ranki            = ranki;
   marpaWrapperGrammarRuleOption.nullRanksHighb   = nullRanksHighb;
@@ -667,6 +688,7 @@ static inline short _marpaWrapperGrammar_precomputeb(marpaWrapperGrammar_t *marp
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
   if (startip != NULL) {
     /* Start symbol out of bounds ? */
@@ -700,6 +722,7 @@ static inline short _marpaWrapperGrammar_precomputeb(marpaWrapperGrammar_t *marp
     MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
     goto err;
   }
+  marpaWrapperGrammarp->precomputedb = 1;
 
   /* Prefetch events */
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammar_eventb(marpaWrapperGrammarp, NULL, NULL, 0 /* exhaustionEventb */, 1) == 0)) {
@@ -719,18 +742,7 @@ short marpaWrapperGrammar_eventb(marpaWrapperGrammar_t *marpaWrapperGrammarp, si
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(marpaWrapperGrammar_eventb)
-  genericLogger_t                  *genericLoggerp = NULL;
-  marpaWrapperGrammarEvent_t       *eventp         = NULL;
-  int                               nbEventi;
-  int                               i;
-  int                               subscribedEventi;
-  const char                       *msgs;
-  const char                       *warningMsgs;
-  const char                       *fatalMsgs;
-  const char                       *infoMsgs;
-  Marpa_Event_Type                  eventType;
-  Marpa_Event                       event;
-  int                               eventValuei;
+  genericLogger_t *genericLoggerp = NULL;
 
 #ifndef NDEBUG
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammarp == NULL)) {
@@ -740,113 +752,22 @@ short marpaWrapperGrammar_eventb(marpaWrapperGrammar_t *marpaWrapperGrammarp, si
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
 
   /* Events are always fetched when necessary internally. External API can nevertheless */
-  /* force the refresh on demand.                                                       */
+  /* force the refresh on demand. Parse events are in the recognizer only, c.f.          */
+  /* marpaWrapperRecognizer_eventb().                                                     */
   if (forceReloadb != 0) {
-
     MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Updating cached event list");
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event_count(%p)", marpaWrapperGrammarp->marpaGrammarp);
-    nbEventi = marpa_g_event_count(marpaWrapperGrammarp->marpaGrammarp);
-    if (MARPAWRAPPER_UNLIKELY(nbEventi < 0)) {
-      MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperGrammar_fetchEventsb(marpaWrapperGrammarp,
+                                                                  genericLoggerp,
+                                                                  exhaustionEventb,
+                                                                  &(marpaWrapperGrammarp->eventArrayp),
+                                                                  &(marpaWrapperGrammarp->sizeEventl),
+                                                                  &(marpaWrapperGrammarp->nEventl),
+                                                                  1 /* sortb */))) {
       goto err;
     }
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Number of events: %d", nbEventi);
-
-    /* This variable is the number of subscribed events */
-    marpaWrapperGrammarp->nEventl = 0;
-
-    if (nbEventi > 0) {
-      /* Get all events, with a distinction between warnings, and the subscriptions */
-      for (i = 0, subscribedEventi = 0; i < nbEventi; i++) {
-    
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event(%p, %p, %d)", marpaWrapperGrammarp->marpaGrammarp, &event, i);
-        eventType = marpa_g_event(marpaWrapperGrammarp->marpaGrammarp, &event, i);
-        if (MARPAWRAPPER_UNLIKELY(eventType < 0)) {
-          MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
-          goto err;
-        }
-
-        msgs = (eventType < MARPA_EVENT_COUNT) ? marpa_event_description[eventType].suggested : NULL;
-        if (MARPAWRAPPER_UNLIKELY(msgs == NULL)) {
-          MARPAWRAPPER_ERRORF(genericLoggerp, "Unknown event type %d", (int) eventType);
-          goto err;
-        }
-        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Event %d: %s", (int) eventType, msgs);
-
-        warningMsgs = NULL;
-        fatalMsgs   = NULL;
-        infoMsgs    = NULL;
-
-        switch (eventType) {
-        case MARPA_EVENT_NONE:
-          break;
-        case MARPA_EVENT_COUNTED_NULLABLE:
-          fatalMsgs = msgs;
-          break;
-        case MARPA_EVENT_EARLEY_ITEM_THRESHOLD:
-          warningMsgs = msgs;
-          break;
-        case MARPA_EVENT_EXHAUSTED:
-          if (exhaustionEventb) {
-            /* Generate an event */
-            MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperGrammarp->eventArrayp, marpaWrapperGrammarp->sizeEventl, subscribedEventi + 1, sizeof(marpaWrapperGrammarEvent_t));
-            eventp = &(marpaWrapperGrammarp->eventArrayp[subscribedEventi]);
-
-            eventp->eventType = MARPAWRAPPERGRAMMAR_EVENT_EXHAUSTED;
-            eventp->symboli   = -1; /* No symbol associated to such event */
-
-            marpaWrapperGrammarp->nEventl = ++subscribedEventi;
-          }
-          break;
-        case MARPA_EVENT_LOOP_RULES:
-          warningMsgs = msgs;
-          break;
-        case MARPA_EVENT_NULLING_TERMINAL:
-          fatalMsgs = msgs;
-          break;
-        case MARPA_EVENT_SYMBOL_COMPLETED:
-        case MARPA_EVENT_SYMBOL_NULLED:
-        case MARPA_EVENT_SYMBOL_EXPECTED: /* Only if marpa_r_expected_symbol_event_set */
-        case MARPA_EVENT_SYMBOL_PREDICTED:
-          /* Event value is the id of the symbol */
-          eventValuei = marpa_g_event_value(&event);
-          MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event_value(%p) returns %d", &event, eventValuei);
-          MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperGrammarp->eventArrayp, marpaWrapperGrammarp->sizeEventl, subscribedEventi + 1, sizeof(marpaWrapperGrammarEvent_t));
-          eventp = &(marpaWrapperGrammarp->eventArrayp[subscribedEventi]);
-
-          eventp->eventType = (eventType == MARPA_EVENT_SYMBOL_COMPLETED) ? MARPAWRAPPERGRAMMAR_EVENT_COMPLETED : ((eventType == MARPA_EVENT_SYMBOL_NULLED) ? MARPAWRAPPERGRAMMAR_EVENT_NULLED : MARPAWRAPPERGRAMMAR_EVENT_EXPECTED);
-          eventp->symboli   = marpaWrapperGrammarp->symbolArrayp[eventValuei].marpaSymbolIdi;
-
-          marpaWrapperGrammarp->nEventl = ++subscribedEventi;
-          break;
-        default:
-          /* These are all the events as per this version of marpa */
-          MARPAWRAPPER_NOTICEF(genericLoggerp, "Unsupported event type %d", (int) eventType);
-          break;
-        }
-        if (warningMsgs != NULL) {
-          if (marpaWrapperGrammarp->marpaWrapperGrammarOption.warningIsErrorb != 0) {
-            MARPAWRAPPER_ERROR(genericLoggerp, warningMsgs);
-            goto err;
-          } else {
-            MARPAWRAPPER_WARN(genericLoggerp, warningMsgs);
-          }
-        } else if (fatalMsgs != NULL) {
-          MARPAWRAPPER_ERROR(genericLoggerp, fatalMsgs);
-          goto err;
-        } else if (infoMsgs != NULL) {
-          MARPAWRAPPER_INFO(genericLoggerp, infoMsgs);
-        }
-      }
-
-      if (subscribedEventi > 1) {
-        /* Sort the events */
-        qsort(marpaWrapperGrammarp->eventArrayp, subscribedEventi, sizeof(marpaWrapperGrammarEvent_t), &_marpaWrapperGrammar_cmpi);
-      }
-
-    }
   } else {
     MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Using cached event list");
   }
@@ -862,16 +783,149 @@ short marpaWrapperGrammar_eventb(marpaWrapperGrammar_t *marpaWrapperGrammarp, si
   return 1;
 
  err:
-  if (eventp != NULL) {
-    int errnoi = errno;
-    free(eventp);
-    errno = errnoi;
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static short _marpaWrapperGrammar_fetchEventsb(marpaWrapperGrammar_t *marpaWrapperGrammarp, genericLogger_t *genericLoggerp, short exhaustionEventb, marpaWrapperGrammarEvent_t **eventArraypp, size_t *sizeEventlp, size_t *nEventlp, short sortb)
+/****************************************************************************/
+/* Drains libmarpa events into *eventArraypp. The grammar is only read: the */
+/* destination is the grammar list at precompute time, the recognizer list  */
+/* during a parse. With sortb == 0 the caller sorts when the list is asked. */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperGrammar_fetchEventsb)
+  marpaWrapperGrammarEvent_t       *eventp;
+  int                               nbEventi;
+  int                               i;
+  int                               subscribedEventi;
+  const char                       *msgs;
+  const char                       *warningMsgs;
+  const char                       *fatalMsgs;
+  const char                       *infoMsgs;
+  Marpa_Event_Type                  eventType;
+  Marpa_Event                       event;
+  int                               eventValuei;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event_count(%p)", marpaWrapperGrammarp->marpaGrammarp);
+  nbEventi = marpa_g_event_count(marpaWrapperGrammarp->marpaGrammarp);
+  if (MARPAWRAPPER_UNLIKELY(nbEventi < 0)) {
+    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+    goto err;
+  }
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Number of events: %d", nbEventi);
+
+  /* This variable is the number of subscribed events */
+  *nEventlp = 0;
+
+  if (nbEventi > 0) {
+    /* Get all events, with a distinction between warnings, and the subscriptions */
+    for (i = 0, subscribedEventi = 0; i < nbEventi; i++) {
+  
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event(%p, %p, %d)", marpaWrapperGrammarp->marpaGrammarp, &event, i);
+      eventType = marpa_g_event(marpaWrapperGrammarp->marpaGrammarp, &event, i);
+      if (MARPAWRAPPER_UNLIKELY(eventType < 0)) {
+        MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+        goto err;
+      }
+
+      msgs = (eventType < MARPA_EVENT_COUNT) ? marpa_event_description[eventType].suggested : NULL;
+      if (MARPAWRAPPER_UNLIKELY(msgs == NULL)) {
+        MARPAWRAPPER_ERRORF(genericLoggerp, "Unknown event type %d", (int) eventType);
+        goto err;
+      }
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Event %d: %s", (int) eventType, msgs);
+
+      warningMsgs = NULL;
+      fatalMsgs   = NULL;
+      infoMsgs    = NULL;
+
+      switch (eventType) {
+      case MARPA_EVENT_NONE:
+        break;
+      case MARPA_EVENT_COUNTED_NULLABLE:
+        fatalMsgs = msgs;
+        break;
+      case MARPA_EVENT_EARLEY_ITEM_THRESHOLD:
+        warningMsgs = msgs;
+        break;
+      case MARPA_EVENT_EXHAUSTED:
+        if (exhaustionEventb) {
+          /* Generate an event */
+          MARPAWRAPPER_MANAGEBUF(genericLoggerp, *eventArraypp, *sizeEventlp, subscribedEventi + 1, sizeof(marpaWrapperGrammarEvent_t));
+          eventp = &((*eventArraypp)[subscribedEventi]);
+
+          eventp->eventType = MARPAWRAPPERGRAMMAR_EVENT_EXHAUSTED;
+          eventp->symboli   = -1; /* No symbol associated to such event */
+
+          *nEventlp = ++subscribedEventi;
+        }
+        break;
+      case MARPA_EVENT_LOOP_RULES:
+        warningMsgs = msgs;
+        break;
+      case MARPA_EVENT_NULLING_TERMINAL:
+        fatalMsgs = msgs;
+        break;
+      case MARPA_EVENT_SYMBOL_COMPLETED:
+      case MARPA_EVENT_SYMBOL_NULLED:
+      case MARPA_EVENT_SYMBOL_EXPECTED: /* Only if marpa_r_expected_symbol_event_set */
+      case MARPA_EVENT_SYMBOL_PREDICTED:
+        /* Event value is the id of the symbol */
+        eventValuei = marpa_g_event_value(&event);
+        MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_event_value(%p) returns %d", &event, eventValuei);
+        MARPAWRAPPER_MANAGEBUF(genericLoggerp, *eventArraypp, *sizeEventlp, subscribedEventi + 1, sizeof(marpaWrapperGrammarEvent_t));
+        eventp = &((*eventArraypp)[subscribedEventi]);
+
+        eventp->eventType = (eventType == MARPA_EVENT_SYMBOL_COMPLETED) ? MARPAWRAPPERGRAMMAR_EVENT_COMPLETED : ((eventType == MARPA_EVENT_SYMBOL_NULLED) ? MARPAWRAPPERGRAMMAR_EVENT_NULLED : MARPAWRAPPERGRAMMAR_EVENT_EXPECTED);
+        eventp->symboli   = marpaWrapperGrammarp->symbolArrayp[eventValuei].marpaSymbolIdi;
+
+        *nEventlp = ++subscribedEventi;
+        break;
+      default:
+        /* These are all the events as per this version of marpa */
+        MARPAWRAPPER_NOTICEF(genericLoggerp, "Unsupported event type %d", (int) eventType);
+        break;
+      }
+      if (warningMsgs != NULL) {
+        if (marpaWrapperGrammarp->marpaWrapperGrammarOption.warningIsErrorb != 0) {
+          MARPAWRAPPER_ERROR(genericLoggerp, warningMsgs);
+          goto err;
+        } else {
+          MARPAWRAPPER_WARN(genericLoggerp, warningMsgs);
+        }
+      } else if (fatalMsgs != NULL) {
+        MARPAWRAPPER_ERROR(genericLoggerp, fatalMsgs);
+        goto err;
+      } else if (infoMsgs != NULL) {
+        MARPAWRAPPER_INFO(genericLoggerp, infoMsgs);
+      }
+    }
+
+    if (sortb) {
+      _marpaWrapperGrammar_sortEventsv(*eventArraypp, *nEventlp);
+    }
+
   }
 
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
   MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
   return 0;
 }
 
+/****************************************************************************/
+static void _marpaWrapperGrammar_sortEventsv(marpaWrapperGrammarEvent_t *eventArrayp, size_t nEventl)
+/****************************************************************************/
+{
+  if (nEventl > 1) {
+    qsort(eventArrayp, nEventl, sizeof(marpaWrapperGrammarEvent_t), &_marpaWrapperGrammar_cmpi);
+  }
+}
+
 /****************************************************************************/
 static inline int _marpaWrapperGrammar_cmpi(const void *event1p, const void *event2p)
 /****************************************************************************/
@@ -905,6 +959,7 @@ short marpaWrapperGrammar_symbolPropertyb(marpaWrapperGrammar_t *marpaWrapperGra
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
   marpaGrammarp  = marpaWrapperGrammarp->marpaGrammarp;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_symbol_is_accessible(%p, %d)", marpaGrammarp, symboli);
@@ -988,6 +1043,7 @@ short marpaWrapperGrammar_symbolEventb(marpaWrapperGrammar_t *marpaWrapperGramma
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
   marpaGrammarp  = marpaWrapperGrammarp->marpaGrammarp;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_symbol_is_completion_event(%p, %d)", marpaGrammarp, symboli);
@@ -1049,6 +1105,7 @@ short marpaWrapperGrammar_rulePropertyb(marpaWrapperGrammar_t *marpaWrapperGramm
 #endif
 
   genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
   marpaGrammarp  = marpaWrapperGrammarp->marpaGrammarp;
 
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_rule_is_accessible(%p)", marpaGrammarp);
@@ -1104,3 +1161,518 @@ short marpaWrapperGrammar_rulePropertyb(marpaWrapperGrammar_t *marpaWrapperGramm
   return 0;
 }
 
+
+/****************************************************************************/
+short marpaWrapperGrammar_serializeb(marpaWrapperGrammar_t *marpaWrapperGrammarp, char **bufferpp, size_t *bufferlp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperGrammar_serializeb)
+  genericLogger_t                   *genericLoggerp = NULL;
+  unsigned char                     *imagep         = NULL;
+  size_t                             nRhsl          = 0;
+  size_t                             wordl;
+  size_t                             imagel;
+  size_t                             i;
+  int                                ruleLengthi;
+  int                                lhsSymboli;
+  int                                rhsSymboli;
+  int                                starti;
+  int                                j;
+  marpaWrapperGrammarSymbolOption_t *marpaWrapperGrammarSymbolOptionp;
+  marpaWrapperGrammarRuleOption_t   *marpaWrapperGrammarRuleOptionp;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY((marpaWrapperGrammarp == NULL) || (bufferpp == NULL) || (bufferlp == NULL))) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
+
+  /* Rule creation does not keep track of rule definition - we have to ask for it, first for the total number of RHS */
+  for (i = 0; i < marpaWrapperGrammarp->nRulel; i++) {
+    ruleLengthi = marpa_g_rule_length(marpaWrapperGrammarp->marpaGrammarp, marpaWrapperGrammarp->ruleArrayp[i].marpaRuleIdi);
+    if (MARPAWRAPPER_UNLIKELY(ruleLengthi < 0)) {
+      MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+      goto err;
+    }
+    nRhsl += (size_t) ruleLengthi;
+  }
+
+  if (marpaWrapperGrammarp->precomputedb != 0) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_start_symbol(%p)", marpaWrapperGrammarp->marpaGrammarp);
+    starti = marpa_g_start_symbol(marpaWrapperGrammarp->marpaGrammarp);
+    if (MARPAWRAPPER_UNLIKELY(starti < 0)) {
+      MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+      goto err;
+    }
+  } else {
+    starti = -1;
+  }
+
+  imagel = (MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS
+            + (marpaWrapperGrammarp->nSymboll * MARPAWRAPPERGRAMMAR_IMAGE_SYMBOL_WORDS)
+            + (marpaWrapperGrammarp->nRulel   * MARPAWRAPPERGRAMMAR_IMAGE_RULE_WORDS)
+            + nRhsl) * 4;
+  /* The caller releases the image with free(): it comes from the C library, not from the grammar allocator */
+  imagep = (unsigned char *) (malloc)(imagel);
+  if (MARPAWRAPPER_UNLIKELY(imagep == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
+    goto err;
+  }
+
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MAGIC_IX,   MARPAWRAPPERGRAMMAR_IMAGE_MAGIC);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_VERSION_IX, MARPAWRAPPERGRAMMAR_IMAGE_VERSION);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MAJOR_IX,   MARPA_MAJOR_VERSION);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MINOR_IX,   MARPA_MINOR_VERSION);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MICRO_IX,   MARPA_MICRO_VERSION);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_FLAGS_IX,   (marpaWrapperGrammarp->precomputedb != 0) ? MARPAWRAPPERGRAMMAR_IMAGE_FLAG_PRECOMPUTED : 0);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_START_IX,   starti);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NSYMBOL_IX, (int) marpaWrapperGrammarp->nSymboll);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NRULE_IX,   (int) marpaWrapperGrammarp->nRulel);
+  _marpaWrapperGrammar_image_setv(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NRHS_IX,    (int) nRhsl);
+
+  wordl = MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS;
+  for (i = 0; i < marpaWrapperGrammarp->nSymboll; i++) {
+    marpaWrapperGrammarSymbolOptionp = &(marpaWrapperGrammarp->symbolArrayp[i].marpaWrapperGrammarSymbolOption);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, (int) marpaWrapperGrammarSymbolOptionp->terminalb);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, (int) marpaWrapperGrammarSymbolOptionp->startb);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, marpaWrapperGrammarSymbolOptionp->eventSeti);
+  }
+
+  for (i = 0; i < marpaWrapperGrammarp->nRulel; i++) {
+    lhsSymboli = marpa_g_rule_lhs(marpaWrapperGrammarp->marpaGrammarp, marpaWrapperGrammarp->ruleArrayp[i].marpaRuleIdi);
+    if (MARPAWRAPPER_UNLIKELY(lhsSymboli < 0)) {
+      MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+      goto err;
+    }
+    ruleLengthi = marpa_g_rule_length(marpaWrapperGrammarp->marpaGrammarp, marpaWrapperGrammarp->ruleArrayp[i].marpaRuleIdi);
+    marpaWrapperGrammarRuleOptionp = &(marpaWrapperGrammarp->ruleArrayp[i].marpaWrapperGrammarRuleOption);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, lhsSymboli);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, marpaWrapperGrammarRuleOptionp->ranki);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, (int) marpaWrapperGrammarRuleOptionp->nullRanksHighb);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, (int) marpaWrapperGrammarRuleOptionp->sequenceb);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, marpaWrapperGrammarRuleOptionp->separatorSymboli);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, (int) marpaWrapperGrammarRuleOptionp->properb);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, marpaWrapperGrammarRuleOptionp->minimumi);
+    _marpaWrapperGrammar_image_setv(imagep, wordl++, ruleLengthi);
+  }
+
+  for (i = 0; i < marpaWrapperGrammarp->nRulel; i++) {
+    ruleLengthi = marpa_g_rule_length(marpaWrapperGrammarp->marpaGrammarp, marpaWrapperGrammarp->ruleArrayp[i].marpaRuleIdi);
+    for (j = 0; j < ruleLengthi; j++) {
+      rhsSymboli = marpa_g_rule_rhs(marpaWrapperGrammarp->marpaGrammarp, marpaWrapperGrammarp->ruleArrayp[i].marpaRuleIdi, j);
+      if (MARPAWRAPPER_UNLIKELY(rhsSymboli < 0)) {
+        MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
+        goto err;
+      }
+      _marpaWrapperGrammar_image_setv(imagep, wordl++, rhsSymboli);
+    }
+  }
+
+  _marpaWrapperGrammar_image_setv(imagep,
+                                  MARPAWRAPPERGRAMMAR_IMAGE_CHECKSUM_IX,
+                                  (int) _marpaWrapperGrammar_image_checksumi(imagep, imagel));
+
+  *bufferpp = (char *) imagep;
+  *bufferlp = imagel;
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Serialized grammar in %ld bytes", (unsigned long) imagel);
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  if (imagep != NULL) {
+    int errnoi = errno;
+    (free)(imagep);
+    errno = errnoi;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+marpaWrapperGrammar_t *marpaWrapperGrammar_deserializep(marpaWrapperGrammarOption_t *marpaWrapperGrammarOptionp, char *bufferp, size_t bufferl)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperGrammar_deserializep)
+  genericLogger_t                  *genericLoggerp       = NULL;
+  marpaWrapperGrammar_t            *marpaWrapperGrammarp = NULL;
+  unsigned char                    *imagep               = (unsigned char *) bufferp;
+  int                              *rhsSymbolip          = NULL;
+  size_t                            sizeRhsSymboll       = 0;
+  size_t                            nSymboll;
+  size_t                            nRulel;
+  size_t                            nRhsl;
+  size_t                            imagel;
+  size_t                            wordl;
+  size_t                            rhsWordl;
+  size_t                            i;
+  int                               flagsi;
+  int                               starti;
+  int                               lhsSymboli;
+  int                               ruleLengthi;
+  int                               marpaSymbolIdi;
+  int                               marpaRuleIdi;
+  int                               j;
+  marpaWrapperGrammarSymbolOption_t marpaWrapperGrammarSymbolOption;
+  marpaWrapperGrammarRuleOption_t   marpaWrapperGrammarRuleOption;
+
+  if (marpaWrapperGrammarOptionp == NULL) {
+    marpaWrapperGrammarOptionp = &marpaWrapperGrammarOptionDefault;
+  }
+  genericLoggerp = marpaWrapperGrammarOptionp->genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarOptionp->allocatorp);
+
+  /* Validate the image before creating anything */
+  if (MARPAWRAPPER_UNLIKELY((imagep == NULL) || (bufferl < (MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS * 4)))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Grammar image is too short");
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MAGIC_IX) != MARPAWRAPPERGRAMMAR_IMAGE_MAGIC)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Grammar image has a bad magic number");
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_VERSION_IX) != MARPAWRAPPERGRAMMAR_IMAGE_VERSION)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Grammar image version is %d instead of %d", _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_VERSION_IX), MARPAWRAPPERGRAMMAR_IMAGE_VERSION);
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY((_marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MAJOR_IX) != MARPA_MAJOR_VERSION) ||
+                            (_marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MINOR_IX) != MARPA_MINOR_VERSION) ||
+                            (_marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MICRO_IX) != MARPA_MICRO_VERSION))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Grammar image was generated with marpa %d.%d.%d instead of %d.%d.%d",
+                        _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MAJOR_IX),
+                        _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MINOR_IX),
+                        _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_MICRO_IX),
+                        MARPA_MAJOR_VERSION, MARPA_MINOR_VERSION, MARPA_MICRO_VERSION);
+    errno = EINVAL;
+    goto err;
+  }
+
+  flagsi   = _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_FLAGS_IX);
+  starti   = _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_START_IX);
+  nSymboll = (size_t) (unsigned int) _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NSYMBOL_IX);
+  nRulel   = (size_t) (unsigned int) _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NRULE_IX);
+  nRhsl    = (size_t) (unsigned int) _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_NRHS_IX);
+  imagel   = (MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS
+              + (nSymboll * MARPAWRAPPERGRAMMAR_IMAGE_SYMBOL_WORDS)
+              + (nRulel   * MARPAWRAPPERGRAMMAR_IMAGE_RULE_WORDS)
+              + nRhsl) * 4;
+  if (MARPAWRAPPER_UNLIKELY(bufferl != imagel)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Grammar image size is %ld instead of %ld", (unsigned long) bufferl, (unsigned long) imagel);
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY((unsigned int) _marpaWrapperGrammar_image_geti(imagep, MARPAWRAPPERGRAMMAR_IMAGE_CHECKSUM_IX) !=
+                            _marpaWrapperGrammar_image_checksumi(imagep, imagel))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Grammar image checksum mismatch");
+    errno = EINVAL;
+    goto err;
+  }
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(marpaWrapperGrammarOptionp);
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammarp == NULL)) {
+    goto err;
+  }
+
+  /* Create the symbols - verifying IDs are identical */
+  wordl = MARPAWRAPPERGRAMMAR_IMAGE_HEADER_WORDS;
+  for (i = 0; i < nSymboll; i++) {
+    marpaWrapperGrammarSymbolOption.terminalb = (short) _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarSymbolOption.startb    = (short) _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarSymbolOption.eventSeti =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaSymbolIdi = marpaWrapperGrammar_newSymboli(marpaWrapperGrammarp, &marpaWrapperGrammarSymbolOption);
+    if (MARPAWRAPPER_UNLIKELY(marpaSymbolIdi < 0)) {
+      goto err;
+    }
+    if (MARPAWRAPPER_UNLIKELY(marpaSymbolIdi != (int) i)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Deserialized symbol ID is %d instead of %d", marpaSymbolIdi, (int) i);
+      goto err;
+    }
+  }
+
+  /* Create the rules - verifying IDs are identical */
+  rhsWordl = wordl + (nRulel * MARPAWRAPPERGRAMMAR_IMAGE_RULE_WORDS);
+  for (i = 0; i < nRulel; i++) {
+    lhsSymboli                                     =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.ranki            =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.nullRanksHighb   = (short) _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.sequenceb        = (short) _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.separatorSymboli =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.properb          = (short) _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    marpaWrapperGrammarRuleOption.minimumi         =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    ruleLengthi                                    =         _marpaWrapperGrammar_image_geti(imagep, wordl++);
+    if (MARPAWRAPPER_UNLIKELY((ruleLengthi < 0) || ((size_t) ruleLengthi > ((imagel / 4) - rhsWordl)))) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Rule %d has an invalid length %d", (int) i, ruleLengthi);
+      errno = EINVAL;
+      goto err;
+    }
+    if (ruleLengthi > 0) {
+      MARPAWRAPPER_MANAGEBUF(genericLoggerp, rhsSymbolip, sizeRhsSymboll, (size_t) ruleLengthi, sizeof(int));
+      for (j = 0; j < ruleLengthi; j++) {
+        rhsSymbolip[j] = _marpaWrapperGrammar_image_geti(imagep, rhsWordl++);
+      }
+    }
+    marpaRuleIdi = marpaWrapperGrammar_newRulei(marpaWrapperGrammarp,
+                                                &marpaWrapperGrammarRuleOption,
+                                                lhsSymboli,
+                                                (size_t) ruleLengthi,
+                                                rhsSymbolip);
+    if (MARPAWRAPPER_UNLIKELY(marpaRuleIdi < 0)) {
+      goto err;
+    }
+    if (MARPAWRAPPER_UNLIKELY(marpaRuleIdi != (int) i)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Deserialized rule ID is %d instead of %d", marpaRuleIdi, (int) i);
+      goto err;
+    }
+  }
+  MARPAWRAPPER_FREEBUF(rhsSymbolip);
+
+  /* libmarpa cannot import its precomputed tables: they are rebuilt, at the full precomputation cost */
+  if ((flagsi & MARPAWRAPPERGRAMMAR_IMAGE_FLAG_PRECOMPUTED) == MARPAWRAPPERGRAMMAR_IMAGE_FLAG_PRECOMPUTED) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp, &starti))) {
+      goto err;
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", marpaWrapperGrammarp);
+  return marpaWrapperGrammarp;
+
+ err:
+  if (rhsSymbolip != NULL) {
+    int errnoi = errno;
+    MARPAWRAPPER_FREEBUF(rhsSymbolip);
+    errno = errnoi;
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    int errnoi = errno;
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+    errno = errnoi;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return NULL");
+  return NULL;
+}
+
+/****************************************************************************/
+short marpaWrapperGrammar_saveb(marpaWrapperGrammar_t *marpaWrapperGrammarp, char *filenames)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperGrammar_saveb)
+  genericLogger_t *genericLoggerp = NULL;
+  char            *bufferp        = NULL;
+  FILE            *fp             = NULL;
+  size_t           bufferl;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY((marpaWrapperGrammarp == NULL) || (filenames == NULL))) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  genericLoggerp = marpaWrapperGrammarp->marpaWrapperGrammarOption.genericLoggerp;
+
+  if (MARPAWRAPPER_UNLIKELY(! marpaWrapperGrammar_serializeb(marpaWrapperGrammarp, &bufferp, &bufferl))) {
+    goto err;
+  }
+
+  fp = fopen(filenames, "wb");
+  if (MARPAWRAPPER_UNLIKELY(fp == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "fopen failure: %s", strerror(errno));
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(fwrite(bufferp, 1, bufferl, fp) != bufferl)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "fwrite failure: %s", strerror(errno));
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(fclose(fp) != 0)) {
+    fp = NULL;
+    MARPAWRAPPER_ERRORF(genericLoggerp, "fclose failure: %s", strerror(errno));
+    goto err;
+  }
+  (free)(bufferp);
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ err:
+  {
+    int errnoi = errno;
+    if (fp != NULL) {
+      fclose(fp);
+    }
+    if (bufferp != NULL) {
+      (free)(bufferp);
+    }
+    errno = errnoi;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+marpaWrapperGrammar_t *marpaWrapperGrammar_loadp(marpaWrapperGrammarOption_t *marpaWrapperGrammarOptionp, char *filenames)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperGrammar_loadp)
+  genericLogger_t       *genericLoggerp       = NULL;
+  marpaWrapperGrammar_t *marpaWrapperGrammarp = NULL;
+  char                  *bufferp              = NULL;
+  size_t                 bufferl              = 0;
+#ifdef _WIN32
+  HANDLE                 fileh                = INVALID_HANDLE_VALUE;
+  HANDLE                 mappingh             = NULL;
+  LARGE_INTEGER          sizel;
+#else
+  int                    fd                   = -1;
+  struct stat            st;
+#endif
+
+  if (marpaWrapperGrammarOptionp == NULL) {
+    marpaWrapperGrammarOptionp = &marpaWrapperGrammarOptionDefault;
+  }
+  genericLoggerp = marpaWrapperGrammarOptionp->genericLoggerp;
+  MARPAWRAPPERGRAMMAR_CONTEXT_SET(marpaWrapperGrammarOptionp->allocatorp);
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(filenames == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  /* The image is mapped read-only for the time of the deserialization, that validates it and copies */
+  /* everything it needs: the mapping is released before returning.                                   */
+#ifdef _WIN32
+  fileh = CreateFileA(filenames, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (MARPAWRAPPER_UNLIKELY(fileh == INVALID_HANDLE_VALUE)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "CreateFile failure, error code %ld", (long) GetLastError());
+    errno = ENOENT;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(! GetFileSizeEx(fileh, &sizel))) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "GetFileSizeEx failure, error code %ld", (long) GetLastError());
+    errno = EIO;
+    goto err;
+  }
+  bufferl = (size_t) sizel.QuadPart;
+  if (bufferl > 0) {
+    mappingh = CreateFileMappingA(fileh, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (MARPAWRAPPER_UNLIKELY(mappingh == NULL)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "CreateFileMapping failure, error code %ld", (long) GetLastError());
+      errno = EIO;
+      goto err;
+    }
+    bufferp = (char *) MapViewOfFile(mappingh, FILE_MAP_READ, 0, 0, 0);
+    if (MARPAWRAPPER_UNLIKELY(bufferp == NULL)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "MapViewOfFile failure, error code %ld", (long) GetLastError());
+      errno = EIO;
+      goto err;
+    }
+  }
+#else
+  fd = open(filenames, O_RDONLY);
+  if (MARPAWRAPPER_UNLIKELY(fd < 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "open failure: %s", strerror(errno));
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(fstat(fd, &st) != 0)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "fstat failure: %s", strerror(errno));
+    goto err;
+  }
+  bufferl = (size_t) st.st_size;
+  if (bufferl > 0) {
+    bufferp = (char *) mmap(NULL, bufferl, PROT_READ, MAP_SHARED, fd, 0);
+    if (MARPAWRAPPER_UNLIKELY(bufferp == (char *) MAP_FAILED)) {
+      bufferp = NULL;
+      MARPAWRAPPER_ERRORF(genericLoggerp, "mmap failure: %s", strerror(errno));
+      goto err;
+    }
+  }
+#endif
+
+  /* An empty file is rejected by deserialization */
+  marpaWrapperGrammarp = marpaWrapperGrammar_deserializep(marpaWrapperGrammarOptionp, bufferp, bufferl);
+
+ err:
+  {
+    int errnoi = errno;
+#ifdef _WIN32
+    if (bufferp != NULL) {
+      UnmapViewOfFile(bufferp);
+    }
+    if (mappingh != NULL) {
+      CloseHandle(mappingh);
+    }
+    if (fileh != INVALID_HANDLE_VALUE) {
+      CloseHandle(fileh);
+    }
+#else
+    if (bufferp != NULL) {
+      munmap(bufferp, bufferl);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+#endif
+    errno = errnoi;
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", marpaWrapperGrammarp);
+  return marpaWrapperGrammarp;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperGrammar_image_setv(unsigned char *imagep, size_t wordl, int valuei)
+/****************************************************************************/
+/* Words are stored in little-endian whatever the host                      */
+/****************************************************************************/
+{
+  unsigned int   valueu = (unsigned int) valuei;
+  unsigned char *p      = imagep + (wordl * 4);
+
+  p[0] = (unsigned char) ( valueu        & 0xFF);
+  p[1] = (unsigned char) ((valueu >>  8) & 0xFF);
+  p[2] = (unsigned char) ((valueu >> 16) & 0xFF);
+  p[3] = (unsigned char) ((valueu >> 24) & 0xFF);
+}
+
+/****************************************************************************/
+static inline int _marpaWrapperGrammar_image_geti(unsigned char *imagep, size_t wordl)
+/****************************************************************************/
+{
+  unsigned char *p = imagep + (wordl * 4);
+
+  return (int) (((unsigned int) p[0])         |
+                (((unsigned int) p[1]) <<  8) |
+                (((unsigned int) p[2]) << 16) |
+                (((unsigned int) p[3]) << 24));
+}
+
+/****************************************************************************/
+static inline unsigned int _marpaWrapperGrammar_image_checksumi(unsigned char *p, size_t lengthl)
+/****************************************************************************/
+/* 32-bit FNV-1a of the whole image but the checksum word itself            */
+/****************************************************************************/
+{
+  unsigned int hashi = 2166136261U;
+  size_t       i;
+
+  for (i = 0; i < lengthl; i++) {
+    if ((i >> 2) == MARPAWRAPPERGRAMMAR_IMAGE_CHECKSUM_IX) {
+      continue;
+    }
+    hashi ^= (unsigned int) p[i];
+    hashi *= 16777619U;
+  }
+
+  return hashi & 0xFFFFFFFFU;
+}
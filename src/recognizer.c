@@ -6,6 +6,7 @@
 #include "marpa.h"
 #include "marpaWrapper/internal/config.h"
 #include "marpaWrapper/internal/_manageBuf.h"
+#include "marpaWrapper/internal/_allocator.h"
 #include "marpaWrapper/internal/_recognizer.h"
 #include "marpaWrapper/internal/_grammar.h"
 #include "marpaWrapper/internal/_logging.h"
@@ -13,12 +14,41 @@
 static marpaWrapperRecognizerOption_t marpaWrapperRecognizerOptionDefault = {
   NULL,    /* genericLoggerp   */
   0,       /* disableThresholdb */
-  0        /* exhaustionEventb */
+  0,       /* exhaustionEventb */
+  NULL     /* allocatorp */
 };
 
+static Marpa_Recognizer _marpaWrapperRecognizer_marpaRecognizerp(marpaWrapperRecognizer_t *marpaWrapperRecognizerp);
+static inline short     _marpaWrapperRecognizer_eventlessb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int nbEventi);
+
 /* Macro that return genericLoggerp from a marpaWrapperRecognizerp */
 #define MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp) ((marpaWrapperRecognizerp != NULL) ? (marpaWrapperRecognizerp)->marpaWrapperRecognizerOption.genericLoggerp : NULL)
 
+/* Macro that logs libmarpa error and keeps a copy of it in the recognizer */
+#define MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp) do { \
+    (marpaWrapperRecognizerp)->marpaErrorCodei = marpa_g_error((marpaWrapperRecognizerp)->marpaWrapperGrammarp->marpaGrammarp, NULL); \
+    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), (marpaWrapperRecognizerp)->marpaWrapperGrammarp->marpaGrammarp); \
+  } while (0)
+
+/* Macro that refreshes the list of events of a recognizer. Sorting is left to the first reader. */
+#define MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp)           \
+  (_marpaWrapperGrammar_fetchEventsb((marpaWrapperRecognizerp)->marpaWrapperGrammarp, \
+                                     MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), \
+                                     (marpaWrapperRecognizerp)->marpaWrapperRecognizerOption.exhaustionEventb, \
+                                     &((marpaWrapperRecognizerp)->eventArrayp), \
+                                     &((marpaWrapperRecognizerp)->sizeEventl), \
+                                     &((marpaWrapperRecognizerp)->nEventl), \
+                                     0 /* sortb */) && \
+   ((marpaWrapperRecognizerp)->sortEventb = 1))
+
+/* Macro that sorts the list of events of a recognizer if not already done */
+#define MARPAWRAPPERRECOGNIZER_SORTEVENTV(marpaWrapperRecognizerp) do { \
+    if ((marpaWrapperRecognizerp)->sortEventb) {                        \
+      _marpaWrapperGrammar_sortEventsv((marpaWrapperRecognizerp)->eventArrayp, (marpaWrapperRecognizerp)->nEventl); \
+      (marpaWrapperRecognizerp)->sortEventb = 0;                        \
+    }                                                                   \
+  } while (0)
+
 /****************************************************************************/
 marpaWrapperRecognizer_t *marpaWrapperRecognizer_newp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp)
 /****************************************************************************/
@@ -41,6 +71,10 @@ marpaWrapperRecognizer_t *marpaWrapperRecognizer_newp(marpaWrapperGrammar_t *mar
   }
   genericLoggerp = marpaWrapperRecognizerOptionp->genericLoggerp;
 
+  /* The recognizer, and everything that derives from it, defaults to the allocator of the grammar */
+  MARPAWRAPPER_ALLOCATOR_SET((marpaWrapperRecognizerOptionp->allocatorp != NULL) ? marpaWrapperRecognizerOptionp->allocatorp : marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
+  marpa_r_context_set(NULL);
+
   /* Create a recognizer instance */
   marpaWrapperRecognizerp = (marpaWrapperRecognizer_t *) malloc(sizeof(marpaWrapperRecognizer_t));
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
@@ -51,32 +85,26 @@ marpaWrapperRecognizer_t *marpaWrapperRecognizer_newp(marpaWrapperGrammar_t *mar
   /* See first instruction after this initialization block: marpaWrapperRecognizerp->marpaRecognizerp */
   marpaWrapperRecognizerp->marpaWrapperGrammarp         = marpaWrapperGrammarp;
   marpaWrapperRecognizerp->marpaWrapperRecognizerOption = *marpaWrapperRecognizerOptionp;
+  marpaWrapperRecognizerp->marpaWrapperRecognizerOption.allocatorp = _marpaWrapperAllocator_currentp;
   marpaWrapperRecognizerp->sizeSymboll                  = 0;
   marpaWrapperRecognizerp->nSymboll                     = 0;
   marpaWrapperRecognizerp->symbolip                     = NULL;
   marpaWrapperRecognizerp->sizeProgressl                = 0;
   marpaWrapperRecognizerp->nProgressl                   = 0;
   marpaWrapperRecognizerp->progressp                    = NULL;
+  marpaWrapperRecognizerp->sizeEventl                   = 0;
+  marpaWrapperRecognizerp->nEventl                      = 0;
+  marpaWrapperRecognizerp->eventArrayp                  = NULL;
+  marpaWrapperRecognizerp->sortEventb                   = 0;
+  marpaWrapperRecognizerp->nCompletel                   = 0;
+  marpaWrapperRecognizerp->nEventlessCompletel          = 0;
+  marpaWrapperRecognizerp->marpaErrorCodei              = MARPA_ERR_NONE;
   marpaWrapperRecognizerp->treeModeb                    = MARPAWRAPPERRECOGNIZERTREEMODE_NA;
   marpaWrapperRecognizerp->haveVariableLengthTokenb     = 0;
+  marpaWrapperRecognizerp->warmb                        = 0;
 
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_new(%p)", marpaWrapperGrammarp->marpaGrammarp);
-  marpaWrapperRecognizerp->marpaRecognizerp = marpa_r_new(marpaWrapperGrammarp->marpaGrammarp);
+  marpaWrapperRecognizerp->marpaRecognizerp = _marpaWrapperRecognizer_marpaRecognizerp(marpaWrapperRecognizerp);
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->marpaRecognizerp == NULL)) {
-    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
-    goto err;
-  }
-
-  /* Apply options */
-  if (marpaWrapperRecognizerp->marpaWrapperRecognizerOption.disableThresholdb != 0) {
-    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_earley_item_warning_threshold_set(%p, -1)", marpaWrapperRecognizerp->marpaRecognizerp);
-    /* Always succeed as per the doc */
-    marpa_r_earley_item_warning_threshold_set(marpaWrapperRecognizerp->marpaRecognizerp, -1);
-  }
-
-  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_start_input(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
-  if (MARPAWRAPPER_UNLIKELY(marpa_r_start_input(marpaWrapperRecognizerp->marpaRecognizerp) < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperGrammarp->marpaGrammarp);
     goto err;
   }
 
@@ -93,7 +121,7 @@ marpaWrapperRecognizer_t *marpaWrapperRecognizer_newp(marpaWrapperGrammar_t *mar
   MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperRecognizerp->symbolip, marpaWrapperRecognizerp->sizeSymboll, nSymboll, sizeof(int));
 
   /* Events can happen */
-  if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammar_eventb(marpaWrapperGrammarp, NULL, NULL, marpaWrapperRecognizerOptionp->exhaustionEventb, 1) == 0)) {
+  if (MARPAWRAPPER_UNLIKELY(! MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp))) {
     goto err;
   }
 
@@ -129,6 +157,105 @@ err:
   return NULL;
 }
 
+/****************************************************************************/
+short marpaWrapperRecognizer_resetb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp)
+/****************************************************************************/
+/* libmarpa cannot rewind a recognizer: the Marpa_Recognizer is replaced by */
+/* a started one. Buffers, options and the cloned logger are kept.          */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_resetb)
+  Marpa_Recognizer marpaRecognizerp;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
+  /* A value or an ASF refers to the current parse */
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->treeModeb != MARPAWRAPPERRECOGNIZERTREEMODE_NA)) {
+    MARPAWRAPPER_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), "Recognizer is in valuation mode");
+    errno = EBUSY;
+    goto err;
+  }
+
+  /* On failure the current recognizer is left untouched */
+  marpaRecognizerp = _marpaWrapperRecognizer_marpaRecognizerp(marpaWrapperRecognizerp);
+  if (MARPAWRAPPER_UNLIKELY(marpaRecognizerp == NULL)) {
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_unref(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
+  marpa_r_unref(marpaWrapperRecognizerp->marpaRecognizerp);
+  marpaWrapperRecognizerp->marpaRecognizerp = marpaRecognizerp;
+
+  marpaWrapperRecognizerp->nSymboll                 = 0;
+  marpaWrapperRecognizerp->nProgressl               = 0;
+  marpaWrapperRecognizerp->nEventl                  = 0;
+  marpaWrapperRecognizerp->sortEventb               = 0;
+  marpaWrapperRecognizerp->nCompletel               = 0;
+  marpaWrapperRecognizerp->nEventlessCompletel      = 0;
+  marpaWrapperRecognizerp->marpaErrorCodei          = MARPA_ERR_NONE;
+  marpaWrapperRecognizerp->haveVariableLengthTokenb = 0;
+
+  /* Events can happen */
+  if (MARPAWRAPPER_UNLIKELY(! MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp))) {
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+static Marpa_Recognizer _marpaWrapperRecognizer_marpaRecognizerp(marpaWrapperRecognizer_t *marpaWrapperRecognizerp)
+/****************************************************************************/
+/* Creates a libmarpa recognizer with the options applied and input started */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(_marpaWrapperRecognizer_marpaRecognizerp)
+  Marpa_Grammar    marpaGrammarp = marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp;
+  Marpa_Recognizer marpaRecognizerp;
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_new(%p)", marpaGrammarp);
+  marpaRecognizerp = marpa_r_new(marpaGrammarp);
+  if (MARPAWRAPPER_UNLIKELY(marpaRecognizerp == NULL)) {
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
+    goto err;
+  }
+  /* From now on libmarpa reports to the new recognizer */
+  marpa_r_context_set(marpaRecognizerp);
+
+  /* Apply options */
+  if (marpaWrapperRecognizerp->marpaWrapperRecognizerOption.disableThresholdb != 0) {
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_earley_item_warning_threshold_set(%p, -1)", marpaRecognizerp);
+    /* Always succeed as per the doc */
+    marpa_r_earley_item_warning_threshold_set(marpaRecognizerp, -1);
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_start_input(%p)", marpaRecognizerp);
+  if (MARPAWRAPPER_UNLIKELY(marpa_r_start_input(marpaRecognizerp) < 0)) {
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
+    marpa_r_unref(marpaRecognizerp);
+    goto err;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return %p", marpaRecognizerp);
+  return marpaRecognizerp;
+
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return NULL");
+  return NULL;
+}
+
 /****************************************************************************/
 short marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, int valuei, int lengthi)
 /****************************************************************************/
@@ -142,6 +269,8 @@ short marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizer_t *marpaWrapper
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
 #ifndef NDEBUG
   if (MARPAWRAPPER_UNLIKELY(symboli < 0)) {
     MARPAWRAPPER_ERRORF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), "Invalid symbol number %d", symboli);
@@ -152,7 +281,7 @@ short marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizer_t *marpaWrapper
 
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_alternative(%p, %d, %d, %d)", marpaWrapperRecognizerp->marpaRecognizerp, symboli, valuei, lengthi);
   if (MARPAWRAPPER_UNLIKELY(marpa_r_alternative(marpaWrapperRecognizerp->marpaRecognizerp, (Marpa_Symbol_ID) symboli, valuei, lengthi) != MARPA_ERR_NONE)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -177,6 +306,7 @@ short marpaWrapperRecognizer_completeb(marpaWrapperRecognizer_t *marpaWrapperRec
 /****************************************************************************/
 {
   MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_completeb)
+  int nbEventi;
   
 #ifndef NDEBUG
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
@@ -185,17 +315,22 @@ short marpaWrapperRecognizer_completeb(marpaWrapperRecognizer_t *marpaWrapperRec
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_earleme_complete(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
-  if (MARPAWRAPPER_UNLIKELY(marpa_r_earleme_complete(marpaWrapperRecognizerp->marpaRecognizerp) < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+  nbEventi = marpa_r_earleme_complete(marpaWrapperRecognizerp->marpaRecognizerp);
+  if (MARPAWRAPPER_UNLIKELY(nbEventi < 0)) {
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     /* As per the doc, events should be fetched even in case of failure */
-    marpaWrapperGrammar_eventb(marpaWrapperRecognizerp->marpaWrapperGrammarp, NULL, NULL, marpaWrapperRecognizerp->marpaWrapperRecognizerOption.exhaustionEventb, 1);
+    MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp);
     goto err;
   }
 
-  /* Events can happen */
-  if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammar_eventb(marpaWrapperRecognizerp->marpaWrapperGrammarp, NULL, NULL, marpaWrapperRecognizerp->marpaWrapperRecognizerOption.exhaustionEventb, 1) == 0)) {
-    goto err;
+  /* Events are fetched only when libmarpa says there are some */
+  if (! _marpaWrapperRecognizer_eventlessb(marpaWrapperRecognizerp, nbEventi)) {
+    if (MARPAWRAPPER_UNLIKELY(! MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp))) {
+      goto err;
+    }
   }
 
   MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1");
@@ -220,6 +355,8 @@ short marpaWrapperRecognizer_latestb(marpaWrapperRecognizer_t *marpaWrapperRecog
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_latest_earley_set(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   /* This method always succeed as per the doc */
   earleySetIdi = marpa_r_latest_earley_set(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -248,6 +385,96 @@ short marpaWrapperRecognizer_readb(marpaWrapperRecognizer_t *marpaWrapperRecogni
     marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp);
 }
 
+/****************************************************************************/
+short marpaWrapperRecognizer_readManyb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperRecognizerToken_t *tokenp, size_t tokenl, size_t *readlp, marpaWrapperRecognizerReadManyCallback_t readManyCallbackp, void *userDatavp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_readManyb)
+  Marpa_Recognizer                marpaRecognizerp;
+  Marpa_Error_Code                marpaErrorCodei;
+  marpaWrapperRecognizerToken_t  *p;
+  size_t                          i = 0;
+  int                             advancei;
+  int                             nbEventi;
+  short                           stopb = 0;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY((marpaWrapperRecognizerp == NULL) || ((tokenp == NULL) && (tokenl > 0)))) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
+  marpaRecognizerp = marpaWrapperRecognizerp->marpaRecognizerp;
+
+  for (p = tokenp; i < tokenl; i++, p++) {
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_alternative(%p, %d, %d, %d)", marpaRecognizerp, p->symboli, p->valuei, p->lengthi);
+    marpaErrorCodei = marpa_r_alternative(marpaRecognizerp, (Marpa_Symbol_ID) p->symboli, p->valuei, p->lengthi);
+    if (MARPAWRAPPER_UNLIKELY(marpaErrorCodei != MARPA_ERR_NONE)) {
+      /* A rejection is not fatal if the caller wants to know about it */
+      if ((marpaErrorCodei != MARPA_ERR_UNEXPECTED_TOKEN_ID) || (readManyCallbackp == NULL)) {
+        MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
+        goto err;
+      }
+      marpaWrapperRecognizerp->marpaErrorCodei = marpaErrorCodei;
+      MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "Token No %ld rejected", (unsigned long) i);
+      stopb = ! readManyCallbackp(userDatavp, i, 1 /* rejectedb */, 0, NULL);
+      MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp); /* Restore */
+      if (stopb) {
+        /* Nothing of this token was done: it is not counted */
+        break;
+      }
+    } else if (p->lengthi > 1) {
+      marpaWrapperRecognizerp->haveVariableLengthTokenb = 1;
+    }
+
+    for (advancei = 0; advancei < p->advancei; advancei++) {
+      MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_earleme_complete(%p)", marpaRecognizerp);
+      nbEventi = marpa_r_earleme_complete(marpaRecognizerp);
+      if (MARPAWRAPPER_UNLIKELY(nbEventi < 0)) {
+        MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
+        /* As per the doc, events should be fetched even in case of failure */
+        MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp);
+        goto err;
+      }
+      /* Events are materialized only when libmarpa has some */
+      if (_marpaWrapperRecognizer_eventlessb(marpaWrapperRecognizerp, nbEventi)) {
+        continue;
+      }
+      if (MARPAWRAPPER_UNLIKELY(! MARPAWRAPPERRECOGNIZER_EVENTB(marpaWrapperRecognizerp))) {
+        goto err;
+      }
+      /* Once stopped, the remaining completions of this token are still done, without callback, */
+      /* so that the batch always ends on a token boundary                                        */
+      if ((! stopb) && (marpaWrapperRecognizerp->nEventl > 0) && (readManyCallbackp != NULL)) {
+        MARPAWRAPPERRECOGNIZER_SORTEVENTV(marpaWrapperRecognizerp);
+        stopb = ! readManyCallbackp(userDatavp, i, 0 /* rejectedb */, marpaWrapperRecognizerp->nEventl, marpaWrapperRecognizerp->eventArrayp);
+        MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp); /* Restore */
+      }
+    }
+    if (stopb) {
+      i++;
+      break;
+    }
+  }
+
+  if (readlp != NULL) {
+    *readlp = i;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1 (%s after %ld tokens)", stopb ? "stopped" : "done", (unsigned long) i);
+  return 1;
+
+ err:
+  if (readlp != NULL) {
+    *readlp = i;
+  }
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 0");
+  return 0;
+}
+
 /****************************************************************************/
 short marpaWrapperRecognizer_event_onoffb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int symboli, marpaWrapperGrammarEventType_t eventSeti, int onoffb)
 /****************************************************************************/
@@ -261,6 +488,8 @@ short marpaWrapperRecognizer_event_onoffb(marpaWrapperRecognizer_t *marpaWrapper
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   if (onoffb != 0) {
     onoffb = 1;
   }
@@ -268,21 +497,21 @@ short marpaWrapperRecognizer_event_onoffb(marpaWrapperRecognizer_t *marpaWrapper
   if ((eventSeti & MARPAWRAPPERGRAMMAR_EVENTTYPE_COMPLETION) == MARPAWRAPPERGRAMMAR_EVENTTYPE_COMPLETION) {
     MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_completion_symbol_activate(%p, %d, %d)", marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb);
     if (MARPAWRAPPER_UNLIKELY(marpa_r_completion_symbol_activate(marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb) != onoffb)) {
-      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
       goto err;
     }
   }
   if ((eventSeti & MARPAWRAPPERGRAMMAR_EVENTTYPE_NULLED) == MARPAWRAPPERGRAMMAR_EVENTTYPE_NULLED) {
     MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_nulled_symbol_activate(%p, %d, %d)", marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb);
     if (MARPAWRAPPER_UNLIKELY(marpa_r_nulled_symbol_activate(marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb) != onoffb)) {
-      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
       goto err;
     }
   }
   if ((eventSeti & MARPAWRAPPERGRAMMAR_EVENTTYPE_PREDICTION) == MARPAWRAPPERGRAMMAR_EVENTTYPE_PREDICTION) {
     MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_prediction_symbol_activate(%p, %d, %d)", marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb);
     if (MARPAWRAPPER_UNLIKELY(marpa_r_prediction_symbol_activate(marpaWrapperRecognizerp->marpaRecognizerp, symboli, onoffb) != onoffb)) {
-      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
       goto err;
     }
   }
@@ -309,10 +538,12 @@ short marpaWrapperRecognizer_expectedb(marpaWrapperRecognizer_t *marpaWrapperRec
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_terminals_expected(%p, %p)", marpaWrapperRecognizerp->marpaRecognizerp, marpaWrapperRecognizerp->symbolip);
   nSymbolIdi = marpa_r_terminals_expected(marpaWrapperRecognizerp->marpaRecognizerp, marpaWrapperRecognizerp->symbolip);
   if (MARPAWRAPPER_UNLIKELY(nSymbolIdi < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -347,10 +578,12 @@ short marpaWrapperRecognizer_isExpectedb(marpaWrapperRecognizer_t *marpaWrapperR
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_terminal_is_expected(%p, %d)", marpaWrapperRecognizerp->marpaRecognizerp, symboli);
   isExpectedi = marpa_r_terminal_is_expected(marpaWrapperRecognizerp->marpaRecognizerp, symboli);
   if (MARPAWRAPPER_UNLIKELY(isExpectedi < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -380,6 +613,8 @@ short marpaWrapperRecognizer_exhaustedb(marpaWrapperRecognizer_t *marpaWrapperRe
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   /* This function always succeed as per doc */
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_is_exhausted(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   exhaustedb = (marpa_r_is_exhausted(marpaWrapperRecognizerp->marpaRecognizerp) != 0) ? 1 : 0;
@@ -422,6 +657,8 @@ short marpaWrapperRecognizer_progressb(marpaWrapperRecognizer_t *marpaWrapperRec
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   /* This function always succeed as per doc */
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_latest_earley_set(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   marpaLatestEarleySetIdi = marpa_r_latest_earley_set(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -456,7 +693,7 @@ short marpaWrapperRecognizer_progressb(marpaWrapperRecognizer_t *marpaWrapperRec
     MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_progress_report_start(%p, %d)", marpaWrapperRecognizerp->marpaRecognizerp, (int) earleySetIdi);
     nbItemsi = marpa_r_progress_report_start(marpaWrapperRecognizerp->marpaRecognizerp, earleySetIdi);
     if (MARPAWRAPPER_UNLIKELY(nbItemsi < 0)) {
-      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
       goto err;
     }
 
@@ -465,7 +702,7 @@ short marpaWrapperRecognizer_progressb(marpaWrapperRecognizer_t *marpaWrapperRec
       MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_progress_item(%p, %p, %p)", marpaWrapperRecognizerp->marpaRecognizerp, &positioni, &earleySetOrigIdi);
       rulei = marpa_r_progress_item(marpaWrapperRecognizerp->marpaRecognizerp, &positioni, &earleySetOrigIdi);
       if (MARPAWRAPPER_UNLIKELY(rulei < 0)) {
-	MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+	MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 	goto err;
       }
 
@@ -481,7 +718,7 @@ short marpaWrapperRecognizer_progressb(marpaWrapperRecognizer_t *marpaWrapperRec
 
     MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_progress_report_finish(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
     if (MARPAWRAPPER_UNLIKELY(marpa_r_progress_report_finish(marpaWrapperRecognizerp->marpaRecognizerp) < 0)) {
-      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
       goto err;
     }
 
@@ -527,6 +764,8 @@ short marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizer_t *marpaWrapper
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   genericLoggerp = marpaWrapperRecognizerp->marpaWrapperRecognizerOption.genericLoggerp;
 
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizer_progressb(marpaWrapperRecognizerp, starti, endi, NULL, NULL) == 0)) {
@@ -547,22 +786,23 @@ short marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizer_t *marpaWrapper
 	  /* MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_earleme(%p, %d)", marpaWrapperRecognizerp->marpaRecognizerp, marpaWrapperRecognizerp->progressp[i].earleySetIdi); */
 	  earlemei = marpa_r_earleme(marpaWrapperRecognizerp->marpaRecognizerp, (Marpa_Earley_Set_ID) marpaWrapperRecognizerp->progressp[i].earleySetIdi);
 	  if (MARPAWRAPPER_UNLIKELY(earlemei < 0)) {
-	    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+	    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 	    goto err;
 	  }
 	  earlemeorigi = marpa_r_earleme(marpaWrapperRecognizerp->marpaRecognizerp, (Marpa_Earley_Set_ID) marpaWrapperRecognizerp->progressp[i].earleySetOrigIdi);
 	  if (MARPAWRAPPER_UNLIKELY(earlemeorigi < 0)) {
-	    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+	    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 	    goto err;
 	  }
 
 	  /* MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_rule_lhs(%p, %d)", marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, marpaWrapperRecognizerp->progressp[i].rulei); */
 	  lhsi = marpa_g_rule_lhs(marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, (Marpa_Rule_ID) marpaWrapperRecognizerp->progressp[i].rulei);
 	  if (MARPAWRAPPER_UNLIKELY(lhsi < 0)) {
-	    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+	    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 	    goto err;
 	  }
 	  descriptionLHSs = symbolDescriptionCallbackp(userDatavp, lhsi);
+	  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp); /* Restore */
 	  if ((descriptionLHSs == NULL) || (strlen(descriptionLHSs) <= 0)) {
 	    descriptionLHSs = "?";
 	  }
@@ -570,7 +810,7 @@ short marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizer_t *marpaWrapper
 	  /* MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_rule_length(%p, %d)", marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, marpaWrapperRecognizerp->progressp[i].rulei); */
 	  ruleLengthi = marpa_g_rule_length(marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, (Marpa_Rule_ID) marpaWrapperRecognizerp->progressp[i].rulei);
 	  if (MARPAWRAPPER_UNLIKELY(ruleLengthi < 0)) {
-	    MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+	    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 	    goto err;
 	  }
 
@@ -589,10 +829,11 @@ short marpaWrapperRecognizer_progressLogb(marpaWrapperRecognizer_t *marpaWrapper
 	      /* MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_g_rule_rhs(%p, %d, %d)", marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, marpaWrapperRecognizerp->progressp[i].rulei, ix); */
 	      rhsi = marpa_g_rule_rhs(marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp, (Marpa_Rule_ID) marpaWrapperRecognizerp->progressp[i].rulei, ix);
 	      if (MARPAWRAPPER_UNLIKELY(rhsi < 0)) {
-		MARPAWRAPPER_MARPA_G_ERROR(genericLoggerp, marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+		MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
 		goto err;
 	      }
 	      descriptionRHSs = symbolDescriptionCallbackp(userDatavp, rhsi);
+	      MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp); /* Restore */
 	      if ((descriptionRHSs == NULL) || (strlen(descriptionRHSs) <= 0)) {
 		descriptionRHSs = "?";
 	      }
@@ -654,6 +895,7 @@ void marpaWrapperRecognizer_freev(marpaWrapperRecognizer_t *marpaWrapperRecogniz
   if (marpaWrapperRecognizerp != NULL) {
     /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
     genericLoggerp = marpaWrapperRecognizerp->marpaWrapperRecognizerOption.genericLoggerp;
+    MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
 
     if (marpaWrapperRecognizerp->marpaRecognizerp != NULL) {
       MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_unref(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
@@ -666,6 +908,9 @@ void marpaWrapperRecognizer_freev(marpaWrapperRecognizer_t *marpaWrapperRecogniz
     MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing progress table");
     MARPAWRAPPER_FREEBUF(marpaWrapperRecognizerp->progressp);
 
+    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing last list of events");
+    MARPAWRAPPER_FREEBUF(marpaWrapperRecognizerp->eventArrayp);
+
     MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperRecognizerp);
     free(marpaWrapperRecognizerp);
 
@@ -709,9 +954,11 @@ short marpaWrapperRecognizer_contextSetb(marpaWrapperRecognizer_t *marpaWrapperR
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_latest_earley_set_values_set(%p, %d, %p)", marpaWrapperRecognizerp->marpaRecognizerp, context.valuei, context.valuep);
   if (MARPAWRAPPER_UNLIKELY(marpa_r_latest_earley_set_values_set(marpaWrapperRecognizerp->marpaRecognizerp, context.valuei, context.valuep) < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -741,6 +988,8 @@ short marpaWrapperRecognizer_contextGetb(marpaWrapperRecognizer_t *marpaWrapperR
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   /* This function always succeed as per doc */
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_latest_earley_set(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   marpaLatestEarleySetIdi = marpa_r_latest_earley_set(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -755,7 +1004,7 @@ short marpaWrapperRecognizer_contextGetb(marpaWrapperRecognizer_t *marpaWrapperR
 
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_earley_set_values(%p, %d, %p, %p)", marpaWrapperRecognizerp->marpaRecognizerp, reali, &valuei, &valuep);
   if (MARPAWRAPPER_UNLIKELY(marpa_r_earley_set_values(marpaWrapperRecognizerp->marpaRecognizerp, (Marpa_Earley_Set_ID) reali, &valuei, &valuep) < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -786,6 +1035,8 @@ short marpaWrapperRecognizer_currentEarlemeb(marpaWrapperRecognizer_t *marpaWrap
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_current_earleme(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   /* Always succeeds as per the doc */
   currentEarlemei = marpa_r_current_earleme(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -820,6 +1071,8 @@ short marpaWrapperRecognizer_earlemeb(marpaWrapperRecognizer_t *marpaWrapperReco
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   /* This function always succeed as per doc */
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_latest_earley_set(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   marpaLatestEarleySetIdi = marpa_r_latest_earley_set(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -835,7 +1088,7 @@ short marpaWrapperRecognizer_earlemeb(marpaWrapperRecognizer_t *marpaWrapperReco
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_earleme(%p, %d)", marpaWrapperRecognizerp->marpaRecognizerp, reali);
   earlemei = marpa_r_earleme(marpaWrapperRecognizerp->marpaRecognizerp, (Marpa_Earley_Set_ID) reali);
   if (MARPAWRAPPER_UNLIKELY(earlemei < 0)) {
-    MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+    MARPAWRAPPERRECOGNIZER_MARPA_ERROR(marpaWrapperRecognizerp);
     goto err;
   }
 
@@ -865,6 +1118,8 @@ short marpaWrapperRecognizer_furthestEarlemeb(marpaWrapperRecognizer_t *marpaWra
   }
 #endif
 
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
+
   MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "marpa_r_furthest_earleme(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
   /* Always succeeds as per the doc */
   furthestEarlemei = marpa_r_furthest_earleme(marpaWrapperRecognizerp->marpaRecognizerp);
@@ -882,3 +1137,108 @@ short marpaWrapperRecognizer_furthestEarlemeb(marpaWrapperRecognizer_t *marpaWra
   return 0;
 #endif
 }
+
+/****************************************************************************/
+short marpaWrapperRecognizer_eventb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t *eventlp, marpaWrapperGrammarEvent_t **eventpp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_eventb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (eventlp != NULL) {
+    *eventlp = marpaWrapperRecognizerp->nEventl;
+  }
+  if (eventpp != NULL) {
+    MARPAWRAPPERRECOGNIZER_SORTEVENTV(marpaWrapperRecognizerp);
+    *eventpp = (marpaWrapperRecognizerp->nEventl > 0) ? marpaWrapperRecognizerp->eventArrayp : NULL;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+short marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *marpaErrorCodeip)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_lastErrorb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (marpaErrorCodeip != NULL) {
+    *marpaErrorCodeip = marpaWrapperRecognizerp->marpaErrorCodei;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+short marpaWrapperRecognizer_completeStatsb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t *completelp, size_t *eventlessCompletelp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizer_completeStatsb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (completelp != NULL) {
+    *completelp = marpaWrapperRecognizerp->nCompletel;
+  }
+  if (eventlessCompletelp != NULL) {
+    *eventlessCompletelp = marpaWrapperRecognizerp->nEventlessCompletel;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZER_GENERICLOGGERP(marpaWrapperRecognizerp), funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperRecognizer_eventlessb(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int nbEventi)
+/****************************************************************************/
+/* Accounts for an earleme completion that generated nbEventi events, and   */
+/* returns 1 when there is none: the list of events is then just emptied.   */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerp->nCompletel++;
+  if (nbEventi != 0) {
+    return 0;
+  }
+
+  marpaWrapperRecognizerp->nEventlessCompletel++;
+  marpaWrapperRecognizerp->nEventl = 0;
+  return 1;
+}
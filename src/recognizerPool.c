@@ -0,0 +1,233 @@
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "marpaWrapper/internal/config.h"
+#include "marpaWrapper/internal/_manageBuf.h"
+#include "marpaWrapper/internal/_allocator.h"
+#include "marpaWrapper/internal/_recognizerPool.h"
+#include "marpaWrapper/internal/_recognizer.h"
+#include "marpaWrapper/internal/_grammar.h"
+#include "marpaWrapper/internal/_logging.h"
+
+static marpaWrapperRecognizerOption_t marpaWrapperRecognizerPoolOptionDefault = {
+  NULL,    /* genericLoggerp   */
+  0,       /* disableThresholdb */
+  0,       /* exhaustionEventb */
+  NULL     /* allocatorp */
+};
+
+/* Macro that return genericLoggerp from a marpaWrapperRecognizerPoolp */
+#define MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp) ((marpaWrapperRecognizerPoolp != NULL) ? (marpaWrapperRecognizerPoolp)->marpaWrapperRecognizerOption.genericLoggerp : NULL)
+
+/****************************************************************************/
+marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPool_newp(marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizerOption_t *marpaWrapperRecognizerOptionp, size_t maxWarml)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizerPool_newp)
+  marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp = NULL;
+  genericLogger_t              *genericLoggerp;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperGrammarp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (marpaWrapperRecognizerOptionp == NULL) {
+    marpaWrapperRecognizerOptionp = &marpaWrapperRecognizerPoolOptionDefault;
+  }
+  genericLoggerp = marpaWrapperRecognizerOptionp->genericLoggerp;
+
+  /* Same allocator as the recognizers of the pool */
+  MARPAWRAPPER_ALLOCATOR_SET((marpaWrapperRecognizerOptionp->allocatorp != NULL) ? marpaWrapperRecognizerOptionp->allocatorp : marpaWrapperGrammarp->marpaWrapperGrammarOption.allocatorp);
+
+  marpaWrapperRecognizerPoolp = (marpaWrapperRecognizerPool_t *) malloc(sizeof(marpaWrapperRecognizerPool_t));
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerPoolp == NULL)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "malloc failure: %s", strerror(errno));
+    goto err;
+  }
+
+  marpaWrapperRecognizerPoolp->marpaWrapperGrammarp                    = marpaWrapperGrammarp;
+  marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption            = *marpaWrapperRecognizerOptionp;
+  marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption.allocatorp = _marpaWrapperAllocator_currentp;
+  marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption.genericLoggerp = NULL;
+  marpaWrapperRecognizerPoolp->maxWarml                                = maxWarml;
+  marpaWrapperRecognizerPoolp->sizeWarml                               = 0;
+  marpaWrapperRecognizerPoolp->nWarml                                  = 0;
+  marpaWrapperRecognizerPoolp->warmpp                                  = NULL;
+  marpaWrapperRecognizerPoolp->hitl                                    = 0;
+  marpaWrapperRecognizerPoolp->missl                                   = 0;
+
+  if (maxWarml > 0) {
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Pre-allocating room for %ld warm recognizers", (unsigned long) maxWarml);
+    MARPAWRAPPER_MANAGEBUF(genericLoggerp, marpaWrapperRecognizerPoolp->warmpp, marpaWrapperRecognizerPoolp->sizeWarml, maxWarml, sizeof(marpaWrapperRecognizer_t *));
+  }
+
+  if (genericLoggerp != NULL) {
+    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Cloning genericLogger");
+
+    marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption.genericLoggerp = GENERICLOGGER_CLONE(genericLoggerp);
+    if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption.genericLoggerp == NULL)) {
+      MARPAWRAPPER_ERRORF(genericLoggerp, "Failed to clone genericLogger: %s", strerror(errno));
+      goto err;
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "return %p", marpaWrapperRecognizerPoolp);
+  return marpaWrapperRecognizerPoolp;
+
+err:
+  if (marpaWrapperRecognizerPoolp != NULL) {
+    int errnoi = errno;
+    marpaWrapperRecognizerPool_freev(marpaWrapperRecognizerPoolp);
+    errno = errnoi;
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+marpaWrapperRecognizer_t *marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizerPool_getp)
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerPoolp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (marpaWrapperRecognizerPoolp->nWarml > 0) {
+    marpaWrapperRecognizerp = marpaWrapperRecognizerPoolp->warmpp[--marpaWrapperRecognizerPoolp->nWarml];
+    marpaWrapperRecognizerp->warmb = 0;
+    marpaWrapperRecognizerPoolp->hitl++;
+  } else {
+    marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperRecognizerPoolp->marpaWrapperGrammarp, &(marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption));
+    if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp == NULL)) {
+      goto err;
+    }
+    marpaWrapperRecognizerPoolp->missl++;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return %p", marpaWrapperRecognizerp);
+  return marpaWrapperRecognizerp;
+
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return NULL");
+  return NULL;
+}
+
+/****************************************************************************/
+short marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp, marpaWrapperRecognizer_t *marpaWrapperRecognizerp)
+/****************************************************************************/
+/* On failure the recognizer is left to the caller.                         */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizerPool_releaseb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY((marpaWrapperRecognizerPoolp == NULL) || (marpaWrapperRecognizerp == NULL))) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->marpaWrapperGrammarp != marpaWrapperRecognizerPoolp->marpaWrapperGrammarp)) {
+    MARPAWRAPPER_ERROR(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), "Recognizer is not on the grammar of the pool");
+    errno = EINVAL;
+    goto err;
+  }
+
+  /* A warm recognizer is already owned by the pool */
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->warmb)) {
+    MARPAWRAPPER_ERROR(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), "Recognizer is already released");
+    errno = EINVAL;
+    goto err;
+  }
+
+  if (marpaWrapperRecognizerPoolp->nWarml >= marpaWrapperRecognizerPoolp->maxWarml) {
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "%ld warm recognizers: freeing %p", (unsigned long) marpaWrapperRecognizerPoolp->nWarml, marpaWrapperRecognizerp);
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  } else {
+    if (MARPAWRAPPER_UNLIKELY(! marpaWrapperRecognizer_resetb(marpaWrapperRecognizerp))) {
+      goto err;
+    }
+    marpaWrapperRecognizerp->warmb = 1;
+    marpaWrapperRecognizerPoolp->warmpp[marpaWrapperRecognizerPoolp->nWarml++] = marpaWrapperRecognizerp;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return 1");
+  return 1;
+
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperRecognizerPool_statsb(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp, size_t *hitlp, size_t *misslp, size_t *warmlp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizerPool_statsb)
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerPoolp == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  if (hitlp != NULL) {
+    *hitlp = marpaWrapperRecognizerPoolp->hitl;
+  }
+  if (misslp != NULL) {
+    *misslp = marpaWrapperRecognizerPoolp->missl;
+  }
+  if (warmlp != NULL) {
+    *warmlp = marpaWrapperRecognizerPoolp->nWarml;
+  }
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return 1");
+  return 1;
+
+#ifndef NDEBUG
+ err:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERRECOGNIZERPOOL_GENERICLOGGERP(marpaWrapperRecognizerPoolp), funcs, "return 0");
+  return 0;
+#endif
+}
+
+/****************************************************************************/
+void marpaWrapperRecognizerPool_freev(marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperRecognizerPool_freev)
+  genericLogger_t  *genericLoggerp;
+
+  if (marpaWrapperRecognizerPoolp != NULL) {
+    /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
+    genericLoggerp = marpaWrapperRecognizerPoolp->marpaWrapperRecognizerOption.genericLoggerp;
+
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Freeing %ld warm recognizers", (unsigned long) marpaWrapperRecognizerPoolp->nWarml);
+    while (marpaWrapperRecognizerPoolp->nWarml > 0) {
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerPoolp->warmpp[--marpaWrapperRecognizerPoolp->nWarml]);
+    }
+
+    MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing warm recognizers table");
+    MARPAWRAPPER_FREEBUF(marpaWrapperRecognizerPoolp->warmpp);
+
+    MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperRecognizerPoolp);
+    free(marpaWrapperRecognizerPoolp);
+
+    if (genericLoggerp != NULL) {
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Freeing cloned generic logger");
+      GENERICLOGGER_FREE(genericLoggerp);
+    }
+  }
+}
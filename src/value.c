@@ -5,10 +5,12 @@
 
 #include "marpa.h"
 #include "marpaWrapper/internal/config.h"
+#include "marpaWrapper/internal/_allocator.h"
 #include "marpaWrapper/internal/_value.h"
 #include "marpaWrapper/internal/_recognizer.h"
 #include "marpaWrapper/internal/_grammar.h"
 #include "marpaWrapper/internal/_logging.h"
+#include "marpaWrapper/internal/_manageBuf.h"
 
 static marpaWrapperValueOption_t marpaWrapperValueOptionDefault = {
   NULL,                           /* genericLoggerp */
@@ -16,12 +18,46 @@ static marpaWrapperValueOption_t marpaWrapperValueOptionDefault = {
   1,                              /* orderByRankb */
   0,                              /* ambiguousb */
   0,                              /* nullb */
-  0                               /* maxParsesi */
+  0,                              /* maxParsesi */
+  0                               /* reuseValuatorb */
 };
 
 /* Macro that return genericLoggerp from a marpaWrapperValuep */
 #define MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep) ((marpaWrapperValuep != NULL) ? (marpaWrapperValuep)->marpaWrapperValueOption.genericLoggerp : NULL)
 
+/* Valuation runs in the context of the recognizer: its allocator, and its libmarpa events and errors */
+#define MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep) MARPAWRAPPERRECOGNIZER_CONTEXT_SET((marpaWrapperValuep)->marpaWrapperRecognizerp)
+
+/* With reuseValuatorb the blocks of the Marpa valuator come from the cache of the value: the cache is */
+/* the current allocator during the libmarpa calls that allocate, reallocate or free them.             */
+#define MARPAWRAPPERVALUE_VALUATOR_SET(marpaWrapperValuep) do {              \
+    if ((marpaWrapperValuep)->marpaWrapperValueOption.reuseValuatorb) {       \
+      MARPAWRAPPER_ALLOCATOR_SET(&((marpaWrapperValuep)->cacheAllocator));    \
+    }                                                                         \
+  } while (0)
+#define MARPAWRAPPERVALUE_VALUATOR_UNSET(marpaWrapperValuep) do {            \
+    if ((marpaWrapperValuep)->marpaWrapperValueOption.reuseValuatorb) {       \
+      MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);                      \
+    }                                                                         \
+  } while (0)
+
+static int _marpaWrapperValue_treei(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value *marpaValuepp);
+static inline Marpa_Step_Type _marpaWrapperValue_valuator_stepi(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value marpaValuep);
+static inline void            _marpaWrapperValue_valuator_unrefv(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value marpaValuep);
+
+/* Specific to tree images */
+static inline void         _marpaWrapperValue_image_setv(unsigned char *imagep, size_t wordl, int valuei);
+static inline int          _marpaWrapperValue_image_geti(unsigned char *imagep, size_t wordl);
+static inline unsigned int _marpaWrapperValue_image_checksumi(unsigned char *p, size_t lengthl);
+static inline size_t       _marpaWrapperValue_image_putl(unsigned char *p, unsigned int valueu);
+static inline short        _marpaWrapperValue_image_getb(unsigned char **pp, unsigned char *endp, unsigned int *valueup);
+
+/* Specific to the valuator cache */
+static void *_marpaWrapperValue_cache_mallocp(void *userDatavp, size_t sizel);
+static void *_marpaWrapperValue_cache_reallocp(void *userDatavp, void *p, size_t sizel);
+static void  _marpaWrapperValue_cache_freev(void *userDatavp, void *p);
+static void  _marpaWrapperValue_cache_releasev(marpaWrapperValue_t *marpaWrapperValuep);
+
 /****************************************************************************/
 marpaWrapperValue_t *marpaWrapperValue_newp(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperValueOption_t *marpaWrapperValueOptionp)
 /****************************************************************************/
@@ -45,6 +81,7 @@ marpaWrapperValue_t *marpaWrapperValue_newp(marpaWrapperRecognizer_t *marpaWrapp
     marpaWrapperValueOptionp = &marpaWrapperValueOptionDefault;
   }
   genericLoggerp = marpaWrapperValueOptionp->genericLoggerp;
+  MARPAWRAPPERRECOGNIZER_CONTEXT_SET(marpaWrapperRecognizerp);
 
   /* Impossible if we are already valuating it */
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperRecognizerp->treeModeb != MARPAWRAPPERRECOGNIZERTREEMODE_NA)) {
@@ -66,6 +103,17 @@ marpaWrapperValue_t *marpaWrapperValue_newp(marpaWrapperRecognizer_t *marpaWrapp
   marpaWrapperValuep->marpaOrderp             = NULL;
   marpaWrapperValuep->marpaTreep              = NULL;
   marpaWrapperValuep->marpaValuep             = NULL; /* Is not NULL only during valueb lifetime */
+  marpaWrapperValuep->stepp                   = NULL;
+  marpaWrapperValuep->sizeStepl               = 0;
+  marpaWrapperValuep->imagep                  = NULL;
+  marpaWrapperValuep->sizeImagel              = 0;
+  marpaWrapperValuep->cacheAllocator.userDatavp = marpaWrapperValuep;
+  marpaWrapperValuep->cacheAllocator.mallocp    = _marpaWrapperValue_cache_mallocp;
+  marpaWrapperValuep->cacheAllocator.reallocp   = _marpaWrapperValue_cache_reallocp;
+  marpaWrapperValuep->cacheAllocator.freep      = _marpaWrapperValue_cache_freev;
+  marpaWrapperValuep->freeBlockp                = NULL;
+  marpaWrapperValuep->allocationl               = 0;
+  marpaWrapperValuep->reusel                    = 0;
 
   /* Always succeed as per the doc */
   MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_r_latest_earley_set(%p)", marpaWrapperRecognizerp->marpaRecognizerp);
@@ -172,34 +220,16 @@ err:
 }
 
 /****************************************************************************/
-short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperValuep,
-			       void                              *userDatavp,
-			       marpaWrapperValueRuleCallback_t    ruleCallbackp,
-			       marpaWrapperValueSymbolCallback_t  symbolCallbackp,
-			       marpaWrapperValueNullingCallback_t nullingCallbackp)
+static int _marpaWrapperValue_treei(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value *marpaValuepp)
+/****************************************************************************/
+/* Moves to the next tree and creates its Marpa_Value: returns 1, 0 if there */
+/* is no more tree, -1 on failure.                                           */
 /****************************************************************************/
 {
-  /* We take much care to set marpaWrapperValuep->marpaValuep only around the callbacks */
-  MARPAWRAPPER_FUNCS(marpaWrapperValue_valueb)
+  MARPAWRAPPER_FUNCS(_marpaWrapperValue_treei)
   int               tnexti;
-  Marpa_Value       marpaValuep = NULL;
-  int               nexti;
-  Marpa_Step_Type   stepi;
-  Marpa_Rule_ID     marpaRuleIdi;
-  Marpa_Symbol_ID   marpaSymbolIdi;
-  int               argFirsti;
-  int               argLasti;
-  int               argResulti;
-  int               tokenValuei;
   int               nParsesi;
-  short             callbackb;
-
-#ifndef NDEBUG
-  if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep == NULL)) {
-    errno = EINVAL;
-    goto err;
-  }
-#endif
+  Marpa_Value       marpaValuep = NULL;
 
   MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_t_next(%p)", marpaWrapperValuep->marpaTreep);
   tnexti = marpa_t_next(marpaWrapperValuep->marpaTreep);
@@ -220,7 +250,9 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
   MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "Number of parse trees: %d, max=%d", nParsesi, marpaWrapperValuep->marpaWrapperValueOption.maxParsesi);
 
   MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_new(%p)", marpaWrapperValuep->marpaTreep);
+  MARPAWRAPPERVALUE_VALUATOR_SET(marpaWrapperValuep);
   marpaValuep = marpa_v_new(marpaWrapperValuep->marpaTreep);
+  MARPAWRAPPERVALUE_VALUATOR_UNSET(marpaWrapperValuep);
   if (MARPAWRAPPER_UNLIKELY(marpaValuep == NULL)) {
     MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
     goto err;
@@ -232,10 +264,69 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
     goto err;
   }
 
+  *marpaValuepp = marpaValuep;
+
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 1");
+  return 1;
+
+ done:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 0");
+  return 0;
+
+ err:
+  if (marpaValuep != NULL) {
+    int errnoi = errno;
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
+    _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
+    errno = errnoi;
+  }
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return -1");
+  return -1;
+}
+
+/****************************************************************************/
+short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperValuep,
+			       void                              *userDatavp,
+			       marpaWrapperValueRuleCallback_t    ruleCallbackp,
+			       marpaWrapperValueSymbolCallback_t  symbolCallbackp,
+			       marpaWrapperValueNullingCallback_t nullingCallbackp)
+/****************************************************************************/
+{
+  /* We take much care to set marpaWrapperValuep->marpaValuep only around the callbacks */
+  MARPAWRAPPER_FUNCS(marpaWrapperValue_valueb)
+  Marpa_Value       marpaValuep = NULL;
+  int               nexti;
+  Marpa_Step_Type   stepi;
+  Marpa_Rule_ID     marpaRuleIdi;
+  Marpa_Symbol_ID   marpaSymbolIdi;
+  int               argFirsti;
+  int               argLasti;
+  int               argResulti;
+  int               tokenValuei;
+  short             callbackb;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+
+  switch (_marpaWrapperValue_treei(marpaWrapperValuep, &marpaValuep)) {
+  case 0:
+    goto done;
+  case 1:
+    break;
+  default:
+    goto err;
+  }
+
   nexti = 1;
   while (nexti != 0) {
     MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_step(%p)", marpaValuep);
-    stepi = marpa_v_step(marpaValuep);
+    stepi = _marpaWrapperValue_valuator_stepi(marpaWrapperValuep, marpaValuep);
     if (MARPAWRAPPER_UNLIKELY(stepi < 0)) {
       MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
       goto err;
@@ -264,6 +355,7 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
         marpaWrapperValuep->marpaValuep = marpaValuep;
 	callbackb = ruleCallbackp(userDatavp, (int) marpaRuleIdi, argFirsti, argLasti, argResulti);
         marpaWrapperValuep->marpaValuep = NULL;
+        MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep); /* Restore */
         if (callbackb == 0) {
 	  MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "Rule No %d value callback failure", (int) marpaRuleIdi);
 	  goto err;
@@ -288,6 +380,7 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
         marpaWrapperValuep->marpaValuep = marpaValuep;
 	callbackb = symbolCallbackp(userDatavp, (int) marpaSymbolIdi, tokenValuei, argResulti);
         marpaWrapperValuep->marpaValuep = NULL;
+        MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep); /* Restore */
         if (callbackb == 0) {
 	  MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "Symbol No %d value callback failure", (int) marpaSymbolIdi);
 	  goto err;
@@ -309,6 +402,7 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
         marpaWrapperValuep->marpaValuep = marpaValuep;
 	callbackb = nullingCallbackp(userDatavp, (int) marpaSymbolIdi, argResulti);
         marpaWrapperValuep->marpaValuep = NULL;
+        MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep); /* Restore */
         if (callbackb == 0) {
 	  MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "Nulling symbol No %d value callback failure", (int) marpaSymbolIdi);
 	  goto err;
@@ -327,7 +421,7 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
   }
   
   MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
-  marpa_v_unref(marpaValuep);
+  _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
 
   MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 1");
   return 1;
@@ -335,7 +429,7 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
  done:
   if (marpaValuep != NULL) {
     MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
-    marpa_v_unref(marpaValuep);
+    _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
   }
 
   MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 0");
@@ -345,13 +439,452 @@ short marpaWrapperValue_valueb(marpaWrapperValue_t               *marpaWrapperVa
   if (marpaValuep != NULL) {
     int errnoi = errno;
     MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
-    marpa_v_unref(marpaValuep);
+    _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
+    errno = errnoi;
+  }
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return -1");
+  return -1;
+}
+
+/****************************************************************************/
+short marpaWrapperValue_stepsb(marpaWrapperValue_t      *marpaWrapperValuep,
+			       marpaWrapperValueStep_t  *stepp,
+			       size_t                    sizeStepl,
+			       marpaWrapperValueStep_t **stepspp,
+			       size_t                   *nSteplp)
+/****************************************************************************/
+/* There is no callback: the marpa_v_* accessors are macros, so the loop    */
+/* below does one marpa_v_step() call per step and nothing else.            */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperValue_stepsb)
+  Marpa_Value                marpaValuep = NULL;
+  marpaWrapperValueStep_t   *outp;
+  size_t                     sizeOutl;
+  short                      ownedb;
+  size_t                     nStepl = 0;
+  marpaWrapperValueStep_t   *currentp;
+  Marpa_Step_Type            stepi;
+  int                        nexti;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+
+  if ((stepp != NULL) && (sizeStepl > 0)) {
+    outp     = stepp;
+    sizeOutl = sizeStepl;
+    ownedb   = 0;
+  } else {
+    outp     = marpaWrapperValuep->stepp;
+    sizeOutl = marpaWrapperValuep->sizeStepl;
+    ownedb   = 1;
+  }
+
+  switch (_marpaWrapperValue_treei(marpaWrapperValuep, &marpaValuep)) {
+  case 0:
+    goto done;
+  case 1:
+    break;
+  default:
+    goto err;
+  }
+
+  nexti = 1;
+  while (nexti != 0) {
+    stepi = _marpaWrapperValue_valuator_stepi(marpaWrapperValuep, marpaValuep);
+    if (MARPAWRAPPER_UNLIKELY(stepi < 0)) {
+      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      goto err;
+    }
+
+    MARPAWRAPPER_MARPA_STEP_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, stepi);
+
+    switch (stepi) {
+    case MARPA_STEP_RULE:
+    case MARPA_STEP_TOKEN:
+    case MARPA_STEP_NULLING_SYMBOL:
+      if (MARPAWRAPPER_UNLIKELY(nStepl >= sizeOutl)) {
+        /* When the caller buffer is full, we continue in ours */
+        MARPAWRAPPER_MANAGEBUF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->stepp, marpaWrapperValuep->sizeStepl, nStepl + 1, sizeof(marpaWrapperValueStep_t));
+        if (! ownedb) {
+          MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "Caller buffer of %lu steps is full", (unsigned long) sizeStepl);
+          memcpy(marpaWrapperValuep->stepp, stepp, nStepl * sizeof(marpaWrapperValueStep_t));
+          ownedb = 1;
+        }
+        outp     = marpaWrapperValuep->stepp;
+        sizeOutl = marpaWrapperValuep->sizeStepl;
+      }
+      currentp = &(outp[nStepl++]);
+
+      if (stepi == MARPA_STEP_RULE) {
+        currentp->typei       = MARPAWRAPPERVALUE_STEP_RULE;
+        currentp->idi         = (int) marpa_v_rule(marpaValuep);
+        currentp->arg0i       = marpa_v_arg_0(marpaValuep);
+        currentp->argni       = marpa_v_arg_n(marpaValuep);
+        currentp->resulti     = marpa_v_result(marpaValuep);
+        currentp->tokenValuei = -1;
+        currentp->starti      = (int) marpa_v_rule_start_es_id(marpaValuep);
+        currentp->lengthi     = (int) marpa_v_es_id(marpaValuep) - currentp->starti + 1;
+        MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "Rule %d: Stack [%d..%d] -> Stack %d", currentp->idi, currentp->arg0i, currentp->argni, currentp->resulti);
+      } else if (stepi == MARPA_STEP_TOKEN) {
+        currentp->typei       = MARPAWRAPPERVALUE_STEP_TOKEN;
+        currentp->idi         = (int) marpa_v_token(marpaValuep);
+        currentp->resulti     = marpa_v_result(marpaValuep);
+        currentp->arg0i       = currentp->resulti;
+        currentp->argni       = currentp->resulti;
+        currentp->tokenValuei = marpa_v_token_value(marpaValuep);
+        currentp->starti      = (int) marpa_v_token_start_es_id(marpaValuep);
+        currentp->lengthi     = (int) marpa_v_es_id(marpaValuep) - currentp->starti + 1;
+        MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "Symbol %d: Stack %d -> Stack %d", currentp->idi, currentp->tokenValuei, currentp->resulti);
+      } else {
+        currentp->typei       = MARPAWRAPPERVALUE_STEP_NULLING;
+        currentp->idi         = (int) marpa_v_symbol(marpaValuep);
+        currentp->resulti     = marpa_v_result(marpaValuep);
+        currentp->arg0i       = currentp->resulti;
+        currentp->argni       = currentp->resulti;
+        currentp->tokenValuei = -1;
+        currentp->starti      = (int) marpa_v_token_start_es_id(marpaValuep);
+        currentp->lengthi     = 0;
+        MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "Nulling symbol %d-> Stack %d", currentp->idi, currentp->resulti);
+      }
+      break;
+    case MARPA_STEP_INACTIVE:
+      nexti = 0;
+      break;
+    default:
+      break;
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
+  _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
+
+  if (stepspp != NULL) {
+    *stepspp = outp;
+  }
+  if (nSteplp != NULL) {
+    *nSteplp = nStepl;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 1 (%lu steps)", (unsigned long) nStepl);
+  return 1;
+
+ done:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 0");
+  return 0;
+
+ err:
+  if (marpaValuep != NULL) {
+    int errnoi = errno;
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
+    _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
+    errno = errnoi;
+  }
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return -1");
+  return -1;
+}
+
+/****************************************************************************/
+short marpaWrapperValue_serializeb(marpaWrapperValue_t *marpaWrapperValuep, char **bufferpp, size_t *bufferlp)
+/****************************************************************************/
+/* Marpa steps are already in postfix order, with a result that is always   */
+/* the bottom of the arguments: we only check that the stack indices are    */
+/* the ones an evaluation stack would give, so that they need no storage.   */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperValue_serializeb)
+  Marpa_Value       marpaValuep = NULL;
+  unsigned char    *bufferp     = NULL;
+  size_t            imagel      = MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4;
+  int               depthi      = 0;
+  int               nStepi      = 0;
+  unsigned char    *p;
+  Marpa_Step_Type   stepi;
+  int               idi;
+  int               arg0i;
+  int               argni;
+  int               resulti;
+  int               tokenValuei;
+  int               nexti;
+
+#ifndef NDEBUG
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep == NULL)) {
+    errno = EINVAL;
+    goto err;
+  }
+#endif
+
+  MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+
+  switch (_marpaWrapperValue_treei(marpaWrapperValuep, &marpaValuep)) {
+  case 0:
+    goto done;
+  case 1:
+    break;
+  default:
+    goto err;
+  }
+
+  nexti = 1;
+  while (nexti != 0) {
+    stepi = _marpaWrapperValue_valuator_stepi(marpaWrapperValuep, marpaValuep);
+    if (MARPAWRAPPER_UNLIKELY(stepi < 0)) {
+      MARPAWRAPPER_MARPA_G_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperGrammarp->marpaGrammarp);
+      goto err;
+    }
+
+    MARPAWRAPPER_MARPA_STEP_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, stepi);
+
+    switch (stepi) {
+    case MARPA_STEP_RULE:
+    case MARPA_STEP_TOKEN:
+    case MARPA_STEP_NULLING_SYMBOL:
+      MARPAWRAPPER_MANAGEBUF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->imagep, marpaWrapperValuep->sizeImagel, imagel + MARPAWRAPPERVALUE_IMAGE_STEP_MAXBYTES, sizeof(unsigned char));
+      p       = marpaWrapperValuep->imagep + imagel;
+      resulti = marpa_v_result(marpaValuep);
+
+      if (stepi == MARPA_STEP_RULE) {
+        idi   = (int) marpa_v_rule(marpaValuep);
+        arg0i = marpa_v_arg_0(marpaValuep);
+        argni = marpa_v_arg_n(marpaValuep);
+        if (MARPAWRAPPER_UNLIKELY((argni != (depthi - 1)) || (arg0i > argni) || (arg0i < 0) || (resulti != arg0i))) {
+          MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "Rule %d: Stack [%d..%d] -> Stack %d does not match a stack depth of %d", idi, arg0i, argni, resulti, depthi);
+          goto err;
+        }
+        p += _marpaWrapperValue_image_putl(p, (((unsigned int) idi) << 2) | MARPAWRAPPERVALUE_STEP_RULE);
+        p += _marpaWrapperValue_image_putl(p, (unsigned int) (argni - arg0i + 1));
+        depthi = resulti + 1;
+      } else {
+        if (MARPAWRAPPER_UNLIKELY(resulti != depthi)) {
+          MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "Symbol step -> Stack %d does not match a stack depth of %d", resulti, depthi);
+          goto err;
+        }
+        if (stepi == MARPA_STEP_TOKEN) {
+          idi         = (int) marpa_v_token(marpaValuep);
+          tokenValuei = marpa_v_token_value(marpaValuep);
+          p += _marpaWrapperValue_image_putl(p, (((unsigned int) idi) << 2) | MARPAWRAPPERVALUE_STEP_TOKEN);
+          /* Zigzag: small negative values stay small */
+          p += _marpaWrapperValue_image_putl(p, (tokenValuei < 0) ? ((((unsigned int) (-(tokenValuei + 1))) << 1) | 1U) : (((unsigned int) tokenValuei) << 1));
+        } else {
+          idi = (int) marpa_v_symbol(marpaValuep);
+          p += _marpaWrapperValue_image_putl(p, (((unsigned int) idi) << 2) | MARPAWRAPPERVALUE_STEP_NULLING);
+        }
+        depthi++;
+      }
+
+      imagel = (size_t) (p - marpaWrapperValuep->imagep);
+      nStepi++;
+      break;
+    case MARPA_STEP_INACTIVE:
+      nexti = 0;
+      break;
+    default:
+      break;
+    }
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
+  _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
+  marpaValuep = NULL;
+
+  /* The empty tree still has its header */
+  MARPAWRAPPER_MANAGEBUF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), marpaWrapperValuep->imagep, marpaWrapperValuep->sizeImagel, imagel, sizeof(unsigned char));
+  _marpaWrapperValue_image_setv(marpaWrapperValuep->imagep, MARPAWRAPPERVALUE_IMAGE_MAGIC_IX,    MARPAWRAPPERVALUE_IMAGE_MAGIC);
+  _marpaWrapperValue_image_setv(marpaWrapperValuep->imagep, MARPAWRAPPERVALUE_IMAGE_VERSION_IX,  MARPAWRAPPERVALUE_IMAGE_VERSION);
+  _marpaWrapperValue_image_setv(marpaWrapperValuep->imagep, MARPAWRAPPERVALUE_IMAGE_NSTEP_IX,    nStepi);
+  _marpaWrapperValue_image_setv(marpaWrapperValuep->imagep,
+                                MARPAWRAPPERVALUE_IMAGE_CHECKSUM_IX,
+                                (int) _marpaWrapperValue_image_checksumi(marpaWrapperValuep->imagep + (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4),
+                                                                         imagel - (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4)));
+
+  /* The caller releases the image with free(): it comes from the C library, not from the recognizer allocator */
+  bufferp = (unsigned char *) (malloc)(imagel);
+  if (MARPAWRAPPER_UNLIKELY(bufferp == NULL)) {
+    MARPAWRAPPER_ERRORF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "malloc failure: %s", strerror(errno));
+    goto err;
+  }
+  memcpy(bufferp, marpaWrapperValuep->imagep, imagel);
+
+  if (bufferpp != NULL) {
+    *bufferpp = (char *) bufferp;
+  } else {
+    (free)(bufferp);
+  }
+  if (bufferlp != NULL) {
+    *bufferlp = imagel;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 1 (%d steps in %lu bytes)", nStepi, (unsigned long) imagel);
+  return 1;
+
+ done:
+  MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 0");
+  return 0;
+
+ err:
+  if (marpaValuep != NULL) {
+    int errnoi = errno;
+    MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "marpa_v_unref(%p)", marpaValuep);
+    _marpaWrapperValue_valuator_unrefv(marpaWrapperValuep, marpaValuep);
     errno = errnoi;
   }
   MARPAWRAPPER_TRACE(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return -1");
   return -1;
 }
 
+/****************************************************************************/
+short marpaWrapperValue_image_valueb(genericLogger_t                   *genericLoggerp,
+				     char                              *bufferp,
+				     size_t                             bufferl,
+				     void                              *userDatavp,
+				     marpaWrapperValueRuleCallback_t    ruleCallbackp,
+				     marpaWrapperValueSymbolCallback_t  symbolCallbackp,
+				     marpaWrapperValueNullingCallback_t nullingCallbackp)
+/****************************************************************************/
+/* The image is only read, so that it can be mapped read-only. Nothing is  */
+/* allocated: the allocator of the caller is restored after each callback. */
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperValue_image_valueb)
+  marpaWrapperAllocator_t *allocatorp = _marpaWrapperAllocator_currentp;
+  unsigned char           *imagep     = (unsigned char *) bufferp;
+  unsigned char           *p;
+  unsigned char           *endp;
+  unsigned int             tagu;
+  unsigned int             valueu;
+  int                      nStepi;
+  int                      stepi;
+  int                      idi;
+  int                      depthi     = 0;
+  int                      arg0i;
+  int                      tokenValuei;
+  short                    callbackb;
+
+  if (MARPAWRAPPER_UNLIKELY((imagep == NULL) || (bufferl < (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4)))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Tree image is too short");
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperValue_image_geti(imagep, MARPAWRAPPERVALUE_IMAGE_MAGIC_IX) != MARPAWRAPPERVALUE_IMAGE_MAGIC)) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Not a tree image");
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY(_marpaWrapperValue_image_geti(imagep, MARPAWRAPPERVALUE_IMAGE_VERSION_IX) != MARPAWRAPPERVALUE_IMAGE_VERSION)) {
+    MARPAWRAPPER_ERRORF(genericLoggerp, "Tree image version is %d instead of %d", _marpaWrapperValue_image_geti(imagep, MARPAWRAPPERVALUE_IMAGE_VERSION_IX), MARPAWRAPPERVALUE_IMAGE_VERSION);
+    errno = EINVAL;
+    goto err;
+  }
+  if (MARPAWRAPPER_UNLIKELY((unsigned int) _marpaWrapperValue_image_geti(imagep, MARPAWRAPPERVALUE_IMAGE_CHECKSUM_IX) != _marpaWrapperValue_image_checksumi(imagep + (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4), bufferl - (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4)))) {
+    MARPAWRAPPER_ERROR(genericLoggerp, "Tree image checksum mismatch");
+    errno = EINVAL;
+    goto err;
+  }
+
+  nStepi = _marpaWrapperValue_image_geti(imagep, MARPAWRAPPERVALUE_IMAGE_NSTEP_IX);
+  p      = imagep + (MARPAWRAPPERVALUE_IMAGE_HEADER_WORDS * 4);
+  endp   = imagep + bufferl;
+
+  for (stepi = 0; stepi < nStepi; stepi++) {
+    if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperValue_image_getb(&p, endp, &tagu))) {
+      goto corrupted;
+    }
+    idi = (int) (tagu >> 2);
+
+    switch (tagu & 0x03) {
+    case MARPAWRAPPERVALUE_STEP_RULE:
+      if (MARPAWRAPPER_UNLIKELY((! _marpaWrapperValue_image_getb(&p, endp, &valueu)) || (valueu == 0) || (valueu > (unsigned int) depthi))) {
+        goto corrupted;
+      }
+      arg0i = depthi - (int) valueu;
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Rule %d: Stack [%d..%d] -> Stack %d", idi, arg0i, depthi - 1, arg0i);
+      if (ruleCallbackp != NULL) {
+        callbackb = ruleCallbackp(userDatavp, idi, arg0i, depthi - 1, arg0i);
+        MARPAWRAPPER_ALLOCATOR_SET(allocatorp); /* Restore */
+        if (! callbackb) {
+          MARPAWRAPPER_ERRORF(genericLoggerp, "Rule No %d value callback failure", idi);
+          goto err;
+        }
+      }
+      depthi = arg0i + 1;
+      break;
+    case MARPAWRAPPERVALUE_STEP_TOKEN:
+      if (MARPAWRAPPER_UNLIKELY(! _marpaWrapperValue_image_getb(&p, endp, &valueu))) {
+        goto corrupted;
+      }
+      tokenValuei = ((valueu & 1U) != 0) ? (- ((int) (valueu >> 1)) - 1) : ((int) (valueu >> 1));
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Symbol %d: Stack %d -> Stack %d", idi, tokenValuei, depthi);
+      if (symbolCallbackp != NULL) {
+        callbackb = symbolCallbackp(userDatavp, idi, tokenValuei, depthi);
+        MARPAWRAPPER_ALLOCATOR_SET(allocatorp); /* Restore */
+        if (! callbackb) {
+          MARPAWRAPPER_ERRORF(genericLoggerp, "Symbol No %d value callback failure", idi);
+          goto err;
+        }
+      }
+      depthi++;
+      break;
+    case MARPAWRAPPERVALUE_STEP_NULLING:
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "Nulling symbol %d-> Stack %d", idi, depthi);
+      if (nullingCallbackp != NULL) {
+        callbackb = nullingCallbackp(userDatavp, idi, depthi);
+        MARPAWRAPPER_ALLOCATOR_SET(allocatorp); /* Restore */
+        if (! callbackb) {
+          MARPAWRAPPER_ERRORF(genericLoggerp, "Nulling symbol No %d value callback failure", idi);
+          goto err;
+        }
+      }
+      depthi++;
+      break;
+    default:
+      goto corrupted;
+    }
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(p != endp)) {
+    goto corrupted;
+  }
+
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 1");
+  return 1;
+
+ corrupted:
+  MARPAWRAPPER_ERRORF(genericLoggerp, "Tree image is corrupted at byte %lu", (unsigned long) (p - imagep));
+  errno = EINVAL;
+
+ err:
+  MARPAWRAPPER_TRACE(genericLoggerp, funcs, "return 0");
+  return 0;
+}
+
+/****************************************************************************/
+short marpaWrapperValue_valuatorStatsb(marpaWrapperValue_t *marpaWrapperValuep, size_t *allocationlp, size_t *reuselp)
+/****************************************************************************/
+{
+  MARPAWRAPPER_FUNCS(marpaWrapperValue_valuatorStatsb)
+
+  if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep == NULL)) {
+    errno = EINVAL;
+    return 0;
+  }
+
+  if (allocationlp != NULL) {
+    *allocationlp = marpaWrapperValuep->allocationl;
+  }
+  if (reuselp != NULL) {
+    *reuselp = marpaWrapperValuep->reusel;
+  }
+
+  MARPAWRAPPER_TRACEF(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), funcs, "return 1 (%lu allocations, %lu reuses)", (unsigned long) marpaWrapperValuep->allocationl, (unsigned long) marpaWrapperValuep->reusel);
+  return 1;
+}
+
 /****************************************************************************/
 short marpaWrapperValue_value_startb(marpaWrapperValue_t *marpaWrapperValuep, int *startip)
 /****************************************************************************/
@@ -367,6 +900,8 @@ short marpaWrapperValue_value_startb(marpaWrapperValue_t *marpaWrapperValuep, in
   }
 #endif
 
+  MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep->marpaValuep == NULL)) {
     MARPAWRAPPER_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "marpaWrapperValue_value_startb() called outside of marpaWrapperValue_valueb()");
     goto err;
@@ -416,6 +951,8 @@ short marpaWrapperValue_value_lengthb(marpaWrapperValue_t *marpaWrapperValuep, i
   }
 #endif
 
+  MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+
   if (MARPAWRAPPER_UNLIKELY(marpaWrapperValuep->marpaValuep == NULL)) {
     MARPAWRAPPER_ERROR(MARPAWRAPPERVALUE_GENERICLOGGERP(marpaWrapperValuep), "marpaWrapperValue_value_lengthb() called outside of marpaWrapperValue_valueb()");
     goto err;
@@ -466,6 +1003,19 @@ void marpaWrapperValue_freev(marpaWrapperValue_t *marpaWrapperValuep)
   if (marpaWrapperValuep != NULL) {
     /* Keep a copy of the generic logger. If original is not NULL, then we have a clone of it */
     genericLoggerp = marpaWrapperValuep->marpaWrapperValueOption.genericLoggerp;
+    if (marpaWrapperValuep->marpaWrapperRecognizerp != NULL) {
+      MARPAWRAPPERVALUE_CONTEXT_SET(marpaWrapperValuep);
+    }
+
+    if (marpaWrapperValuep->stepp != NULL) {
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperValuep->stepp);
+      MARPAWRAPPER_FREEBUF(marpaWrapperValuep->stepp);
+    }
+
+    if (marpaWrapperValuep->imagep != NULL) {
+      MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "free(%p)", marpaWrapperValuep->imagep);
+      MARPAWRAPPER_FREEBUF(marpaWrapperValuep->imagep);
+    }
 
     if (marpaWrapperValuep->marpaTreep != NULL) {
       MARPAWRAPPER_TRACEF(genericLoggerp, funcs, "marpa_t_unref(%p)", marpaWrapperValuep->marpaTreep);
@@ -482,6 +1032,11 @@ void marpaWrapperValue_freev(marpaWrapperValue_t *marpaWrapperValuep)
       marpa_b_unref(marpaWrapperValuep->marpaBocagep);
     }
 
+    if (marpaWrapperValuep->freeBlockp != NULL) {
+      MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Releasing valuator cache");
+      _marpaWrapperValue_cache_releasev(marpaWrapperValuep);
+    }
+
     if (marpaWrapperValuep->marpaWrapperRecognizerp != NULL) {
       MARPAWRAPPER_TRACE(genericLoggerp, funcs, "Flagging tree mode to NA");
       marpaWrapperValuep->marpaWrapperRecognizerp->treeModeb = MARPAWRAPPERRECOGNIZERTREEMODE_NA;
@@ -497,3 +1052,218 @@ void marpaWrapperValue_freev(marpaWrapperValue_t *marpaWrapperValuep)
   }
 }
 
+/****************************************************************************/
+static inline void _marpaWrapperValue_image_setv(unsigned char *imagep, size_t wordl, int valuei)
+/****************************************************************************/
+/* Words are stored in little-endian whatever the host                      */
+/****************************************************************************/
+{
+  unsigned int   valueu = (unsigned int) valuei;
+  unsigned char *p      = imagep + (wordl * 4);
+
+  p[0] = (unsigned char) ( valueu        & 0xFF);
+  p[1] = (unsigned char) ((valueu >>  8) & 0xFF);
+  p[2] = (unsigned char) ((valueu >> 16) & 0xFF);
+  p[3] = (unsigned char) ((valueu >> 24) & 0xFF);
+}
+
+/****************************************************************************/
+static inline int _marpaWrapperValue_image_geti(unsigned char *imagep, size_t wordl)
+/****************************************************************************/
+{
+  unsigned char *p = imagep + (wordl * 4);
+
+  return (int) (((unsigned int) p[0])         |
+                (((unsigned int) p[1]) <<  8) |
+                (((unsigned int) p[2]) << 16) |
+                (((unsigned int) p[3]) << 24));
+}
+
+/****************************************************************************/
+static inline unsigned int _marpaWrapperValue_image_checksumi(unsigned char *p, size_t lengthl)
+/****************************************************************************/
+/* 32-bit FNV-1a, as for grammar images                                     */
+/****************************************************************************/
+{
+  unsigned int hashi = 2166136261U;
+  size_t       i;
+
+  for (i = 0; i < lengthl; i++) {
+    hashi ^= (unsigned int) p[i];
+    hashi *= 16777619U;
+  }
+
+  return hashi & 0xFFFFFFFFU;
+}
+
+/****************************************************************************/
+static inline size_t _marpaWrapperValue_image_putl(unsigned char *p, unsigned int valueu)
+/****************************************************************************/
+/* LEB128: 7 bits per byte, high bit set when more bytes follow             */
+/****************************************************************************/
+{
+  size_t l = 0;
+
+  valueu &= 0xFFFFFFFFU;
+  while (valueu >= 0x80U) {
+    p[l++]   = (unsigned char) ((valueu & 0x7FU) | 0x80U);
+    valueu >>= 7;
+  }
+  p[l++] = (unsigned char) valueu;
+
+  return l;
+}
+
+/****************************************************************************/
+static inline short _marpaWrapperValue_image_getb(unsigned char **pp, unsigned char *endp, unsigned int *valueup)
+/****************************************************************************/
+/* Fails on a truncated varint or one that does not fit in 32 bits          */
+/****************************************************************************/
+{
+  unsigned char *p      = *pp;
+  unsigned int   valueu = 0;
+  unsigned int   shifti = 0;
+  unsigned int   bytei;
+
+  do {
+    if ((p >= endp) || (shifti > 28)) {
+      return 0;
+    }
+    bytei   = (unsigned int) *p++;
+    if ((shifti == 28) && ((bytei & 0x70U) != 0)) {
+      return 0;
+    }
+    valueu |= (bytei & 0x7FU) << shifti;
+    shifti += 7;
+  } while ((bytei & 0x80U) != 0);
+
+  *pp      = p;
+  *valueup = valueu & 0xFFFFFFFFU;
+
+  return 1;
+}
+
+/****************************************************************************/
+static inline Marpa_Step_Type _marpaWrapperValue_valuator_stepi(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value marpaValuep)
+/****************************************************************************/
+{
+  Marpa_Step_Type stepi;
+
+  MARPAWRAPPERVALUE_VALUATOR_SET(marpaWrapperValuep);
+  stepi = marpa_v_step(marpaValuep);
+  MARPAWRAPPERVALUE_VALUATOR_UNSET(marpaWrapperValuep);
+
+  return stepi;
+}
+
+/****************************************************************************/
+static inline void _marpaWrapperValue_valuator_unrefv(marpaWrapperValue_t *marpaWrapperValuep, Marpa_Value marpaValuep)
+/****************************************************************************/
+/* With reuseValuatorb, gives the blocks of the valuator back to the cache  */
+/****************************************************************************/
+{
+  MARPAWRAPPERVALUE_VALUATOR_SET(marpaWrapperValuep);
+  marpa_v_unref(marpaValuep);
+  MARPAWRAPPERVALUE_VALUATOR_UNSET(marpaWrapperValuep);
+}
+
+/****************************************************************************/
+static void *_marpaWrapperValue_cache_mallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+/* A valuator needs a handful of blocks: the free list is small, and the    */
+/* best fit keeps the large value stack for the next value stack.           */
+/****************************************************************************/
+{
+  marpaWrapperValue_t      *marpaWrapperValuep = (marpaWrapperValue_t *) userDatavp;
+  marpaWrapperAllocator_t  *allocatorp         = marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperRecognizerOption.allocatorp;
+  marpaWrapperValueBlock_t **previouspp;
+  marpaWrapperValueBlock_t **bestpp            = NULL;
+  marpaWrapperValueBlock_t *blockp;
+
+  for (previouspp = &(marpaWrapperValuep->freeBlockp); *previouspp != NULL; previouspp = &((*previouspp)->block.nextp)) {
+    if (((*previouspp)->block.sizel >= sizel) && ((bestpp == NULL) || ((*previouspp)->block.sizel < (*bestpp)->block.sizel))) {
+      bestpp = previouspp;
+    }
+  }
+  if (bestpp != NULL) {
+    blockp  = *bestpp;
+    *bestpp = blockp->block.nextp;
+    marpaWrapperValuep->reusel++;
+    return (void *) (blockp + 1);
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - sizeof(marpaWrapperValueBlock_t))) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  blockp = (marpaWrapperValueBlock_t *) ((allocatorp == NULL) ? (malloc)(sizeof(marpaWrapperValueBlock_t) + sizel) : allocatorp->mallocp(allocatorp->userDatavp, sizeof(marpaWrapperValueBlock_t) + sizel));
+  if (MARPAWRAPPER_UNLIKELY(blockp == NULL)) {
+    return NULL;
+  }
+  blockp->block.sizel = sizel;
+  marpaWrapperValuep->allocationl++;
+
+  return (void *) (blockp + 1);
+}
+
+/****************************************************************************/
+static void *_marpaWrapperValue_cache_reallocp(void *userDatavp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  marpaWrapperValue_t      *marpaWrapperValuep = (marpaWrapperValue_t *) userDatavp;
+  marpaWrapperAllocator_t  *allocatorp         = marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperRecognizerOption.allocatorp;
+  marpaWrapperValueBlock_t *blockp;
+
+  if (p == NULL) {
+    return _marpaWrapperValue_cache_mallocp(userDatavp, sizel);
+  }
+
+  blockp = ((marpaWrapperValueBlock_t *) p) - 1;
+  if (blockp->block.sizel >= sizel) {
+    return p;
+  }
+
+  if (MARPAWRAPPER_UNLIKELY(sizel > ((size_t) -1) - sizeof(marpaWrapperValueBlock_t))) {
+    errno = ENOMEM;
+    return NULL;
+  }
+  blockp = (marpaWrapperValueBlock_t *) ((allocatorp == NULL) ? (realloc)(blockp, sizeof(marpaWrapperValueBlock_t) + sizel) : allocatorp->reallocp(allocatorp->userDatavp, blockp, sizeof(marpaWrapperValueBlock_t) + sizel));
+  if (MARPAWRAPPER_UNLIKELY(blockp == NULL)) {
+    return NULL;
+  }
+  blockp->block.sizel = sizel;
+  marpaWrapperValuep->allocationl++;
+
+  return (void *) (blockp + 1);
+}
+
+/****************************************************************************/
+static void _marpaWrapperValue_cache_freev(void *userDatavp, void *p)
+/****************************************************************************/
+{
+  marpaWrapperValue_t      *marpaWrapperValuep = (marpaWrapperValue_t *) userDatavp;
+  marpaWrapperValueBlock_t *blockp;
+
+  if (p != NULL) {
+    blockp                         = ((marpaWrapperValueBlock_t *) p) - 1;
+    blockp->block.nextp            = marpaWrapperValuep->freeBlockp;
+    marpaWrapperValuep->freeBlockp = blockp;
+  }
+}
+
+/****************************************************************************/
+static void _marpaWrapperValue_cache_releasev(marpaWrapperValue_t *marpaWrapperValuep)
+/****************************************************************************/
+{
+  marpaWrapperAllocator_t  *allocatorp = marpaWrapperValuep->marpaWrapperRecognizerp->marpaWrapperRecognizerOption.allocatorp;
+  marpaWrapperValueBlock_t *blockp;
+
+  while ((blockp = marpaWrapperValuep->freeBlockp) != NULL) {
+    marpaWrapperValuep->freeBlockp = blockp->block.nextp;
+    if (allocatorp == NULL) {
+      (free)(blockp);
+    } else {
+      allocatorp->freep(allocatorp->userDatavp, blockp);
+    }
+  }
+}
@@ -0,0 +1,208 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number
+
+  1 - 2 * 3 has two trees.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+#define NDOCUMENT 3
+
+typedef struct treesContext {
+  char   s[1024];
+  size_t usedl;
+} treesContext_t;
+
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static int   parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp);
+
+/* All the trees of an ambiguous input, in parse order */
+static marpaWrapperValueOption_t treesValueOption = {
+  NULL, /* genericLoggerp */
+  0,    /* highRankOnlyb */
+  0,    /* orderByRankb */
+  1,    /* ambiguousb */
+  0,    /* nullb */
+  0,    /* maxParsesi */
+  0     /* reuseValuatorb */
+};
+
+int main(int argc, char **argv) {
+  genericLogger_t                *genericLoggerp               = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp         = NULL;
+  marpaWrapperArena_t            *marpaWrapperArenap           = NULL;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  treesContext_t                  firstTrees;
+  treesContext_t                  trees;
+  size_t                          firstTreel;
+  size_t                          treel;
+  size_t                          usedl;
+  size_t                          capacityl;
+  size_t                          keptCapacityl = 0;
+  size_t                          nChunkl;
+  int                             symbolip[MAX_SYMBOL];
+  int                             documenti;
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    marpaWrapperArenap = marpaWrapperArena_newp(genericLoggerp, 1024 * 1024);
+    if (marpaWrapperArenap == NULL) {
+      rci = 1;
+    } else {
+      marpaWrapperRecognizerOption.allocatorp = marpaWrapperArena_allocatorp(marpaWrapperArenap);
+    }
+  }
+
+  /* Documents in one arena: the chunk kept by the reset is enough for the next ones, that parse the same trees */
+  for (documenti = 0; (rci == 0) && (documenti < NDOCUMENT); documenti++) {
+    marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+    if (marpaWrapperRecognizerp == NULL) {
+      rci = 1;
+      break;
+    }
+    rci = parseTrees(marpaWrapperRecognizerp, symbolip, (documenti == 0) ? &firstTrees : &trees, (documenti == 0) ? &firstTreel : &treel);
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    if (rci != 0) {
+      break;
+    }
+    if ((documenti == 0) && (firstTreel != 2)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Document 0 has %ld trees instead of 2", (unsigned long) firstTreel);
+      rci = 1;
+      break;
+    }
+    if ((documenti > 0) && ((treel != firstTreel) || (strcmp(firstTrees.s, trees.s) != 0))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Document %d has %ld trees \"%s\" instead of %ld trees \"%s\"", documenti, (unsigned long) treel, trees.s, (unsigned long) firstTreel, firstTrees.s);
+      rci = 1;
+      break;
+    }
+
+    /* Freed objects stay in the arena until it is reset */
+    if (marpaWrapperArena_statsb(marpaWrapperArenap, &usedl, &capacityl, &nChunkl) == 0) {
+      rci = 1;
+      break;
+    }
+    if ((usedl <= 0) || (nChunkl != 1) || ((documenti > 0) && (capacityl != keptCapacityl))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Document %d used %ld bytes of %ld in %ld chunks", documenti, (unsigned long) usedl, (unsigned long) capacityl, (unsigned long) nChunkl);
+      rci = 1;
+      break;
+    }
+
+    if ((marpaWrapperArena_resetb(marpaWrapperArenap) == 0) ||
+        (marpaWrapperArena_statsb(marpaWrapperArenap, &usedl, &capacityl, &nChunkl) == 0)) {
+      rci = 1;
+      break;
+    }
+    if ((usedl != 0) || (nChunkl != 1) || ((documenti > 0) && (capacityl != keptCapacityl))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "After reset %ld bytes used of %ld in %ld chunks", (unsigned long) usedl, (unsigned long) capacityl, (unsigned long) nChunkl);
+      rci = 1;
+      break;
+    }
+    keptCapacityl = capacityl;
+  }
+  if (rci == 0) {
+    GENERICLOGGER_INFOF(genericLoggerp, "%d documents in one chunk of %ld bytes, same %ld trees", NDOCUMENT, (unsigned long) keptCapacityl, (unsigned long) firstTreel);
+  }
+
+  if (marpaWrapperArenap != NULL) {
+    marpaWrapperArena_freev(marpaWrapperArenap);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "R%d[%d..%d]->%d ", rulei, arg0i, argni, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "T%d[%d]->%d ", symboli, argi, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static int parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp)
+/****************************************************************************/
+/* Reads 1 - 2 * 3 and writes all its trees, as seen by the callbacks, in   */
+/* treesContextp->s. The value instance is freed before returning.          */
+/****************************************************************************/
+{
+  marpaWrapperValue_t       *marpaWrapperValuep;
+  short                      valueb;
+  int                        i;
+
+  treesContextp->s[0] = '\0';
+  treesContextp->usedl = 0;
+  *nTreelp             = 0;
+
+  for (i = 1; i <= 5; i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      return 1;
+    }
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &treesValueOption);
+  if (marpaWrapperValuep == NULL) {
+    return 1;
+  }
+  while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, (void *) treesContextp, treesRuleCallback, treesSymbolCallback, NULL)) > 0) {
+    (*nTreelp)++;
+    if (treesContextp->usedl + 2 >= sizeof(treesContextp->s)) {
+      valueb = -1;
+      break;
+    }
+    treesContextp->s[treesContextp->usedl++] = '|';
+    treesContextp->s[treesContextp->usedl]   = '\0';
+  }
+  marpaWrapperValue_freev(marpaWrapperValuep);
+
+  return (valueb < 0) ? 1 : 0;
+}
@@ -0,0 +1,597 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number                     E ::= number op number, in the flat grammar only
+
+  number op number op ... op number is ambiguous: there are Catalan(n-1) trees with n numbers.
+  The number of trees given by a traversal of the forest must be the one of the enumeration
+  with marpaWrapperValue_valueb(), for every length of input. A second traversal interns no
+  new intset. Glades are set up without per-glade allocations: the number of allocator calls
+  grows far slower than the number of glades. Every factoring of a glade covers the span of the
+  glade with the spans of its RHS glades, in order. Pruning the flat rule off the forest of the
+  flat grammar leaves the trees of the enumeration that do not use it.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+#define MAX_NUMBER 10 /* Catalan(9) = 4862 trees */
+#define GLADE_NUMBER 20 /* Forests of 20 and 40 numbers have 421 and 1641 glades */
+#define PRUNE_NUMBER 7
+
+/* Spans are encoded as first token * SPAN_BASE + last token, tokens being numbered from 0 */
+#define SPAN_BASE 1000
+
+typedef struct spanContext {
+  int    *symbolip;
+  size_t  nFactoringl;   /* Factorings visited, a glade being visited once per parent */
+} spanContext_t;
+
+typedef struct flatContext {
+  int     flatRulei;
+  short   flatb;         /* The current tree uses the flat rule */
+} flatContext_t;
+
+/* Counts the calls to the allocator */
+typedef struct accounting {
+  size_t nCalll;
+} accounting_t;
+
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static short spanTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static short flatRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short rejectFlatRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
+static void *accountingMallocp(void *userDatavp, size_t sizel);
+static void *accountingReallocp(void *userDatavp, void *p, size_t sizel);
+static void  accountingFreev(void *userDatavp, void *p);
+static marpaWrapperRecognizer_t *recognizerp(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, int nNumberi, marpaWrapperAllocator_t *allocatorp);
+static int   checkGladeAllocations(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, genericLogger_t *genericLoggerp);
+static int   checkSpans(int nNumberi, marpaWrapperAsf_t *marpaWrapperAsfp, int *symbolip, genericLogger_t *genericLoggerp);
+static int   checkIntsets(int nNumberi, marpaWrapperAsf_t *marpaWrapperAsfp, genericLogger_t *genericLoggerp);
+static int   checkForest(int nNumberi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, genericLogger_t *genericLoggerp);
+static int   checkPrune(int nNumberi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, int flatRulei, genericLogger_t *genericLoggerp);
+
+static marpaWrapperValueOption_t marpaWrapperValueOption = {
+  NULL, /* genericLoggerp */
+  0,    /* highRankOnlyb */
+  0,    /* orderByRankb */
+  1,    /* ambiguousb */
+  0,    /* nullb */
+  0,    /* maxParsesi */
+  0     /* reuseValuatorb */
+};
+
+static marpaWrapperAsfOption_t marpaWrapperAsfOption = {
+  NULL, /* genericLoggerp */
+  0,    /* highRankOnlyb */
+  0,    /* orderByRankb */
+  1,    /* ambiguousb */
+  0,    /* maxParsesi */
+  0,    /* okCacheb */
+  0,    /* memob */
+  0     /* maxBytesl */
+};
+
+int main(int argc, char **argv) {
+  genericLogger_t       *genericLoggerp       = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t *marpaWrapperGrammarp = NULL;
+  marpaWrapperGrammar_t *flatGrammarp         = NULL;
+  int                    symbolip[MAX_SYMBOL];
+  int                    flatSymbolip[MAX_SYMBOL];
+  int                    flatRulei;
+  int                    nNumberi;
+  int                    rci = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  for (nNumberi = 1; (rci == 0) && (nNumberi <= MAX_NUMBER); nNumberi++) {
+    rci = checkForest(nNumberi, marpaWrapperGrammarp, symbolip, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkGladeAllocations(marpaWrapperGrammarp, symbolip, genericLoggerp);
+  }
+
+  if (rci == 0) {
+    flatGrammarp = marpaWrapperGrammar_newp(NULL);
+    if ((flatGrammarp == NULL) ||
+        ((flatSymbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(flatGrammarp)) < 0) ||
+        ((flatSymbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(flatGrammarp)) < 0) ||
+        ((flatSymbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(flatGrammarp)) < 0) ||
+        ((flatSymbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(flatGrammarp)) < 0) ||
+        (MARPAWRAPPERGRAMMAR_NEWRULE(flatGrammarp, flatSymbolip[S], flatSymbolip[E],                                                  -1) < 0) ||
+        (MARPAWRAPPERGRAMMAR_NEWRULE(flatGrammarp, flatSymbolip[E], flatSymbolip[E], flatSymbolip[op], flatSymbolip[E],               -1) < 0) ||
+        (MARPAWRAPPERGRAMMAR_NEWRULE(flatGrammarp, flatSymbolip[E], flatSymbolip[number],                                             -1) < 0) ||
+        ((flatRulei = MARPAWRAPPERGRAMMAR_NEWRULE(flatGrammarp, flatSymbolip[E], flatSymbolip[number], flatSymbolip[op], flatSymbolip[number], -1)) < 0) ||
+        (marpaWrapperGrammar_precomputeb(flatGrammarp) == 0)) {
+      rci = 1;
+    }
+  }
+  for (nNumberi = 1; (rci == 0) && (nNumberi <= PRUNE_NUMBER); nNumberi++) {
+    rci = checkPrune(nNumberi, flatGrammarp, flatSymbolip, flatRulei, genericLoggerp);
+  }
+
+  if (flatGrammarp != NULL) {
+    marpaWrapperGrammar_freev(flatGrammarp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static int checkForest(int nNumberi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Trees of the forest of nNumberi numbers, by enumeration and by traversal */
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  marpaWrapperValue_t      *marpaWrapperValuep;
+  marpaWrapperAsf_t        *marpaWrapperAsfp = NULL;
+  size_t                    nTreel           = 0;
+  int                       nAsfTreei        = 0;
+  short                     valueb;
+  int                       rci              = 0;
+
+  marpaWrapperRecognizerp = recognizerp(marpaWrapperGrammarp, symbolip, nNumberi, NULL);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 1;
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  if (marpaWrapperValuep == NULL) {
+    rci = 1;
+  } else {
+    while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, NULL, valueRuleCallback, valueSymbolCallback, NULL)) > 0) {
+      nTreel++;
+    }
+    if (valueb < 0) {
+      rci = 1;
+    }
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+
+  if (rci == 0) {
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if ((marpaWrapperAsfp == NULL) || (marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, NULL, &nAsfTreei) == 0)) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    if ((nAsfTreei < 0) || ((size_t) nAsfTreei != nTreel)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers: %d trees in the forest instead of %ld", nNumberi, nAsfTreei, (unsigned long) nTreel);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%d numbers: %d trees", nNumberi, nAsfTreei);
+    }
+  }
+  if (rci == 0) {
+    rci = checkIntsets(nNumberi, marpaWrapperAsfp, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkSpans(nNumberi, marpaWrapperAsfp, symbolip, genericLoggerp);
+  }
+
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static int checkIntsets(int nNumberi, marpaWrapperAsf_t *marpaWrapperAsfp, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Intset statistics after a traversal are consistent, and a second        */
+/* traversal interns no new intset.                                         */
+/****************************************************************************/
+{
+  size_t nIntsetl;
+  size_t nLookupl;
+  size_t nProbel;
+  size_t maxProbel;
+  size_t nCollisionl;
+  size_t nAgainIntsetl;
+  size_t nAgainLookupl;
+  int    nAsfTreei;
+
+  if (marpaWrapperAsf_intsetStatsb(marpaWrapperAsfp, &nIntsetl, &nLookupl, &nProbel, &maxProbel, &nCollisionl) == 0) {
+    return 1;
+  }
+  if ((nIntsetl <= 0) || (nLookupl < nIntsetl) || (maxProbel > nProbel) || (nCollisionl > nLookupl)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers: %ld intsets, %ld lookups, %ld probes, longest %ld, %ld collisions",
+                         nNumberi, (unsigned long) nIntsetl, (unsigned long) nLookupl, (unsigned long) nProbel, (unsigned long) maxProbel, (unsigned long) nCollisionl);
+    return 1;
+  }
+
+  if ((marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, NULL, &nAsfTreei) == 0) ||
+      (marpaWrapperAsf_intsetStatsb(marpaWrapperAsfp, &nAgainIntsetl, &nAgainLookupl, NULL, NULL, NULL) == 0)) {
+    return 1;
+  }
+  if ((nAgainIntsetl != nIntsetl) || (nAgainLookupl < nLookupl)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers: %ld intsets, %ld lookups after a second traversal instead of %ld, at least %ld",
+                         nNumberi, (unsigned long) nAgainIntsetl, (unsigned long) nAgainLookupl, (unsigned long) nIntsetl, (unsigned long) nLookupl);
+    return 1;
+  }
+
+  if (nNumberi == MAX_NUMBER) {
+    GENERICLOGGER_INFOF(genericLoggerp, "%d numbers: %ld intsets, same after a second traversal", nNumberi, (unsigned long) nIntsetl);
+  }
+
+  return 0;
+}
+
+/****************************************************************************/
+static int checkSpans(int nNumberi, marpaWrapperAsf_t *marpaWrapperAsfp, int *symbolip, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* The peak glade spans all the tokens, and no factoring breaks the spans   */
+/****************************************************************************/
+{
+  spanContext_t spanContext;
+  int           spani;
+
+  spanContext.symbolip    = symbolip;
+  spanContext.nFactoringl = 0;
+
+  if (marpaWrapperAsf_traverseb(marpaWrapperAsfp, spanTraverserCallbacki, &spanContext, &spani) == 0) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers: span traversal failure", nNumberi);
+    return 1;
+  }
+  if (spani != 2 * nNumberi - 2) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers: span %d..%d instead of 0..%d", nNumberi, spani / SPAN_BASE, spani % SPAN_BASE, 2 * nNumberi - 2);
+    return 1;
+  }
+
+  if (nNumberi == MAX_NUMBER) {
+    GENERICLOGGER_INFOF(genericLoggerp, "%d numbers: %ld factorings visited, all of them cover their glade", nNumberi, (unsigned long) spanContext.nFactoringl);
+  }
+
+  return 0;
+}
+
+/****************************************************************************/
+static int checkPrune(int nNumberi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, int flatRulei, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Trees of the forest of nNumberi numbers in the flat grammar, by          */
+/* enumeration and by traversal, before and after pruning the flat rule. A  */
+/* second pruning finds nothing new.                                        */
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  marpaWrapperValue_t      *marpaWrapperValuep;
+  marpaWrapperAsf_t        *marpaWrapperAsfp = NULL;
+  flatContext_t             flatContext;
+  size_t                    nTreel           = 0;
+  size_t                    nPrunedTreel     = 0;
+  size_t                    nDeadFactoringl  = 0;
+  size_t                    nAgainDeadFactoringl;
+  int                       nAsfTreei        = 0;
+  int                       nPrunedAsfTreei  = 0;
+  short                     valueb;
+  int                       rci              = 0;
+
+  flatContext.flatRulei = flatRulei;
+
+  marpaWrapperRecognizerp = recognizerp(marpaWrapperGrammarp, symbolip, nNumberi, NULL);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 1;
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  if (marpaWrapperValuep == NULL) {
+    rci = 1;
+  } else {
+    while (1) {
+      flatContext.flatb = 0;
+      valueb = marpaWrapperValue_valueb(marpaWrapperValuep, &flatContext, flatRuleCallback, valueSymbolCallback, NULL);
+      if (valueb <= 0) {
+        break;
+      }
+      nTreel++;
+      if (! flatContext.flatb) {
+        nPrunedTreel++;
+      }
+    }
+    if (valueb < 0) {
+      rci = 1;
+    }
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+
+  if (rci == 0) {
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if ((marpaWrapperAsfp == NULL) ||
+        (marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, NULL, &nAsfTreei) == 0) ||
+        (marpaWrapperAsf_pruneb(marpaWrapperAsfp, &flatContext, rejectFlatRuleCallback, NULL, NULL, &nDeadFactoringl) == 0) ||
+        (marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, NULL, &nPrunedAsfTreei) == 0) ||
+        (marpaWrapperAsf_pruneb(marpaWrapperAsfp, &flatContext, rejectFlatRuleCallback, NULL, NULL, &nAgainDeadFactoringl) == 0)) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    if ((nAsfTreei < 0) || ((size_t) nAsfTreei != nTreel) ||
+        (nPrunedAsfTreei < 0) || ((size_t) nPrunedAsfTreei != nPrunedTreel) ||
+        ((nDeadFactoringl > 0) != (nPrunedTreel < nTreel)) ||
+        (nAgainDeadFactoringl != nDeadFactoringl)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%d numbers, flat grammar: %d and %d trees in the forest before and after pruning, instead of %ld and %ld, %ld then %ld dead factorings",
+                           nNumberi, nAsfTreei, nPrunedAsfTreei, (unsigned long) nTreel, (unsigned long) nPrunedTreel, (unsigned long) nDeadFactoringl, (unsigned long) nAgainDeadFactoringl);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%d numbers, flat grammar: %d trees, %d after pruning, %ld dead factorings", nNumberi, nAsfTreei, nPrunedAsfTreei, (unsigned long) nDeadFactoringl);
+    }
+  }
+
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static int checkGladeAllocations(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Setting up all the glades of a forest four times larger adds less than   */
+/* one allocator call per ten glades.                                       */
+/****************************************************************************/
+{
+  accounting_t              accounting          = { 0 };
+  marpaWrapperAllocator_t   accountingAllocator = { &accounting, accountingMallocp, accountingReallocp, accountingFreev };
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  marpaWrapperAsf_t        *marpaWrapperAsfp;
+  marpaWrapperAsfStats_t    stats;
+  size_t                    nCalll[2];
+  size_t                    nGladel[2];
+  int                       gladeIdi;
+  int                       i;
+  int                       rci = 0;
+
+  for (i = 0; (rci == 0) && (i < 2); i++) {
+    marpaWrapperRecognizerp = recognizerp(marpaWrapperGrammarp, symbolip, GLADE_NUMBER * (i + 1), &accountingAllocator);
+    if (marpaWrapperRecognizerp == NULL) {
+      return 1;
+    }
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if (marpaWrapperAsfp == NULL) {
+      rci = 1;
+    } else {
+      accounting.nCalll = 0;
+      if (marpaWrapperAsf_prepareb(marpaWrapperAsfp, &gladeIdi) == 0) {
+        rci = 1;
+      }
+      nCalll[i] = accounting.nCalll;
+      if ((rci == 0) && (marpaWrapperAsf_statsb(marpaWrapperAsfp, &stats, NULL, 0, NULL) == 0)) {
+        rci = 1;
+      }
+      nGladel[i] = stats.nGladel;
+      marpaWrapperAsf_freev(marpaWrapperAsfp);
+    }
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+
+  if (rci == 0) {
+    if ((nGladel[1] <= nGladel[0]) || ((nCalll[1] > nCalll[0]) && ((nCalll[1] - nCalll[0]) * 10 >= (nGladel[1] - nGladel[0])))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%d and %d numbers: %ld and %ld glades set up with %ld and %ld allocator calls",
+                           GLADE_NUMBER, 2 * GLADE_NUMBER, (unsigned long) nGladel[0], (unsigned long) nGladel[1], (unsigned long) nCalll[0], (unsigned long) nCalll[1]);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%d and %d numbers: %ld and %ld glades, less than one more allocator call per ten more glades",
+                          GLADE_NUMBER, 2 * GLADE_NUMBER, (unsigned long) nGladel[0], (unsigned long) nGladel[1]);
+    }
+  }
+
+  return rci;
+}
+
+/****************************************************************************/
+static marpaWrapperRecognizer_t *recognizerp(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, int nNumberi, marpaWrapperAllocator_t *allocatorp)
+/****************************************************************************/
+/* Token values are their positions, starting at 1: Marpa reserves value 0  */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  int                             i;
+
+  marpaWrapperRecognizerOption.allocatorp = allocatorp;
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    return NULL;
+  }
+  for (i = 1; i < 2 * nNumberi; i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+      return NULL;
+    }
+  }
+
+  return marpaWrapperRecognizerp;
+}
+
+/****************************************************************************/
+static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short flatRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  flatContext_t *flatContextp = (flatContext_t *) userDatavp;
+
+  if (rulei == flatContextp->flatRulei) {
+    flatContextp->flatb = 1;
+  }
+  return 1;
+}
+
+/****************************************************************************/
+static short rejectFlatRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni)
+/****************************************************************************/
+{
+  return (rulei == ((flatContext_t *) userDatavp)->flatRulei) ? -1 : 1;
+}
+
+/****************************************************************************/
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip)
+/****************************************************************************/
+/* The value of a glade is its number of trees: the sum on its factorings   */
+/* of the product of the values of the RHS.                                 */
+/****************************************************************************/
+{
+  int   ruleIdi;
+  int   lengthi;
+  int   rhIxi;
+  int   rhValuei;
+  int   factoringValuei;
+  int   valuei = 0;
+  short nextb;
+
+  while (1) {
+    if (! marpaWrapperAsf_traverse_ruleIdb(traverserp, &ruleIdi)) {
+      return 0;
+    }
+    factoringValuei = 1;
+    if (ruleIdi >= 0) {
+      lengthi = marpaWrapperAsf_traverse_rh_lengthi(traverserp);
+      if (lengthi < 0) {
+        return 0;
+      }
+      for (rhIxi = 0; rhIxi < lengthi; rhIxi++) {
+        if (! marpaWrapperAsf_traverse_rh_valueb(traverserp, rhIxi, &rhValuei, NULL)) {
+          return 0;
+        }
+        factoringValuei *= rhValuei;
+      }
+    }
+    valuei += factoringValuei;
+    if (! marpaWrapperAsf_traverse_nextb(traverserp, &nextb)) {
+      return 0;
+    }
+    if (! nextb) {
+      break;
+    }
+  }
+
+  *valueip = valuei;
+  return 1;
+}
+
+/****************************************************************************/
+static short spanTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip)
+/****************************************************************************/
+/* The value of a glade is its span. A token is its own span: its value is  */
+/* its indice in the input stack. The spans of the RHS of every factoring   */
+/* must follow each other, and all the factorings must give the same span.  */
+/****************************************************************************/
+{
+  spanContext_t *spanContextp = (spanContext_t *) userDatavp;
+  int            symbolIdi;
+  int            ruleIdi;
+  int            lengthi;
+  int            rhIxi;
+  int            rhSpani;
+  int            factoringSpani;
+  int            spani = -1;
+  short          nextb;
+
+  if (! marpaWrapperAsf_traverse_symbolIdb(traverserp, &symbolIdi)) {
+    return 0;
+  }
+  while (1) {
+    if (! marpaWrapperAsf_traverse_ruleIdb(traverserp, &ruleIdi)) {
+      return 0;
+    }
+    spanContextp->nFactoringl++;
+    if (ruleIdi < 0) {
+      if ((! marpaWrapperAsf_traverse_rh_valueb(traverserp, 0, &rhSpani, &lengthi)) || (lengthi != 1)) {
+        return 0;
+      }
+      factoringSpani = rhSpani * SPAN_BASE + rhSpani;
+    } else {
+      lengthi = marpaWrapperAsf_traverse_rh_lengthi(traverserp);
+      if ((lengthi <= 0) || ((symbolIdi == spanContextp->symbolip[E]) && (lengthi != 1) && (lengthi != 3))) {
+        return 0;
+      }
+      factoringSpani = -1;
+      for (rhIxi = 0; rhIxi < lengthi; rhIxi++) {
+        if (! marpaWrapperAsf_traverse_rh_valueb(traverserp, rhIxi, &rhSpani, NULL)) {
+          return 0;
+        }
+        if (rhIxi == 0) {
+          factoringSpani = rhSpani;
+        } else if (rhSpani / SPAN_BASE != (factoringSpani % SPAN_BASE) + 1) {
+          return 0;
+        } else {
+          factoringSpani = (factoringSpani / SPAN_BASE) * SPAN_BASE + (rhSpani % SPAN_BASE);
+        }
+      }
+    }
+    if ((spani >= 0) && (factoringSpani != spani)) {
+      return 0;
+    }
+    spani = factoringSpani;
+    if (! marpaWrapperAsf_traverse_nextb(traverserp, &nextb)) {
+      return 0;
+    }
+    if (! nextb) {
+      break;
+    }
+  }
+
+  *valueip = spani;
+  return 1;
+}
+
+/****************************************************************************/
+static void *accountingMallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+{
+  ((accounting_t *) userDatavp)->nCalll++;
+  return malloc(sizel);
+}
+
+/****************************************************************************/
+static void *accountingReallocp(void *userDatavp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  ((accounting_t *) userDatavp)->nCalll++;
+  return realloc(p, sizel);
+}
+
+/****************************************************************************/
+static void accountingFreev(void *userDatavp, void *p)
+/****************************************************************************/
+{
+  free(p);
+}
@@ -0,0 +1,282 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  PAIRS ::= PAIR+
+  PAIR  ::= DUPLE       rank  2
+          | ITEM ITEM   rank  0
+  DUPLE ::= ITEM ITEM   rank -1
+  ITEM  ::= HESPERUS    rank  1
+          | PHOSPHORUS  rank  5
+
+  Every token is both a HESPERUS and a PHOSPHORUS: NTOKEN tokens give 8^(NTOKEN/2) trees.
+  The score of a tree is the sum of the ranks of its rules and of the scores of its tokens.
+*/
+enum { PAIRS = 0, PAIR, DUPLE, ITEM, HESPERUS, PHOSPHORUS, MAX_SYMBOL };
+enum { PAIRS_RULE = 0, PAIR_RULE_01, PAIR_RULE_02, DUPLE_RULE, ITEM_RULE_01, ITEM_RULE_02, MAX_RULE };
+
+#define NTOKEN     6
+#define NTREE      512 /* 8^3 */
+#define MAX_STACK  64
+
+typedef struct scoreContext {
+  int *symbolip;
+  int *ruleRankip;            /* Indexed by rule id */
+  int  stackip[MAX_STACK];    /* Scores of the value stack */
+} scoreContext_t;
+
+static short tokenScoreCallback(void *userDatavp, int symboli, int argi, int *scoreip);
+static short scoreRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short scoreSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static int   scoreCmpi(const void *ap, const void *bp);
+static int   checkKbest(marpaWrapperAsf_t *marpaWrapperAsfp, scoreContext_t *scoreContextp, int ki, int *bruteScoreip, int nBruteTreei, genericLogger_t *genericLoggerp);
+
+int main(int argc, char **argv) {
+  genericLogger_t             *genericLoggerp          = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t       *marpaWrapperGrammarp    = NULL;
+  marpaWrapperRecognizer_t    *marpaWrapperRecognizerp = NULL;
+  marpaWrapperValue_t         *marpaWrapperValuep      = NULL;
+  marpaWrapperAsf_t           *marpaWrapperAsfp        = NULL;
+  marpaWrapperGrammarOption_t  marpaWrapperGrammarOption = { NULL,
+                                                             0 /* warningIsErrorb */,
+                                                             1 /* warningIsIgnoredb */,
+                                                             0 /* autorankb */,
+                                                             NULL /* allocatorp */
+  };
+  marpaWrapperValueOption_t    marpaWrapperValueOption   = { NULL,
+                                                             0 /* highRankOnlyb */,
+                                                             0 /* orderByRankb */,
+                                                             1 /* ambiguousb */,
+                                                             0 /* nullb */,
+                                                             0 /* maxParsesi */,
+                                                             0 /* reuseValuatorb */
+  };
+  marpaWrapperAsfOption_t      marpaWrapperAsfOption     = { NULL,
+                                                             0 /* highRankOnlyb */,
+                                                             0 /* orderByRankb */,
+                                                             1 /* ambiguousb */,
+                                                             0 /* maxParsesi */,
+                                                             0 /* okCacheb */,
+                                                             0 /* memob */,
+                                                             0 /* maxBytesl */
+  };
+  int                          symbolip[MAX_SYMBOL];
+  int                          ruleip[MAX_RULE];
+  int                          ruleRankip[MAX_RULE];
+  int                          bruteScoreip[NTREE];
+  int                          nBruteTreei = 0;
+  scoreContext_t               scoreContext;
+  short                        valueb;
+  size_t                       nGladel;
+  size_t                       nDerivationl;
+  int                          i;
+  int                          rci = 0;
+
+  scoreContext.symbolip   = symbolip;
+  scoreContext.ruleRankip = ruleRankip;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     PAIRS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[      PAIR] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     DUPLE] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[      ITEM] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[  HESPERUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[PHOSPHORUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((ruleip[  PAIRS_RULE] = MARPAWRAPPERGRAMMAR_NEWSEQUENCE(marpaWrapperGrammarp, symbolip[PAIRS], symbolip[PAIR], 1)) < 0) ||
+      ((ruleip[PAIR_RULE_01] = marpaWrapperGrammar_newRuleExti(marpaWrapperGrammarp,  2, 0, symbolip[PAIR],  symbolip[DUPLE],                 -1)) < 0) ||
+      ((ruleip[PAIR_RULE_02] = marpaWrapperGrammar_newRuleExti(marpaWrapperGrammarp,  0, 0, symbolip[PAIR],  symbolip[ITEM], symbolip[ITEM], -1)) < 0) ||
+      ((ruleip[  DUPLE_RULE] = marpaWrapperGrammar_newRuleExti(marpaWrapperGrammarp, -1, 0, symbolip[DUPLE], symbolip[ITEM], symbolip[ITEM], -1)) < 0) ||
+      ((ruleip[ITEM_RULE_01] = marpaWrapperGrammar_newRuleExti(marpaWrapperGrammarp,  1, 0, symbolip[ITEM],  symbolip[HESPERUS],              -1)) < 0) ||
+      ((ruleip[ITEM_RULE_02] = marpaWrapperGrammar_newRuleExti(marpaWrapperGrammarp,  5, 0, symbolip[ITEM],  symbolip[PHOSPHORUS],            -1)) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+  if (rci == 0) {
+    ruleRankip[ruleip[  PAIRS_RULE]] =  0;
+    ruleRankip[ruleip[PAIR_RULE_01]] =  2;
+    ruleRankip[ruleip[PAIR_RULE_02]] =  0;
+    ruleRankip[ruleip[  DUPLE_RULE]] = -1;
+    ruleRankip[ruleip[ITEM_RULE_01]] =  1;
+    ruleRankip[ruleip[ITEM_RULE_02]] =  5;
+  }
+
+  if (rci == 0) {
+    marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL);
+    if (marpaWrapperRecognizerp == NULL) {
+      rci = 1;
+    }
+  }
+  /* Token values start at 1: Marpa reserves value 0 */
+  for (i = 1; (rci == 0) && (i <= NTOKEN); i++) {
+    if ((marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[HESPERUS], i, 1) == 0) ||
+        (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[PHOSPHORUS], i, 1) == 0) ||
+        (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0)) {
+      rci = 1;
+    }
+  }
+
+  /* Brute force: the scores of all the trees, best first */
+  if (rci == 0) {
+    marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+    if (marpaWrapperValuep == NULL) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, &scoreContext, scoreRuleCallback, scoreSymbolCallback, NULL)) > 0) {
+      if (nBruteTreei >= NTREE) {
+        valueb = -1;
+        break;
+      }
+      bruteScoreip[nBruteTreei++] = scoreContext.stackip[0];
+    }
+    if ((valueb < 0) || (nBruteTreei != NTREE)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Brute force: %d trees instead of %d", nBruteTreei, NTREE);
+      rci = 1;
+    } else {
+      qsort(bruteScoreip, nBruteTreei, sizeof(int), scoreCmpi);
+      GENERICLOGGER_INFOF(genericLoggerp, "Brute force: %d trees, scores from %d to %d", nBruteTreei, bruteScoreip[0], bruteScoreip[nBruteTreei - 1]);
+    }
+  }
+  /* The k-best search needs the recognizer out of valuation mode */
+  if (marpaWrapperValuep != NULL) {
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+
+  if (rci == 0) {
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if (marpaWrapperAsfp == NULL) {
+      rci = 1;
+    }
+  }
+  /* The best tree, a few, all of them, more than all of them, then a few again on the same ASF */
+  if (rci == 0) {
+    rci = checkKbest(marpaWrapperAsfp, &scoreContext, 1, bruteScoreip, nBruteTreei, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkKbest(marpaWrapperAsfp, &scoreContext, 10, bruteScoreip, nBruteTreei, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkKbest(marpaWrapperAsfp, &scoreContext, NTREE, bruteScoreip, nBruteTreei, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkKbest(marpaWrapperAsfp, &scoreContext, NTREE + 100, bruteScoreip, nBruteTreei, genericLoggerp);
+  }
+  if (rci == 0) {
+    rci = checkKbest(marpaWrapperAsfp, &scoreContext, 3, bruteScoreip, nBruteTreei, genericLoggerp);
+  }
+
+  /* The search does not visit more glades than the forest has, and creates some derivations */
+  if (rci == 0) {
+    if (marpaWrapperAsf_kbestStatsb(marpaWrapperAsfp, &nGladel, &nDerivationl) == 0) {
+      rci = 1;
+    } else if ((nGladel <= 0) || (nDerivationl < 3)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "K-best statistics: %ld glades, %ld derivations", (unsigned long) nGladel, (unsigned long) nDerivationl);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "K-best statistics: %ld glades, %ld derivations", (unsigned long) nGladel, (unsigned long) nDerivationl);
+    }
+  }
+
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static int checkKbest(marpaWrapperAsf_t *marpaWrapperAsfp, scoreContext_t *scoreContextp, int ki, int *bruteScoreip, int nBruteTreei, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Tree No i of the k-best search must have the i-th best score of the      */
+/* brute force, and a valuation of it must give the same score.             */
+/****************************************************************************/
+{
+  int nTreei;
+  int treei;
+  int scorei;
+
+  if (marpaWrapperAsf_kbestb(marpaWrapperAsfp, ki, scoreContextp, tokenScoreCallback, &nTreei) == 0) {
+    return 1;
+  }
+  if (nTreei != ((ki < nBruteTreei) ? ki : nBruteTreei)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%d-best: %d trees found", ki, nTreei);
+    return 1;
+  }
+  for (treei = 0; treei < nTreei; treei++) {
+    if (marpaWrapperAsf_kbest_valueb(marpaWrapperAsfp, treei, scoreContextp, scoreRuleCallback, scoreSymbolCallback, NULL, &scorei) == 0) {
+      return 1;
+    }
+    if ((scorei != bruteScoreip[treei]) || (scoreContextp->stackip[0] != scorei)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%d-best: tree No %d has score %d, valued to %d, instead of %d", ki, treei, scorei, scoreContextp->stackip[0], bruteScoreip[treei]);
+      return 1;
+    }
+  }
+
+  GENERICLOGGER_INFOF(genericLoggerp, "%d-best: %d trees, scores from %d to %d", ki, nTreei, bruteScoreip[0], bruteScoreip[nTreei - 1]);
+  return 0;
+}
+
+/****************************************************************************/
+static short tokenScoreCallback(void *userDatavp, int symboli, int argi, int *scoreip)
+/****************************************************************************/
+{
+  scoreContext_t *scoreContextp = (scoreContext_t *) userDatavp;
+
+  *scoreip = (symboli == scoreContextp->symbolip[HESPERUS]) ? 3 : (((argi % 3) != 0) ? 1 : 0);
+  return 1;
+}
+
+/****************************************************************************/
+static short scoreRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  scoreContext_t *scoreContextp = (scoreContext_t *) userDatavp;
+  int             scorei        = scoreContextp->ruleRankip[rulei];
+  int             i;
+
+  if ((arg0i < 0) || (argni >= MAX_STACK) || (resulti < 0) || (resulti >= MAX_STACK)) {
+    return 0;
+  }
+  for (i = arg0i; i <= argni; i++) {
+    scorei += scoreContextp->stackip[i];
+  }
+  scoreContextp->stackip[resulti] = scorei;
+
+  return 1;
+}
+
+/****************************************************************************/
+static short scoreSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  scoreContext_t *scoreContextp = (scoreContext_t *) userDatavp;
+
+  if ((resulti < 0) || (resulti >= MAX_STACK)) {
+    return 0;
+  }
+  return tokenScoreCallback(userDatavp, symboli, argi, &(scoreContextp->stackip[resulti]));
+}
+
+/****************************************************************************/
+static int scoreCmpi(const void *ap, const void *bp)
+/****************************************************************************/
+/* Best score first */
+/****************************************************************************/
+{
+  int ai = * (const int *) ap;
+  int bi = * (const int *) bp;
+
+  return (ai < bi) ? 1 : ((ai > bi) ? -1 : 0);
+}
@@ -0,0 +1,368 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number
+
+  number op number op ... op number is ambiguous: there are Catalan(n-1) trees with n numbers.
+  The options must not change what is computed: each of them is checked against a run without
+  it, that is the golden one.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+#define NNUMBER  7
+#define NTREE    132 /* Catalan(6) */
+
+typedef struct valueContext {
+  unsigned long hashl;        /* Of the value callbacks of the current tree, in call order */
+  size_t        nOkl;         /* Ok callbacks calls, all trees */
+} valueContext_t;
+
+typedef struct valueRun {
+  unsigned long hashl[NTREE];
+  size_t        nTreel;
+  size_t        nOkl;
+  size_t        nEvictionl;
+  size_t        nRebuildl;
+} valueRun_t;
+
+typedef struct traverseContext {
+  size_t        nGladel;      /* Traverser calls */
+} traverseContext_t;
+
+static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
+static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
+static short okNullingCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli);
+static short hashRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short hashSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static short hashNullingCallback(void *userDatavp, int symboli, int resulti);
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static int   valueRuni(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperAsfOption_t *marpaWrapperAsfOptionp, valueRun_t *valueRunp);
+static int   sameRunsi(char *whats, valueRun_t *goldenRunp, valueRun_t *valueRunp, genericLogger_t *genericLoggerp);
+
+int main(int argc, char **argv) {
+  genericLogger_t          *genericLoggerp          = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t    *marpaWrapperGrammarp    = NULL;
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp = NULL;
+  marpaWrapperAsf_t        *marpaWrapperAsfp        = NULL;
+  marpaWrapperAsfOption_t   marpaWrapperAsfOption   = { NULL,
+                                                        0 /* highRankOnlyb */,
+                                                        0 /* orderByRankb */,
+                                                        1 /* ambiguousb */,
+                                                        0 /* maxParsesi */,
+                                                        0 /* okCacheb */,
+                                                        0 /* memob */,
+                                                        0 /* maxBytesl */
+  };
+  valueRun_t                goldenRun;
+  valueRun_t                valueRun;
+  traverseContext_t         goldenContext;
+  traverseContext_t         memoContext;
+  int                       goldenValuei;
+  int                       memoValuei;
+  size_t                    nLookupl;
+  size_t                    nHitl;
+  int                       symbolip[MAX_SYMBOL];
+  int                       i;
+  int                       rci = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL);
+    if (marpaWrapperRecognizerp == NULL) {
+      rci = 1;
+    }
+  }
+  /* Token values are their positions, starting at 1 */
+  for (i = 1; (rci == 0) && (i < 2 * NNUMBER); i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      rci = 1;
+    }
+  }
+
+  /* Golden valuation: no option */
+  if (rci == 0) {
+    rci = valueRuni(marpaWrapperRecognizerp, &marpaWrapperAsfOption, &goldenRun);
+  }
+  if (rci == 0) {
+    if (goldenRun.nTreel != NTREE) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Golden valuation: %ld trees instead of %d", (unsigned long) goldenRun.nTreel, NTREE);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Golden valuation: %ld trees, %ld ok callbacks", (unsigned long) goldenRun.nTreel, (unsigned long) goldenRun.nOkl);
+    }
+  }
+
+  /* okCacheb: all the trees are valued again, ok callbacks are not called again for unchanged subtrees */
+  if (rci == 0) {
+    marpaWrapperAsfOption.okCacheb = 1;
+    rci = valueRuni(marpaWrapperRecognizerp, &marpaWrapperAsfOption, &valueRun);
+    marpaWrapperAsfOption.okCacheb = 0;
+  }
+  if (rci == 0) {
+    rci = sameRunsi("okCacheb", &goldenRun, &valueRun, genericLoggerp);
+  }
+  if (rci == 0) {
+    if (valueRun.nOkl >= goldenRun.nOkl) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "okCacheb: %ld ok callbacks, not less than %ld", (unsigned long) valueRun.nOkl, (unsigned long) goldenRun.nOkl);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "okCacheb: same %ld trees, %ld ok callbacks instead of %ld", (unsigned long) valueRun.nTreel, (unsigned long) valueRun.nOkl, (unsigned long) goldenRun.nOkl);
+    }
+  }
+
+  /* maxBytesl: same values, glade contents are evicted and set up again */
+  if (rci == 0) {
+    marpaWrapperAsfOption.maxBytesl = 1;
+    rci = valueRuni(marpaWrapperRecognizerp, &marpaWrapperAsfOption, &valueRun);
+    marpaWrapperAsfOption.maxBytesl = 0;
+  }
+  if (rci == 0) {
+    rci = sameRunsi("maxBytesl", &goldenRun, &valueRun, genericLoggerp);
+  }
+  if (rci == 0) {
+    if ((valueRun.nEvictionl <= 0) || (valueRun.nRebuildl <= 0) || (goldenRun.nEvictionl != 0) || (goldenRun.nRebuildl != 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "maxBytesl: %ld evictions, %ld rebuilds, %ld and %ld without the option",
+                           (unsigned long) valueRun.nEvictionl, (unsigned long) valueRun.nRebuildl, (unsigned long) goldenRun.nEvictionl, (unsigned long) goldenRun.nRebuildl);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "maxBytesl: same %ld trees, %ld glades evicted, %ld set up again", (unsigned long) valueRun.nTreel, (unsigned long) valueRun.nEvictionl, (unsigned long) valueRun.nRebuildl);
+    }
+  }
+
+  /* memob: same traversal value, the traverser is called once per glade */
+  if (rci == 0) {
+    goldenContext.nGladel = 0;
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if ((marpaWrapperAsfp == NULL) || (marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, &goldenContext, &goldenValuei) == 0)) {
+      rci = 1;
+    }
+    if (marpaWrapperAsfp != NULL) {
+      marpaWrapperAsf_freev(marpaWrapperAsfp);
+      marpaWrapperAsfp = NULL;
+    }
+  }
+  if (rci == 0) {
+    memoContext.nGladel = 0;
+    marpaWrapperAsfOption.memob = 1;
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    marpaWrapperAsfOption.memob = 0;
+    if ((marpaWrapperAsfp == NULL) ||
+        (marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, &memoContext, &memoValuei) == 0) ||
+        (marpaWrapperAsf_memoStatsb(marpaWrapperAsfp, &nLookupl, &nHitl) == 0)) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    if ((goldenValuei != NTREE) || (memoValuei != goldenValuei) || (memoContext.nGladel >= goldenContext.nGladel) || (nHitl <= 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "memob: %d trees, %ld traverser calls, %ld hits, instead of %d trees, %ld traverser calls without the option",
+                           memoValuei, (unsigned long) memoContext.nGladel, (unsigned long) nHitl, goldenValuei, (unsigned long) goldenContext.nGladel);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "memob: same %d trees, %ld traverser calls instead of %ld", memoValuei, (unsigned long) memoContext.nGladel, (unsigned long) goldenContext.nGladel);
+    }
+  }
+
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static int valueRuni(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, marpaWrapperAsfOption_t *marpaWrapperAsfOptionp, valueRun_t *valueRunp)
+/****************************************************************************/
+/* Valuation of all the trees: the hash of the value callbacks of each of   */
+/* them, the number of ok callbacks, and the eviction statistics.           */
+/****************************************************************************/
+{
+  marpaWrapperAsfValue_t *marpaWrapperAsfValuep;
+  valueContext_t          valueContext;
+  short                   valueb;
+  int                     rci = 0;
+
+  valueRunp->nTreel = 0;
+  valueContext.nOkl = 0;
+
+  marpaWrapperAsfValuep = marpaWrapperAsfValue_newp(marpaWrapperRecognizerp, marpaWrapperAsfOptionp);
+  if (marpaWrapperAsfValuep == NULL) {
+    return 1;
+  }
+  while (1) {
+    valueContext.hashl = 5381;
+    valueb = marpaWrapperAsfValue_valueb(marpaWrapperAsfValuep, &valueContext,
+                                         okRuleCallback, okSymbolCallback, okNullingCallback,
+                                         hashRuleCallback, hashSymbolCallback, hashNullingCallback);
+    if (valueb <= 0) {
+      break;
+    }
+    if (valueRunp->nTreel >= NTREE) {
+      valueb = -1;
+      break;
+    }
+    valueRunp->hashl[valueRunp->nTreel++] = valueContext.hashl;
+  }
+  valueRunp->nOkl = valueContext.nOkl;
+  if ((valueb < 0) ||
+      (marpaWrapperAsf_evictionStatsb(marpaWrapperAsfValue_asfp(marpaWrapperAsfValuep), &(valueRunp->nEvictionl), &(valueRunp->nRebuildl), NULL) == 0)) {
+    rci = 1;
+  }
+
+  marpaWrapperAsfValue_freev(marpaWrapperAsfValuep);
+
+  return rci;
+}
+
+/****************************************************************************/
+static int sameRunsi(char *whats, valueRun_t *goldenRunp, valueRun_t *valueRunp, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+{
+  size_t i;
+
+  if (valueRunp->nTreel != goldenRunp->nTreel) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld trees instead of %ld", whats, (unsigned long) valueRunp->nTreel, (unsigned long) goldenRunp->nTreel);
+    return 1;
+  }
+  for (i = 0; i < valueRunp->nTreel; i++) {
+    if (valueRunp->hashl[i] != goldenRunp->hashl[i]) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld differs", whats, (unsigned long) i);
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/****************************************************************************/
+static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni)
+/****************************************************************************/
+{
+  ((valueContext_t *) userDatavp)->nOkl++;
+  return 1;
+}
+
+/****************************************************************************/
+static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi)
+/****************************************************************************/
+{
+  ((valueContext_t *) userDatavp)->nOkl++;
+  return 1;
+}
+
+/****************************************************************************/
+static short okNullingCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli)
+/****************************************************************************/
+{
+  ((valueContext_t *) userDatavp)->nOkl++;
+  return 1;
+}
+
+/****************************************************************************/
+static short hashRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  valueContext_t *valueContextp = (valueContext_t *) userDatavp;
+
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (rulei + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (arg0i + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (argni + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (resulti + 1);
+  return 1;
+}
+
+/****************************************************************************/
+static short hashSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  valueContext_t *valueContextp = (valueContext_t *) userDatavp;
+
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (symboli + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (argi + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (resulti + 1);
+  return 1;
+}
+
+/****************************************************************************/
+static short hashNullingCallback(void *userDatavp, int symboli, int resulti)
+/****************************************************************************/
+{
+  valueContext_t *valueContextp = (valueContext_t *) userDatavp;
+
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (symboli + 1);
+  valueContextp->hashl = valueContextp->hashl * 33 + (unsigned long) (resulti + 1);
+  return 1;
+}
+
+/****************************************************************************/
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip)
+/****************************************************************************/
+/* The value of a glade is its number of trees: the sum on its factorings   */
+/* of the product of the values of the RHS. It does not depend on the       */
+/* parent, as the memob option requires.                                    */
+/****************************************************************************/
+{
+  traverseContext_t *traverseContextp = (traverseContext_t *) userDatavp;
+  int                ruleIdi;
+  int                lengthi;
+  int                rhIxi;
+  int                rhValuei;
+  int                factoringValuei;
+  int                valuei = 0;
+  short              nextb;
+
+  traverseContextp->nGladel++;
+
+  while (1) {
+    if (! marpaWrapperAsf_traverse_ruleIdb(traverserp, &ruleIdi)) {
+      return 0;
+    }
+    factoringValuei = 1;
+    if (ruleIdi >= 0) {
+      lengthi = marpaWrapperAsf_traverse_rh_lengthi(traverserp);
+      if (lengthi < 0) {
+        return 0;
+      }
+      for (rhIxi = 0; rhIxi < lengthi; rhIxi++) {
+        if (! marpaWrapperAsf_traverse_rh_valueb(traverserp, rhIxi, &rhValuei, NULL)) {
+          return 0;
+        }
+        factoringValuei *= rhValuei;
+      }
+    }
+    valuei += factoringValuei;
+    if (! marpaWrapperAsf_traverse_nextb(traverserp, &nextb)) {
+      return 0;
+    }
+    if (! nextb) {
+      break;
+    }
+  }
+
+  *valueip = valuei;
+  return 1;
+}
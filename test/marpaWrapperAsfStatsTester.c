@@ -0,0 +1,343 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+#include "genericStack.h"
+
+/*
+  PAIRS ::= PAIR+
+  PAIR  ::= DUPLE | ITEM ITEM
+  DUPLE ::= ITEM ITEM
+  ITEM  ::= HESPERUS | PHOSPHORUS
+
+  Every token is both a HESPERUS and a PHOSPHORUS: NTOKEN tokens give 8^(NTOKEN/2) trees.
+  The pruning rejects DUPLE, and PHOSPHORUS on every third token: 4 * 2 * 2 = 16 trees are left.
+*/
+enum { PAIRS = 0, PAIR, DUPLE, ITEM, HESPERUS, PHOSPHORUS, MAX_SYMBOL };
+enum { PAIRS_RULE = 0, PAIR_RULE_01, PAIR_RULE_02, DUPLE_RULE, ITEM_RULE_01, ITEM_RULE_02, MAX_RULE };
+
+#define NTOKEN        6
+#define NTREE         512 /* 8^3 */
+#define NPRUNEDTREE   16
+#define MAX_STACK     64
+#define MAX_TOP       8
+
+typedef struct pruneContext {
+  int   *symbolip;
+  int   *ruleip;
+  short  rejectedbp[MAX_STACK]; /* Value stack: does the subtree contain something that the pruning rejects */
+} pruneContext_t;
+
+static short rejectedb(pruneContext_t *pruneContextp, int symboli, int argi);
+static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
+static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
+static short acceptRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
+static short acceptSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
+static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static int   checkStats(char *whats, marpaWrapperAsf_t *marpaWrapperAsfp, pruneContext_t *pruneContextp, size_t expectedTreel, int expectedNAmbiguousi, int expectedNTopi, int expectedTopSymboli, int expectedNAlternativei, size_t expectedTopTreel, genericLogger_t *genericLoggerp);
+static marpaWrapperRecognizer_t *recognizerp(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip);
+
+int main(int argc, char **argv) {
+  genericLogger_t           *genericLoggerp          = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t     *marpaWrapperGrammarp    = NULL;
+  marpaWrapperRecognizer_t  *marpaWrapperRecognizerp = NULL;
+  marpaWrapperValue_t       *marpaWrapperValuep      = NULL;
+  marpaWrapperAsf_t         *marpaWrapperAsfp        = NULL;
+  marpaWrapperAsfValue_t    *marpaWrapperAsfValuep   = NULL;
+  marpaWrapperValueOption_t  marpaWrapperValueOption = { NULL,
+                                                         0 /* highRankOnlyb */,
+                                                         0 /* orderByRankb */,
+                                                         1 /* ambiguousb */,
+                                                         0 /* nullb */,
+                                                         0 /* maxParsesi */,
+                                                         0 /* reuseValuatorb */
+  };
+  marpaWrapperAsfOption_t    marpaWrapperAsfOption   = { NULL,
+                                                         0 /* highRankOnlyb */,
+                                                         0 /* orderByRankb */,
+                                                         1 /* ambiguousb */,
+                                                         0 /* maxParsesi */,
+                                                         0 /* okCacheb */,
+                                                         0 /* memob */,
+                                                         0 /* maxBytesl */
+  };
+  int                        symbolip[MAX_SYMBOL];
+  int                        ruleip[MAX_RULE];
+  pruneContext_t             pruneContext;
+  size_t                     nTreel         = 0;
+  size_t                     nPrunedTreel   = 0;
+  size_t                     nAsfValueTreel = 0;
+  size_t                     nDeadFactoringl;
+  short                      valueb;
+  int                        rci = 0;
+
+  pruneContext.symbolip = symbolip;
+  pruneContext.ruleip   = ruleip;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     PAIRS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[      PAIR] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     DUPLE] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[      ITEM] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[  HESPERUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[PHOSPHORUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((ruleip[  PAIRS_RULE] = MARPAWRAPPERGRAMMAR_NEWSEQUENCE(marpaWrapperGrammarp, symbolip[PAIRS], symbolip[PAIR], 1)) < 0) ||
+      ((ruleip[PAIR_RULE_01] = MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[PAIR],  symbolip[DUPLE],                 -1)) < 0) ||
+      ((ruleip[PAIR_RULE_02] = MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[PAIR],  symbolip[ITEM], symbolip[ITEM], -1)) < 0) ||
+      ((ruleip[  DUPLE_RULE] = MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[DUPLE], symbolip[ITEM], symbolip[ITEM], -1)) < 0) ||
+      ((ruleip[ITEM_RULE_01] = MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ITEM],  symbolip[HESPERUS],              -1)) < 0) ||
+      ((ruleip[ITEM_RULE_02] = MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ITEM],  symbolip[PHOSPHORUS],            -1)) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  /* Enumeration: all the trees, and the ones the pruning will keep */
+  if (rci == 0) {
+    marpaWrapperRecognizerp = recognizerp(marpaWrapperGrammarp, symbolip);
+    if (marpaWrapperRecognizerp == NULL) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+    if (marpaWrapperValuep == NULL) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, &pruneContext, valueRuleCallback, valueSymbolCallback, NULL)) > 0) {
+      nTreel++;
+      if (! pruneContext.rejectedbp[0]) {
+        nPrunedTreel++;
+      }
+    }
+    if ((valueb < 0) || (nTreel != NTREE) || (nPrunedTreel != NPRUNEDTREE)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Enumeration: %ld trees, %ld without rejection, instead of %d and %d", (unsigned long) nTreel, (unsigned long) nPrunedTreel, NTREE, NPRUNEDTREE);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Enumeration: %ld trees, %ld without rejection", (unsigned long) nTreel, (unsigned long) nPrunedTreel);
+    }
+  }
+  if (marpaWrapperValuep != NULL) {
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+
+  /* Statistics of the whole forest: 6 ITEM glades and 3 PAIR glades are ambiguous, */
+  /* the PAIR glades first with 2 alternatives and 8 trees.                          */
+  if (rci == 0) {
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if (marpaWrapperAsfp == NULL) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    rci = checkStats("Forest", marpaWrapperAsfp, &pruneContext, nTreel, 9, 3, PAIR, 2, 8, genericLoggerp);
+  }
+
+  /* Pruned forest: PAIR glades have 1 alternative with 4 or 2 trees, only 4 ITEM glades are ambiguous */
+  if (rci == 0) {
+    if (marpaWrapperAsf_pruneb(marpaWrapperAsfp, &pruneContext, okRuleCallback, okSymbolCallback, NULL, &nDeadFactoringl) == 0) {
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Pruning: %ld dead factorings", (unsigned long) nDeadFactoringl);
+      rci = checkStats("Pruned forest", marpaWrapperAsfp, &pruneContext, nPrunedTreel, 4, 4, ITEM, 2, 2, genericLoggerp);
+    }
+  }
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+
+  /* ASF valuation of a pruned forest gives the same trees */
+  if (rci == 0) {
+    marpaWrapperAsfValuep = marpaWrapperAsfValue_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if ((marpaWrapperAsfValuep == NULL) ||
+        (marpaWrapperAsf_pruneb(marpaWrapperAsfValue_asfp(marpaWrapperAsfValuep), &pruneContext, okRuleCallback, okSymbolCallback, NULL, NULL) == 0)) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    while ((valueb = marpaWrapperAsfValue_valueb(marpaWrapperAsfValuep, &pruneContext, acceptRuleCallback, acceptSymbolCallback, NULL, valueRuleCallback, valueSymbolCallback, NULL)) > 0) {
+      if (pruneContext.rejectedbp[0]) {
+        break;
+      }
+      nAsfValueTreel++;
+    }
+    if ((valueb < 0) || (nAsfValueTreel != nPrunedTreel)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Pruned ASF valuation: %ld trees instead of %ld, status %d", (unsigned long) nAsfValueTreel, (unsigned long) nPrunedTreel, (int) valueb);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Pruned ASF valuation: %ld trees", (unsigned long) nAsfValueTreel);
+    }
+  }
+  if (marpaWrapperAsfValuep != NULL) {
+    marpaWrapperAsfValue_freev(marpaWrapperAsfValuep);
+  }
+
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static marpaWrapperRecognizer_t *recognizerp(marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip)
+/****************************************************************************/
+/* Token values start at 1: Marpa reserves value 0                          */
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  int                       i;
+
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL);
+  if (marpaWrapperRecognizerp == NULL) {
+    return NULL;
+  }
+  for (i = 1; i <= NTOKEN; i++) {
+    if ((marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[HESPERUS], i, 1) == 0) ||
+        (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[PHOSPHORUS], i, 1) == 0) ||
+        (marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp) == 0)) {
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+      return NULL;
+    }
+  }
+
+  return marpaWrapperRecognizerp;
+}
+
+/****************************************************************************/
+static int checkStats(char *whats, marpaWrapperAsf_t *marpaWrapperAsfp, pruneContext_t *pruneContextp, size_t expectedTreel, int expectedNAmbiguousi, int expectedNTopi, int expectedTopSymboli, int expectedNAlternativei, size_t expectedTopTreel, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* The number of trees of the forest is the one of the enumeration, and the */
+/* one of the peak glade. The first expectedNTopi top glades are of symbol */
+/* expectedTopSymboli. Top glades have the same statistics when asked one  */
+/* by one.                                                                  */
+/****************************************************************************/
+{
+  marpaWrapperAsfStats_t      stats;
+  marpaWrapperAsfGladeStats_t topGladeStats[MAX_TOP];
+  marpaWrapperAsfGladeStats_t gladeStats;
+  int                         nTopi;
+  int                         peakGladeIdi;
+  int                         i;
+
+  if ((marpaWrapperAsf_statsb(marpaWrapperAsfp, &stats, topGladeStats, MAX_TOP, &nTopi) == 0) ||
+      (marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi) == 0) ||
+      (marpaWrapperAsf_glade_statsb(marpaWrapperAsfp, peakGladeIdi, &gladeStats) == 0)) {
+    return 1;
+  }
+  if ((stats.nTreel != expectedTreel) || stats.treesSaturatedb || stats.factoringsOmittedb || (gladeStats.nTreel != stats.nTreel)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld trees, %ld in the peak glade, saturated %d, omitted %d, instead of %ld", whats, (unsigned long) stats.nTreel, (unsigned long) gladeStats.nTreel, (int) stats.treesSaturatedb, (int) stats.factoringsOmittedb, (unsigned long) expectedTreel);
+    return 1;
+  }
+  if ((gladeStats.symboli != pruneContextp->symbolip[PAIRS]) || (gladeStats.starti != 0) || (gladeStats.lengthi != NTOKEN)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: peak glade is symbol %d at %d, length %d", whats, gladeStats.symboli, gladeStats.starti, gladeStats.lengthi);
+    return 1;
+  }
+  if ((stats.nAmbiguousGladel != (size_t) expectedNAmbiguousi) || (nTopi != ((expectedNAmbiguousi < MAX_TOP) ? expectedNAmbiguousi : MAX_TOP))) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld ambiguous glades, %d top glades instead of %d", whats, (unsigned long) stats.nAmbiguousGladel, nTopi, expectedNAmbiguousi);
+    return 1;
+  }
+  for (i = 0; i < nTopi; i++) {
+    if (marpaWrapperAsf_glade_statsb(marpaWrapperAsfp, topGladeStats[i].gladeIdi, &gladeStats) == 0) {
+      return 1;
+    }
+    if ((gladeStats.symboli       != topGladeStats[i].symboli)       ||
+        (gladeStats.starti        != topGladeStats[i].starti)        ||
+        (gladeStats.lengthi       != topGladeStats[i].lengthi)       ||
+        (gladeStats.nAlternativei != topGladeStats[i].nAlternativei) ||
+        (gladeStats.nTreel        != topGladeStats[i].nTreel)        ||
+        (gladeStats.nAlternativei < 2)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: top glade No %d differs from glade %d statistics", whats, i, topGladeStats[i].gladeIdi);
+      return 1;
+    }
+    if ((i < expectedNTopi) &&
+        ((gladeStats.symboli != pruneContextp->symbolip[expectedTopSymboli]) ||
+         (gladeStats.nAlternativei != expectedNAlternativei) ||
+         (gladeStats.nTreel != expectedTopTreel))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: top glade No %d is symbol %d with %d alternatives and %ld trees", whats, i, gladeStats.symboli, gladeStats.nAlternativei, (unsigned long) gladeStats.nTreel);
+      return 1;
+    }
+  }
+
+  GENERICLOGGER_INFOF(genericLoggerp, "%s: %ld trees, %ld glades, %ld symches, %ld factorings, %ld ambiguous glades",
+                      whats, (unsigned long) stats.nTreel, (unsigned long) stats.nGladel, (unsigned long) stats.nSymchl, (unsigned long) stats.nFactoringl, (unsigned long) stats.nAmbiguousGladel);
+  return 0;
+}
+
+/****************************************************************************/
+static short rejectedb(pruneContext_t *pruneContextp, int symboli, int argi)
+/****************************************************************************/
+{
+  return ((symboli == pruneContextp->symbolip[PHOSPHORUS]) && ((argi % 3) == 0)) ? 1 : 0;
+}
+
+/****************************************************************************/
+static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni)
+/****************************************************************************/
+{
+  pruneContext_t *pruneContextp = (pruneContext_t *) userDatavp;
+
+  return (rulei == pruneContextp->ruleip[DUPLE_RULE]) ? -1 : 1;
+}
+
+/****************************************************************************/
+static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi)
+/****************************************************************************/
+{
+  return rejectedb((pruneContext_t *) userDatavp, symboli, argi) ? -1 : 1;
+}
+
+/****************************************************************************/
+static short acceptRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short acceptSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  pruneContext_t *pruneContextp = (pruneContext_t *) userDatavp;
+  short           rejectedb     = (rulei == pruneContextp->ruleip[DUPLE_RULE]) ? 1 : 0;
+  int             i;
+
+  if ((arg0i < 0) || (argni >= MAX_STACK) || (resulti < 0) || (resulti >= MAX_STACK)) {
+    return 0;
+  }
+  for (i = arg0i; i <= argni; i++) {
+    rejectedb |= pruneContextp->rejectedbp[i];
+  }
+  pruneContextp->rejectedbp[resulti] = rejectedb;
+
+  return 1;
+}
+
+/****************************************************************************/
+static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  pruneContext_t *pruneContextp = (pruneContext_t *) userDatavp;
+
+  if ((resulti < 0) || (resulti >= MAX_STACK)) {
+    return 0;
+  }
+  pruneContextp->rejectedbp[resulti] = rejectedb(pruneContextp, symboli, argi);
+
+  return 1;
+}
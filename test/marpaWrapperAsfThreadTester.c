@@ -0,0 +1,223 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number
+
+  number op number op ... op number is ambiguous: there are Catalan(n-1) trees with n numbers.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+#define NNUMBER  7
+#define NTREE    132 /* Catalan(6) */
+#define NTHREAD  8
+
+typedef struct traverseContext {
+  size_t        nGladel;      /* Traverser calls */
+  unsigned long hashl;        /* Of all what the traverser saw, in call order */
+} traverseContext_t;
+
+typedef struct traverseJob {
+  marpaWrapperAsf_t *marpaWrapperAsfp;
+  int                gladeIdi;
+  short              okb;
+  int                valuei;
+  traverseContext_t  traverseContext;
+} traverseJob_t;
+
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static void *traverseThreadp(void *userDatavp);
+
+int main(int argc, char **argv) {
+  genericLogger_t          *genericLoggerp          = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t    *marpaWrapperGrammarp    = NULL;
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp = NULL;
+  marpaWrapperAsf_t        *marpaWrapperAsfp        = NULL;
+  marpaWrapperAsfOption_t   marpaWrapperAsfOption   = { NULL,
+                                                        0 /* highRankOnlyb */,
+                                                        0 /* orderByRankb */,
+                                                        1 /* ambiguousb */,
+                                                        0 /* maxParsesi */,
+                                                        0 /* okCacheb */,
+                                                        0 /* memob */,
+                                                        0 /* maxBytesl */
+  };
+  int                       symbolip[MAX_SYMBOL];
+  int                       peakGladeIdi;
+  traverseJob_t             referenceJob;
+  traverseJob_t             jobs[NTHREAD];
+  pthread_t                 threads[NTHREAD];
+  short                     startedb[NTHREAD];
+  int                       i;
+  int                       rci = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL);
+    if (marpaWrapperRecognizerp == NULL) {
+      rci = 1;
+    }
+  }
+  /* Token values are their positions, starting at 1 */
+  for (i = 1; (rci == 0) && (i < 2 * NNUMBER); i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      rci = 1;
+    }
+  }
+
+  /* Traversals of a prepared ASF do not modify it */
+  if (rci == 0) {
+    marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+    if ((marpaWrapperAsfp == NULL) || (marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi) == 0)) {
+      rci = 1;
+    }
+  }
+
+  /* Reference traversal in this thread */
+  if (rci == 0) {
+    referenceJob.marpaWrapperAsfp = marpaWrapperAsfp;
+    referenceJob.gladeIdi         = peakGladeIdi;
+    traverseThreadp(&referenceJob);
+    if ((! referenceJob.okb) || (referenceJob.valuei != NTREE)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Reference traversal: status %d, %d trees instead of %d", (int) referenceJob.okb, referenceJob.valuei, NTREE);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Reference traversal: %d trees, %ld traverser calls", referenceJob.valuei, (unsigned long) referenceJob.traverseContext.nGladel);
+    }
+  }
+
+  /* Concurrent traversals: they must all see the same thing */
+  if (rci == 0) {
+    for (i = 0; i < NTHREAD; i++) {
+      jobs[i].marpaWrapperAsfp = marpaWrapperAsfp;
+      jobs[i].gladeIdi         = peakGladeIdi;
+      startedb[i]              = (pthread_create(&(threads[i]), NULL, traverseThreadp, &(jobs[i])) == 0);
+      if (! startedb[i]) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: pthread_create failure", i);
+        rci = 1;
+      }
+    }
+    for (i = 0; i < NTHREAD; i++) {
+      if (! startedb[i]) {
+        continue;
+      }
+      if (pthread_join(threads[i], NULL) != 0) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: pthread_join failure", i);
+        rci = 1;
+        continue;
+      }
+      if ((! jobs[i].okb) ||
+          (jobs[i].valuei                  != referenceJob.valuei) ||
+          (jobs[i].traverseContext.nGladel != referenceJob.traverseContext.nGladel) ||
+          (jobs[i].traverseContext.hashl   != referenceJob.traverseContext.hashl)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: status %d, %d trees, %ld traverser calls, hash %lu instead of 1, %d, %ld, %lu",
+                             i,
+                             (int) jobs[i].okb, jobs[i].valuei, (unsigned long) jobs[i].traverseContext.nGladel, jobs[i].traverseContext.hashl,
+                             referenceJob.valuei, (unsigned long) referenceJob.traverseContext.nGladel, referenceJob.traverseContext.hashl);
+        rci = 1;
+      }
+    }
+    if (rci == 0) {
+      GENERICLOGGER_INFOF(genericLoggerp, "%d concurrent traversals: same %d trees", NTHREAD, referenceJob.valuei);
+    }
+  }
+
+  if (marpaWrapperAsfp != NULL) {
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static void *traverseThreadp(void *userDatavp)
+/****************************************************************************/
+{
+  traverseJob_t *traverseJobp = (traverseJob_t *) userDatavp;
+
+  traverseJobp->traverseContext.nGladel = 0;
+  traverseJobp->traverseContext.hashl   = 5381;
+  traverseJobp->valuei                  = 0;
+  traverseJobp->okb                     = marpaWrapperAsf_traverse_gladeb(traverseJobp->marpaWrapperAsfp, traverseJobp->gladeIdi, countTraverserCallbacki, &(traverseJobp->traverseContext), &(traverseJobp->valuei));
+
+  return NULL;
+}
+
+/****************************************************************************/
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip)
+/****************************************************************************/
+/* The value of a glade is its number of trees: the sum on its factorings   */
+/* of the product of the values of the RHS. The hash is on rule ids and RHS */
+/* values, in the order they are seen.                                      */
+/****************************************************************************/
+{
+  traverseContext_t *traverseContextp = (traverseContext_t *) userDatavp;
+  int                ruleIdi;
+  int                lengthi;
+  int                rhIxi;
+  int                rhValuei;
+  int                factoringValuei;
+  int                valuei = 0;
+  short              nextb;
+
+  traverseContextp->nGladel++;
+
+  while (1) {
+    if (! marpaWrapperAsf_traverse_ruleIdb(traverserp, &ruleIdi)) {
+      return 0;
+    }
+    traverseContextp->hashl = traverseContextp->hashl * 33 + (unsigned long) (ruleIdi + 1);
+    if (ruleIdi < 0) {
+      /* A token */
+      factoringValuei = 1;
+    } else {
+      lengthi = marpaWrapperAsf_traverse_rh_lengthi(traverserp);
+      if (lengthi < 0) {
+        return 0;
+      }
+      factoringValuei = 1;
+      for (rhIxi = 0; rhIxi < lengthi; rhIxi++) {
+        if (! marpaWrapperAsf_traverse_rh_valueb(traverserp, rhIxi, &rhValuei, NULL)) {
+          return 0;
+        }
+        traverseContextp->hashl = traverseContextp->hashl * 33 + (unsigned long) rhValuei;
+        factoringValuei *= rhValuei;
+      }
+    }
+    valuei += factoringValuei;
+    if (! marpaWrapperAsf_traverse_nextb(traverserp, &nextb)) {
+      return 0;
+    }
+    if (! nextb) {
+      break;
+    }
+  }
+
+  *valueip = valuei;
+  return 1;
+}
@@ -57,16 +57,21 @@ int main(int argc, char **argv) {
 								  0 /* warningIsErrorb */,
 								  0 /* warningIsIgnoredb */,
 								  0 /* autorankb */,
+								  NULL /* allocatorp */
   };
   marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption = { GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG),
 								  0, /* disableThresholdb */
-								  0 /* exhaustion */
+								  0 /* exhaustion */,
+								  NULL /* allocatorp */
   };
   marpaWrapperAsfOption_t        marpaWrapperAsfOption        = { GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG),
 								  0 /* highRankOnlyb */,
 								  0 /* orderByRankb */,
 								  1 /* ambiguousb */,
-								  0 /* maxParsesi */
+								  0 /* maxParsesi */,
+								  0 /* okCacheb */,
+								  0 /* memob */,
+								  0 /* maxBytesl */
   };
 
   GENERICSTACK_NEW(traverseContext.inputStackp);
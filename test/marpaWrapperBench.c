@@ -0,0 +1,1365 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#endif
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  Throughput benchmark. Output is a JSON document on stdout (or in the file given with -o),
+  so that results can be tracked across releases.
+
+  Usage: marpaWrapperBench [-s scenario] [-n tokens] [-a asfTokens] [-t maxTrees] [-o file]
+
+  Scenarios:
+
+  expression     S ::= E
+                 E ::= E op number | number
+
+                 This is the expression grammar of marpaWrapperTester.c. The E ::= E op E
+                 form of the tester is ambiguous and cubic in the input length, so it is
+                 written left-recursively here in order to scale to 10^6 tokens.
+
+  ambiguous      S      ::= PAIR+
+                 PAIR   ::= DUPLE | ITEM ITEM
+                 DUPLE  ::= ITEM ITEM
+                 ITEM   ::= HESPERUS | PHOSPHORUS
+
+                 This is the grammar of marpaWrapperAsfAmbiguousTester.c repeated: every
+                 input token is read as both HESPERUS and PHOSPHORUS, so there are 8^(n/2) trees.
+
+  rightRecursive S ::= L
+                 L ::= A L | A
+
+  For every scenario the following phases are measured:
+
+  grammar        Creation of symbols and rules and marpaWrapperGrammar_precomputeb()
+  recognizer     marpaWrapperRecognizer_readb() on every token  -> tokens/second
+  readMany       marpaWrapperRecognizer_readManyb() on all tokens -> tokens/second
+  value          marpaWrapperValue_valueb() on at most maxTrees -> steps/second, with the
+                 time per tree
+  valueReuse     Same as value with the reuseValuatorb option, with the valuator blocks
+                 allocated and reused of marpaWrapperValue_valuatorStatsb(): the difference
+                 of time per tree with value is the valuator setup saved per tree
+  valueSteps     Same as value with marpaWrapperValue_stepsb() into its own buffer, the
+                 steps being walked in a loop instead of calling back
+  valueImage     Same as value with marpaWrapperValue_serializeb() then
+                 marpaWrapperValue_image_valueb() on each tree, with the total image bytes
+  documents      BENCH_DOCUMENTS small documents, one recognizer each -> documents/second
+  resetDocuments Same documents on one recognizer, marpaWrapperRecognizer_resetb() in between
+  poolDocuments  Same documents with recognizers from a marpaWrapperRecognizerPool_t
+  asf            marpaWrapperAsf_traverseb() of a full traverser -> glades/second,
+                 with the intset interning statistics of marpaWrapperAsf_intsetStatsb()
+                 and the number of allocations per glade and the peak of ASF heap bytes,
+                 from marpaWrapperAsf_newp() to marpaWrapperAsf_freev()
+  asfArena       Same as asf, with the recognizer and the ASF in a marpaWrapperArena_t
+  asfMemo        Same as asf with the memob ASF option: glades/second counts traverser calls,
+                 with the memo statistics of marpaWrapperAsf_memoStatsb()
+  asfPrepared    Same as asf with marpaWrapperAsf_prepareb() first, then
+                 marpaWrapperAsf_traverse_gladeb() from the peak
+  asfValue       marpaWrapperAsfValue_valueb() on at most maxTrees -> steps/second,
+                 with the number of ok callback calls
+  asfOkCacheValue
+                 Same as asfValue with the okCacheb ASF option: every tree is still
+                 traversed, the ok callbacks of unchanged subtrees are skipped
+  asfBoundedValue
+                 Same as asfValue with the maxBytesl ASF option at BENCH_ASF_MAX_BYTES,
+                 with the eviction statistics of marpaWrapperAsf_evictionStatsb()
+  asfRejectValue Same as asfValue, the ok symbol callback rejecting PHOSPHORUS in the
+                 ambiguous scenario
+  asfPrunedValue Same as asfRejectValue with marpaWrapperAsf_pruneb() first, with the
+                 number of dead factorings
+  asfStats       marpaWrapperAsf_statsb() -> glades/second, with the number of trees,
+                 saturated or not, and of ambiguous glades
+  asfKbest       marpaWrapperAsf_kbestb() of the maxTrees best trees, symbol ids being the
+                 token scores, then marpaWrapperAsf_kbest_valueb() on each -> steps/second,
+                 with the number of derivations of marpaWrapperAsf_kbestStatsb()
+
+  The ASF phases use its own recognizer over asfTokens tokens: traversal recursion depth
+  follows the depth of the forest.
+
+  Large forests: "-s ambiguous -n 20 -t 1 -a 16000" gives a forest of 112001 glades.
+
+  Peak RSS is reported per phase in kilobytes: on Linux the high water mark is reset
+  before each phase, elsewhere it is the process peak at the end of the phase.
+*/
+
+typedef enum benchScenarioType {
+  BENCH_EXPRESSION = 0,
+  BENCH_AMBIGUOUS,
+  BENCH_RIGHTRECURSIVE,
+  BENCH_MAX
+} benchScenarioType_t;
+
+typedef struct benchScenario {
+  benchScenarioType_t  typei;
+  char                *names;
+  int                  ntokeni;     /* Number of tokens for grammar, recognizer and value phases */
+  int                  nasfTokeni;  /* Number of tokens for the ASF phase */
+  int                  maxTreesi;   /* Maximum number of trees in the value phase */
+} benchScenario_t;
+
+static benchScenario_t benchScenarios[BENCH_MAX] = {
+  { BENCH_EXPRESSION,     "expression",     1000001, 10001,   1 },
+  { BENCH_AMBIGUOUS,      "ambiguous",         2000,   200, 100 },
+  { BENCH_RIGHTRECURSIVE, "rightRecursive",  200000, 10000,   1 }
+};
+
+/* Symbols used by all scenarios - not all of them are used at the same time */
+enum { S = 0, E, op, number, PAIRS, PAIR, DUPLE, ITEM, HESPERUS, PHOSPHORUS, L, A, MAX_SYMBOL };
+
+/* Small documents phases */
+#define BENCH_DOCUMENTS 10000
+#define BENCH_DOCUMENT_TOKENS 9
+
+/* Glade contents budget of the asfBoundedValue phase */
+#define BENCH_ASF_MAX_BYTES 65536
+
+typedef enum benchDocumentsMode {
+  BENCH_DOCUMENTS_NEW = 0,
+  BENCH_DOCUMENTS_RESET,
+  BENCH_DOCUMENTS_POOL
+} benchDocumentsMode_t;
+
+typedef enum benchValueMode {
+  BENCH_VALUE_CALLBACKS = 0,
+  BENCH_VALUE_STEPS,
+  BENCH_VALUE_IMAGE,
+  BENCH_VALUE_REUSE
+} benchValueMode_t;
+
+typedef enum benchAsfMode {
+  BENCH_ASF_TRAVERSE = 0,
+  BENCH_ASF_MEMO,
+  BENCH_ASF_PREPARED
+} benchAsfMode_t;
+
+typedef enum benchAsfReject {
+  BENCH_ASF_ACCEPT = 0,
+  BENCH_ASF_REJECT,
+  BENCH_ASF_PRUNE
+} benchAsfReject_t;
+
+typedef struct benchPhase {
+  double  secondsd;
+  long    peakRssKbl;
+  long    counterl;   /* Tokens, steps or glades */
+  long    treesl;     /* Value phases only */
+  long    okCallsl;   /* ASF value phases only */
+  size_t  intsetl;    /* ASF phases only: marpaWrapperAsf_intsetStatsb() */
+  size_t  lookupl;
+  size_t  probel;
+  size_t  maxProbel;
+  size_t  collisionl;
+  long    allocationsl; /* ASF phase only: malloc() and realloc() calls */
+  size_t  peakBytesl;   /* ASF phase only: peak of the bytes allocated by the ASF */
+  size_t  memoLookupl;  /* ASF phases only: marpaWrapperAsf_memoStatsb() */
+  size_t  memoHitl;
+  size_t  evictionl;     /* ASF value phases only: marpaWrapperAsf_evictionStatsb() */
+  size_t  rebuildl;
+  size_t  contentBytesl;
+  size_t  derivationl;   /* ASF k-best phase only: marpaWrapperAsf_kbestStatsb() */
+  size_t  deadFactoringl; /* ASF pruned value phase only: marpaWrapperAsf_pruneb() */
+  size_t  ambiguousGladel; /* ASF stats phase only: marpaWrapperAsf_statsb() */
+  short   treesSaturatedb;
+  size_t  imageBytesl;   /* Value image phase only: marpaWrapperValue_serializeb() */
+  double  perTreeMicrosecondsd; /* Value phases only */
+  size_t  valuatorAllocationl;  /* Value reuse phase only: marpaWrapperValue_valuatorStatsb() */
+  size_t  valuatorReusel;
+} benchPhase_t;
+
+/* State of the allocator of the asf phase */
+typedef struct benchCount {
+  long    allocationsl;
+  size_t  bytesl;
+  size_t  peakBytesl;
+} benchCount_t;
+
+/* Every block is prefixed with its size */
+typedef union benchCountHeader {
+  size_t      sizel;
+  long double alignld;
+} benchCountHeader_t;
+
+typedef struct benchContext {
+  long steps;
+  long glades;
+  long okCalls;
+  int  rejectSymboli; /* -1 if none */
+} benchContext_t;
+
+/* Allocator of the asf phase: it counts calls and bytes */
+static void *benchCountMallocp(void *userDatavp, size_t sizel);
+static void *benchCountReallocp(void *userDatavp, void *ptr, size_t sizel);
+static void  benchCountFreev(void *userDatavp, void *ptr);
+
+static double                 benchNowd(void);
+static void                   benchPeakRssResetv(void);
+static long                   benchPeakRssKbl(void);
+static marpaWrapperGrammar_t *benchGrammarp(benchScenario_t *scenariop, int *symbolip);
+static short                  benchReadb(benchScenario_t *scenariop, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, int ntokeni);
+static short                  benchGrammarPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t **marpaWrapperGrammarpp, int *symbolip);
+static short                  benchRecognizerPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizer_t **marpaWrapperRecognizerpp, int *symbolip);
+static short                  benchReadManyPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip);
+static short                  benchDocumentsPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, benchDocumentsMode_t modei);
+static short                  benchValuePhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, benchValueMode_t modei);
+static short                  benchAsfPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, marpaWrapperArena_t *marpaWrapperArenap, benchAsfMode_t modei);
+static short                  benchAsfValuePhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, short okCacheb, size_t maxBytesl, benchAsfReject_t rejecti);
+static short                  benchAsfStatsPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip);
+static short                  benchAsfKbestPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip);
+static short                  okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
+static short                  okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
+static short                  okNullingCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli);
+static short                  valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short                  valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static short                  valueNullingCallback(void *userDatavp, int symboli, int resulti);
+static short                  tokenScoreCallback(void *userDatavp, int symboli, int argi, int *scoreip);
+static short                  countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip);
+static void                   benchJsonPhasev(FILE *fp, char *names, benchPhase_t *phasep, char *counters, char *rates, short lastb);
+
+/****************************************************************************/
+int main(int argc, char **argv)
+/****************************************************************************/
+{
+  FILE                     *fp                      = stdout;
+  char                     *scenarios               = NULL;
+  int                       ntokeni                 = -1;
+  int                       nasfTokeni              = -1;
+  int                       maxTreesi               = -1;
+  short                     firstb                  = 1;
+  int                       rci                     = 0;
+  marpaWrapperGrammar_t    *marpaWrapperGrammarp    = NULL;
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp = NULL;
+  marpaWrapperArena_t      *marpaWrapperArenap      = NULL;
+  int                       symbolip[MAX_SYMBOL];
+  benchPhase_t              grammarPhase;
+  benchPhase_t              recognizerPhase;
+  benchPhase_t              readManyPhase;
+  benchPhase_t              documentsPhase;
+  benchPhase_t              resetDocumentsPhase;
+  benchPhase_t              poolDocumentsPhase;
+  benchPhase_t              valuePhase;
+  benchPhase_t              valueStepsPhase;
+  benchPhase_t              valueImagePhase;
+  benchPhase_t              valueReusePhase;
+  benchPhase_t              asfPhase;
+  benchPhase_t              asfArenaPhase;
+  benchPhase_t              asfMemoPhase;
+  benchPhase_t              asfPreparedPhase;
+  benchPhase_t              asfValuePhase;
+  benchPhase_t              asfOkCacheValuePhase;
+  benchPhase_t              asfBoundedValuePhase;
+  benchPhase_t              asfRejectValuePhase;
+  benchPhase_t              asfPrunedValuePhase;
+  benchPhase_t              asfStatsPhase;
+  benchPhase_t              asfKbestPhase;
+  benchScenario_t           scenario;
+  int                       i;
+
+  for (i = 1; i < argc; i++) {
+    if ((strcmp(argv[i], "-s") == 0) && (i + 1 < argc)) {
+      scenarios = argv[++i];
+    } else if ((strcmp(argv[i], "-n") == 0) && (i + 1 < argc)) {
+      ntokeni = atoi(argv[++i]);
+    } else if ((strcmp(argv[i], "-a") == 0) && (i + 1 < argc)) {
+      nasfTokeni = atoi(argv[++i]);
+    } else if ((strcmp(argv[i], "-t") == 0) && (i + 1 < argc)) {
+      maxTreesi = atoi(argv[++i]);
+    } else if ((strcmp(argv[i], "-o") == 0) && (i + 1 < argc)) {
+      fp = fopen(argv[++i], "w");
+      if (fp == NULL) {
+        perror(argv[i]);
+        exit(1);
+      }
+    } else {
+      fprintf(stderr, "Usage: %s [-s scenario] [-n tokens] [-a asfTokens] [-t maxTrees] [-o file]\n", argv[0]);
+      exit(1);
+    }
+  }
+
+  marpaWrapperArenap = marpaWrapperArena_newp(NULL, 0);
+  if (marpaWrapperArenap == NULL) {
+    perror("marpaWrapperArena_newp");
+    exit(1);
+  }
+
+  fprintf(fp, "{\n  \"benchmarks\": [");
+  for (i = 0; i < BENCH_MAX; i++) {
+    scenario = benchScenarios[i];
+    if ((scenarios != NULL) && (strcmp(scenarios, scenario.names) != 0)) {
+      continue;
+    }
+    if (ntokeni > 0) {
+      scenario.ntokeni = ntokeni;
+    }
+    if (nasfTokeni > 0) {
+      scenario.nasfTokeni = nasfTokeni;
+    }
+    if (maxTreesi > 0) {
+      scenario.maxTreesi = maxTreesi;
+    }
+    /* The expression scenario needs an odd number of tokens, the ambiguous one an even number */
+    if (scenario.typei == BENCH_EXPRESSION) {
+      scenario.ntokeni    |= 1;
+      scenario.nasfTokeni |= 1;
+    } else if (scenario.typei == BENCH_AMBIGUOUS) {
+      scenario.ntokeni    += scenario.ntokeni % 2;
+      scenario.nasfTokeni += scenario.nasfTokeni % 2;
+    }
+
+    memset(&grammarPhase,    0, sizeof(benchPhase_t));
+    memset(&recognizerPhase, 0, sizeof(benchPhase_t));
+    memset(&readManyPhase,   0, sizeof(benchPhase_t));
+    memset(&documentsPhase,      0, sizeof(benchPhase_t));
+    memset(&resetDocumentsPhase, 0, sizeof(benchPhase_t));
+    memset(&poolDocumentsPhase,  0, sizeof(benchPhase_t));
+    memset(&valuePhase,      0, sizeof(benchPhase_t));
+    memset(&valueStepsPhase, 0, sizeof(benchPhase_t));
+    memset(&valueImagePhase, 0, sizeof(benchPhase_t));
+    memset(&valueReusePhase, 0, sizeof(benchPhase_t));
+    memset(&asfPhase,        0, sizeof(benchPhase_t));
+    memset(&asfArenaPhase,   0, sizeof(benchPhase_t));
+    memset(&asfMemoPhase,    0, sizeof(benchPhase_t));
+    memset(&asfPreparedPhase, 0, sizeof(benchPhase_t));
+    memset(&asfValuePhase,            0, sizeof(benchPhase_t));
+    memset(&asfOkCacheValuePhase,     0, sizeof(benchPhase_t));
+    memset(&asfBoundedValuePhase,     0, sizeof(benchPhase_t));
+    memset(&asfRejectValuePhase,      0, sizeof(benchPhase_t));
+    memset(&asfPrunedValuePhase,      0, sizeof(benchPhase_t));
+    memset(&asfStatsPhase,            0, sizeof(benchPhase_t));
+    memset(&asfKbestPhase,            0, sizeof(benchPhase_t));
+
+    if ((! benchGrammarPhaseb(&scenario, &grammarPhase, &marpaWrapperGrammarp, symbolip)) ||
+        (! benchReadManyPhaseb(&scenario, &readManyPhase, marpaWrapperGrammarp, symbolip)) ||
+        (! benchDocumentsPhaseb(&scenario, &documentsPhase,      marpaWrapperGrammarp, symbolip, BENCH_DOCUMENTS_NEW)) ||
+        (! benchDocumentsPhaseb(&scenario, &resetDocumentsPhase, marpaWrapperGrammarp, symbolip, BENCH_DOCUMENTS_RESET)) ||
+        (! benchDocumentsPhaseb(&scenario, &poolDocumentsPhase,  marpaWrapperGrammarp, symbolip, BENCH_DOCUMENTS_POOL)) ||
+        (! benchRecognizerPhaseb(&scenario, &recognizerPhase, marpaWrapperGrammarp, &marpaWrapperRecognizerp, symbolip)) ||
+        (! benchValuePhaseb(&scenario, &valuePhase,      marpaWrapperRecognizerp, BENCH_VALUE_CALLBACKS)) ||
+        (! benchValuePhaseb(&scenario, &valueStepsPhase, marpaWrapperRecognizerp, BENCH_VALUE_STEPS)) ||
+        (! benchValuePhaseb(&scenario, &valueImagePhase, marpaWrapperRecognizerp, BENCH_VALUE_IMAGE)) ||
+        (! benchValuePhaseb(&scenario, &valueReusePhase, marpaWrapperRecognizerp, BENCH_VALUE_REUSE))) {
+      fprintf(stderr, "Scenario %s failed\n", scenario.names);
+      rci = 1;
+    }
+    if (marpaWrapperRecognizerp != NULL) {
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+      marpaWrapperRecognizerp = NULL;
+    }
+    if ((rci == 0) && ((! benchAsfPhaseb(&scenario, &asfPhase,         marpaWrapperGrammarp, symbolip, NULL,               BENCH_ASF_TRAVERSE)) ||
+                       (! benchAsfPhaseb(&scenario, &asfArenaPhase,    marpaWrapperGrammarp, symbolip, marpaWrapperArenap, BENCH_ASF_TRAVERSE)) ||
+                       (! benchAsfPhaseb(&scenario, &asfMemoPhase,     marpaWrapperGrammarp, symbolip, NULL,               BENCH_ASF_MEMO)) ||
+                       (! benchAsfPhaseb(&scenario, &asfPreparedPhase, marpaWrapperGrammarp, symbolip, NULL,               BENCH_ASF_PREPARED)) ||
+                       (! benchAsfValuePhaseb(&scenario, &asfValuePhase,            marpaWrapperGrammarp, symbolip, 0 /* okCacheb */, 0,                   BENCH_ASF_ACCEPT)) ||
+                       (! benchAsfValuePhaseb(&scenario, &asfOkCacheValuePhase,     marpaWrapperGrammarp, symbolip, 1 /* okCacheb */, 0,                   BENCH_ASF_ACCEPT)) ||
+                       (! benchAsfValuePhaseb(&scenario, &asfBoundedValuePhase,     marpaWrapperGrammarp, symbolip, 0 /* okCacheb */, BENCH_ASF_MAX_BYTES, BENCH_ASF_ACCEPT)) ||
+                       (! benchAsfValuePhaseb(&scenario, &asfRejectValuePhase,      marpaWrapperGrammarp, symbolip, 0 /* okCacheb */, 0,                   BENCH_ASF_REJECT)) ||
+                       (! benchAsfValuePhaseb(&scenario, &asfPrunedValuePhase,      marpaWrapperGrammarp, symbolip, 0 /* okCacheb */, 0,                   BENCH_ASF_PRUNE)) ||
+                       (! benchAsfStatsPhaseb(&scenario, &asfStatsPhase, marpaWrapperGrammarp, symbolip)) ||
+                       (! benchAsfKbestPhaseb(&scenario, &asfKbestPhase, marpaWrapperGrammarp, symbolip)))) {
+      fprintf(stderr, "Scenario %s ASF phase failed\n", scenario.names);
+      rci = 1;
+    }
+    if (marpaWrapperGrammarp != NULL) {
+      marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+      marpaWrapperGrammarp = NULL;
+    }
+    if (rci != 0) {
+      break;
+    }
+
+    fprintf(fp, "%s\n    {\n", firstb ? "" : ",");
+    fprintf(fp, "      \"name\": \"%s\",\n", scenario.names);
+    fprintf(fp, "      \"tokens\": %d,\n", scenario.ntokeni);
+    fprintf(fp, "      \"asfTokens\": %d,\n", scenario.nasfTokeni);
+    fprintf(fp, "      \"phases\": {\n");
+    benchJsonPhasev(fp, "grammar",    &grammarPhase,    NULL,     NULL,              0);
+    benchJsonPhasev(fp, "recognizer", &recognizerPhase, "tokens", "tokensPerSecond", 0);
+    benchJsonPhasev(fp, "readMany",   &readManyPhase,   "tokens", "tokensPerSecond", 0);
+    benchJsonPhasev(fp, "documents",      &documentsPhase,      "documents", "documentsPerSecond", 0);
+    benchJsonPhasev(fp, "resetDocuments", &resetDocumentsPhase, "documents", "documentsPerSecond", 0);
+    benchJsonPhasev(fp, "poolDocuments",  &poolDocumentsPhase,  "documents", "documentsPerSecond", 0);
+    benchJsonPhasev(fp, "value",      &valuePhase,      "steps",  "stepsPerSecond",  0);
+    benchJsonPhasev(fp, "valueSteps", &valueStepsPhase, "steps",  "stepsPerSecond",  0);
+    benchJsonPhasev(fp, "valueImage", &valueImagePhase, "steps",  "stepsPerSecond",  0);
+    benchJsonPhasev(fp, "valueReuse", &valueReusePhase, "steps",  "stepsPerSecond",  0);
+    benchJsonPhasev(fp, "asf",        &asfPhase,        "glades", "gladesPerSecond", 0);
+    benchJsonPhasev(fp, "asfArena",   &asfArenaPhase,   "glades", "gladesPerSecond", 0);
+    benchJsonPhasev(fp, "asfMemo",    &asfMemoPhase,    "glades", "gladesPerSecond", 0);
+    benchJsonPhasev(fp, "asfPrepared", &asfPreparedPhase, "glades", "gladesPerSecond", 0);
+    benchJsonPhasev(fp, "asfValue",            &asfValuePhase,            "steps", "stepsPerSecond", 0);
+    benchJsonPhasev(fp, "asfOkCacheValue",     &asfOkCacheValuePhase,     "steps", "stepsPerSecond", 0);
+    benchJsonPhasev(fp, "asfBoundedValue",     &asfBoundedValuePhase,     "steps", "stepsPerSecond", 0);
+    benchJsonPhasev(fp, "asfRejectValue",      &asfRejectValuePhase,      "steps", "stepsPerSecond", 0);
+    benchJsonPhasev(fp, "asfPrunedValue",      &asfPrunedValuePhase,      "steps", "stepsPerSecond", 0);
+    benchJsonPhasev(fp, "asfStats",            &asfStatsPhase,            "glades", "gladesPerSecond", 0);
+    benchJsonPhasev(fp, "asfKbest",            &asfKbestPhase,            "steps", "stepsPerSecond", 1);
+    fprintf(fp, "      }\n    }");
+    fflush(fp);
+    firstb = 0;
+  }
+  fprintf(fp, "\n  ]\n}\n");
+
+  if (fp != stdout) {
+    fclose(fp);
+  }
+  marpaWrapperArena_freev(marpaWrapperArenap);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static double benchNowd(void)
+/****************************************************************************/
+{
+#ifdef _WIN32
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+
+  return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double) ts.tv_sec + ((double) ts.tv_nsec / 1000000000.);
+#endif
+}
+
+/****************************************************************************/
+static void benchPeakRssResetv(void)
+/****************************************************************************/
+{
+#ifdef __linux__
+  /* Since linux 4.0, writing 5 resets the peak resident set size (VmHWM) */
+  FILE *fp = fopen("/proc/self/clear_refs", "w");
+
+  if (fp != NULL) {
+    fputs("5", fp);
+    fclose(fp);
+  }
+#endif
+}
+
+/****************************************************************************/
+static long benchPeakRssKbl(void)
+/****************************************************************************/
+{
+#ifdef _WIN32
+  return -1;
+#else
+  struct rusage usage;
+#ifdef __linux__
+  FILE *fp = fopen("/proc/self/status", "r");
+  char  lines[256];
+  long  kbl = -1;
+
+  if (fp != NULL) {
+    while (fgets(lines, sizeof(lines), fp) != NULL) {
+      if (strncmp(lines, "VmHWM:", 6) == 0) {
+        kbl = atol(lines + 6);
+        break;
+      }
+    }
+    fclose(fp);
+    if (kbl >= 0) {
+      return kbl;
+    }
+  }
+#endif
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; /* Bytes on Mac OS X */
+#else
+  return usage.ru_maxrss;
+#endif
+#endif
+}
+
+/****************************************************************************/
+static marpaWrapperGrammar_t *benchGrammarp(benchScenario_t *scenariop, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperGrammarOption_t  marpaWrapperGrammarOption = { NULL /* genericLoggerp */,
+                                                             0    /* warningIsErrorb */,
+                                                             1    /* warningIsIgnoredb */,
+                                                             0    /* autorankb */,
+                                                             NULL /* allocatorp */
+  };
+  marpaWrapperGrammar_t       *marpaWrapperGrammarp;
+  short                        okb = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
+  if (marpaWrapperGrammarp == NULL) {
+    return NULL;
+  }
+
+  switch (scenariop->typei) {
+  case BENCH_EXPRESSION:
+    okb =
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      /* S ::= E           */
+      /* E ::= E op number */
+      /* E ::= number      */
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                                 -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[number], -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                            -1) >= 0);
+    break;
+  case BENCH_AMBIGUOUS:
+    okb =
+      ((symbolip[     PAIRS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[      PAIR] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[     DUPLE] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[      ITEM] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[  HESPERUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[PHOSPHORUS] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      /* S      ::= PAIR+                 */
+      /* PAIR   ::= DUPLE | ITEM ITEM     */
+      /* DUPLE  ::= ITEM ITEM             */
+      /* ITEM   ::= HESPERUS | PHOSPHORUS */
+      (MARPAWRAPPERGRAMMAR_NEWSEQUENCE(marpaWrapperGrammarp, symbolip[PAIRS], symbolip[PAIR], 1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ PAIR], symbolip[DUPLE],                  -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ PAIR], symbolip[ ITEM], symbolip[ITEM],  -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[DUPLE], symbolip[ ITEM], symbolip[ITEM],  -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ ITEM], symbolip[  HESPERUS],             -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[ ITEM], symbolip[PHOSPHORUS],             -1) >= 0);
+    break;
+  case BENCH_RIGHTRECURSIVE:
+    okb =
+      ((symbolip[S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[L] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      ((symbolip[A] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+      /* S ::= L     */
+      /* L ::= A L   */
+      /* L ::= A     */
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[L],              -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[L], symbolip[A], symbolip[L], -1) >= 0) &&
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[L], symbolip[A],              -1) >= 0);
+    break;
+  default:
+    break;
+  }
+
+  if ((! okb) || (! marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp))) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+    return NULL;
+  }
+
+  return marpaWrapperGrammarp;
+}
+
+/****************************************************************************/
+static short benchReadb(benchScenario_t *scenariop, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, int ntokeni)
+/****************************************************************************/
+{
+  int i;
+
+  /* Token values start at 1: Marpa reserves value 0 */
+  switch (scenariop->typei) {
+  case BENCH_EXPRESSION:
+    for (i = 0; i < ntokeni; i++) {
+      if (! marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[(i % 2) ? op : number], i + 1, 1)) {
+        return 0;
+      }
+    }
+    break;
+  case BENCH_AMBIGUOUS:
+    for (i = 0; i < ntokeni; i++) {
+      if ((! marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[HESPERUS], i + 1, 1)) ||
+          (! marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[PHOSPHORUS], i + 1, 1)) ||
+          (! marpaWrapperRecognizer_completeb(marpaWrapperRecognizerp))) {
+        return 0;
+      }
+    }
+    break;
+  case BENCH_RIGHTRECURSIVE:
+    for (i = 0; i < ntokeni; i++) {
+      if (! marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[A], i + 1, 1)) {
+        return 0;
+      }
+    }
+    break;
+  default:
+    return 0;
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static short benchGrammarPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t **marpaWrapperGrammarpp, int *symbolip)
+/****************************************************************************/
+{
+  double startd;
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  *marpaWrapperGrammarpp = benchGrammarp(scenariop, symbolip);
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+
+  return (*marpaWrapperGrammarpp != NULL) ? 1 : 0;
+}
+
+/****************************************************************************/
+static short benchRecognizerPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizer_t **marpaWrapperRecognizerpp, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                  0    /* disableThresholdb */,
+                                                                  0    /* exhaustionEventb */,
+                                                                  NULL /* allocatorp */
+  };
+  double                         startd;
+  short                          rcb;
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  *marpaWrapperRecognizerpp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  rcb = (*marpaWrapperRecognizerpp != NULL) ? benchReadb(scenariop, *marpaWrapperRecognizerpp, symbolip, scenariop->ntokeni) : 0;
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = scenariop->ntokeni;
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short benchReadManyPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip)
+/****************************************************************************/
+/* Same input as the recognizer phase, in one marpaWrapperRecognizer_readManyb() call. */
+/* Building the token array is not part of the measure.                                */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                   0    /* disableThresholdb */,
+                                                                   0    /* exhaustionEventb */,
+                                                                   NULL /* allocatorp */
+  };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperRecognizerToken_t  *tokenp;
+  size_t                          tokenl = 0;
+  size_t                          readl  = 0;
+  double                          startd;
+  short                           rcb    = 0;
+  int                             i;
+
+  tokenp = (marpaWrapperRecognizerToken_t *) malloc(2 * (size_t) scenariop->ntokeni * sizeof(marpaWrapperRecognizerToken_t));
+  if (tokenp == NULL) {
+    return 0;
+  }
+  for (i = 0; i < scenariop->ntokeni; i++) {
+    /* Token values start at 1: Marpa reserves value 0 */
+    tokenp[tokenl].valuei   = i + 1;
+    tokenp[tokenl].lengthi  = 1;
+    tokenp[tokenl].advancei = 1;
+    switch (scenariop->typei) {
+    case BENCH_EXPRESSION:
+      tokenp[tokenl++].symboli = symbolip[(i % 2) ? op : number];
+      break;
+    case BENCH_AMBIGUOUS:
+      tokenp[tokenl].symboli  = symbolip[HESPERUS];
+      tokenp[tokenl].advancei = 0;
+      tokenl++;
+      tokenp[tokenl].valuei   = i + 1;
+      tokenp[tokenl].lengthi  = 1;
+      tokenp[tokenl].advancei = 1;
+      tokenp[tokenl++].symboli = symbolip[PHOSPHORUS];
+      break;
+    default:
+      tokenp[tokenl++].symboli = symbolip[A];
+      break;
+    }
+  }
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp != NULL) {
+    rcb = marpaWrapperRecognizer_readManyb(marpaWrapperRecognizerp, tokenp, tokenl, &readl, NULL, NULL) && (readl == tokenl);
+  }
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = scenariop->ntokeni;
+
+  /* Like the recognizer phase, teardown is not part of the measure */
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+
+  free(tokenp);
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short benchDocumentsPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, benchDocumentsMode_t modei)
+/****************************************************************************/
+/* The pool keeps a single recognizer warm: documents are parsed one after  */
+/* the other.                                                               */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerPool_t *marpaWrapperRecognizerPoolp = NULL;
+  marpaWrapperRecognizer_t     *marpaWrapperRecognizerp     = NULL;
+  double                        startd;
+  int                           ntokeni                     = BENCH_DOCUMENT_TOKENS;
+  int                           i;
+  short                         rcb                         = 1;
+
+  /* Same parity constraints as the main input */
+  if (scenariop->typei == BENCH_AMBIGUOUS) {
+    ntokeni++;
+  }
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  if (modei == BENCH_DOCUMENTS_POOL) {
+    marpaWrapperRecognizerPoolp = marpaWrapperRecognizerPool_newp(marpaWrapperGrammarp, NULL, 1 /* maxWarml */);
+    if (marpaWrapperRecognizerPoolp == NULL) {
+      return 0;
+    }
+  }
+  for (i = 0; i < BENCH_DOCUMENTS; i++) {
+    switch (modei) {
+    case BENCH_DOCUMENTS_RESET:
+      if (marpaWrapperRecognizerp != NULL) {
+        rcb = marpaWrapperRecognizer_resetb(marpaWrapperRecognizerp);
+      } else {
+        rcb = ((marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL)) != NULL);
+      }
+      break;
+    case BENCH_DOCUMENTS_POOL:
+      rcb = ((marpaWrapperRecognizerp = marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPoolp)) != NULL);
+      break;
+    default:
+      rcb = ((marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL)) != NULL);
+      break;
+    }
+    if ((! rcb) || (! (rcb = benchReadb(scenariop, marpaWrapperRecognizerp, symbolip, ntokeni)))) {
+      break;
+    }
+    switch (modei) {
+    case BENCH_DOCUMENTS_RESET:
+      break;
+    case BENCH_DOCUMENTS_POOL:
+      if (! (rcb = marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, marpaWrapperRecognizerp))) {
+        break;
+      }
+      marpaWrapperRecognizerp = NULL;
+      break;
+    default:
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+      marpaWrapperRecognizerp = NULL;
+      break;
+    }
+    if (! rcb) {
+      break;
+    }
+  }
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  marpaWrapperRecognizerPool_freev(marpaWrapperRecognizerPoolp);
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = i;
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short benchValuePhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, benchValueMode_t modei)
+/****************************************************************************/
+{
+  marpaWrapperValueOption_t  marpaWrapperValueOption = { NULL /* genericLoggerp */,
+                                                         0    /* highRankOnlyb */,
+                                                         0    /* orderByRankb */,
+                                                         1    /* ambiguousb */,
+                                                         0    /* nullb */,
+                                                         0    /* maxParsesi */,
+                                                         0    /* reuseValuatorb */
+  };
+  marpaWrapperValue_t       *marpaWrapperValuep;
+  benchContext_t             benchContext = { 0, 0, 0, -1 };
+  marpaWrapperValueStep_t   *stepp;
+  size_t                     nStepl;
+  size_t                     i;
+  char                      *bufferp;
+  size_t                     bufferl;
+  double                     startd;
+  short                      rcb;
+
+  marpaWrapperValueOption.maxParsesi     = scenariop->maxTreesi;
+  marpaWrapperValueOption.reuseValuatorb = (modei == BENCH_VALUE_REUSE) ? 1 : 0;
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  if (marpaWrapperValuep == NULL) {
+    return 0;
+  }
+  if (modei == BENCH_VALUE_IMAGE) {
+    while ((rcb = marpaWrapperValue_serializeb(marpaWrapperValuep, &bufferp, &bufferl)) > 0) {
+      phasep->imageBytesl += bufferl;
+      rcb = marpaWrapperValue_image_valueb(NULL, bufferp, bufferl, &benchContext, valueRuleCallback, valueSymbolCallback, valueNullingCallback);
+      free(bufferp);
+      if (! rcb) {
+        rcb = -1;
+        break;
+      }
+      phasep->treesl++;
+    }
+  } else if (modei == BENCH_VALUE_STEPS) {
+    while ((rcb = marpaWrapperValue_stepsb(marpaWrapperValuep, NULL, 0, &stepp, &nStepl)) > 0) {
+      for (i = 0; i < nStepl; i++) {
+        switch (stepp[i].typei) {
+        case MARPAWRAPPERVALUE_STEP_RULE:
+        case MARPAWRAPPERVALUE_STEP_TOKEN:
+        case MARPAWRAPPERVALUE_STEP_NULLING:
+          benchContext.steps++;
+          break;
+        default:
+          break;
+        }
+      }
+      phasep->treesl++;
+    }
+  } else {
+    while ((rcb = marpaWrapperValue_valueb(marpaWrapperValuep, &benchContext, valueRuleCallback, valueSymbolCallback, valueNullingCallback)) > 0) {
+      phasep->treesl++;
+    }
+  }
+  marpaWrapperValue_valuatorStatsb(marpaWrapperValuep, &(phasep->valuatorAllocationl), &(phasep->valuatorReusel));
+  marpaWrapperValue_freev(marpaWrapperValuep);
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = benchContext.steps;
+  if (phasep->treesl > 0) {
+    phasep->perTreeMicrosecondsd = (phasep->secondsd * 1000000.) / (double) phasep->treesl;
+  }
+
+  return (rcb < 0) ? 0 : 1;
+}
+
+/****************************************************************************/
+static short benchAsfPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, marpaWrapperArena_t *marpaWrapperArenap, benchAsfMode_t modei)
+/****************************************************************************/
+/* With an arena, marpaWrapperArena_resetb() releases the recognizer memory */
+/* after the measure: it costs one free() per chunk.                        */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                   0    /* disableThresholdb */,
+                                                                   0    /* exhaustionEventb */,
+                                                                   NULL /* allocatorp */
+  };
+  marpaWrapperAsfOption_t         marpaWrapperAsfOption        = { NULL /* genericLoggerp */,
+                                                                   0    /* highRankOnlyb */,
+                                                                   0    /* orderByRankb */,
+                                                                   1    /* ambiguousb */,
+                                                                   0    /* maxParsesi */,
+                                                                   0    /* okCacheb */,
+                                                                   0    /* memob */,
+                                                                   0    /* maxBytesl */
+  };
+  benchCount_t                    benchCount                   = { 0, 0, 0 };
+  marpaWrapperAllocator_t         countAllocator               = { &benchCount, benchCountMallocp, benchCountReallocp, benchCountFreev };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperAsf_t              *marpaWrapperAsfp;
+  benchContext_t                  benchContext = { 0, 0, 0, -1 };
+  size_t                          startBytesl;
+  double                          startd;
+  int                             valuei;
+  int                             peakGladeIdi;
+  short                           rcb = 0;
+
+  marpaWrapperAsfOption.memob = (modei == BENCH_ASF_MEMO) ? 1 : 0;
+
+  if (marpaWrapperArenap != NULL) {
+    marpaWrapperRecognizerOption.allocatorp = marpaWrapperArena_allocatorp(marpaWrapperArenap);
+  } else {
+    marpaWrapperRecognizerOption.allocatorp = &countAllocator;
+  }
+
+  /* Recognition of the ASF input is not part of the measure */
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 0;
+  }
+  if (! benchReadb(scenariop, marpaWrapperRecognizerp, symbolip, scenariop->nasfTokeni)) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    return 0;
+  }
+
+  benchPeakRssResetv();
+  /* The recognizer is still allocated: only what the ASF adds is measured */
+  benchCount.allocationsl = 0;
+  benchCount.peakBytesl   = benchCount.bytesl;
+  startBytesl             = benchCount.bytesl;
+  startd = benchNowd();
+  marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+  if (marpaWrapperAsfp != NULL) {
+    if (modei == BENCH_ASF_PREPARED) {
+      rcb = marpaWrapperAsf_prepareb(marpaWrapperAsfp, &peakGladeIdi) &&
+            marpaWrapperAsf_traverse_gladeb(marpaWrapperAsfp, peakGladeIdi, countTraverserCallbacki, &benchContext, &valuei);
+    } else {
+      rcb = marpaWrapperAsf_traverseb(marpaWrapperAsfp, countTraverserCallbacki, &benchContext, &valuei);
+    }
+    if (! marpaWrapperAsf_intsetStatsb(marpaWrapperAsfp, &(phasep->intsetl), &(phasep->lookupl), &(phasep->probel), &(phasep->maxProbel), &(phasep->collisionl))) {
+      rcb = 0;
+    }
+    if (! marpaWrapperAsf_memoStatsb(marpaWrapperAsfp, &(phasep->memoLookupl), &(phasep->memoHitl))) {
+      rcb = 0;
+    }
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = benchContext.glades;
+  if (marpaWrapperArenap == NULL) {
+    phasep->allocationsl = benchCount.allocationsl;
+    phasep->peakBytesl   = benchCount.peakBytesl - startBytesl;
+  }
+
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  if ((marpaWrapperArenap != NULL) && (! marpaWrapperArena_resetb(marpaWrapperArenap))) {
+    rcb = 0;
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short benchAsfValuePhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip, short okCacheb, size_t maxBytesl, benchAsfReject_t rejecti)
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                   0    /* disableThresholdb */,
+                                                                   0    /* exhaustionEventb */,
+                                                                   NULL /* allocatorp */
+  };
+  marpaWrapperAsfOption_t         marpaWrapperAsfOption        = { NULL /* genericLoggerp */,
+                                                                   0    /* highRankOnlyb */,
+                                                                   0    /* orderByRankb */,
+                                                                   1    /* ambiguousb */,
+                                                                   0    /* maxParsesi */,
+                                                                   0    /* okCacheb */,
+                                                                   0    /* memob */,
+                                                                   0    /* maxBytesl */
+  };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperAsfValue_t         *marpaWrapperAsfValuep;
+  benchContext_t                  benchContext = { 0, 0, 0, -1 };
+  double                          startd;
+  short                           rcb = -1;
+
+  marpaWrapperAsfOption.maxParsesi   = scenariop->maxTreesi;
+  marpaWrapperAsfOption.okCacheb = okCacheb;
+  marpaWrapperAsfOption.maxBytesl    = maxBytesl;
+  if ((rejecti != BENCH_ASF_ACCEPT) && (scenariop->typei == BENCH_AMBIGUOUS)) {
+    benchContext.rejectSymboli = symbolip[PHOSPHORUS];
+  }
+
+  /* Recognition of the ASF input is not part of the measure */
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 0;
+  }
+  if (! benchReadb(scenariop, marpaWrapperRecognizerp, symbolip, scenariop->nasfTokeni)) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    return 0;
+  }
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  marpaWrapperAsfValuep = marpaWrapperAsfValue_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+  if ((marpaWrapperAsfValuep != NULL) && (rejecti == BENCH_ASF_PRUNE)) {
+    if (! marpaWrapperAsf_pruneb(marpaWrapperAsfValue_asfp(marpaWrapperAsfValuep),
+                                 &benchContext,
+                                 okRuleCallback,
+                                 okSymbolCallback,
+                                 okNullingCallback,
+                                 &(phasep->deadFactoringl))) {
+      marpaWrapperAsfValue_freev(marpaWrapperAsfValuep);
+      marpaWrapperAsfValuep = NULL;
+    }
+  }
+  if (marpaWrapperAsfValuep != NULL) {
+    while ((rcb = marpaWrapperAsfValue_valueb(marpaWrapperAsfValuep,
+                                              &benchContext,
+                                              okRuleCallback,
+                                              okSymbolCallback,
+                                              okNullingCallback,
+                                              valueRuleCallback,
+                                              valueSymbolCallback,
+                                              valueNullingCallback)) > 0) {
+      phasep->treesl++;
+    }
+    if (! marpaWrapperAsf_evictionStatsb(marpaWrapperAsfValue_asfp(marpaWrapperAsfValuep), &(phasep->evictionl), &(phasep->rebuildl), &(phasep->contentBytesl))) {
+      rcb = -1;
+    }
+    marpaWrapperAsfValue_freev(marpaWrapperAsfValuep);
+  }
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = benchContext.steps;
+  phasep->okCallsl   = benchContext.okCalls;
+
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  return (rcb < 0) ? 0 : 1;
+}
+
+/****************************************************************************/
+static short benchAsfStatsPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                   0    /* disableThresholdb */,
+                                                                   0    /* exhaustionEventb */,
+                                                                   NULL /* allocatorp */
+  };
+  marpaWrapperAsfOption_t         marpaWrapperAsfOption        = { NULL /* genericLoggerp */,
+                                                                   0    /* highRankOnlyb */,
+                                                                   0    /* orderByRankb */,
+                                                                   1    /* ambiguousb */,
+                                                                   0    /* maxParsesi */,
+                                                                   0    /* okCacheb */,
+                                                                   0    /* memob */,
+                                                                   0    /* maxBytesl */
+  };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperAsf_t              *marpaWrapperAsfp;
+  marpaWrapperAsfStats_t          marpaWrapperAsfStats;
+  double                          startd;
+  short                           rcb = 0;
+
+  /* Recognition of the ASF input is not part of the measure */
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 0;
+  }
+  if (! benchReadb(scenariop, marpaWrapperRecognizerp, symbolip, scenariop->nasfTokeni)) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    return 0;
+  }
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+  if (marpaWrapperAsfp != NULL) {
+    rcb = marpaWrapperAsf_statsb(marpaWrapperAsfp, &marpaWrapperAsfStats, NULL, 0, NULL);
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  if (rcb) {
+    phasep->counterl        = (long) marpaWrapperAsfStats.nGladel;
+    phasep->treesl          = (marpaWrapperAsfStats.nTreel > (size_t) LONG_MAX) ? LONG_MAX : (long) marpaWrapperAsfStats.nTreel;
+    phasep->treesSaturatedb = marpaWrapperAsfStats.treesSaturatedb || (marpaWrapperAsfStats.nTreel > (size_t) LONG_MAX);
+    phasep->ambiguousGladel = marpaWrapperAsfStats.nAmbiguousGladel;
+  }
+
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short benchAsfKbestPhaseb(benchScenario_t *scenariop, benchPhase_t *phasep, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL /* genericLoggerp */,
+                                                                   0    /* disableThresholdb */,
+                                                                   0    /* exhaustionEventb */,
+                                                                   NULL /* allocatorp */
+  };
+  marpaWrapperAsfOption_t         marpaWrapperAsfOption        = { NULL /* genericLoggerp */,
+                                                                   0    /* highRankOnlyb */,
+                                                                   0    /* orderByRankb */,
+                                                                   1    /* ambiguousb */,
+                                                                   0    /* maxParsesi */,
+                                                                   0    /* okCacheb */,
+                                                                   0    /* memob */,
+                                                                   0    /* maxBytesl */
+  };
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperAsf_t              *marpaWrapperAsfp;
+  benchContext_t                  benchContext = { 0, 0, 0, -1 };
+  double                          startd;
+  int                             nTreei;
+  int                             treei;
+  int                             scorei;
+  short                           rcb = 0;
+
+  /* Recognition of the ASF input is not part of the measure */
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    return 0;
+  }
+  if (! benchReadb(scenariop, marpaWrapperRecognizerp, symbolip, scenariop->nasfTokeni)) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    return 0;
+  }
+
+  benchPeakRssResetv();
+  startd = benchNowd();
+  marpaWrapperAsfp = marpaWrapperAsf_newp(marpaWrapperRecognizerp, &marpaWrapperAsfOption);
+  if (marpaWrapperAsfp != NULL) {
+    rcb = marpaWrapperAsf_kbestb(marpaWrapperAsfp, scenariop->maxTreesi, NULL, tokenScoreCallback, &nTreei);
+    for (treei = 0; rcb && (treei < nTreei); treei++) {
+      rcb = marpaWrapperAsf_kbest_valueb(marpaWrapperAsfp,
+                                         treei,
+                                         &benchContext,
+                                         valueRuleCallback,
+                                         valueSymbolCallback,
+                                         valueNullingCallback,
+                                         &scorei);
+      phasep->treesl++;
+    }
+    if (! marpaWrapperAsf_kbestStatsb(marpaWrapperAsfp, NULL, &(phasep->derivationl))) {
+      rcb = 0;
+    }
+    marpaWrapperAsf_freev(marpaWrapperAsfp);
+  }
+  phasep->secondsd   = benchNowd() - startd;
+  phasep->peakRssKbl = benchPeakRssKbl();
+  phasep->counterl   = benchContext.steps;
+
+  marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni)
+/****************************************************************************/
+{
+  ((benchContext_t *) userDatavp)->okCalls++;
+  return 1;
+}
+
+/****************************************************************************/
+static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi)
+/****************************************************************************/
+{
+  benchContext_t *benchContextp = (benchContext_t *) userDatavp;
+
+  benchContextp->okCalls++;
+  return (symboli == benchContextp->rejectSymboli) ? -1 : 1;
+}
+
+/****************************************************************************/
+static short okNullingCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli)
+/****************************************************************************/
+{
+  ((benchContext_t *) userDatavp)->okCalls++;
+  return 1;
+}
+
+/****************************************************************************/
+static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  ((benchContext_t *) userDatavp)->steps++;
+  return 1;
+}
+
+/****************************************************************************/
+static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  ((benchContext_t *) userDatavp)->steps++;
+  return 1;
+}
+
+/****************************************************************************/
+static short valueNullingCallback(void *userDatavp, int symboli, int resulti)
+/****************************************************************************/
+{
+  ((benchContext_t *) userDatavp)->steps++;
+  return 1;
+}
+
+/****************************************************************************/
+static short tokenScoreCallback(void *userDatavp, int symboli, int argi, int *scoreip)
+/****************************************************************************/
+{
+  *scoreip = symboli;
+  return 1;
+}
+
+/****************************************************************************/
+static void *benchCountMallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+{
+  return benchCountReallocp(userDatavp, NULL, sizel);
+}
+
+/****************************************************************************/
+static void *benchCountReallocp(void *userDatavp, void *ptr, size_t sizel)
+/****************************************************************************/
+{
+  benchCount_t       *benchCountp = (benchCount_t *) userDatavp;
+  benchCountHeader_t *headerp     = (ptr != NULL) ? (((benchCountHeader_t *) ptr) - 1) : NULL;
+  size_t              oldSizel    = (headerp != NULL) ? headerp->sizel : 0;
+
+  benchCountp->allocationsl++;
+  headerp = (benchCountHeader_t *) realloc(headerp, sizeof(benchCountHeader_t) + sizel);
+  if (headerp == NULL) {
+    return NULL;
+  }
+  headerp->sizel = sizel;
+  benchCountp->bytesl += sizel;
+  benchCountp->bytesl -= oldSizel;
+  if (benchCountp->bytesl > benchCountp->peakBytesl) {
+    benchCountp->peakBytesl = benchCountp->bytesl;
+  }
+  return (void *) (headerp + 1);
+}
+
+/****************************************************************************/
+static void benchCountFreev(void *userDatavp, void *ptr)
+/****************************************************************************/
+{
+  benchCount_t       *benchCountp = (benchCount_t *) userDatavp;
+  benchCountHeader_t *headerp;
+
+  if (ptr != NULL) {
+    headerp = ((benchCountHeader_t *) ptr) - 1;
+    benchCountp->bytesl -= headerp->sizel;
+    free(headerp);
+  }
+}
+
+/****************************************************************************/
+static short countTraverserCallbacki(marpaWrapperAsfTraverser_t *traverserp, void *userDatavp, int *valueip)
+/****************************************************************************/
+/* Visits every symch and every factoring of the glade, and every RHS of    */
+/* every factoring.                                                         */
+/****************************************************************************/
+{
+  benchContext_t *benchContextp = (benchContext_t *) userDatavp;
+  int             ruleIdi;
+  int             lengthi;
+  int             rhIxi;
+  int             rhValuei;
+  short           nextb;
+
+  benchContextp->glades++;
+
+  while (1) {
+    if (! marpaWrapperAsf_traverse_ruleIdb(traverserp, &ruleIdi)) {
+      return 0;
+    }
+    if (ruleIdi >= 0) {
+      lengthi = marpaWrapperAsf_traverse_rh_lengthi(traverserp);
+      if (lengthi < 0) {
+        return 0;
+      }
+      for (rhIxi = 0; rhIxi < lengthi; rhIxi++) {
+        if (! marpaWrapperAsf_traverse_rh_valueb(traverserp, rhIxi, &rhValuei, NULL)) {
+          return 0;
+        }
+      }
+    }
+    if (! marpaWrapperAsf_traverse_nextb(traverserp, &nextb)) {
+      return 0;
+    }
+    if (! nextb) {
+      break;
+    }
+  }
+
+  *valueip = 0;
+  return 1;
+}
+
+/****************************************************************************/
+static void benchJsonPhasev(FILE *fp, char *names, benchPhase_t *phasep, char *counters, char *rates, short lastb)
+/****************************************************************************/
+{
+  fprintf(fp, "        \"%s\": { \"seconds\": %.6f, \"peakRssKb\": %ld", names, phasep->secondsd, phasep->peakRssKbl);
+  if (counters != NULL) {
+    fprintf(fp, ", \"%s\": %ld, \"%s\": %.1f",
+            counters,
+            phasep->counterl,
+            rates,
+            (phasep->secondsd > 0.) ? ((double) phasep->counterl / phasep->secondsd) : 0.);
+  }
+  if (phasep->treesl > 0) {
+    fprintf(fp, ", \"trees\": %ld", phasep->treesl);
+  }
+  if (phasep->okCallsl > 0) {
+    fprintf(fp, ", \"okCalls\": %ld", phasep->okCallsl);
+  }
+  if (phasep->allocationsl > 0) {
+    fprintf(fp, ", \"allocations\": %ld, \"allocationsPerGlade\": %.2f",
+            phasep->allocationsl,
+            (phasep->counterl > 0) ? ((double) phasep->allocationsl / (double) phasep->counterl) : 0.);
+  }
+  if (phasep->peakBytesl > 0) {
+    fprintf(fp, ", \"peakBytes\": %lu, \"bytesPerGlade\": %.1f",
+            (unsigned long) phasep->peakBytesl,
+            (phasep->counterl > 0) ? ((double) phasep->peakBytesl / (double) phasep->counterl) : 0.);
+  }
+  if (phasep->lookupl > 0) {
+    fprintf(fp, ", \"intsets\": %lu, \"intsetLookups\": %lu, \"intsetProbes\": %lu, \"intsetMaxProbe\": %lu, \"intsetCollisions\": %lu",
+            (unsigned long) phasep->intsetl,
+            (unsigned long) phasep->lookupl,
+            (unsigned long) phasep->probel,
+            (unsigned long) phasep->maxProbel,
+            (unsigned long) phasep->collisionl);
+  }
+  if (phasep->memoLookupl > 0) {
+    fprintf(fp, ", \"memoLookups\": %lu, \"memoHits\": %lu, \"memoHitRate\": %.3f",
+            (unsigned long) phasep->memoLookupl,
+            (unsigned long) phasep->memoHitl,
+            (double) phasep->memoHitl / (double) phasep->memoLookupl);
+  }
+  if (phasep->contentBytesl > 0) {
+    fprintf(fp, ", \"evictions\": %lu, \"rebuilds\": %lu, \"contentBytes\": %lu",
+            (unsigned long) phasep->evictionl,
+            (unsigned long) phasep->rebuildl,
+            (unsigned long) phasep->contentBytesl);
+  }
+  if (phasep->derivationl > 0) {
+    fprintf(fp, ", \"derivations\": %lu", (unsigned long) phasep->derivationl);
+  }
+  if (phasep->deadFactoringl > 0) {
+    fprintf(fp, ", \"deadFactorings\": %lu", (unsigned long) phasep->deadFactoringl);
+  }
+  if (phasep->treesSaturatedb) {
+    fprintf(fp, ", \"treesSaturated\": true");
+  }
+  if (phasep->perTreeMicrosecondsd > 0.) {
+    fprintf(fp, ", \"microsecondsPerTree\": %.3f", phasep->perTreeMicrosecondsd);
+  }
+  if (phasep->valuatorAllocationl > 0) {
+    fprintf(fp, ", \"valuatorAllocations\": %lu, \"valuatorReuses\": %lu", (unsigned long) phasep->valuatorAllocationl, (unsigned long) phasep->valuatorReusel);
+  }
+  if (phasep->imageBytesl > 0) {
+    fprintf(fp, ", \"imageBytes\": %lu", (unsigned long) phasep->imageBytesl);
+  }
+  if (phasep->ambiguousGladel > 0) {
+    fprintf(fp, ", \"ambiguousGlades\": %lu", (unsigned long) phasep->ambiguousGladel);
+  }
+  fprintf(fp, " }%s\n", lastb ? "" : ",");
+}
@@ -0,0 +1,268 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number
+
+  1 - 2 * 3 has two trees.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+typedef struct treesContext {
+  char   s[1024];
+  size_t usedl;
+} treesContext_t;
+
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static int   parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp);
+
+/* All the trees of an ambiguous input, in parse order */
+static marpaWrapperValueOption_t treesValueOption = {
+  NULL, /* genericLoggerp */
+  0,    /* highRankOnlyb */
+  0,    /* orderByRankb */
+  1,    /* ambiguousb */
+  0,    /* nullb */
+  0,    /* maxParsesi */
+  0     /* reuseValuatorb */
+};
+
+int main(int argc, char **argv) {
+  genericLogger_t                *genericLoggerp               = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp         = NULL;
+  marpaWrapperRecognizerPool_t   *marpaWrapperRecognizerPoolp  = NULL;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizer1p     = NULL;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizer2p     = NULL;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizer3p     = NULL;
+  marpaWrapperRecognizer_t       *warmRecognizerp;
+  marpaWrapperValue_t            *marpaWrapperValuep;
+  treesContext_t                  firstTrees;
+  treesContext_t                  trees;
+  size_t                          firstTreel;
+  size_t                          treel;
+  size_t                          hitl;
+  size_t                          missl;
+  size_t                          warml;
+  int                             symbolip[MAX_SYMBOL];
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  /* A pool of at most one warm recognizer */
+  if (rci == 0) {
+    marpaWrapperRecognizerPoolp = marpaWrapperRecognizerPool_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption, 1);
+    if (marpaWrapperRecognizerPoolp == NULL) {
+      rci = 1;
+    }
+  }
+
+  /* Two misses: the first release keeps a warm recognizer, the second one is over the cap and frees it */
+  if (rci == 0) {
+    marpaWrapperRecognizer1p = marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPoolp);
+    marpaWrapperRecognizer2p = marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPoolp);
+    if ((marpaWrapperRecognizer1p == NULL) || (marpaWrapperRecognizer2p == NULL)) {
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    rci = parseTrees(marpaWrapperRecognizer1p, symbolip, &firstTrees, &firstTreel);
+  }
+  if ((rci == 0) && (firstTreel != 2)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%ld trees instead of 2", (unsigned long) firstTreel);
+    rci = 1;
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, marpaWrapperRecognizer1p) == 0) {
+      rci = 1;
+    } else {
+      warmRecognizerp          = marpaWrapperRecognizer1p;
+      marpaWrapperRecognizer1p = NULL;
+    }
+  }
+
+  /* The warm recognizer belongs to the pool: releasing it again is an error that leaves the pool as it is */
+  if (rci == 0) {
+    errno = 0;
+    if ((marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, warmRecognizerp) != 0) || (errno != EINVAL)) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Warm recognizer was released twice");
+      rci = 1;
+    }
+  }
+
+  if (rci == 0) {
+    if (marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, marpaWrapperRecognizer2p) == 0) {
+      rci = 1;
+    } else {
+      marpaWrapperRecognizer2p = NULL;
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizerPool_statsb(marpaWrapperRecognizerPoolp, &hitl, &missl, &warml) == 0) {
+      rci = 1;
+    } else if ((hitl != 0) || (missl != 2) || (warml != 1)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%ld hits, %ld misses, %ld warm instead of 0, 2, 1", (unsigned long) hitl, (unsigned long) missl, (unsigned long) warml);
+      rci = 1;
+    }
+  }
+
+  /* A hit gives the warm recognizer at the start of input, that parses the same trees */
+  if (rci == 0) {
+    marpaWrapperRecognizer3p = marpaWrapperRecognizerPool_getp(marpaWrapperRecognizerPoolp);
+    if (marpaWrapperRecognizer3p == NULL) {
+      rci = 1;
+    } else if (marpaWrapperRecognizer3p != warmRecognizerp) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Hit did not give the warm recognizer");
+      rci = 1;
+    } else {
+      rci = parseTrees(marpaWrapperRecognizer3p, symbolip, &trees, &treel);
+    }
+  }
+  if (rci == 0) {
+    if ((treel != firstTreel) || (strcmp(firstTrees.s, trees.s) != 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%ld trees \"%s\" instead of %ld trees \"%s\"", (unsigned long) treel, trees.s, (unsigned long) firstTreel, firstTrees.s);
+      rci = 1;
+    }
+  }
+
+  /* A recognizer with a value alive cannot be released, and is left to the caller */
+  if (rci == 0) {
+    marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizer3p, &treesValueOption);
+    if (marpaWrapperValuep == NULL) {
+      rci = 1;
+    } else {
+      errno = 0;
+      if ((marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, marpaWrapperRecognizer3p) != 0) || (errno != EBUSY)) {
+        GENERICLOGGER_ERROR(genericLoggerp, "Recognizer was released while a value is alive");
+        marpaWrapperRecognizer3p = NULL;
+        rci = 1;
+      }
+      marpaWrapperValue_freev(marpaWrapperValuep);
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizerPool_releaseb(marpaWrapperRecognizerPoolp, marpaWrapperRecognizer3p) == 0) {
+      rci = 1;
+    } else {
+      marpaWrapperRecognizer3p = NULL;
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizerPool_statsb(marpaWrapperRecognizerPoolp, &hitl, &missl, &warml) == 0) {
+      rci = 1;
+    } else if ((hitl != 1) || (missl != 2) || (warml != 1)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%ld hits, %ld misses, %ld warm instead of 1, 2, 1", (unsigned long) hitl, (unsigned long) missl, (unsigned long) warml);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%ld hits, %ld misses, %ld warm, same %ld trees", (unsigned long) hitl, (unsigned long) missl, (unsigned long) warml, (unsigned long) treel);
+    }
+  }
+
+  if (marpaWrapperRecognizer1p != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizer1p);
+  }
+  if (marpaWrapperRecognizer2p != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizer2p);
+  }
+  if (marpaWrapperRecognizer3p != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizer3p);
+  }
+  if (marpaWrapperRecognizerPoolp != NULL) {
+    marpaWrapperRecognizerPool_freev(marpaWrapperRecognizerPoolp);
+  }
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "R%d[%d..%d]->%d ", rulei, arg0i, argni, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "T%d[%d]->%d ", symboli, argi, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static int parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp)
+/****************************************************************************/
+/* Reads 1 - 2 * 3 and writes all its trees, as seen by the callbacks, in   */
+/* treesContextp->s. The value instance is freed before returning.          */
+/****************************************************************************/
+{
+  marpaWrapperValue_t       *marpaWrapperValuep;
+  short                      valueb;
+  int                        i;
+
+  treesContextp->s[0] = '\0';
+  treesContextp->usedl = 0;
+  *nTreelp             = 0;
+
+  for (i = 1; i <= 5; i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      return 1;
+    }
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &treesValueOption);
+  if (marpaWrapperValuep == NULL) {
+    return 1;
+  }
+  while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, (void *) treesContextp, treesRuleCallback, treesSymbolCallback, NULL)) > 0) {
+    (*nTreelp)++;
+    if (treesContextp->usedl + 2 >= sizeof(treesContextp->s)) {
+      valueb = -1;
+      break;
+    }
+    treesContextp->s[treesContextp->usedl++] = '|';
+    treesContextp->s[treesContextp->usedl]   = '\0';
+  }
+  marpaWrapperValue_freev(marpaWrapperValuep);
+
+  return (valueb < 0) ? 1 : 0;
+}
@@ -0,0 +1,228 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <pthread.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  S ::= E
+  E ::= E op E
+  E ::= number
+
+  E has a completion event. number op number op ... op number is ambiguous: there are Catalan(n-1) trees with n numbers.
+*/
+enum { S = 0, E, op, number, MAX_SYMBOL };
+
+#define NNUMBER  7
+#define NTREE    132 /* Catalan(6) */
+#define NTHREAD  8
+#define NPARSE   20  /* Per thread */
+
+typedef struct parseJob {
+  marpaWrapperGrammar_t *marpaWrapperGrammarp;
+  int                   *symbolip;
+  short                  okb;
+  size_t                 nEventl;     /* Completion events, on all parses */
+  size_t                 nTreel;      /* Trees, on all parses */
+  size_t                 nRejectedl;  /* Rejected tokens seen with their own error, on all parses */
+} parseJob_t;
+
+static void  *parseThreadp(void *userDatavp);
+static short  parseb(parseJob_t *parseJobp);
+static short  ruleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short  symbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static short  nullingCallback(void *userDatavp, int symboli, int resulti);
+
+int main(int argc, char **argv) {
+  genericLogger_t       *genericLoggerp       = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  marpaWrapperGrammar_t *marpaWrapperGrammarp = NULL;
+  int                    symbolip[MAX_SYMBOL];
+  parseJob_t             jobs[NTHREAD];
+  pthread_t              threads[NTHREAD];
+  short                  startedb[NTHREAD];
+  int                    i;
+  int                    rci = 0;
+
+  /* One precomputed grammar, shared by all threads */
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if ((marpaWrapperGrammarp == NULL) ||
+      ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = marpaWrapperGrammar_newSymbolExti(marpaWrapperGrammarp, 0 /* terminalb */, 0 /* startb */, MARPAWRAPPERGRAMMAR_EVENTTYPE_COMPLETION)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    rci = 1;
+  }
+
+  /* Concurrent parses: none of them may see the events or the errors of another one */
+  if (rci == 0) {
+    for (i = 0; i < NTHREAD; i++) {
+      jobs[i].marpaWrapperGrammarp = marpaWrapperGrammarp;
+      jobs[i].symbolip             = symbolip;
+      startedb[i]                  = (pthread_create(&(threads[i]), NULL, parseThreadp, &(jobs[i])) == 0);
+      if (! startedb[i]) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: pthread_create failure", i);
+        rci = 1;
+      }
+    }
+    for (i = 0; i < NTHREAD; i++) {
+      if (! startedb[i]) {
+        continue;
+      }
+      if (pthread_join(threads[i], NULL) != 0) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: pthread_join failure", i);
+        rci = 1;
+        continue;
+      }
+      if ((! jobs[i].okb) ||
+          (jobs[i].nEventl    != NPARSE * NNUMBER) ||
+          (jobs[i].nTreel     != NPARSE * NTREE) ||
+          (jobs[i].nRejectedl != NPARSE)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Thread %d: status %d, %ld events, %ld trees, %ld rejections instead of 1, %ld, %ld, %ld",
+                             i,
+                             (int) jobs[i].okb, (unsigned long) jobs[i].nEventl, (unsigned long) jobs[i].nTreel, (unsigned long) jobs[i].nRejectedl,
+                             (unsigned long) (NPARSE * NNUMBER), (unsigned long) (NPARSE * NTREE), (unsigned long) NPARSE);
+        rci = 1;
+      }
+    }
+    if (rci == 0) {
+      GENERICLOGGER_INFOF(genericLoggerp, "%d threads sharing one grammar: %d parses each, %d events and %d trees per parse", NTHREAD, NPARSE, NNUMBER, NTREE);
+    }
+  }
+
+  if (marpaWrapperGrammarp != NULL) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+  }
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static void *parseThreadp(void *userDatavp)
+/****************************************************************************/
+{
+  parseJob_t *parseJobp = (parseJob_t *) userDatavp;
+  int         parsei;
+
+  parseJobp->okb        = 1;
+  parseJobp->nEventl    = 0;
+  parseJobp->nTreel     = 0;
+  parseJobp->nRejectedl = 0;
+
+  for (parsei = 0; parseJobp->okb && (parsei < NPARSE); parsei++) {
+    parseJobp->okb = parseb(parseJobp);
+  }
+
+  return NULL;
+}
+
+/****************************************************************************/
+static short parseb(parseJob_t *parseJobp)
+/****************************************************************************/
+/* One parse with its own recognizer: E is completed after every number, a */
+/* number after a number is rejected, and all the trees are valuated.      */
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t  *marpaWrapperRecognizerp = NULL;
+  marpaWrapperValue_t       *marpaWrapperValuep      = NULL;
+  marpaWrapperValueOption_t  marpaWrapperValueOption = { NULL,
+                                                         0 /* highRankOnlyb */,
+                                                         0 /* orderByRankb */,
+                                                         1 /* ambiguousb */,
+                                                         0 /* nullb */,
+                                                         0 /* maxParsesi */,
+                                                         0 /* reuseValuatorb */
+  };
+  int                       *symbolip                = parseJobp->symbolip;
+  marpaWrapperGrammarEvent_t *eventp;
+  size_t                     eventl;
+  size_t                     grammarEventl;
+  int                        marpaErrorCodei;
+  short                      valueb;
+  short                      rcb = 0;
+  int                        i;
+
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(parseJobp->marpaWrapperGrammarp, NULL);
+  if (marpaWrapperRecognizerp == NULL) {
+    goto done;
+  }
+
+  /* Token values are their positions, starting at 1 */
+  for (i = 1; i < 2 * NNUMBER; i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      goto done;
+    }
+    if (marpaWrapperRecognizer_eventb(marpaWrapperRecognizerp, &eventl, &eventp) == 0) {
+      goto done;
+    }
+    if ((i % 2) == 1) {
+      if ((eventl != 1) || (eventp[0].eventType != MARPAWRAPPERGRAMMAR_EVENT_COMPLETED) || (eventp[0].symboli != symbolip[E])) {
+        goto done;
+      }
+      /* The rejection is the only error of this recognizer, whatever the other threads do */
+      if (i == 1) {
+        if ((marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizerp, &marpaErrorCodei) == 0) || (marpaErrorCodei != 0 /* MARPA_ERR_NONE */)) {
+          goto done;
+        }
+        if ((marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizerp, symbolip[number], 0, 1) == 0) &&
+            (marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizerp, &marpaErrorCodei) != 0) &&
+            (marpaErrorCodei != 0 /* MARPA_ERR_NONE */)) {
+          parseJobp->nRejectedl++;
+        }
+      }
+    } else if (eventl != 0) {
+      goto done;
+    }
+    parseJobp->nEventl += eventl;
+  }
+
+  /* The shared grammar never gets the parse events */
+  if ((marpaWrapperGrammar_eventb(parseJobp->marpaWrapperGrammarp, &grammarEventl, NULL, 0 /* exhaustionEventb */, 0 /* forceReloadb */) == 0) || (grammarEventl != 0)) {
+    goto done;
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &marpaWrapperValueOption);
+  if (marpaWrapperValuep == NULL) {
+    goto done;
+  }
+  while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, NULL, ruleCallback, symbolCallback, nullingCallback)) > 0) {
+    parseJobp->nTreel++;
+  }
+  rcb = (valueb == 0);
+
+ done:
+  if (marpaWrapperValuep != NULL) {
+    marpaWrapperValue_freev(marpaWrapperValuep);
+  }
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+
+  return rcb;
+}
+
+/****************************************************************************/
+static short ruleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short symbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  return 1;
+}
+
+/****************************************************************************/
+static short nullingCallback(void *userDatavp, int symboli, int resulti)
+/****************************************************************************/
+{
+  return 1;
+}
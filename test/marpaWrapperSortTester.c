@@ -0,0 +1,104 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "marpaWrapper/internal/_sort.h"
+#include "genericLogger.h"
+
+/*
+  The sorts of the ASF intsets, checked against qsort():
+  - sorting networks: all the inputs of 0s and 1s, that is enough to prove a network (0-1 principle),
+  - all paths: random inputs of every size up to well above MARPAWRAPPERSORT_RADIX_MIN, with
+    duplicates, negative values, INT_MIN and INT_MAX.
+*/
+#define MAX_SIZE   (4 * MARPAWRAPPERSORT_RADIX_MIN)
+#define NRANDOM    20 /* Random inputs per size */
+
+static int   intCmpi(const void *p1, const void *p2);
+static short sameSortb(int *ip, size_t nl);
+
+int main(int argc, char **argv) {
+  genericLogger_t *genericLoggerp = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  int              ip[MAX_SIZE];
+  size_t           nl;
+  unsigned long    bitsl;
+  size_t           i;
+  int              randomi;
+  int              rci = 0;
+
+  /* Sorting networks */
+  for (nl = 2; (rci == 0) && (nl <= 16); nl++) {
+    for (bitsl = 0; bitsl < (1UL << nl); bitsl++) {
+      for (i = 0; i < nl; i++) {
+        ip[i] = (int) ((bitsl >> i) & 1);
+      }
+      if (! sameSortb(ip, nl)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Size %ld: 0-1 input 0x%lx is not sorted", (unsigned long) nl, bitsl);
+        rci = 1;
+        break;
+      }
+    }
+  }
+  if (rci == 0) {
+    GENERICLOGGER_INFO(genericLoggerp, "Sorting networks: all 0-1 inputs up to 16 elements are sorted");
+  }
+
+  /* All paths. The range of values is small for some inputs, to have duplicates */
+  srand(1);
+  for (nl = 0; (rci == 0) && (nl <= MAX_SIZE); nl++) {
+    for (randomi = 0; randomi < NRANDOM; randomi++) {
+      for (i = 0; i < nl; i++) {
+        switch (randomi % 4) {
+        case 0:
+          ip[i] = rand() % 8;
+          break;
+        case 1:
+          ip[i] = rand() - (RAND_MAX / 2);
+          break;
+        case 2:
+          ip[i] = (int) (nl - i);
+          break;
+        default:
+          ip[i] = ((rand() % 3) == 0) ? INT_MIN : (((rand() % 2) == 0) ? INT_MAX : rand());
+          break;
+        }
+      }
+      if (! sameSortb(ip, nl)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "Size %ld: random input No %d is not sorted", (unsigned long) nl, randomi);
+        rci = 1;
+        break;
+      }
+    }
+  }
+  if (rci == 0) {
+    GENERICLOGGER_INFOF(genericLoggerp, "All paths: random inputs up to %d elements are sorted", MAX_SIZE);
+  }
+
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static short sameSortb(int *ip, size_t nl)
+/****************************************************************************/
+{
+  int expectedip[MAX_SIZE];
+  int scratchip[MAX_SIZE];
+
+  memcpy(expectedip, ip, nl * sizeof(int));
+  qsort(expectedip, nl, sizeof(int), intCmpi);
+  _marpaWrapperSort_intv(ip, scratchip, nl);
+
+  return (memcmp(expectedip, ip, nl * sizeof(int)) == 0) ? 1 : 0;
+}
+
+/****************************************************************************/
+static int intCmpi(const void *p1, const void *p2)
+/****************************************************************************/
+{
+  int i1 = *((const int *) p1);
+  int i2 = *((const int *) p2);
+
+  return (i1 < i2) ? -1 : ((i1 > i2) ? 1 : 0);
+}
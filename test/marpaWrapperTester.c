@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <errno.h>
 #include "marpaWrapper.h"
 #include "genericLogger.h"
@@ -19,6 +20,24 @@ typedef struct valueContext {
   genericLogger_t          *genericLoggerp;
 } valueContext_t;
 
+typedef struct nestedContext {
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  int                      *symbolip;
+  int                       nReadi;
+} nestedContext_t;
+
+typedef struct treesContext {
+  char   s[1024];
+  size_t usedl;
+} treesContext_t;
+
+typedef struct readManyContext {
+  short  stopOnEventb;
+  short  stopOnRejectionb;
+  size_t nEventCalll;
+  size_t nRejectedl;
+} readManyContext_t;
+
 static char *symbolDescription(void *userDatavp, int symboli);
 static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
 static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
@@ -29,6 +48,45 @@ static short ruleOptionSetter(void *userDatavp, int symboli, marpaWrapperGrammar
 static short okRuleCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int rulei, int arg0i, int argni);
 static short okSymbolCallback(void *userDatavp, genericStack_t *parentRuleiStackp, int symboli, int argi);
 static int   checkEarlemes(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, genericLogger_t *genericLoggerp);
+static marpaWrapperGrammar_t *eventGrammarp(int *symbolip);
+static int   checkEventCounts(char *whats, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t expectedl, genericLogger_t *genericLoggerp);
+static int   checkEvents(genericLogger_t *genericLoggerp);
+static short readManyCallback(void *userDatavp, size_t tokenl, short rejectedb, size_t eventl, marpaWrapperGrammarEvent_t *eventp);
+static short nestedReadManyCallback(void *userDatavp, size_t tokenl, short rejectedb, size_t eventl, marpaWrapperGrammarEvent_t *eventp);
+static int   checkNestedAllocators(genericLogger_t *genericLoggerp);
+static int   checkReadMany(char *whats, marpaWrapperRecognizerToken_t *tokenp, size_t tokenl, short stopOnEventb, short stopOnRejectionb, size_t expectedReadl, size_t expectedEventCalll, size_t expectedRejectedl, int expectedEarlemei, genericLogger_t *genericLoggerp);
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static int   parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp);
+static int   checkReset(genericLogger_t *genericLoggerp);
+static void *accountingMallocp(void *userDatavp, size_t sizel);
+static void *accountingReallocp(void *userDatavp, void *p, size_t sizel);
+static void  accountingFreev(void *userDatavp, void *p);
+
+/* Counts blocks given by the allocator to the grammars, and everything derived from them */
+typedef struct accounting {
+  size_t nAllocl;
+  size_t nLivel;
+} accounting_t;
+
+static accounting_t            accounting = { 0, 0 };
+static marpaWrapperAllocator_t accountingAllocator = {
+  &accounting,
+  accountingMallocp,
+  accountingReallocp,
+  accountingFreev
+};
+
+/* All the trees of an ambiguous input, in parse order */
+static marpaWrapperValueOption_t treesValueOption = {
+  NULL, /* genericLoggerp */
+  0,    /* highRankOnlyb */
+  0,    /* orderByRankb */
+  1,    /* ambiguousb */
+  0,    /* nullb */
+  0,    /* maxParsesi */
+  0     /* reuseValuatorb */
+};
 
 static marpaWrapperGrammarCloneOption_t marpaWrapperGrammarCloneOption = {
   NULL, /* userDatavp */
@@ -70,23 +128,29 @@ int main(int argc, char **argv)
 								  0 /* warningIsErrorb */,
 								  0 /* warningIsIgnoredb */,
 								  0 /* autorankb */,
+								  &accountingAllocator
   };
   marpaWrapperRecognizerOption_t marpaWrapperRecognizerOption = { GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_TRACE),
 								  0, /* disableThresholdb */
-								  0 /* exhaustion */
+								  0 /* exhaustion */,
+								  NULL /* allocatorp */
   };
   marpaWrapperValueOption_t      marpaWrapperValueOption      = { GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_TRACE),
 								  1 /* highRankOnlyb */,
 								  1 /* orderByRankb */,
 								  1 /* ambiguousb - We KNOW this test is ambiguous */,
 								  0 /* nullb */,
-								  0 /* maxParsesi */
+								  0 /* maxParsesi */,
+								  0 /* reuseValuatorb */
   };
   marpaWrapperAsfOption_t        marpaWrapperAsfOption        = { GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_TRACE),
 								  1 /* highRankOnlyb */,
 								  1 /* orderByRankb */,
 								  1 /* ambiguousb - We KNOW this test is ambiguous */,
-								  0 /* maxParsesi */
+								  0 /* maxParsesi */,
+								  0 /* okCacheb */,
+								  0 /* memob */,
+								  0 /* maxBytesl */
   };
 
   GENERICSTACK_NEW(valueContext.inputStackp);
@@ -133,6 +197,80 @@ int main(int argc, char **argv)
       }
     }
   }
+  if (rci == 0) {
+    /* We will work on the grammar restored from its serialized image */
+    marpaWrapperGrammar_t *marpaWrapperGrammarRestoredp;
+    char                  *bufferp;
+    size_t                 bufferl;
+
+    if (marpaWrapperGrammar_serializeb(marpaWrapperGrammarp, &bufferp, &bufferl) == 0) {
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(marpaWrapperGrammarOption.genericLoggerp, "Grammar serialized in %ld bytes", (unsigned long) bufferl);
+      {
+        /* Any single bit flip, header included, must be refused */
+        marpaWrapperGrammarOption_t quietGrammarOption = marpaWrapperGrammarOption;
+        size_t                      bitl;
+
+        quietGrammarOption.genericLoggerp = NULL;
+        for (bitl = 0; bitl < bufferl * 8; bitl++) {
+          bufferp[bitl / 8] ^= (char) (1 << (bitl % 8));
+          marpaWrapperGrammarRestoredp = marpaWrapperGrammar_deserializep(&quietGrammarOption, bufferp, bufferl);
+          bufferp[bitl / 8] ^= (char) (1 << (bitl % 8));
+          if (marpaWrapperGrammarRestoredp != NULL) {
+            GENERICLOGGER_ERRORF(marpaWrapperGrammarOption.genericLoggerp, "Grammar image with bit %ld flipped was accepted", (unsigned long) bitl);
+            marpaWrapperGrammar_freev(marpaWrapperGrammarRestoredp);
+            rci = 1;
+          }
+        }
+      }
+      marpaWrapperGrammarRestoredp = marpaWrapperGrammar_deserializep(&marpaWrapperGrammarOption, bufferp, bufferl);
+      free(bufferp);
+      if (marpaWrapperGrammarRestoredp == NULL) {
+	rci = 1;
+      } else {
+	marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+	marpaWrapperGrammarp = marpaWrapperGrammarRestoredp;
+      }
+    }
+  }
+  if (rci == 0) {
+    /* We will work on the grammar saved to and loaded back from a file */
+    marpaWrapperGrammar_t *marpaWrapperGrammarLoadedp;
+    char                  *filenames = "marpaWrapperTester.grammar";
+    char                  *bufferp   = NULL;
+    char                  *loadedp   = NULL;
+    size_t                 bufferl;
+    size_t                 loadedl;
+
+    if (marpaWrapperGrammar_saveb(marpaWrapperGrammarp, filenames) == 0) {
+      rci = 1;
+    } else {
+      marpaWrapperGrammarLoadedp = marpaWrapperGrammar_loadp(&marpaWrapperGrammarOption, filenames);
+      remove(filenames);
+      if (marpaWrapperGrammarLoadedp == NULL) {
+	rci = 1;
+      } else {
+	if ((marpaWrapperGrammar_serializeb(marpaWrapperGrammarp, &bufferp, &bufferl) == 0) ||
+	    (marpaWrapperGrammar_serializeb(marpaWrapperGrammarLoadedp, &loadedp, &loadedl) == 0)) {
+	  rci = 1;
+	} else if ((bufferl != loadedl) || (memcmp(bufferp, loadedp, bufferl) != 0)) {
+	  GENERICLOGGER_ERROR(marpaWrapperGrammarOption.genericLoggerp, "Grammar loaded from a file differs from the saved one");
+	  rci = 1;
+	} else {
+	  GENERICLOGGER_INFOF(marpaWrapperGrammarOption.genericLoggerp, "Grammar saved and loaded back in %ld bytes", (unsigned long) loadedl);
+	}
+	if (bufferp != NULL) {
+	  free(bufferp);
+	}
+	if (loadedp != NULL) {
+	  free(loadedp);
+	}
+	marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+	marpaWrapperGrammarp = marpaWrapperGrammarLoadedp;
+      }
+    }
+  }
   if (rci == 0) {
     if (marpaWrapperGrammar_eventb(marpaWrapperGrammarp, &neventl, NULL, 0 /* exhaustionEventb */, 0) == 0) {
       rci = 1;
@@ -383,6 +521,16 @@ int main(int argc, char **argv)
     }
   }
 
+  if (rci == 0) {
+    size_t completel;
+    size_t eventlessCompletel;
+    if (marpaWrapperRecognizer_completeStatsb(marpaWrapperRecognizerp, &completel, &eventlessCompletel) == 0) {
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(marpaWrapperRecognizerOption.genericLoggerp, "%ld earleme completions, %ld without event", (unsigned long) completel, (unsigned long) eventlessCompletel);
+    }
+  }
+
   if (rci == 0) {
     if (marpaWrapperRecognizer_event_onoffb(marpaWrapperRecognizerp, symbolip[S], MARPAWRAPPERGRAMMAR_EVENTTYPE_PREDICTION, 0) == 0) {
       rci = 1;
@@ -542,6 +690,58 @@ int main(int argc, char **argv)
   }
   GENERICLOGGER_FREE(marpaWrapperGrammarOption.genericLoggerp);
 
+  /* Events and errors of a parse, with several recognizers on one grammar */
+  if (rci == 0) {
+    rci = checkEvents(valueContext.genericLoggerp);
+  }
+
+  /* A callback that works with another allocator */
+  if (rci == 0) {
+    rci = checkNestedAllocators(valueContext.genericLoggerp);
+  }
+
+  /* Batched input */
+  if (rci == 0) {
+    /* 1 - 2 * 3 */
+    marpaWrapperRecognizerToken_t tokens[] = {
+      { number, 1, 1, 1 }, { op, 2, 1, 1 }, { number, 3, 1, 1 }, { op, 4, 1, 1 }, { number, 5, 1, 1 }
+    };
+    rci = checkReadMany("readMany", tokens, 5, 0, 0, 5, 3, 0, 5, valueContext.genericLoggerp);
+    if (rci == 0) {
+      rci = checkReadMany("readMany stopped on the first event", tokens, 5, 1, 0, 1, 1, 0, 1, valueContext.genericLoggerp);
+    }
+  }
+  if (rci == 0) {
+    /* An unexpected op, a number, then an unexpected number */
+    marpaWrapperRecognizerToken_t tokens[] = {
+      { op, 1, 1, 0 }, { number, 2, 1, 1 }, { number, 3, 1, 0 }
+    };
+    rci = checkReadMany("readMany with rejections", tokens, 3, 0, 0, 3, 1, 2, 1, valueContext.genericLoggerp);
+    if (rci == 0) {
+      rci = checkReadMany("readMany stopped on the first rejection", tokens, 3, 0, 1, 0, 0, 1, 0, valueContext.genericLoggerp);
+    }
+  }
+  if (rci == 0) {
+    /* Two numbers at the same earleme, of length 1 and 2: stopping on the event of the first */
+    /* completion still does the second one.                                                  */
+    marpaWrapperRecognizerToken_t tokens[] = {
+      { number, 1, 1, 0 }, { number, 2, 2, 2 }, { op, 3, 1, 1 }
+    };
+    rci = checkReadMany("readMany stopped inside a token", tokens, 3, 1, 0, 2, 1, 0, 2, valueContext.genericLoggerp);
+  }
+
+  /* Recognizer reuse */
+  if (rci == 0) {
+    rci = checkReset(valueContext.genericLoggerp);
+  }
+
+  if ((accounting.nAllocl <= 0) || (accounting.nLivel != 0)) {
+    GENERICLOGGER_ERRORF(valueContext.genericLoggerp, "Accounting allocator: %ld blocks given, %ld not released", (unsigned long) accounting.nAllocl, (unsigned long) accounting.nLivel);
+    rci = 1;
+  } else {
+    GENERICLOGGER_INFO(valueContext.genericLoggerp, "Accounting allocator: all blocks released");
+  }
+
   GENERICLOGGER_FREE(valueContext.genericLoggerp);
 
   /* Input stack has no inner PTR */
@@ -637,7 +837,7 @@ static short valueRuleCallback(void *userDatavp, int rulei, int arg0i, int argni
       char                        var2c = GENERICSTACK_GET_CHAR(outputStackp, arg0i+1);
       stackValueAndDescription_t *var3p = (stackValueAndDescription_t *) GENERICSTACK_GET_PTR(outputStackp,  arg0i+2);
 
-      sprintf(resultp->s, "(%s %c %s)", var1p->s, var2c, var3p->s);
+      snprintf(resultp->s, sizeof(resultp->s), "(%s %c %s)", var1p->s, var2c, var3p->s);
       switch (var2c) {
       case '+':
 	resultp->i = var1p->i + var3p->i;
@@ -767,7 +967,7 @@ static short valueSymbolCallback(void *userDatavp, int symboli, int argi, int re
       }
 
       resultp->i = vari;
-      sprintf(resultp->s, "%d", vari);
+      snprintf(resultp->s, sizeof(resultp->s), "%d", vari);
       GENERICLOGGER_TRACEF(genericLoggerp, "[%s][%s] number: value %d at input stack No %d -> {s=%s,i=%d} at output stack No %d", modes, funcs, vari, argi, resultp->s, resultp->i, resulti);
 
       if (GENERICSTACK_IS_PTR(outputStackp, resulti)) {
@@ -941,3 +1141,504 @@ static int checkEarlemes(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, gene
   return rci;
 }
 
+/****************************************************************************/
+static marpaWrapperGrammar_t *eventGrammarp(int *symbolip)
+/****************************************************************************/
+/* Same grammar as in main, with a completion event on E                    */
+/****************************************************************************/
+{
+  marpaWrapperGrammarOption_t  marpaWrapperGrammarOption = { NULL, 0, 0, 0, &accountingAllocator };
+  marpaWrapperGrammar_t       *marpaWrapperGrammarp;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(&marpaWrapperGrammarOption);
+  if (marpaWrapperGrammarp == NULL) {
+    return NULL;
+  }
+  if (((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[     E] = marpaWrapperGrammar_newSymbolExti(marpaWrapperGrammarp, 0, 0, MARPAWRAPPERGRAMMAR_EVENTTYPE_COMPLETION)) < 0) ||
+      ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) < 0) ||
+      (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) < 0) ||
+      (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+    return NULL;
+  }
+
+  return marpaWrapperGrammarp;
+}
+
+/****************************************************************************/
+static int checkEventCounts(char *whats, marpaWrapperGrammar_t *marpaWrapperGrammarp, marpaWrapperRecognizer_t *marpaWrapperRecognizerp, size_t expectedl, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Parse events are in the recognizer only: the grammar, that is shared by */
+/* all its recognizers, never reports them.                                 */
+/****************************************************************************/
+{
+  size_t                      eventl;
+  size_t                      grammarEventl;
+  marpaWrapperGrammarEvent_t *eventp;
+
+  if ((marpaWrapperRecognizer_eventb(marpaWrapperRecognizerp, &eventl, &eventp) == 0) ||
+      (marpaWrapperGrammar_eventb(marpaWrapperGrammarp, &grammarEventl, NULL, 0 /* exhaustionEventb */, 0 /* forceReloadb */) == 0)) {
+    return 1;
+  }
+  if ((eventl != expectedl) || (grammarEventl != 0)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld recognizer events and %ld grammar events instead of %ld and 0", whats, (unsigned long) eventl, (unsigned long) grammarEventl, (unsigned long) expectedl);
+    return 1;
+  }
+  if ((eventl > 0) && (eventp[0].eventType != MARPAWRAPPERGRAMMAR_EVENT_COMPLETED)) {
+    GENERICLOGGER_ERRORF(genericLoggerp, "%s: first event is not a completion", whats);
+    return 1;
+  }
+
+  GENERICLOGGER_INFOF(genericLoggerp, "%s: %ld events", whats, (unsigned long) eventl);
+  return 0;
+}
+
+/****************************************************************************/
+static int checkEvents(genericLogger_t *genericLoggerp)
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizer1p = NULL;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizer2p = NULL;
+  int                             symbolip[MAX_SYMBOL];
+  int                             marpaErrorCodei;
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = eventGrammarp(symbolip);
+  if (marpaWrapperGrammarp == NULL) {
+    return 1;
+  }
+
+  marpaWrapperRecognizer1p = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  marpaWrapperRecognizer2p = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if ((marpaWrapperRecognizer1p == NULL) || (marpaWrapperRecognizer2p == NULL)) {
+    rci = 1;
+  }
+
+  /* 1 - 2: E is completed on the first and the last tokens */
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizer1p, symbolip[number], 1, 1) == 0) {
+      rci = 1;
+    } else {
+      rci = checkEventCounts("number", marpaWrapperGrammarp, marpaWrapperRecognizer1p, 1, genericLoggerp);
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizer1p, symbolip[op], 2, 1) == 0) {
+      rci = 1;
+    } else {
+      rci = checkEventCounts("number op", marpaWrapperGrammarp, marpaWrapperRecognizer1p, 0, genericLoggerp);
+    }
+  }
+
+  /* Another recognizer on the same grammar does not touch the events of the first one */
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizer2p, symbolip[number], 1, 1) == 0) {
+      rci = 1;
+    } else {
+      rci = checkEventCounts("Second recognizer: number", marpaWrapperGrammarp, marpaWrapperRecognizer2p, 1, genericLoggerp);
+    }
+  }
+  if (rci == 0) {
+    size_t eventl;
+    if (marpaWrapperRecognizer_eventb(marpaWrapperRecognizer1p, &eventl, NULL) == 0) {
+      rci = 1;
+    } else if (eventl != 0) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "First recognizer has %ld events instead of 0", (unsigned long) eventl);
+      rci = 1;
+    }
+  }
+
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizer1p, symbolip[number], 3, 1) == 0) {
+      rci = 1;
+    } else {
+      rci = checkEventCounts("number op number", marpaWrapperGrammarp, marpaWrapperRecognizer1p, 1, genericLoggerp);
+    }
+  }
+
+  /* A rejected token is the last error of its recognizer only */
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizer1p, &marpaErrorCodei) == 0) {
+      rci = 1;
+    } else if (marpaErrorCodei != 0 /* MARPA_ERR_NONE */) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Last error is %d instead of 0", marpaErrorCodei);
+      rci = 1;
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_alternativeb(marpaWrapperRecognizer1p, symbolip[number], 4, 1) != 0) {
+      GENERICLOGGER_ERROR(genericLoggerp, "number after number was accepted");
+      rci = 1;
+    } else if (marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizer1p, &marpaErrorCodei) == 0) {
+      rci = 1;
+    } else if (marpaErrorCodei == 0 /* MARPA_ERR_NONE */) {
+      GENERICLOGGER_ERROR(genericLoggerp, "Last error is MARPA_ERR_NONE after a rejected token");
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "number after number: last error is %d", marpaErrorCodei);
+    }
+  }
+  if (rci == 0) {
+    if (marpaWrapperRecognizer_lastErrorb(marpaWrapperRecognizer2p, &marpaErrorCodei) == 0) {
+      rci = 1;
+    } else if (marpaErrorCodei != 0 /* MARPA_ERR_NONE */) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Second recognizer last error is %d instead of 0", marpaErrorCodei);
+      rci = 1;
+    }
+  }
+
+  /* Nor does the grammar inherit the events of its recognizers when they go away */
+  if (marpaWrapperRecognizer2p != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizer2p);
+  }
+  if (marpaWrapperRecognizer1p != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizer1p);
+  }
+  if (rci == 0) {
+    size_t grammarEventl;
+    if (marpaWrapperGrammar_eventb(marpaWrapperGrammarp, &grammarEventl, NULL, 0 /* exhaustionEventb */, 0 /* forceReloadb */) == 0) {
+      rci = 1;
+    } else if (grammarEventl != 0) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Grammar has %ld events instead of 0 after the recognizers are freed", (unsigned long) grammarEventl);
+      rci = 1;
+    }
+  }
+
+  marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static short nestedReadManyCallback(void *userDatavp, size_t tokenl, short rejectedb, size_t eventl, marpaWrapperGrammarEvent_t *eventp)
+/****************************************************************************/
+/* Reads number, op, number... in another recognizer                        */
+/****************************************************************************/
+{
+  nestedContext_t *nestedContextp = (nestedContext_t *) userDatavp;
+  int              symboli        = nestedContextp->symbolip[((nestedContextp->nReadi % 2) == 0) ? number : op];
+
+  nestedContextp->nReadi++;
+  return marpaWrapperRecognizer_readb(nestedContextp->marpaWrapperRecognizerp, symboli, nestedContextp->nReadi, 1);
+}
+
+/****************************************************************************/
+static int checkNestedAllocators(genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Recognizer memory must come from its own allocator even when a callback  */
+/* drives a recognizer that has another one.                                */
+/****************************************************************************/
+{
+  accounting_t                    accountingNested             = { 0, 0 };
+  marpaWrapperAllocator_t         nestedAllocator              = { &accountingNested, accountingMallocp, accountingReallocp, accountingFreev };
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperRecognizerOption_t  nestedRecognizerOption       = { NULL, 0, 0, &nestedAllocator };
+  marpaWrapperRecognizerToken_t   tokens[]                     = {
+    { number, 1, 1, 1 }, { op, 2, 1, 1 }, { number, 3, 1, 1 }, { op, 4, 1, 1 }, { number, 5, 1, 1 }
+  };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  nestedContext_t                 nestedContext;
+  int                             symbolip[MAX_SYMBOL];
+  size_t                          readl;
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = eventGrammarp(symbolip);
+  if (marpaWrapperGrammarp == NULL) {
+    return 1;
+  }
+  marpaWrapperRecognizerp               = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  nestedContext.marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &nestedRecognizerOption);
+  nestedContext.symbolip                = symbolip;
+  nestedContext.nReadi                  = 0;
+  if ((marpaWrapperRecognizerp == NULL) || (nestedContext.marpaWrapperRecognizerp == NULL)) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    if ((marpaWrapperRecognizer_readManyb(marpaWrapperRecognizerp, tokens, 5, &readl, nestedReadManyCallback, &nestedContext) == 0) || (readl != 5) || (nestedContext.nReadi != 3)) {
+      rci = 1;
+    }
+  }
+
+  /* Nothing of the first recognizer may remain in the other allocator */
+  if (nestedContext.marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(nestedContext.marpaWrapperRecognizerp);
+  }
+  if (rci == 0) {
+    if ((accountingNested.nAllocl <= 0) || (accountingNested.nLivel != 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Nested allocator: %ld blocks given, %ld not released", (unsigned long) accountingNested.nAllocl, (unsigned long) accountingNested.nLivel);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFO(genericLoggerp, "Nested allocator: all blocks released");
+    }
+  }
+
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static short readManyCallback(void *userDatavp, size_t tokenl, short rejectedb, size_t eventl, marpaWrapperGrammarEvent_t *eventp)
+/****************************************************************************/
+{
+  readManyContext_t *readManyContextp = (readManyContext_t *) userDatavp;
+
+  if (rejectedb) {
+    readManyContextp->nRejectedl++;
+    return readManyContextp->stopOnRejectionb ? 0 : 1;
+  }
+
+  readManyContextp->nEventCalll++;
+  return readManyContextp->stopOnEventb ? 0 : 1;
+}
+
+/****************************************************************************/
+static int checkReadMany(char *whats, marpaWrapperRecognizerToken_t *tokenp, size_t tokenl, short stopOnEventb, short stopOnRejectionb, size_t expectedReadl, size_t expectedEventCalll, size_t expectedRejectedl, int expectedEarlemei, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Tokens use the symbol enums, that are also their ids in eventGrammarp()  */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  readManyContext_t               readManyContext              = { stopOnEventb, stopOnRejectionb, 0, 0 };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  int                             symbolip[MAX_SYMBOL];
+  size_t                          readl;
+  int                             earlemei;
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = eventGrammarp(symbolip);
+  if (marpaWrapperGrammarp == NULL) {
+    return 1;
+  }
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    if ((marpaWrapperRecognizer_readManyb(marpaWrapperRecognizerp, tokenp, tokenl, &readl, readManyCallback, &readManyContext) == 0) ||
+        (marpaWrapperRecognizer_currentEarlemeb(marpaWrapperRecognizerp, &earlemei) == 0)) {
+      rci = 1;
+    } else if ((readl != expectedReadl) ||
+               (readManyContext.nEventCalll != expectedEventCalll) ||
+               (readManyContext.nRejectedl != expectedRejectedl) ||
+               (earlemei != expectedEarlemei)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld tokens read, %ld event calls, %ld rejections, earleme %d instead of %ld, %ld, %ld, %d",
+                           whats,
+                           (unsigned long) readl, (unsigned long) readManyContext.nEventCalll, (unsigned long) readManyContext.nRejectedl, earlemei,
+                           (unsigned long) expectedReadl, (unsigned long) expectedEventCalll, (unsigned long) expectedRejectedl, expectedEarlemei);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%s: %ld tokens read, %ld event calls, %ld rejections, earleme %d",
+                          whats, (unsigned long) readl, (unsigned long) readManyContext.nEventCalll, (unsigned long) readManyContext.nRejectedl, earlemei);
+    }
+  }
+
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static short treesRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "R%d[%d..%d]->%d ", rulei, arg0i, argni, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static short treesSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  treesContext_t *treesContextp = (treesContext_t *) userDatavp;
+  int             ni;
+
+  ni = snprintf(treesContextp->s + treesContextp->usedl, sizeof(treesContextp->s) - treesContextp->usedl, "T%d[%d]->%d ", symboli, argi, resulti);
+  if ((ni < 0) || ((size_t) ni >= sizeof(treesContextp->s) - treesContextp->usedl)) {
+    return 0;
+  }
+  treesContextp->usedl += (size_t) ni;
+
+  return 1;
+}
+
+/****************************************************************************/
+static int parseTrees(marpaWrapperRecognizer_t *marpaWrapperRecognizerp, int *symbolip, treesContext_t *treesContextp, size_t *nTreelp)
+/****************************************************************************/
+/* Reads 1 - 2 * 3 and writes all its trees, as seen by the callbacks, in   */
+/* treesContextp->s. The value instance is freed before returning.          */
+/****************************************************************************/
+{
+  marpaWrapperValue_t       *marpaWrapperValuep;
+  short                      valueb;
+  int                        i;
+
+  treesContextp->s[0] = '\0';
+  treesContextp->usedl = 0;
+  *nTreelp             = 0;
+
+  for (i = 1; i <= 5; i++) {
+    if (marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1) == 0) {
+      return 1;
+    }
+  }
+
+  marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &treesValueOption);
+  if (marpaWrapperValuep == NULL) {
+    return 1;
+  }
+  while ((valueb = marpaWrapperValue_valueb(marpaWrapperValuep, (void *) treesContextp, treesRuleCallback, treesSymbolCallback, NULL)) > 0) {
+    (*nTreelp)++;
+    if (treesContextp->usedl + 2 >= sizeof(treesContextp->s)) {
+      valueb = -1;
+      break;
+    }
+    treesContextp->s[treesContextp->usedl++] = '|';
+    treesContextp->s[treesContextp->usedl]   = '\0';
+  }
+  marpaWrapperValue_freev(marpaWrapperValuep);
+
+  return (valueb < 0) ? 1 : 0;
+}
+
+/****************************************************************************/
+static int checkReset(genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* A reset recognizer parses again the same trees. It cannot be reset while */
+/* a value refers to its parse.                                             */
+/****************************************************************************/
+{
+  marpaWrapperRecognizerOption_t  marpaWrapperRecognizerOption = { NULL, 0, 0, NULL };
+  marpaWrapperGrammar_t          *marpaWrapperGrammarp;
+  marpaWrapperRecognizer_t       *marpaWrapperRecognizerp;
+  marpaWrapperValue_t            *marpaWrapperValuep;
+  treesContext_t                  firstTrees;
+  treesContext_t                  trees;
+  size_t                          firstTreel;
+  size_t                          treel;
+  int                             symbolip[MAX_SYMBOL];
+  int                             earlemei;
+  int                             rci = 0;
+
+  marpaWrapperGrammarp = eventGrammarp(symbolip);
+  if (marpaWrapperGrammarp == NULL) {
+    return 1;
+  }
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, &marpaWrapperRecognizerOption);
+  if (marpaWrapperRecognizerp == NULL) {
+    rci = 1;
+  }
+
+  if (rci == 0) {
+    rci = parseTrees(marpaWrapperRecognizerp, symbolip, &firstTrees, &firstTreel);
+  }
+
+  if (rci == 0) {
+    marpaWrapperValuep = marpaWrapperValue_newp(marpaWrapperRecognizerp, &treesValueOption);
+    if (marpaWrapperValuep == NULL) {
+      rci = 1;
+    } else {
+      errno = 0;
+      if ((marpaWrapperRecognizer_resetb(marpaWrapperRecognizerp) != 0) || (errno != EBUSY)) {
+        GENERICLOGGER_ERROR(genericLoggerp, "Reset: recognizer was reset while a value is alive");
+        rci = 1;
+      }
+      marpaWrapperValue_freev(marpaWrapperValuep);
+    }
+  }
+
+  if (rci == 0) {
+    if ((marpaWrapperRecognizer_resetb(marpaWrapperRecognizerp) == 0) ||
+        (marpaWrapperRecognizer_currentEarlemeb(marpaWrapperRecognizerp, &earlemei) == 0)) {
+      rci = 1;
+    } else if (earlemei != 0) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Reset: current earleme is %d instead of 0", earlemei);
+      rci = 1;
+    }
+  }
+
+  if (rci == 0) {
+    rci = parseTrees(marpaWrapperRecognizerp, symbolip, &trees, &treel);
+  }
+  if (rci == 0) {
+    if ((firstTreel != 2) || (treel != firstTreel) || (strcmp(firstTrees.s, trees.s) != 0)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "Reset: %ld trees \"%s\" instead of %ld trees \"%s\"", (unsigned long) treel, trees.s, (unsigned long) firstTreel, firstTrees.s);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "Reset: same %ld trees %s", (unsigned long) treel, trees.s);
+    }
+  }
+
+  if (marpaWrapperRecognizerp != NULL) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+  }
+  marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static void *accountingMallocp(void *userDatavp, size_t sizel)
+/****************************************************************************/
+{
+  accounting_t *accountingp = (accounting_t *) userDatavp;
+  void         *p           = malloc(sizel);
+
+  if (p != NULL) {
+    accountingp->nAllocl++;
+    accountingp->nLivel++;
+  }
+
+  return p;
+}
+
+/****************************************************************************/
+static void *accountingReallocp(void *userDatavp, void *p, size_t sizel)
+/****************************************************************************/
+{
+  accounting_t *accountingp = (accounting_t *) userDatavp;
+  void         *newp        = realloc(p, sizel);
+
+  if ((p == NULL) && (newp != NULL)) {
+    accountingp->nAllocl++;
+    accountingp->nLivel++;
+  }
+
+  return newp;
+}
+
+/****************************************************************************/
+static void accountingFreev(void *userDatavp, void *p)
+/****************************************************************************/
+{
+  accounting_t *accountingp = (accounting_t *) userDatavp;
+
+  if (p != NULL) {
+    accountingp->nLivel--;
+  }
+  free(p);
+}
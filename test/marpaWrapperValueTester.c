@@ -0,0 +1,365 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <errno.h>
+#include <limits.h>
+#include "marpaWrapper.h"
+#include "genericLogger.h"
+
+/*
+  Expression scenario:              Nulling scenario:
+
+  S ::= E                           S ::= A N A
+  E ::= E op E                      S ::= S N A
+  E ::= number                      N ::=
+
+  number op number ... with NNUMBER numbers has Catalan(NNUMBER-1) trees. NA tokens A have one
+  tree, with nulling N steps, and token values that need all the bytes of an int.
+*/
+enum { S = 0, E, op, number, A, N, MAX_SYMBOL };
+enum { EXPRESSION_SCENARIO = 0, NULLING_SCENARIO };
+enum { REFERENCE_RECOGNIZER = 0, STEPS_RECOGNIZER, IMAGE_RECOGNIZER, REUSE_RECOGNIZER, MAX_RECOGNIZER };
+
+#define NNUMBER     7
+#define NTREE       132 /* Catalan(6) */
+#define NA          5
+#define MAX_STEP    64
+#define SMALL_STEP  3
+
+typedef struct recordContext {
+  marpaWrapperValue_t     *marpaWrapperValuep; /* NULL when there is no Earley set */
+  marpaWrapperValueStep_t  stepp[MAX_STEP];
+  size_t                   nStepl;
+} recordContext_t;
+
+static int   aTokenValueip[NA] = { 1, -1, 300, -70000, INT_MAX };
+
+static short recordRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti);
+static short recordSymbolCallback(void *userDatavp, int symboli, int argi, int resulti);
+static short recordNullingCallback(void *userDatavp, int symboli, int resulti);
+static short recordStepb(recordContext_t *recordContextp, int typei, int idi, int arg0i, int argni, int resulti, int tokenValuei);
+static short sameStepsb(marpaWrapperValueStep_t *step1p, size_t nStep1l, marpaWrapperValueStep_t *step2p, size_t nStep2l, short earleySetsb);
+static marpaWrapperGrammar_t    *grammarp(int scenarioi, int *symbolip);
+static marpaWrapperRecognizer_t *recognizerp(int scenarioi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip);
+static int   checkValues(char *whats, int scenarioi, size_t expectedTreel, genericLogger_t *genericLoggerp);
+
+int main(int argc, char **argv) {
+  genericLogger_t *genericLoggerp = GENERICLOGGER_NEW(GENERICLOGGER_LOGLEVEL_DEBUG);
+  int              rci;
+
+  rci = checkValues("Expression", EXPRESSION_SCENARIO, NTREE, genericLoggerp);
+  if (rci == 0) {
+    rci = checkValues("Nulling", NULLING_SCENARIO, 1, genericLoggerp);
+  }
+
+  GENERICLOGGER_FREE(genericLoggerp);
+
+  exit(rci);
+}
+
+/****************************************************************************/
+static int checkValues(char *whats, int scenarioi, size_t expectedTreel, genericLogger_t *genericLoggerp)
+/****************************************************************************/
+/* Recognizers read the same input. For every tree, the callbacks of the   */
+/* reference one are the reference for:                                     */
+/* - marpaWrapperValue_stepsb() of another one, with no buffer, a buffer    */
+/*   too small or a buffer large enough, in turn,                           */
+/* - marpaWrapperValue_image_valueb() of the images of another one, but     */
+/*   Earley sets,                                                           */
+/* - the callbacks of another one, that has the reuseValuatorb option.      */
+/****************************************************************************/
+{
+  marpaWrapperValueOption_t  marpaWrapperValueOption     = { NULL,
+                                                             0 /* highRankOnlyb */,
+                                                             0 /* orderByRankb */,
+                                                             1 /* ambiguousb */,
+                                                             0 /* nullb */,
+                                                             0 /* maxParsesi */,
+                                                             0 /* reuseValuatorb */
+  };
+  marpaWrapperValueOption_t  reuseValueOption            = { NULL,
+                                                             0 /* highRankOnlyb */,
+                                                             0 /* orderByRankb */,
+                                                             1 /* ambiguousb */,
+                                                             0 /* nullb */,
+                                                             0 /* maxParsesi */,
+                                                             1 /* reuseValuatorb */
+  };
+  marpaWrapperGrammar_t     *marpaWrapperGrammarp;
+  marpaWrapperRecognizer_t  *marpaWrapperRecognizerpp[MAX_RECOGNIZER];
+  marpaWrapperValue_t       *marpaWrapperValuepp[MAX_RECOGNIZER];
+  recordContext_t            referenceContext;
+  recordContext_t            imageContext;
+  recordContext_t            reuseContext;
+  marpaWrapperValueStep_t    callerStepp[MAX_STEP];
+  marpaWrapperValueStep_t   *stepp;
+  size_t                     nStepl;
+  size_t                     sizeStepl;
+  char                      *bufferp;
+  size_t                     bufferl;
+  short                      referenceb;
+  short                      stepsb;
+  short                      imageb;
+  short                      reuseb;
+  size_t                     nTreel        = 0;
+  size_t                     nTotalStepl   = 0;
+  size_t                     nTotalBytel   = 0;
+  size_t                     allocationl;
+  size_t                     reusel;
+  int                        symbolip[MAX_SYMBOL];
+  int                        i;
+  int                        rci = 0;
+
+  marpaWrapperGrammarp = grammarp(scenarioi, symbolip);
+  if (marpaWrapperGrammarp == NULL) {
+    return 1;
+  }
+  for (i = 0; i < MAX_RECOGNIZER; i++) {
+    marpaWrapperRecognizerpp[i] = NULL;
+    marpaWrapperValuepp[i]      = NULL;
+  }
+  for (i = 0; (rci == 0) && (i < MAX_RECOGNIZER); i++) {
+    marpaWrapperRecognizerpp[i] = recognizerp(scenarioi, marpaWrapperGrammarp, symbolip);
+    if (marpaWrapperRecognizerpp[i] == NULL) {
+      rci = 1;
+    } else {
+      marpaWrapperValuepp[i] = marpaWrapperValue_newp(marpaWrapperRecognizerpp[i], (i == REUSE_RECOGNIZER) ? &reuseValueOption : &marpaWrapperValueOption);
+      if (marpaWrapperValuepp[i] == NULL) {
+        rci = 1;
+      }
+    }
+  }
+  referenceContext.marpaWrapperValuep = marpaWrapperValuepp[REFERENCE_RECOGNIZER];
+  imageContext.marpaWrapperValuep     = NULL;
+  reuseContext.marpaWrapperValuep     = marpaWrapperValuepp[REUSE_RECOGNIZER];
+
+  while (rci == 0) {
+    referenceContext.nStepl = 0;
+    referenceb = marpaWrapperValue_valueb(marpaWrapperValuepp[REFERENCE_RECOGNIZER], &referenceContext, recordRuleCallback, recordSymbolCallback, recordNullingCallback);
+
+    sizeStepl = ((nTreel % 3) == 0) ? 0 : (((nTreel % 3) == 1) ? SMALL_STEP : MAX_STEP);
+    stepsb    = marpaWrapperValue_stepsb(marpaWrapperValuepp[STEPS_RECOGNIZER], (sizeStepl > 0) ? callerStepp : NULL, sizeStepl, &stepp, &nStepl);
+
+    bufferp = NULL;
+    imageb  = marpaWrapperValue_serializeb(marpaWrapperValuepp[IMAGE_RECOGNIZER], &bufferp, &bufferl);
+
+    reuseContext.nStepl = 0;
+    reuseb = marpaWrapperValue_valueb(marpaWrapperValuepp[REUSE_RECOGNIZER], &reuseContext, recordRuleCallback, recordSymbolCallback, recordNullingCallback);
+
+    if ((stepsb != referenceb) || (imageb != referenceb) || (reuseb != referenceb)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: status %d, %d with steps, %d with an image, %d with reuse", whats, (unsigned long) nTreel, (int) referenceb, (int) stepsb, (int) imageb, (int) reuseb);
+      rci = 1;
+    }
+    if ((rci != 0) || (referenceb <= 0)) {
+      if (bufferp != NULL) {
+        free(bufferp);
+      }
+      break;
+    }
+
+    if (! sameStepsb(referenceContext.stepp, referenceContext.nStepl, stepp, nStepl, 1)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: steps differ from the callbacks", whats, (unsigned long) nTreel);
+      rci = 1;
+    } else if ((nStepl <= sizeStepl) != (stepp == callerStepp)) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: %ld steps are not where expected with a buffer of %ld steps", whats, (unsigned long) nTreel, (unsigned long) nStepl, (unsigned long) sizeStepl);
+      rci = 1;
+    }
+
+    if (rci == 0) {
+      imageContext.nStepl = 0;
+      if (marpaWrapperValue_image_valueb(NULL, bufferp, bufferl, &imageContext, recordRuleCallback, recordSymbolCallback, recordNullingCallback) == 0) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: image valuation failure", whats, (unsigned long) nTreel);
+        rci = 1;
+      } else if (! sameStepsb(referenceContext.stepp, referenceContext.nStepl, imageContext.stepp, imageContext.nStepl, 0)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: image valuation differs from the callbacks", whats, (unsigned long) nTreel);
+        rci = 1;
+      } else if ((nTreel == 0) && (marpaWrapperValue_image_valueb(NULL, bufferp, bufferl - 1, &imageContext, recordRuleCallback, recordSymbolCallback, recordNullingCallback) != 0)) {
+        GENERICLOGGER_ERRORF(genericLoggerp, "%s: a truncated image was accepted", whats);
+        rci = 1;
+      }
+    }
+    free(bufferp);
+
+    if ((rci == 0) && (! sameStepsb(referenceContext.stepp, referenceContext.nStepl, reuseContext.stepp, reuseContext.nStepl, 1))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: tree No %ld: reusing the valuator changes the callbacks", whats, (unsigned long) nTreel);
+      rci = 1;
+    }
+
+    if (rci != 0) {
+      break;
+    }
+
+    nTreel++;
+    nTotalStepl += nStepl;
+    nTotalBytel += bufferl;
+  }
+
+  /* Valuators of all the trees but the first reuse some memory */
+  if (rci == 0) {
+    if (marpaWrapperValue_valuatorStatsb(marpaWrapperValuepp[REUSE_RECOGNIZER], &allocationl, &reusel) == 0) {
+      rci = 1;
+    } else if ((nTreel != expectedTreel) || (allocationl <= 0) || ((nTreel > 1) && (reusel <= 0))) {
+      GENERICLOGGER_ERRORF(genericLoggerp, "%s: %ld trees instead of %ld, %ld valuator blocks allocated, %ld reused", whats, (unsigned long) nTreel, (unsigned long) expectedTreel, (unsigned long) allocationl, (unsigned long) reusel);
+      rci = 1;
+    } else {
+      GENERICLOGGER_INFOF(genericLoggerp, "%s: %ld trees, %ld steps, images of %ld bytes, valuator blocks reused %s",
+                          whats, (unsigned long) nTreel, (unsigned long) nTotalStepl, (unsigned long) nTotalBytel, (reusel > 0) ? "yes" : "no");
+    }
+  }
+
+  for (i = 0; i < MAX_RECOGNIZER; i++) {
+    if (marpaWrapperValuepp[i] != NULL) {
+      marpaWrapperValue_freev(marpaWrapperValuepp[i]);
+    }
+    if (marpaWrapperRecognizerpp[i] != NULL) {
+      marpaWrapperRecognizer_freev(marpaWrapperRecognizerpp[i]);
+    }
+  }
+  marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+
+  return rci;
+}
+
+/****************************************************************************/
+static marpaWrapperGrammar_t *grammarp(int scenarioi, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperGrammar_t *marpaWrapperGrammarp;
+  short                  okb;
+
+  marpaWrapperGrammarp = marpaWrapperGrammar_newp(NULL);
+  if (marpaWrapperGrammarp == NULL) {
+    return NULL;
+  }
+  if (scenarioi == EXPRESSION_SCENARIO) {
+    okb = ((symbolip[     S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          ((symbolip[     E] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          ((symbolip[    op] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          ((symbolip[number] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[E],                            -1) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[E], symbolip[op], symbolip[E], -1) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[E], symbolip[number],                       -1) >= 0);
+  } else {
+    okb = ((symbolip[S] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          ((symbolip[A] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          ((symbolip[N] = MARPAWRAPPERGRAMMAR_NEWSYMBOL(marpaWrapperGrammarp)) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[A], symbolip[N], symbolip[A], -1) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[N],                                        -1) >= 0) &&
+          (MARPAWRAPPERGRAMMAR_NEWRULE(marpaWrapperGrammarp, symbolip[S], symbolip[S], symbolip[N], symbolip[A], -1) >= 0);
+  }
+  if ((! okb) || (marpaWrapperGrammar_precomputeb(marpaWrapperGrammarp) == 0)) {
+    marpaWrapperGrammar_freev(marpaWrapperGrammarp);
+    return NULL;
+  }
+
+  return marpaWrapperGrammarp;
+}
+
+/****************************************************************************/
+static marpaWrapperRecognizer_t *recognizerp(int scenarioi, marpaWrapperGrammar_t *marpaWrapperGrammarp, int *symbolip)
+/****************************************************************************/
+{
+  marpaWrapperRecognizer_t *marpaWrapperRecognizerp;
+  int                       i;
+  short                     okb = 1;
+
+  marpaWrapperRecognizerp = marpaWrapperRecognizer_newp(marpaWrapperGrammarp, NULL);
+  if (marpaWrapperRecognizerp == NULL) {
+    return NULL;
+  }
+  if (scenarioi == EXPRESSION_SCENARIO) {
+    /* Token values are their positions, starting at 1 */
+    for (i = 1; okb && (i < 2 * NNUMBER); i++) {
+      okb = marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[((i % 2) == 1) ? number : op], i, 1);
+    }
+  } else {
+    for (i = 0; okb && (i < NA); i++) {
+      okb = marpaWrapperRecognizer_readb(marpaWrapperRecognizerp, symbolip[A], aTokenValueip[i], 1);
+    }
+  }
+  if (! okb) {
+    marpaWrapperRecognizer_freev(marpaWrapperRecognizerp);
+    return NULL;
+  }
+
+  return marpaWrapperRecognizerp;
+}
+
+/****************************************************************************/
+static short recordStepb(recordContext_t *recordContextp, int typei, int idi, int arg0i, int argni, int resulti, int tokenValuei)
+/****************************************************************************/
+/* Records what marpaWrapperValue_stepsb() would give for a callback        */
+/****************************************************************************/
+{
+  marpaWrapperValueStep_t *stepp;
+
+  if (recordContextp->nStepl >= MAX_STEP) {
+    return 0;
+  }
+  stepp = &(recordContextp->stepp[recordContextp->nStepl++]);
+
+  stepp->typei       = typei;
+  stepp->idi         = idi;
+  stepp->arg0i       = arg0i;
+  stepp->argni       = argni;
+  stepp->resulti     = resulti;
+  stepp->tokenValuei = tokenValuei;
+  stepp->starti      = 0;
+  stepp->lengthi     = 0;
+  if (recordContextp->marpaWrapperValuep != NULL) {
+    if ((marpaWrapperValue_value_startb(recordContextp->marpaWrapperValuep, &(stepp->starti)) == 0) ||
+        (marpaWrapperValue_value_lengthb(recordContextp->marpaWrapperValuep, &(stepp->lengthi)) == 0)) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/****************************************************************************/
+static short recordRuleCallback(void *userDatavp, int rulei, int arg0i, int argni, int resulti)
+/****************************************************************************/
+{
+  return recordStepb((recordContext_t *) userDatavp, MARPAWRAPPERVALUE_STEP_RULE, rulei, arg0i, argni, resulti, -1);
+}
+
+/****************************************************************************/
+static short recordSymbolCallback(void *userDatavp, int symboli, int argi, int resulti)
+/****************************************************************************/
+{
+  return recordStepb((recordContext_t *) userDatavp, MARPAWRAPPERVALUE_STEP_TOKEN, symboli, resulti, resulti, resulti, argi);
+}
+
+/****************************************************************************/
+static short recordNullingCallback(void *userDatavp, int symboli, int resulti)
+/****************************************************************************/
+{
+  return recordStepb((recordContext_t *) userDatavp, MARPAWRAPPERVALUE_STEP_NULLING, symboli, resulti, resulti, resulti, -1);
+}
+
+/****************************************************************************/
+static short sameStepsb(marpaWrapperValueStep_t *step1p, size_t nStep1l, marpaWrapperValueStep_t *step2p, size_t nStep2l, short earleySetsb)
+/****************************************************************************/
+{
+  size_t i;
+
+  if (nStep1l != nStep2l) {
+    return 0;
+  }
+  for (i = 0; i < nStep1l; i++) {
+    if ((step1p[i].typei       != step2p[i].typei)       ||
+        (step1p[i].idi         != step2p[i].idi)         ||
+        (step1p[i].arg0i       != step2p[i].arg0i)       ||
+        (step1p[i].argni       != step2p[i].argni)       ||
+        (step1p[i].resulti     != step2p[i].resulti)     ||
+        (step1p[i].tokenValuei != step2p[i].tokenValuei)) {
+      return 0;
+    }
+    if (earleySetsb &&
+        ((step1p[i].starti  != step2p[i].starti) ||
+         (step1p[i].lengthi != step2p[i].lengthi))) {
+      return 0;
+    }
+  }
+
+  return 1;
+}